@@ -43,8 +43,11 @@ private:
     StateMap *_render_settings;
     RenderPlugin::PipeCtxStub *_display_pipe_ctx{};
     vstd::optional<rbc::Lights> _lights;
+    // started in init_graphics, reported once the first frame is presented
+    luisa::Clock _startup_clock;
     bool _require_reset : 1 {false};
     bool _denoiser_inited : 1 {false};
+    bool _startup_reported : 1 {false};
 
 public:
     auto render_plugin() const { return _render_plugin; }
@@ -82,6 +85,8 @@ public:
         uint2 resolution,
         TickStage tick_stage = TickStage::PathTracingPreview);
     void denoise();
+    // ms/MPixel of the last finished denoise, the CPU denoiser finishes one frame late
+    [[nodiscard]] double denoise_ms_per_mpixel() const;
     void create_texture(
         DeviceImage *ptr,
         PixelStorage storage,
@@ -35,11 +35,14 @@ void GraphicsUtils::dispose(vstd::function<void()> after_sync) {
     if (_display_pipe_ctx)
         _render_plugin->destroy_pipeline_context(_display_pipe_ctx);
     _denoise_pack.denoise_callback = {};
+    _denoise_pack.ms_per_mpixel = {};
     _render_module.reset();
     if (_lights)
         _lights.destroy();
     AssetsManager::destroy_instance();
     if (_sm) {
+        // the next start preloads what this session used
+        ShaderManager::instance()->save_manifest();
         _sm.destroy();
     }
     if (_present_stream)
@@ -56,6 +59,7 @@ void GraphicsUtils::init_device(luisa::string_view program_path, luisa::string_v
     _backend_name = backend_name;
 }
 void GraphicsUtils::init_graphics(luisa::filesystem::path const &shader_path) {
+    _startup_clock.tic();
     auto &cmdlist = _render_device.lc_main_cmd_list();
     _sm.create(
         _render_device.lc_ctx(),
@@ -67,6 +71,8 @@ void GraphicsUtils::init_graphics(luisa::filesystem::path const &shader_path) {
     AssetsManager::init_instance(_render_device, _sm);
     // init
     {
+        // subsystems asking for a preloading shader wait for it instead of loading it again
+        auto preload_counter = ShaderManager::instance()->preload_manifest();
         luisa::fiber::counter init_counter;
         _sm->load_shader(init_counter);
         // Build a simple accel to preload driver builtin shaders
@@ -91,6 +97,7 @@ void GraphicsUtils::init_graphics(luisa::filesystem::path const &shader_path) {
             << [accel = std::move(accel), mesh = std::move(mesh), buffer = std::move(buffer)]() {};
         _render_device.lc_main_stream().synchronize();
         init_counter.wait();
+        preload_counter.wait();
     }
     _lights.create();
 }
@@ -275,6 +282,10 @@ void GraphicsUtils::tick(
     /////////// Present
     if (_swapchain)
         _present_stream << _swapchain.present(_dst_image);
+    if (!_startup_reported) {
+        _startup_reported = true;
+        ShaderManager::instance()->report_load_times(_startup_clock.toc());
+    }
     render_lck.unlock();
     world::Component::_zz_invoke_world_event(world::WorldEventType::AfterFrame);
     // for (auto &i : rpc_hook.shared_window.swapchains) {
@@ -372,6 +383,10 @@ void GraphicsUtils::denoise() {
     }
     _denoise_pack.denoise_callback();
 }
+double GraphicsUtils::denoise_ms_per_mpixel() const {
+    if (!_denoiser_inited || !_denoise_pack.ms_per_mpixel) return 0.0;
+    return _denoise_pack.ms_per_mpixel();
+}
 void GraphicsUtils::create_texture(
     DeviceImage *ptr,
     PixelStorage storage,
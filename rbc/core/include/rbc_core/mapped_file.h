@@ -0,0 +1,34 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/stl/filesystem.h>
+#include <luisa/core/stl/memory.h>
+namespace rbc {
+// Read-only memory mapping of a whole file, pages are loaded by the OS on first access.
+struct RBC_CORE_API MappedFile {
+private:
+    std::byte const *_data{nullptr};
+    size_t _size{0};
+#ifdef _WIN32
+    void *_file{nullptr};
+    void *_mapping{nullptr};
+#endif
+    void _dispose();
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(luisa::filesystem::path const &path);
+    MappedFile(MappedFile const &) = delete;
+    MappedFile(MappedFile &&rhs);
+    MappedFile &operator=(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile &&rhs) {
+        this->~MappedFile();
+        new (std::launder(this)) MappedFile{std::move(rhs)};
+        return *this;
+    }
+    ~MappedFile();
+    // empty files are not mapped and stay invalid
+    [[nodiscard]] bool valid() const { return _data != nullptr; }
+    [[nodiscard]] luisa::span<std::byte const> data() const { return {_data, _size}; }
+    [[nodiscard]] size_t size() const { return _size; }
+};
+}// namespace rbc
@@ -2,6 +2,7 @@
 #include <rbc_config.h>
 #include <tracy_wrapper.h>
 #include <new>
+#include <cstdint>
 #include <type_traits>
 
 //=======================basic alloc=======================
@@ -28,6 +29,37 @@ RBC_EXTERN_C RBC_CORE_API void *traced_os_realloc_aligned(void *p, size_t newsiz
 RBC_EXTERN_C RBC_CORE_API void *containers_malloc_aligned(size_t size, size_t alignment);
 RBC_EXTERN_C RBC_CORE_API void containers_free_aligned(void *p, size_t alignment);
 
+//=======================pool statistics=======================
+// Counters of one pool name, allocations without a pool name are counted under "rbc::default".
+// Rates are obtained by sampling the monotonic counts twice.
+typedef struct RBCPoolStats {
+    const char *name;
+    uint64_t live_bytes;
+    uint64_t peak_bytes;// sampled every 64 KiB allocated per thread and on every stats read
+    uint64_t alloc_count;
+    uint64_t free_count;
+    uint64_t total_alloc_bytes;
+} RBCPoolStats;
+
+// Dedicated allocator a pool name can be bound to, all callbacks must be thread-safe.
+typedef struct RBCPoolAllocator {
+    void *user_data;
+    void *(*alloc)(void *user_data, size_t size, size_t alignment);
+    void (*free)(void *user_data, void *p);
+    // Size usable by the caller, used by realloc and statistics
+    size_t (*usable_size)(void *user_data, void *p);
+} RBCPoolAllocator;
+
+// Returns false if the pool was never used
+RBC_EXTERN_C RBC_CORE_API bool rbc_pool_stats(const char *pool_name, RBCPoolStats *stats);
+// Pools are indexed in first-use order, returns false once index is out of range
+RBC_EXTERN_C RBC_CORE_API bool rbc_pool_stats_at(size_t index, RBCPoolStats *stats);
+RBC_EXTERN_C RBC_CORE_API size_t rbc_pool_count();
+// Route every rbc_*N call with this pool name to allocator, nullptr restores the default heap.
+// Only possible before the pool's first allocation, which fixes the allocator for the rest of the
+// process, so it must outlive every later use of the pool name.
+RBC_EXTERN_C RBC_CORE_API bool rbc_pool_bind_allocator(const char *pool_name, const RBCPoolAllocator *allocator);
+
 //=======================alloc with trace=======================
 #if defined(RBC_PROFILE_ENABLE) && defined(TRACY_TRACE_ALLOCATION)
 #define RBC_ALLOC_TRACY_MARKER_COLOR 0xff0000
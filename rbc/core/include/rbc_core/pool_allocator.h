@@ -0,0 +1,77 @@
+#pragma once
+#include <rbc_config.h>
+#include <rbc_core/memory.h>
+#include <luisa/core/spin_mutex.h>
+#include <luisa/core/stl/vector.h>
+#include <array>
+#include <type_traits>
+
+namespace rbc {
+// Bump allocator for pools whose blocks die together, e.g. once per frame.
+// free() is a no-op, reset() recycles every chunk, so no block of the pool may be alive past reset().
+struct RBC_CORE_API ArenaPoolAllocator {
+private:
+    struct Chunk {
+        std::byte *ptr;
+        size_t size;
+    };
+    RBCPoolAllocator _allocator;
+    luisa::spin_mutex _mtx;
+    luisa::vector<Chunk> _chunks;
+    size_t _chunk_size;
+    size_t _chunk_index{};
+    size_t _offset{};
+    size_t _used_bytes{};
+    void *_alloc(size_t size, size_t alignment);
+
+public:
+    explicit ArenaPoolAllocator(size_t chunk_size = 1024ull * 1024ull);
+    ~ArenaPoolAllocator();
+    ArenaPoolAllocator(ArenaPoolAllocator const &) = delete;
+    ArenaPoolAllocator(ArenaPoolAllocator &&) = delete;
+    // Direct allocation without binding a pool name, thread-safe
+    [[nodiscard]] void *allocate(size_t size, size_t alignment) { return _alloc(size, alignment); }
+    // Uninitialized storage, only for types that need no destructor
+    template<typename T>
+        requires(std::is_trivially_destructible_v<T>)
+    [[nodiscard]] luisa::span<T> allocate_array(size_t count) {
+        return {static_cast<T *>(_alloc(sizeof(T) * count, alignof(T))), count};
+    }
+    void reset();
+    [[nodiscard]] size_t used_bytes() const { return _used_bytes; }
+    [[nodiscard]] size_t reserved_bytes() const;
+    // Pass to rbc_pool_bind_allocator
+    [[nodiscard]] RBCPoolAllocator const *allocator() const { return &_allocator; }
+};
+
+// Segregated free lists for blocks up to max_class_size, larger or over-aligned blocks use the heap.
+// Memory of freed small blocks is kept for reuse until destruction.
+struct RBC_CORE_API SizeClassPoolAllocator {
+    static constexpr size_t min_class_size = 16;
+    static constexpr size_t max_class_size = 4096;
+    static constexpr size_t class_count = 9;
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    struct SizeClass {
+        luisa::spin_mutex mtx;
+        FreeBlock *free_list{};
+        luisa::vector<std::byte *> slabs;
+    };
+    RBCPoolAllocator _allocator;
+    std::array<SizeClass, class_count> _classes;
+    size_t _slab_size;
+    void *_alloc(size_t size, size_t alignment);
+    void _free(void *p);
+    [[nodiscard]] static size_t _usable_size(void *p);
+
+public:
+    explicit SizeClassPoolAllocator(size_t slab_size = 64ull * 1024ull);
+    ~SizeClassPoolAllocator();
+    SizeClassPoolAllocator(SizeClassPoolAllocator const &) = delete;
+    SizeClassPoolAllocator(SizeClassPoolAllocator &&) = delete;
+    [[nodiscard]] RBCPoolAllocator const *allocator() const { return &_allocator; }
+};
+}// namespace rbc
@@ -29,6 +29,43 @@ public:
     }
     void add_node(float time, float value);
     [[nodiscard]] float sample_node(float time) const;
+    // Batch version of sample_node, ascending times walk the segments instead of searching for each sample.
+    // Unsorted times stay correct, every step back costs one binary search.
+    void sample_nodes(luisa::span<float const> times, luisa::span<float> out) const;
+    // out[i] = sample_node(begin + i * step), for baking LUTs
+    void sample_uniform(float begin, float step, luisa::span<float> out) const;
+};
+
+// Many curves sampled at one time, key nodes are stored SoA.
+// Every curve keeps its current segment, so advancing time costs a range check per curve.
+// Not thread-safe, sample() updates the cached segments.
+struct RBC_CORE_API CurveBatch {
+private:
+    vstd::vector<float> _times;
+    vstd::vector<float> _values;
+    vstd::vector<uint> _offsets{0u};
+    // cached segment of every curve: valid for lo <= time < hi, value = y0 + (time - x0) * slope
+    vstd::vector<float> _lo;
+    vstd::vector<float> _hi;
+    vstd::vector<float> _x0;
+    vstd::vector<float> _y0;
+    vstd::vector<float> _slope;
+    vstd::vector<int64_t> _cursors;
+    void _refresh(size_t curve, float time);
+
+public:
+    CurveBatch();
+    ~CurveBatch();
+    CurveBatch(CurveBatch const &) = default;
+    CurveBatch(CurveBatch &&) = default;
+    CurveBatch &operator=(CurveBatch const &) = default;
+    CurveBatch &operator=(CurveBatch &&) = default;
+    // returns the index of the curve in sample() output
+    size_t add_curve(Curve const &curve);
+    [[nodiscard]] size_t curve_count() const { return _offsets.size() - 1; }
+    void clear();
+    // out[i] = curve i sampled at time
+    void sample(float time, luisa::span<float> out);
 };
 
 struct Rect {
@@ -62,6 +99,8 @@ struct RBC_CORE_API CubicBezier2D {
     void offset(float2 offset);
     // eval
     float2 eval(float time) const;
+    // Batch eval in power basis, out[i] = eval(times[i])
+    void eval(luisa::span<float const> times, luisa::span<float2> out) const;
     float2 eval_tangent(float time) const;
     float2 eval_normal(float time) const;
     // length & bound
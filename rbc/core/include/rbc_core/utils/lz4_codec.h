@@ -0,0 +1,12 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/stl/memory.h>
+#include <cstddef>
+// Self-contained codec writing the LZ4 block format, streams produced here can be read by any LZ4 block decoder
+namespace rbc::lz4 {
+[[nodiscard]] RBC_CORE_API size_t compress_bound(size_t src_size);
+// Return compressed size, or 0 if dst is too small
+RBC_CORE_API size_t compress(luisa::span<std::byte const> src, luisa::span<std::byte> dst);
+// Return decompressed size, or 0 if src is malformed or dst is too small
+RBC_CORE_API size_t decompress(luisa::span<std::byte const> src, luisa::span<std::byte> dst);
+}// namespace rbc::lz4
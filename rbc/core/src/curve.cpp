@@ -1,5 +1,8 @@
 #include <rbc_core/utils/curve.h>
 #include <rbc_core/utils/binary_search.h>
+#include <luisa/core/logging.h>
+#include <algorithm>
+#include <limits>
 
 namespace rbc {
 namespace curve_detail {
@@ -10,6 +13,67 @@ size_t _get_idx(Curve const &curve, float time) {
         return 0;
     });
 }
+// Key times are read with a stride, so AoS key nodes and SoA batches share the search.
+// Segment s holds times in [times[s], times[s + 1]), -1 is before the first key and count - 1 from the last key on
+int64_t _find_segment(float const *times, size_t stride, int64_t count, float time) {
+    int64_t low = 0;
+    int64_t high = count;
+    while (low < high) {
+        auto mid = low + (high - low) / 2;
+        if (time < times[mid * stride]) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low - 1;
+}
+// Moves a cursor to the segment of time, a few steps forward are walked, anything else is searched
+int64_t _advance_segment(float const *times, size_t stride, int64_t count, int64_t seg, float time) {
+    auto last = count - 1;
+    if (seg >= 0 && time < times[seg * stride]) {
+        return _find_segment(times, stride, count, time);
+    }
+    for (int step = 0; step < 8; ++step) {
+        if (seg >= last || time < times[(seg + 1) * stride]) {
+            return seg;
+        }
+        ++seg;
+    }
+    return _find_segment(times, stride, count, time);
+}
+// Splits the samples into runs inside one segment, each run is a branch-free affine loop
+template<typename TimeFunc>
+void _sample_runs(luisa::span<float2 const> keys, size_t count, TimeFunc &&time_of, float *out) {
+    if (keys.empty()) {
+        std::fill_n(out, count, 0.0f);
+        return;
+    }
+    auto last = static_cast<int64_t>(keys.size()) - 1;
+    int64_t seg = -1;
+    size_t i = 0;
+    while (i < count) {
+        seg = _advance_segment(&keys[0].x, 2, static_cast<int64_t>(keys.size()), seg, time_of(i));
+        auto lo = seg < 0 ? -std::numeric_limits<float>::infinity() : keys[seg].x;
+        auto hi = seg < last ? keys[seg + 1].x : std::numeric_limits<float>::infinity();
+        auto end = i + 1;
+        for (; end < count; ++end) {
+            auto t = time_of(end);
+            if (t < lo || t >= hi) break;
+        }
+        if (seg < 0 || seg == last) {
+            std::fill(out + i, out + end, keys[seg < 0 ? 0 : last].y);
+        } else {
+            auto x0 = keys[seg].x;
+            auto y0 = keys[seg].y;
+            auto slope = (keys[seg + 1].y - y0) / std::max<float>(keys[seg + 1].x - x0, 1e-5f);
+            for (auto k = i; k < end; ++k) {
+                out[k] = y0 + (time_of(k) - x0) * slope;
+            }
+        }
+        i = end;
+    }
+}
 };// namespace curve_detail
 void Curve::add_node(float time, float value) {
     _range.x = std::min(time, _range.x);
@@ -34,6 +98,13 @@ float Curve::sample_node(float time) const {
     auto lerp_val = (_key_nodes[next_idx].x - time) / std::max<float>(_key_nodes[next_idx].x - _key_nodes[idx].x, 1e-5f);
     return lerp(_key_nodes[next_idx].y, _key_nodes[idx].y, lerp_val);
 }
+void Curve::sample_nodes(luisa::span<float const> times, luisa::span<float> out) const {
+    LUISA_ASSERT(out.size() >= times.size(), "Curve sample output is smaller than input.");
+    curve_detail::_sample_runs(key_nodes(), times.size(), [times](size_t i) { return times[i]; }, out.data());
+}
+void Curve::sample_uniform(float begin, float step, luisa::span<float> out) const {
+    curve_detail::_sample_runs(key_nodes(), out.size(), [begin, step](size_t i) { return begin + static_cast<float>(i) * step; }, out.data());
+}
 Curve::Curve() {}
 Curve::~Curve() {}
 void Curve::_sync_range() {
@@ -48,6 +119,81 @@ Curve::Curve(std::initializer_list<float2> key_nodes) : _key_nodes(key_nodes) {
 Curve::Curve(vstd::vector<float2> &&key_nodes) : _key_nodes(std::move(key_nodes)) {
     _sync_range();
 }
+CurveBatch::CurveBatch() {}
+CurveBatch::~CurveBatch() {}
+size_t CurveBatch::add_curve(Curve const &curve) {
+    for (auto &i : curve.key_nodes()) {
+        _times.emplace_back(i.x);
+        _values.emplace_back(i.y);
+    }
+    _offsets.emplace_back(static_cast<uint>(_times.size()));
+    // an empty range forces a refresh on the first sample
+    _lo.emplace_back(std::numeric_limits<float>::infinity());
+    _hi.emplace_back(-std::numeric_limits<float>::infinity());
+    _x0.emplace_back(0.0f);
+    _y0.emplace_back(0.0f);
+    _slope.emplace_back(0.0f);
+    _cursors.emplace_back(-1);
+    return curve_count() - 1;
+}
+void CurveBatch::clear() {
+    _times.clear();
+    _values.clear();
+    _offsets.clear();
+    _offsets.emplace_back(0u);
+    _lo.clear();
+    _hi.clear();
+    _x0.clear();
+    _y0.clear();
+    _slope.clear();
+    _cursors.clear();
+}
+void CurveBatch::_refresh(size_t curve, float time) {
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    auto begin = _offsets[curve];
+    auto count = static_cast<int64_t>(_offsets[curve + 1] - begin);
+    auto times = _times.data() + begin;
+    auto values = _values.data() + begin;
+    if (count == 0) {
+        _lo[curve] = -inf;
+        _hi[curve] = inf;
+        _x0[curve] = 0.0f;
+        _y0[curve] = 0.0f;
+        _slope[curve] = 0.0f;
+        return;
+    }
+    auto last = count - 1;
+    auto seg = curve_detail::_advance_segment(times, 1, count, _cursors[curve], time);
+    _cursors[curve] = seg;
+    _lo[curve] = seg < 0 ? -inf : times[seg];
+    _hi[curve] = seg < last ? times[seg + 1] : inf;
+    if (seg < 0 || seg == last) {
+        _x0[curve] = 0.0f;
+        _y0[curve] = values[seg < 0 ? 0 : last];
+        _slope[curve] = 0.0f;
+    } else {
+        _x0[curve] = times[seg];
+        _y0[curve] = values[seg];
+        _slope[curve] = (values[seg + 1] - values[seg]) / std::max<float>(times[seg + 1] - times[seg], 1e-5f);
+    }
+}
+void CurveBatch::sample(float time, luisa::span<float> out) {
+    auto count = curve_count();
+    LUISA_ASSERT(out.size() >= count, "Curve batch output is smaller than curve count.");
+    for (size_t i = 0; i < count; ++i) {
+        if (time < _lo[i] || time >= _hi[i]) [[unlikely]] {
+            _refresh(i, time);
+        }
+    }
+    auto x0 = _x0.data();
+    auto y0 = _y0.data();
+    auto slope = _slope.data();
+    auto dst = out.data();
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = y0[i] + (time - x0[i]) * slope[i];
+    }
+}
+
 void CubicBezier2D::offset(float2 offset) {
     p0 += offset;
     p1 += offset;
@@ -70,6 +216,18 @@ float2 CubicBezier2D::eval(float time) const {
     result += ttt * p3;
     return result;
 }
+void CubicBezier2D::eval(luisa::span<float const> times, luisa::span<float2> out) const {
+    LUISA_ASSERT(out.size() >= times.size(), "Bezier eval output is smaller than input.");
+    // p0 + c1 * t + c2 * t^2 + c3 * t^3
+    float2 c1 = 3.0f * (p1 - p0);
+    float2 c2 = 3.0f * (p0 - 2.0f * p1 + p2);
+    float2 c3 = p3 - p0 + 3.0f * (p1 - p2);
+    auto dst = out.data();
+    for (size_t i = 0; i < times.size(); ++i) {
+        auto t = times[i];
+        dst[i] = ((c3 * t + c2) * t + c1) * t + p0;
+    }
+}
 float2 CubicBezier2D::eval_tangent(float time) const {
     float u = 1 - time;
     float tt = time * time;
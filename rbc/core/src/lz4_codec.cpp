@@ -0,0 +1,156 @@
+#include <rbc_core/utils/lz4_codec.h>
+#include <cstring>
+#include <cstdint>
+#include <array>
+namespace rbc::lz4 {
+namespace lz4_detail {
+static constexpr size_t min_match = 4;
+// the last match must start at least 12 bytes before end of block
+static constexpr size_t match_limit = 12;
+// the last 5 bytes are always literals
+static constexpr size_t last_literals = 5;
+static constexpr uint32_t hash_log = 12;
+static constexpr size_t max_distance = 65535;
+static inline uint32_t read32(std::byte const *ptr) {
+    uint32_t v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+static inline uint32_t hash(uint32_t v) {
+    return (v * 2654435761u) >> (32u - hash_log);
+}
+static inline bool write_length(std::byte *&op, std::byte const *op_end, size_t len) {
+    while (len >= 255) {
+        if (op >= op_end) return false;
+        *op++ = std::byte{255};
+        len -= 255;
+    }
+    if (op >= op_end) return false;
+    *op++ = static_cast<std::byte>(len);
+    return true;
+}
+static inline bool write_sequence(
+    std::byte *&op, std::byte const *op_end,
+    std::byte const *literal, size_t literal_len,
+    size_t offset, size_t match_len) {
+    if (op >= op_end) return false;
+    auto token = op++;
+    uint8_t token_value = static_cast<uint8_t>(std::min<size_t>(literal_len, 15) << 4u);
+    if (literal_len >= 15 && !write_length(op, op_end, literal_len - 15)) return false;
+    if (static_cast<size_t>(op_end - op) < literal_len) return false;
+    std::memcpy(op, literal, literal_len);
+    op += literal_len;
+    if (match_len == 0) {
+        *token = static_cast<std::byte>(token_value);
+        return true;
+    }
+    if (op_end - op < 2) return false;
+    *op++ = static_cast<std::byte>(offset & 255u);
+    *op++ = static_cast<std::byte>(offset >> 8u);
+    auto match_code = match_len - min_match;
+    token_value |= static_cast<uint8_t>(std::min<size_t>(match_code, 15));
+    if (match_code >= 15 && !write_length(op, op_end, match_code - 15)) return false;
+    *token = static_cast<std::byte>(token_value);
+    return true;
+}
+}// namespace lz4_detail
+
+size_t compress_bound(size_t src_size) {
+    return src_size + src_size / 255 + 16;
+}
+
+size_t compress(luisa::span<std::byte const> src, luisa::span<std::byte> dst) {
+    using namespace lz4_detail;
+    auto ip = src.data();
+    auto const ip_begin = ip;
+    auto const ip_end = ip + src.size();
+    auto op = dst.data();
+    auto const op_end = op + dst.size();
+    auto anchor = ip;
+    if (src.size() >= match_limit + 1) {
+        std::array<uint32_t, 1u << hash_log> table;
+        table.fill(0);
+        auto const match_end = ip_end - match_limit;
+        auto const copy_end = ip_end - last_literals;
+        ++ip;
+        while (ip < match_end) {
+            auto seq = read32(ip);
+            auto &slot = table[hash(seq)];
+            auto ref = ip_begin + slot;
+            slot = static_cast<uint32_t>(ip - ip_begin);
+            if (ref >= ip || static_cast<size_t>(ip - ref) > max_distance || read32(ref) != seq) {
+                ++ip;
+                continue;
+            }
+            // extend backward over pending literals
+            while (ip > anchor && ref > ip_begin && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            auto match_ptr = ip + min_match;
+            auto ref_ptr = ref + min_match;
+            while (match_ptr < copy_end && *match_ptr == *ref_ptr) {
+                ++match_ptr;
+                ++ref_ptr;
+            }
+            if (!write_sequence(op, op_end, anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - ref), static_cast<size_t>(match_ptr - ip)))
+                return 0;
+            ip = match_ptr;
+            anchor = ip;
+            if (ip < match_end) {
+                table[hash(read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - ip_begin);
+            }
+        }
+    }
+    if (!write_sequence(op, op_end, anchor, static_cast<size_t>(ip_end - anchor), 0, 0))
+        return 0;
+    return static_cast<size_t>(op - dst.data());
+}
+
+size_t decompress(luisa::span<std::byte const> src, luisa::span<std::byte> dst) {
+    auto ip = src.data();
+    auto const ip_end = ip + src.size();
+    auto op = dst.data();
+    auto const op_begin = op;
+    auto const op_end = op + dst.size();
+    auto read_length = [&](size_t &len) {
+        uint8_t v;
+        do {
+            if (ip >= ip_end) return false;
+            v = static_cast<uint8_t>(*ip++);
+            len += v;
+        } while (v == 255);
+        return true;
+    };
+    while (ip < ip_end) {
+        auto token = static_cast<uint8_t>(*ip++);
+        size_t literal_len = token >> 4u;
+        if (literal_len == 15 && !read_length(literal_len)) return 0;
+        if (static_cast<size_t>(ip_end - ip) < literal_len || static_cast<size_t>(op_end - op) < literal_len) return 0;
+        std::memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+        // the last sequence carries literals only
+        if (ip == ip_end) break;
+        if (ip_end - ip < 2) return 0;
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8u);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - op_begin)) return 0;
+        size_t match_len = token & 15u;
+        if (match_len == 15 && !read_length(match_len)) return 0;
+        match_len += lz4_detail::min_match;
+        if (static_cast<size_t>(op_end - op) < match_len) return 0;
+        auto ref = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, ref, match_len);
+            op += match_len;
+        } else {
+            // overlapped copy repeats the pattern
+            for (size_t i = 0; i < match_len; ++i) {
+                *op++ = *ref++;
+            }
+        }
+    }
+    return static_cast<size_t>(op - op_begin);
+}
+}// namespace rbc::lz4
@@ -0,0 +1,82 @@
+#include <rbc_core/mapped_file.h>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace rbc {
+#ifdef _WIN32
+MappedFile::MappedFile(luisa::filesystem::path const &path) {
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    _file = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        _dispose();
+        return;
+    }
+    _mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping) {
+        _dispose();
+        return;
+    }
+    _data = static_cast<std::byte const *>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        _dispose();
+        return;
+    }
+    _size = static_cast<size_t>(size.QuadPart);
+}
+MappedFile::MappedFile(MappedFile &&rhs)
+    : _data(rhs._data), _size(rhs._size), _file(rhs._file), _mapping(rhs._mapping) {
+    rhs._data = nullptr;
+    rhs._size = 0;
+    rhs._file = nullptr;
+    rhs._mapping = nullptr;
+}
+void MappedFile::_dispose() {
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle(_mapping);
+    if (_file) CloseHandle(_file);
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+    _file = nullptr;
+}
+#else
+MappedFile::MappedFile(luisa::filesystem::path const &path) {
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return;
+    }
+    auto ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    if (ptr == MAP_FAILED) return;
+    _data = static_cast<std::byte const *>(ptr);
+    _size = static_cast<size_t>(st.st_size);
+}
+MappedFile::MappedFile(MappedFile &&rhs)
+    : _data(rhs._data), _size(rhs._size) {
+    rhs._data = nullptr;
+    rhs._size = 0;
+}
+void MappedFile::_dispose() {
+    if (_data) munmap(const_cast<std::byte *>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+#endif
+MappedFile::~MappedFile() {
+    _dispose();
+}
+}// namespace rbc
@@ -1,7 +1,15 @@
 #include <rbc_core/memory.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
 #ifdef RBC_RUNTIME_USE_MIMALLOC
 #include <mimalloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif !defined(_WIN32)
+#include <malloc.h>
 #endif
 
 RBC_FORCEINLINE static void *calloc_aligned(size_t count, size_t size, size_t alignment) {
@@ -105,10 +113,14 @@ RBC_EXTERN_C RBC_CORE_API void *traced_os_realloc_aligned(void *p, size_t newsiz
     return new_allocation;
 }
 
-// internal_rbc_alloc
+// heap backend, wrapped by the pool aware internal_rbc_* below
 
 #if defined(RBC_RUNTIME_USE_MIMALLOC)
-RBC_CORE_API void *internal_rbc_malloc(size_t size, const char *pool_name) {
+static size_t heap_usable_size(void *p, size_t alignment) {
+    return mi_usable_size(p);
+}
+
+static void *heap_malloc(size_t size, const char *pool_name) {
     void *p = mi_malloc(size);
     if (pool_name) {
         RBCCAllocN(p, size, pool_name);
@@ -118,7 +130,7 @@ RBC_CORE_API void *internal_rbc_malloc(size_t size, const char *pool_name) {
     return p;
 }
 
-RBC_CORE_API void *internal_rbc_calloc(size_t count, size_t size, const char *pool_name) {
+static void *heap_calloc(size_t count, size_t size, const char *pool_name) {
     void *p = mi_calloc(count, size);
     if (pool_name) {
         RBCCAllocN(p, size, pool_name);
@@ -128,7 +140,7 @@ RBC_CORE_API void *internal_rbc_calloc(size_t count, size_t size, const char *po
     return p;
 }
 
-RBC_CORE_API void *internal_rbc_calloc_aligned(size_t count, size_t size, size_t alignment, const char *pool_name) {
+static void *heap_calloc_aligned(size_t count, size_t size, size_t alignment, const char *pool_name) {
     void *p = mi_calloc_aligned(count, size, alignment);
     if (pool_name) {
         RBCCAllocN(p, size, pool_name);
@@ -138,7 +150,7 @@ RBC_CORE_API void *internal_rbc_calloc_aligned(size_t count, size_t size, size_t
     return p;
 }
 
-RBC_CORE_API void *internal_rbc_malloc_aligned(size_t size, size_t alignment, const char *pool_name) {
+static void *heap_malloc_aligned(size_t size, size_t alignment, const char *pool_name) {
     void *p = mi_malloc_aligned(size, alignment);
     if (pool_name) {
         RBCCAllocN(p, size, pool_name);
@@ -148,7 +160,7 @@ RBC_CORE_API void *internal_rbc_malloc_aligned(size_t size, size_t alignment, co
     return p;
 }
 
-RBC_EXTERN_C RBC_CORE_API void *internal_rbc_new_n(size_t count, size_t size, const char *pool_name) {
+static void *heap_new_n(size_t count, size_t size, const char *pool_name) {
     void *p = mi_new_n(count, size);
     if (pool_name) {
         RBCCAllocN(p, size * count, pool_name);
@@ -158,7 +170,7 @@ RBC_EXTERN_C RBC_CORE_API void *internal_rbc_new_n(size_t count, size_t size, co
     return p;
 }
 
-RBC_CORE_API void *internal_rbc_new_aligned(size_t size, size_t alignment, const char *pool_name) {
+static void *heap_new_aligned(size_t size, size_t alignment, const char *pool_name) {
     void *p = mi_new_aligned(size, alignment);
     if (pool_name) {
         RBCCAllocN(p, size, pool_name);
@@ -168,7 +180,7 @@ RBC_CORE_API void *internal_rbc_new_aligned(size_t size, size_t alignment, const
     return p;
 }
 
-RBC_CORE_API void internal_rbc_free(void *p, const char *pool_name) RBC_NOEXCEPT {
+static void heap_free(void *p, const char *pool_name) RBC_NOEXCEPT {
     if (pool_name) {
         RBCCFreeN(p, pool_name);
     } else {
@@ -177,7 +189,7 @@ RBC_CORE_API void internal_rbc_free(void *p, const char *pool_name) RBC_NOEXCEPT
     mi_free(p);
 }
 
-RBC_CORE_API void internal_rbc_free_aligned(void *p, size_t alignment, const char *pool_name) {
+static void heap_free_aligned(void *p, size_t alignment, const char *pool_name) {
     if (pool_name) {
         RBCCFreeN(p, pool_name);
     } else {
@@ -186,7 +198,7 @@ RBC_CORE_API void internal_rbc_free_aligned(void *p, size_t alignment, const cha
     mi_free_aligned(p, alignment);
 }
 
-RBC_CORE_API void *internal_rbc_realloc(void *p, size_t newsize, const char *pool_name) {
+static void *heap_realloc(void *p, size_t newsize, const char *pool_name) {
     if (pool_name) {
         RBCCFreeN(p, pool_name);
     } else {
@@ -201,7 +213,7 @@ RBC_CORE_API void *internal_rbc_realloc(void *p, size_t newsize, const char *poo
     return np;
 }
 
-RBC_CORE_API void *internal_rbc_realloc_aligned(void *p, size_t newsize, size_t alignment, const char *pool_name) {
+static void *heap_realloc_aligned(void *p, size_t newsize, size_t alignment, const char *pool_name) {
     if (pool_name) {
         RBCCFreeN(p, pool_name);
     } else {
@@ -220,49 +232,432 @@ RBC_CORE_API void *internal_rbc_realloc_aligned(void *p, size_t newsize, size_t
 
 #else
 
-RBC_CORE_API void *internal_rbc_malloc(size_t size, const char *pool_name) {
+static size_t heap_usable_size(void *p, size_t alignment) {
+#if defined(_WIN32)
+    return alignment ? _aligned_msize(p, alignment, 0) : _msize(p);
+#elif defined(__APPLE__)
+    return malloc_size(p);
+#else
+    return malloc_usable_size(p);
+#endif
+}
+
+static void *heap_malloc(size_t size, const char *pool_name) {
     return traced_os_malloc(size, pool_name);
 }
 
-RBC_CORE_API void *internal_rbc_calloc(size_t count, size_t size, const char *pool_name) {
+static void *heap_calloc(size_t count, size_t size, const char *pool_name) {
     return traced_os_calloc(count, size, pool_name);
 }
 
-RBC_EXTERN_C RBC_CORE_API void *internal_rbc_new_n(size_t count, size_t size, const char *pool_name) {
+static void *heap_new_n(size_t count, size_t size, const char *pool_name) {
     void *p = malloc(count * size);
     return p;
 }
 
-RBC_CORE_API void *internal_rbc_calloc_aligned(size_t count, size_t size, size_t alignment, const char *pool_name) {
+static void *heap_calloc_aligned(size_t count, size_t size, size_t alignment, const char *pool_name) {
     return traced_os_calloc_aligned(count, size, alignment, pool_name);
 }
 
-RBC_CORE_API void *internal_rbc_malloc_aligned(size_t size, size_t alignment, const char *pool_name) {
+static void *heap_malloc_aligned(size_t size, size_t alignment, const char *pool_name) {
     return traced_os_malloc_aligned(size, alignment, pool_name);
 }
 
-RBC_CORE_API void *internal_rbc_new_aligned(size_t size, size_t alignment, const char *pool_name) {
+static void *heap_new_aligned(size_t size, size_t alignment, const char *pool_name) {
     return traced_os_malloc_aligned(size, alignment, pool_name);
 }
 
-RBC_CORE_API void internal_rbc_free(void *p, const char *pool_name) {
+static void heap_free(void *p, const char *pool_name) {
     return traced_os_free(p, pool_name);
 }
 
-RBC_CORE_API void internal_rbc_free_aligned(void *p, size_t alignment, const char *pool_name) {
+static void heap_free_aligned(void *p, size_t alignment, const char *pool_name) {
     traced_os_free_aligned(p, alignment, pool_name);
 }
 
-RBC_CORE_API void *internal_rbc_realloc(void *p, size_t newsize, const char *pool_name) {
+static void *heap_realloc(void *p, size_t newsize, const char *pool_name) {
     return traced_os_realloc(p, newsize, pool_name);
 }
 
-RBC_CORE_API void *internal_rbc_realloc_aligned(void *p, size_t newsize, size_t align, const char *pool_name) {
+static void *heap_realloc_aligned(void *p, size_t newsize, size_t align, const char *pool_name) {
     return traced_os_realloc_aligned(p, newsize, align, pool_name);
 }
 
 #endif
 
+// pool registry
+
+namespace {
+enum PoolBindState : uint8_t {
+    kBindOpen,
+    kBinding,
+    // set by the first allocation, the allocator never changes afterwards
+    kSealed
+};
+struct PoolRecord {
+    std::atomic<const char *> name{};
+    std::atomic<const RBCPoolAllocator *> allocator{};
+    std::atomic<uint8_t> bind_state{kBindOpen};
+    // sampled from the striped counters, see update_peak
+    std::atomic<uint64_t> peak_bytes{};
+};
+struct PoolCounters {
+    std::atomic<uint64_t> alloc_count{};
+    std::atomic<uint64_t> free_count{};
+    std::atomic<uint64_t> alloc_bytes{};
+    std::atomic<uint64_t> free_bytes{};
+};
+// Pool names are usually string literals, so lookups are keyed by pointer and only first sight of a
+// pointer compares strings. Everything is constant-initialized, allocations may happen during static init.
+struct PoolRegistry {
+    static constexpr size_t kSlotCount = 1024;
+    static constexpr size_t kMaxPools = 256;
+    std::atomic<const char *> slot_keys[kSlotCount]{};
+    std::atomic<PoolRecord *> slot_values[kSlotCount]{};
+    PoolRecord records[kMaxPools]{};
+    std::atomic<size_t> record_count{};
+    PoolRecord default_record{};
+    std::atomic_flag lock{};
+};
+constinit PoolRegistry _pool_registry{};
+constexpr const char *kDefaultPoolName = "rbc::default";
+
+// Threads count into their own stripe so the hot path never shares a cache line with another
+// thread unless there are more threads than stripes. Readers sum all stripes.
+constexpr size_t kCounterStripes = 16;
+struct alignas(64) PoolCounterStripe {
+    // index 0 is the default pool, then registry records in order
+    PoolCounters counters[PoolRegistry::kMaxPools + 1];
+};
+constinit PoolCounterStripe _pool_counter_stripes[kCounterStripes]{};
+constinit std::atomic<uint32_t> _pool_next_stripe{};
+// peak_bytes is refreshed whenever a stripe allocated another 64 KiB, and on every stats read
+constexpr uint64_t kPeakSampleShift = 16;
+
+struct PoolRegistryLock {
+    PoolRegistryLock() {
+        while (_pool_registry.lock.test_and_set(std::memory_order_acquire)) {
+            _pool_registry.lock.wait(true, std::memory_order_relaxed);
+        }
+    }
+    ~PoolRegistryLock() {
+        _pool_registry.lock.clear(std::memory_order_release);
+        _pool_registry.lock.notify_one();
+    }
+};
+
+size_t pool_slot(const char *name) {
+    return ((reinterpret_cast<uintptr_t>(name) >> 3) * 0x9E3779B97F4A7C15ull) >> 54;
+}
+
+// caller holds the registry lock
+PoolRecord *find_record_by_name(const char *name) {
+    auto count = _pool_registry.record_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        auto &record = _pool_registry.records[i];
+        if (strcmp(record.name.load(std::memory_order_relaxed), name) == 0) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+PoolRecord *pool_record(const char *name, bool create = true) {
+    if (!name) return &_pool_registry.default_record;
+    static_assert((PoolRegistry::kSlotCount & (PoolRegistry::kSlotCount - 1)) == 0);
+    auto slot = pool_slot(name);
+    for (size_t i = 0; i < PoolRegistry::kSlotCount; ++i) {
+        auto idx = (slot + i) & (PoolRegistry::kSlotCount - 1);
+        auto key = _pool_registry.slot_keys[idx].load(std::memory_order_acquire);
+        if (key == name) return _pool_registry.slot_values[idx].load(std::memory_order_acquire);
+        if (!key) break;
+    }
+    if (!create) {
+        PoolRegistryLock lck;
+        return find_record_by_name(name);
+    }
+    PoolRegistryLock lck;
+    auto record = find_record_by_name(name);
+    if (!record) {
+        auto count = _pool_registry.record_count.load(std::memory_order_relaxed);
+        if (count == PoolRegistry::kMaxPools) [[unlikely]] {
+            return &_pool_registry.default_record;
+        }
+        record = &_pool_registry.records[count];
+        record->name.store(name, std::memory_order_relaxed);
+        _pool_registry.record_count.store(count + 1, std::memory_order_release);
+    }
+    // cache this pointer, a full table only costs the locked lookup
+    for (size_t i = 0; i < PoolRegistry::kSlotCount; ++i) {
+        auto idx = (slot + i) & (PoolRegistry::kSlotCount - 1);
+        auto key = _pool_registry.slot_keys[idx].load(std::memory_order_relaxed);
+        if (key == name) break;
+        if (key) continue;
+        _pool_registry.slot_values[idx].store(record, std::memory_order_relaxed);
+        _pool_registry.slot_keys[idx].store(name, std::memory_order_release);
+        break;
+    }
+    return record;
+}
+
+size_t record_index(PoolRecord const *record) {
+    if (record == &_pool_registry.default_record) return 0;
+    return static_cast<size_t>(record - _pool_registry.records) + 1;
+}
+
+PoolCounters &local_counters(PoolRecord const *record) {
+    // trivially destructible, still valid for allocations during thread exit
+    thread_local uint32_t stripe = ~0u;
+    if (stripe == ~0u) [[unlikely]] {
+        stripe = _pool_next_stripe.fetch_add(1, std::memory_order_relaxed) % kCounterStripes;
+    }
+    return _pool_counter_stripes[stripe].counters[record_index(record)];
+}
+
+struct PoolTotals {
+    uint64_t alloc_count;
+    uint64_t free_count;
+    uint64_t alloc_bytes;
+    uint64_t free_bytes;
+};
+PoolTotals sum_counters(PoolRecord const *record) {
+    auto index = record_index(record);
+    PoolTotals totals{};
+    // frees first: a free that is seen was released after its allocation was counted,
+    // so the allocation is seen as well and live bytes never underflow
+    for (auto &stripe : _pool_counter_stripes) {
+        auto &counters = stripe.counters[index];
+        totals.free_count += counters.free_count.load(std::memory_order_acquire);
+        totals.free_bytes += counters.free_bytes.load(std::memory_order_acquire);
+    }
+    for (auto &stripe : _pool_counter_stripes) {
+        auto &counters = stripe.counters[index];
+        totals.alloc_count += counters.alloc_count.load(std::memory_order_relaxed);
+        totals.alloc_bytes += counters.alloc_bytes.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+uint64_t update_peak(PoolRecord *record, PoolTotals const &totals) {
+    auto live = totals.alloc_bytes - totals.free_bytes;
+    auto peak = record->peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !record->peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return live > peak ? live : peak;
+}
+
+void record_alloc(PoolRecord *record, size_t size) {
+    auto &counters = local_counters(record);
+    counters.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    auto bytes = counters.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (((bytes + size) >> kPeakSampleShift) != (bytes >> kPeakSampleShift)) [[unlikely]] {
+        update_peak(record, sum_counters(record));
+    }
+}
+
+void record_free(PoolRecord *record, size_t size) {
+    auto &counters = local_counters(record);
+    counters.free_count.fetch_add(1, std::memory_order_release);
+    counters.free_bytes.fetch_add(size, std::memory_order_release);
+}
+
+void fill_stats(PoolRecord &record, const char *name, RBCPoolStats *stats) {
+    auto totals = sum_counters(&record);
+    stats->name = name;
+    stats->live_bytes = totals.alloc_bytes - totals.free_bytes;
+    stats->peak_bytes = update_peak(&record, totals);
+    stats->alloc_count = totals.alloc_count;
+    stats->free_count = totals.free_count;
+    stats->total_alloc_bytes = totals.alloc_bytes;
+}
+
+// Seals the pool on first use, blocks only while rbc_pool_bind_allocator is swapping
+const RBCPoolAllocator *pool_allocator(PoolRecord *record) {
+    auto state = record->bind_state.load(std::memory_order_acquire);
+    while (state != kSealed) {
+        if (state == kBinding) {
+            std::this_thread::yield();
+            state = record->bind_state.load(std::memory_order_acquire);
+            continue;
+        }
+        record->bind_state.compare_exchange_weak(state, kSealed, std::memory_order_acquire, std::memory_order_acquire);
+    }
+    return record->allocator.load(std::memory_order_relaxed);
+}
+
+void *pool_alloc(PoolRecord *record, const RBCPoolAllocator *allocator, size_t size, size_t alignment) {
+    void *p = allocator->alloc(allocator->user_data, size, alignment ? alignment : alignof(std::max_align_t));
+    if (p) record_alloc(record, allocator->usable_size(allocator->user_data, p));
+    return p;
+}
+
+void pool_free(PoolRecord *record, const RBCPoolAllocator *allocator, void *p) {
+    record_free(record, allocator->usable_size(allocator->user_data, p));
+    allocator->free(allocator->user_data, p);
+}
+
+void *pool_realloc(PoolRecord *record, const RBCPoolAllocator *allocator, void *p, size_t newsize, size_t alignment) {
+    void *np = pool_alloc(record, allocator, newsize, alignment);
+    if (p) {
+        if (np) {
+            auto old_size = allocator->usable_size(allocator->user_data, p);
+            memcpy(np, p, old_size < newsize ? old_size : newsize);
+        }
+        pool_free(record, allocator, p);
+    }
+    return np;
+}
+}// namespace
+
+RBC_CORE_API bool rbc_pool_stats(const char *pool_name, RBCPoolStats *stats) {
+    auto record = pool_record(pool_name, false);
+    if (!record) return false;
+    fill_stats(*record, pool_name ? pool_name : kDefaultPoolName, stats);
+    return true;
+}
+
+RBC_CORE_API bool rbc_pool_stats_at(size_t index, RBCPoolStats *stats) {
+    if (index == 0) {
+        fill_stats(_pool_registry.default_record, kDefaultPoolName, stats);
+        return true;
+    }
+    if (index > _pool_registry.record_count.load(std::memory_order_acquire)) return false;
+    auto &record = _pool_registry.records[index - 1];
+    fill_stats(record, record.name.load(std::memory_order_relaxed), stats);
+    return true;
+}
+
+RBC_CORE_API size_t rbc_pool_count() {
+    return _pool_registry.record_count.load(std::memory_order_acquire) + 1;
+}
+
+RBC_CORE_API bool rbc_pool_bind_allocator(const char *pool_name, const RBCPoolAllocator *allocator) {
+    if (!pool_name) return false;
+    auto record = pool_record(pool_name);
+    if (record == &_pool_registry.default_record) return false;
+    // allocations wait for kBinding to end, so none can see a half-swapped allocator
+    uint8_t expected = kBindOpen;
+    if (!record->bind_state.compare_exchange_strong(expected, kBinding, std::memory_order_acquire)) {
+        return false;
+    }
+    record->allocator.store(allocator, std::memory_order_relaxed);
+    record->bind_state.store(kBindOpen, std::memory_order_release);
+    return true;
+}
+
+// internal_rbc_alloc
+
+RBC_CORE_API void *internal_rbc_malloc(size_t size, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        return pool_alloc(record, allocator, size, 0);
+    }
+    void *p = heap_malloc(size, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, 0));
+    return p;
+}
+
+RBC_CORE_API void *internal_rbc_calloc(size_t count, size_t size, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        void *p = pool_alloc(record, allocator, count * size, 0);
+        if (p) memset(p, 0, count * size);
+        return p;
+    }
+    void *p = heap_calloc(count, size, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, 0));
+    return p;
+}
+
+RBC_CORE_API void *internal_rbc_malloc_aligned(size_t size, size_t alignment, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        return pool_alloc(record, allocator, size, alignment);
+    }
+    void *p = heap_malloc_aligned(size, alignment, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, alignment));
+    return p;
+}
+
+RBC_CORE_API void *internal_rbc_calloc_aligned(size_t count, size_t size, size_t alignment, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        void *p = pool_alloc(record, allocator, count * size, alignment);
+        if (p) memset(p, 0, count * size);
+        return p;
+    }
+    void *p = heap_calloc_aligned(count, size, alignment, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, alignment));
+    return p;
+}
+
+RBC_CORE_API void *internal_rbc_new_n(size_t count, size_t size, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        void *p = pool_alloc(record, allocator, count * size, 0);
+        if (!p) [[unlikely]] throw std::bad_alloc{};
+        return p;
+    }
+    void *p = heap_new_n(count, size, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, 0));
+    return p;
+}
+
+RBC_CORE_API void *internal_rbc_new_aligned(size_t size, size_t alignment, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        void *p = pool_alloc(record, allocator, size, alignment);
+        if (!p) [[unlikely]] throw std::bad_alloc{};
+        return p;
+    }
+    void *p = heap_new_aligned(size, alignment, pool_name);
+    if (p) record_alloc(record, heap_usable_size(p, alignment));
+    return p;
+}
+
+RBC_CORE_API void internal_rbc_free(void *p, const char *pool_name) RBC_NOEXCEPT {
+    if (!p) return;
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        pool_free(record, allocator, p);
+        return;
+    }
+    record_free(record, heap_usable_size(p, 0));
+    heap_free(p, pool_name);
+}
+
+RBC_CORE_API void internal_rbc_free_aligned(void *p, size_t alignment, const char *pool_name) {
+    if (!p) return;
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        pool_free(record, allocator, p);
+        return;
+    }
+    record_free(record, heap_usable_size(p, alignment));
+    heap_free_aligned(p, alignment, pool_name);
+}
+
+RBC_CORE_API void *internal_rbc_realloc(void *p, size_t newsize, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        return pool_realloc(record, allocator, p, newsize, 0);
+    }
+    if (p) record_free(record, heap_usable_size(p, 0));
+    void *np = heap_realloc(p, newsize, pool_name);
+    if (np) record_alloc(record, heap_usable_size(np, 0));
+    return np;
+}
+
+RBC_CORE_API void *internal_rbc_realloc_aligned(void *p, size_t newsize, size_t alignment, const char *pool_name) {
+    auto record = pool_record(pool_name);
+    if (auto allocator = pool_allocator(record)) {
+        return pool_realloc(record, allocator, p, newsize, alignment);
+    }
+    if (p) record_free(record, heap_usable_size(p, alignment));
+    void *np = heap_realloc_aligned(p, newsize, alignment, pool_name);
+    if (np) record_alloc(record, heap_usable_size(np, alignment));
+    return np;
+}
+
 const char *kContainersDefaultPoolName = "rbc::containers";
 
 void *containers_malloc_aligned(size_t size, size_t alignment) {
@@ -0,0 +1,178 @@
+#include <rbc_core/pool_allocator.h>
+#include <bit>
+#include <mutex>
+
+namespace rbc {
+namespace {
+// Stored right before every block handed out by the pool allocators
+struct alignas(16) BlockHeader {
+    uint32_t size_class;
+    uint32_t offset;
+    uint64_t size;
+};
+static_assert(sizeof(BlockHeader) == 16);
+constexpr uint32_t kLargeClass = ~0u;
+const char *kArenaChunkPoolName = "rbc::arena_chunk";
+const char *kSizeClassSlabPoolName = "rbc::size_class_slab";
+
+BlockHeader *header_of(void *p) {
+    return reinterpret_cast<BlockHeader *>(static_cast<std::byte *>(p) - sizeof(BlockHeader));
+}
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}// namespace
+
+/////////////////// ArenaPoolAllocator
+
+ArenaPoolAllocator::ArenaPoolAllocator(size_t chunk_size)
+    : _chunk_size(chunk_size) {
+    _allocator.user_data = this;
+    _allocator.alloc = [](void *user_data, size_t size, size_t alignment) {
+        return static_cast<ArenaPoolAllocator *>(user_data)->_alloc(size, alignment);
+    };
+    _allocator.free = [](void *, void *) {};
+    _allocator.usable_size = [](void *, void *p) -> size_t {
+        return header_of(p)->size;
+    };
+}
+
+ArenaPoolAllocator::~ArenaPoolAllocator() {
+    for (auto &chunk : _chunks) {
+        traced_os_free_aligned(chunk.ptr, alignof(BlockHeader), kArenaChunkPoolName);
+    }
+}
+
+void *ArenaPoolAllocator::_alloc(size_t size, size_t alignment) {
+    alignment = alignment > alignof(BlockHeader) ? alignment : alignof(BlockHeader);
+    std::lock_guard lck{_mtx};
+    while (true) {
+        if (_chunk_index < _chunks.size()) {
+            auto &chunk = _chunks[_chunk_index];
+            auto base = reinterpret_cast<uintptr_t>(chunk.ptr);
+            auto user = align_up(base + _offset + sizeof(BlockHeader), alignment);
+            if (user + size <= base + chunk.size) {
+                auto ptr = reinterpret_cast<void *>(user);
+                auto header = header_of(ptr);
+                header->size_class = 0;
+                header->offset = 0;
+                header->size = size;
+                _offset = user + size - base;
+                _used_bytes += size;
+                return ptr;
+            }
+            // the rest of this chunk is wasted until reset
+            ++_chunk_index;
+            _offset = 0;
+            continue;
+        }
+        auto chunk_size = _chunk_size;
+        auto required = size + alignment + sizeof(BlockHeader);
+        if (required > chunk_size) chunk_size = required;
+        auto ptr = static_cast<std::byte *>(traced_os_malloc_aligned(chunk_size, alignof(BlockHeader), kArenaChunkPoolName));
+        if (!ptr) [[unlikely]] {
+            return nullptr;
+        }
+        _chunks.emplace_back(Chunk{ptr, chunk_size});
+    }
+}
+
+void ArenaPoolAllocator::reset() {
+    std::lock_guard lck{_mtx};
+    _chunk_index = 0;
+    _offset = 0;
+    _used_bytes = 0;
+}
+
+size_t ArenaPoolAllocator::reserved_bytes() const {
+    size_t size = 0;
+    for (auto &chunk : _chunks) {
+        size += chunk.size;
+    }
+    return size;
+}
+
+/////////////////// SizeClassPoolAllocator
+
+SizeClassPoolAllocator::SizeClassPoolAllocator(size_t slab_size)
+    : _slab_size(slab_size) {
+    auto min_slab = 2 * (max_class_size + sizeof(BlockHeader));
+    if (_slab_size < min_slab) _slab_size = min_slab;
+    _allocator.user_data = this;
+    _allocator.alloc = [](void *user_data, size_t size, size_t alignment) {
+        return static_cast<SizeClassPoolAllocator *>(user_data)->_alloc(size, alignment);
+    };
+    _allocator.free = [](void *user_data, void *p) {
+        static_cast<SizeClassPoolAllocator *>(user_data)->_free(p);
+    };
+    _allocator.usable_size = [](void *, void *p) {
+        return _usable_size(p);
+    };
+}
+
+SizeClassPoolAllocator::~SizeClassPoolAllocator() {
+    for (auto &size_class : _classes) {
+        for (auto slab : size_class.slabs) {
+            traced_os_free_aligned(slab, alignof(BlockHeader), kSizeClassSlabPoolName);
+        }
+    }
+}
+
+void *SizeClassPoolAllocator::_alloc(size_t size, size_t alignment) {
+    if (size > max_class_size || alignment > alignof(BlockHeader)) {
+        auto offset = alignment > sizeof(BlockHeader) ? alignment : sizeof(BlockHeader);
+        auto raw = static_cast<std::byte *>(traced_os_malloc_aligned(size + offset, offset, kSizeClassSlabPoolName));
+        if (!raw) [[unlikely]] {
+            return nullptr;
+        }
+        auto ptr = raw + offset;
+        auto header = header_of(ptr);
+        header->size_class = kLargeClass;
+        header->offset = static_cast<uint32_t>(offset);
+        header->size = size;
+        return ptr;
+    }
+    auto class_size = std::bit_ceil(size < min_class_size ? min_class_size : size);
+    auto class_index = static_cast<uint32_t>(std::countr_zero(class_size) - std::countr_zero(min_class_size));
+    auto &size_class = _classes[class_index];
+    std::lock_guard lck{size_class.mtx};
+    if (!size_class.free_list) {
+        auto slab = static_cast<std::byte *>(traced_os_malloc_aligned(_slab_size, alignof(BlockHeader), kSizeClassSlabPoolName));
+        if (!slab) [[unlikely]] {
+            return nullptr;
+        }
+        size_class.slabs.emplace_back(slab);
+        auto stride = class_size + sizeof(BlockHeader);
+        for (size_t offset = 0; offset + stride <= _slab_size; offset += stride) {
+            auto ptr = slab + offset + sizeof(BlockHeader);
+            auto header = header_of(ptr);
+            header->size_class = class_index;
+            header->offset = 0;
+            header->size = class_size;
+            auto block = reinterpret_cast<FreeBlock *>(ptr);
+            block->next = size_class.free_list;
+            size_class.free_list = block;
+        }
+    }
+    auto block = size_class.free_list;
+    size_class.free_list = block->next;
+    return block;
+}
+
+void SizeClassPoolAllocator::_free(void *p) {
+    auto header = header_of(p);
+    if (header->size_class == kLargeClass) {
+        traced_os_free_aligned(static_cast<std::byte *>(p) - header->offset, header->offset, kSizeClassSlabPoolName);
+        return;
+    }
+    auto &size_class = _classes[header->size_class];
+    auto block = static_cast<FreeBlock *>(p);
+    std::lock_guard lck{size_class.mtx};
+    block->next = size_class.free_list;
+    size_class.free_list = block;
+}
+
+size_t SizeClassPoolAllocator::_usable_size(void *p) {
+    return header_of(p)->size;
+}
+}// namespace rbc
@@ -25,6 +25,8 @@ public:
 
     // Update scene from synchronized state
     void updateFromSync(const SceneSync &sync);
+    // Apply only the entities touched by the last scene delta
+    void applyDelta(const SceneSync &sync);
 
     // Called each frame to process pending render operations
     // Should be called after IO operations are complete (e.g., after execute_io in tick)
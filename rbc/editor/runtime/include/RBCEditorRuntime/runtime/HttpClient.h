@@ -34,6 +34,8 @@ public:
 
     // API methods - Scene Synchronization
     void getSceneState(std::function<void(const QJsonObject &, bool)> callback);
+    // Long-poll for entities changed after sinceVersion, the server answers early on change
+    void getSceneDelta(uint64_t sinceVersion, int timeoutMs, std::function<void(const QJsonObject &, bool)> callback);
     void getAllResources(std::function<void(const QJsonObject &, bool)> callback);
     void registerEditor(const QString &editorId, std::function<void(bool)> callback);
     void sendHeartbeat(const QString &editorId, std::function<void(bool)> callback);
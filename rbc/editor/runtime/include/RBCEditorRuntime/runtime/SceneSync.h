@@ -53,6 +53,7 @@ struct EditorResourceMetadata {
  * Manages local mirror of Python scene state by:
  * - Fetching scene state from HTTP server
  * - Parsing JSON data
+ * - Applying versioned scene deltas in place
  * - Tracking entity and resource changes
  */
 class SceneSync {
@@ -62,6 +63,8 @@ public:
 
     // Parse scene state from JSON string (typically from HttpClient)
     bool parseSceneState(const std::string &json);
+    // Apply a delta from /scene/delta, returns true if any entity changed
+    bool applySceneDelta(const std::string &json);
     bool parseResources(const std::string &json);
     bool parseAnimations(const std::string &json);
 
@@ -77,6 +80,14 @@ public:
     [[nodiscard]] const luisa::vector<AnimationClip> &animations() const { return animations_; }
     [[nodiscard]] const AnimationClip *getAnimation(const luisa::string &name) const;
 
+    // Scene version of the last applied delta, 0 before the first sync
+    [[nodiscard]] uint64_t version() const { return version_; }
+    // Entities added or updated / removed by the last applied delta
+    [[nodiscard]] const luisa::vector<int> &changedEntities() const { return changed_entities_; }
+    [[nodiscard]] const luisa::vector<int> &removedEntities() const { return removed_entities_; }
+    // Entities were added or removed (not only modified) by the last update
+    [[nodiscard]] bool structureChanged() const { return structure_changed_; }
+
     // Check if scene has changed since last update
     [[nodiscard]] bool hasChanges() const { return has_changes_; }
     void clearChanges() { has_changes_ = false; }
@@ -89,6 +100,13 @@ private:
     luisa::unordered_map<int, size_t> resource_map_;           // resource_id -> index in resources_
     luisa::unordered_map<luisa::string, size_t> animation_map_;// animation name -> index in animations_
     bool has_changes_;
+    uint64_t version_ = 0;
+    luisa::vector<int> changed_entities_;
+    luisa::vector<int> removed_entities_;
+    bool structure_changed_ = false;
+
+    void rebuildEntityMap();
+    void removeEntity(int entity_id);
 
     // JSON parsing helpers using yyjson
     SceneEntity parseEntity(JsonReader &reader);
@@ -12,8 +12,8 @@ namespace rbc {
  * Scene Sync Manager
  * 
  * Manages the scene synchronization lifecycle:
- * - Periodic sync with Python server (100ms intervals)
- * - Heartbeat to keep connection alive (1s intervals)
+ * - Long-polls the Python server for versioned scene deltas, one request in flight
+ * - Heartbeat to keep connection alive (2s intervals), also refreshes animations
  * - Coordinates HttpClient, SceneSync, and EditorScene
  * - Emits signals for UI updates
  */
@@ -46,6 +46,12 @@ private slots:
 
 private:
     void registerWithServer();
+    void fetchResourcesAndAnimations();
+
+    // Server holds the delta request open up to this long when nothing changed
+    static constexpr int kLongPollTimeoutMs = 10000;
+    // Delay before polling again after a failed request
+    static constexpr int kRetryIntervalMs = 1000;
 
     HttpClient *httpClient_;
     SceneSync *sceneSync_;
@@ -56,6 +62,7 @@ private:
     QString editorId_;
     bool isConnected_;
     bool isRunning_;
+    bool syncInFlight_;
 };
 
 }// namespace rbc
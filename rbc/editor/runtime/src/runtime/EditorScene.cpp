@@ -204,6 +204,39 @@ void EditorScene::updateFromSync(const SceneSync &sync) {
     qDebug() << "EditorScene: Scene ready =" << scene_ready_ << "with" << entities_.size() << "entities";
 }
 
+void EditorScene::applyDelta(const SceneSync &sync) {
+    for (int entity_id : sync.removedEntities()) {
+        removeEntity(entity_id);
+    }
+
+    for (int entity_id : sync.changedEntities()) {
+        const auto *scene_entity = sync.getEntity(entity_id);
+        if (!scene_entity) {
+            continue;
+        }
+        // Render component dropped on the server
+        if (!scene_entity->has_render_component) {
+            removeEntity(entity_id);
+            continue;
+        }
+
+        if (entity_map_.find(entity_id) != entity_map_.end()) {
+            updateEntityTransform(entity_id, scene_entity->transform);
+            continue;
+        }
+
+        const auto *mesh_resource = sync.getResource(scene_entity->render_component.mesh_id);
+        if (!mesh_resource) {
+            LUISA_WARNING("Entity {} references unknown mesh resource {}",
+                          entity_id, scene_entity->render_component.mesh_id);
+            continue;
+        }
+        addEntity(entity_id, mesh_resource->path, scene_entity->transform);
+    }
+
+    scene_ready_ = !entities_.empty();
+}
+
 void EditorScene::addEntity(int entity_id, const luisa::string &mesh_path,
                             const Transform &transform) {
     using namespace luisa;
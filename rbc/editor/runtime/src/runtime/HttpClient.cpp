@@ -69,6 +69,10 @@ void HttpClient::getSceneState(std::function<void(const QJsonObject &, bool)> ca
     sendGetRequest("/scene/state", callback);
 }
 
+void HttpClient::getSceneDelta(uint64_t sinceVersion, int timeoutMs, std::function<void(const QJsonObject &, bool)> callback) {
+    sendGetRequest(QString("/scene/delta?since=%1&timeout_ms=%2").arg(sinceVersion).arg(timeoutMs), callback);
+}
+
 void HttpClient::getAllResources(std::function<void(const QJsonObject &, bool)> callback) {
     sendGetRequest("/resources/all", callback);
 }
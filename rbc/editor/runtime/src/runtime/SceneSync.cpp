@@ -34,7 +34,6 @@ const EditorResourceMetadata *SceneSync::getResource(int resource_id) const {
 */
 
 bool SceneSync::parseSceneState(const std::string &json) {
-    // TODO: 未来改为增量场景传输
     try {
         JsonReader reader(json);
 
@@ -49,10 +48,13 @@ bool SceneSync::parseSceneState(const std::string &json) {
         uint64_t entity_count = 0;
         if (!reader.start_array(entity_count, "entities")) {
             LUISA_INFO("No entities in scene");
+            has_changes_ = structure_changed_ = !entities_.empty();
             entities_.clear();
             entity_map_.clear();
+            changed_entities_.clear();
+            removed_entities_.clear();
             reader.end_scope();// end scene object
-            return true;
+            return has_changes_;
         }
 
         // Parse entities
@@ -78,14 +80,15 @@ bool SceneSync::parseSceneState(const std::string &json) {
                 }
             }
         }
-        // 当前为了方便开发我们每次全量更新
-        // Update entities
-        entities_ = new_entities;
-        entity_map_.clear();
-        for (size_t i = 0; i < entities_.size(); ++i) {
-            entity_map_[entities_[i].id] = i;
+        // Full snapshot: every entity counts as changed
+        entities_ = std::move(new_entities);
+        rebuildEntityMap();
+        changed_entities_.clear();
+        removed_entities_.clear();
+        for (auto &entity : entities_) {
+            changed_entities_.push_back(entity.id);
         }
-
+        structure_changed_ = changed;
         has_changes_ = changed;
         return changed;
 
@@ -95,6 +98,113 @@ bool SceneSync::parseSceneState(const std::string &json) {
     }
 }
 
+bool SceneSync::applySceneDelta(const std::string &json) {
+    try {
+        JsonReader reader(json);
+
+        if (!reader.start_object("delta")) {
+            LUISA_WARNING("No 'delta' object in JSON");
+            return false;
+        }
+
+        int64_t version_val = 0;
+        reader.read(version_val, "version");
+        bool full = false;
+        reader.read(full, "full");
+
+        changed_entities_.clear();
+        removed_entities_.clear();
+        structure_changed_ = false;
+
+        luisa::vector<SceneEntity> delta_entities;
+        uint64_t entity_count = 0;
+        if (reader.start_array(entity_count, "entities")) {
+            delta_entities.reserve(entity_count);
+            for (uint64_t i = 0; i < entity_count; ++i) {
+                if (reader.start_object()) {
+                    delta_entities.emplace_back(parseEntity(reader));
+                    reader.end_scope();// end entity object
+                }
+            }
+            reader.end_scope();// end entities array
+        }
+
+        uint64_t removed_count = 0;
+        if (reader.start_array(removed_count, "removed")) {
+            for (uint64_t i = 0; i < removed_count; ++i) {
+                int64_t id_val = 0;
+                if (reader.read(id_val)) {
+                    removed_entities_.push_back(static_cast<int>(id_val));
+                }
+            }
+            reader.end_scope();// end removed array
+        }
+        reader.end_scope();// end delta object
+
+        // A full delta lists every live entity, anything else was removed on the server
+        if (full) {
+            luisa::unordered_set<int> alive;
+            for (auto &entity : delta_entities) {
+                alive.insert(entity.id);
+            }
+            for (auto &entity : entities_) {
+                if (!alive.contains(entity.id)) {
+                    removed_entities_.push_back(entity.id);
+                }
+            }
+        }
+
+        for (int entity_id : removed_entities_) {
+            removeEntity(entity_id);
+        }
+
+        // Update in place, only unknown entities are appended
+        for (auto &entity : delta_entities) {
+            changed_entities_.push_back(entity.id);
+            auto it = entity_map_.find(entity.id);
+            if (it != entity_map_.end()) {
+                entities_[it->second] = std::move(entity);
+            } else {
+                entity_map_[entity.id] = entities_.size();
+                entities_.emplace_back(std::move(entity));
+                structure_changed_ = true;
+            }
+        }
+
+        version_ = static_cast<uint64_t>(version_val);
+        bool changed = !changed_entities_.empty() || !removed_entities_.empty();
+        has_changes_ = has_changes_ || changed;
+        return changed;
+
+    } catch (const std::exception &e) {
+        LUISA_ERROR("Failed to apply scene delta: {}", e.what());
+        return false;
+    }
+}
+
+void SceneSync::rebuildEntityMap() {
+    entity_map_.clear();
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        entity_map_[entities_[i].id] = i;
+    }
+}
+
+void SceneSync::removeEntity(int entity_id) {
+    auto it = entity_map_.find(entity_id);
+    if (it == entity_map_.end()) {
+        return;
+    }
+    // swap with the last entity to keep removal O(1)
+    size_t index = it->second;
+    entity_map_.erase(it);
+    if (index + 1 != entities_.size()) {
+        entities_[index] = std::move(entities_.back());
+        entity_map_[entities_[index].id] = index;
+    }
+    entities_.pop_back();
+    structure_changed_ = true;
+}
+
 SceneEntity SceneSync::parseEntity(JsonReader &reader) {
     SceneEntity entity;
 
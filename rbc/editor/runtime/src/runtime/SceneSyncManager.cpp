@@ -11,13 +11,15 @@ SceneSyncManager::SceneSyncManager(HttpClient *httpClient, QObject *parent)
       syncTimer_(new QTimer(this)),
       heartbeatTimer_(new QTimer(this)),
       isConnected_(false),
-      isRunning_(false) {
+      isRunning_(false),
+      syncInFlight_(false) {
 
     // Generate unique editor ID
     editorId_ = QString("qt_editor_%1").arg(QDateTime::currentMSecsSinceEpoch());
     // Setup timers
-    syncTimer_->setInterval(1000);     // 1s sync interval
-    heartbeatTimer_->setInterval(2000);// 1s heartbeat interval
+    syncTimer_->setSingleShot(true);
+    syncTimer_->setInterval(kRetryIntervalMs);// retry after a failed delta request
+    heartbeatTimer_->setInterval(2000);       // 2s heartbeat interval
 
     connect(syncTimer_, &QTimer::timeout, this, &SceneSyncManager::syncWithServer);
     connect(heartbeatTimer_, &QTimer::timeout, this, &SceneSyncManager::sendHeartbeat);
@@ -36,11 +38,10 @@ void SceneSyncManager::start(const QString &serverUrl) {
     httpClient_->setServerUrl(serverUrl);
     // Register with server
     registerWithServer();
-    // Start timers
-    syncTimer_->start();
-    heartbeatTimer_->start();
-
     isRunning_ = true;
+    // Start the long-poll loop, it re-arms itself after every response
+    syncWithServer();
+    heartbeatTimer_->start();
 }
 
 void SceneSyncManager::stop() {
@@ -70,17 +71,23 @@ void SceneSyncManager::registerWithServer() {
 }
 
 void SceneSyncManager::syncWithServer() {
-    if (!isRunning_) {
+    if (!isRunning_ || syncInFlight_) {
         return;
     }
+    syncInFlight_ = true;
 
-    // Fetch scene state
-    httpClient_->getSceneState([this](const QJsonObject &response, bool success) {
+    // Version 0 makes the server answer with a full snapshot
+    httpClient_->getSceneDelta(sceneSync_->version(), kLongPollTimeoutMs, [this](const QJsonObject &response, bool success) {
+        syncInFlight_ = false;
+        if (!isRunning_) {
+            return;
+        }
         if (!success) {
             if (isConnected_) {
                 isConnected_ = false;
                 emit connectionStatusChanged(false);
             }
+            syncTimer_->start();
             return;
         }
 
@@ -90,23 +97,32 @@ void SceneSyncManager::syncWithServer() {
             emit connectionStatusChanged(true);
         }
 
-        // Parse scene state
         QJsonDocument doc(response);
         QString jsonStr = doc.toJson(QJsonDocument::Compact);
-        bool sceneChanged = sceneSync_->parseSceneState(jsonStr.toStdString());
+        bool sceneChanged = sceneSync_->applySceneDelta(jsonStr.toStdString());
 
-        // Fetch resources if scene changed
         if (sceneChanged) {
-            httpClient_->getAllResources([this](const QJsonObject &resResponse, bool resSuccess) {
-                if (resSuccess) {
-                    QJsonDocument resDoc(resResponse);
-                    QString resJsonStr = resDoc.toJson(QJsonDocument::Compact);
-                    sceneSync_->parseResources(resJsonStr.toStdString());
-                }
-            });
+            if (sceneSync_->structureChanged()) {
+                // New entities may reference resources the editor has not seen yet
+                fetchResourcesAndAnimations();
+            } else {
+                emit sceneUpdated();
+            }
+        }
+
+        // Immediately wait for the next delta
+        syncWithServer();
+    });
+}
+
+void SceneSyncManager::fetchResourcesAndAnimations() {
+    httpClient_->getAllResources([this](const QJsonObject &resResponse, bool resSuccess) {
+        if (resSuccess) {
+            QJsonDocument resDoc(resResponse);
+            QString resJsonStr = resDoc.toJson(QJsonDocument::Compact);
+            sceneSync_->parseResources(resJsonStr.toStdString());
         }
 
-        // Also fetch animations
         httpClient_->getAnimations([this](const QJsonObject &animResponse, bool animSuccess) {
             if (animSuccess) {
                 QJsonDocument animDoc(animResponse);
@@ -131,6 +147,18 @@ void SceneSyncManager::sendHeartbeat() {
             emit connectionStatusChanged(false);
         }
     });
+
+    // Animations are not part of the scene version, refresh them at heartbeat rate
+    httpClient_->getAnimations([this](const QJsonObject &animResponse, bool animSuccess) {
+        if (!animSuccess) {
+            return;
+        }
+        QJsonDocument animDoc(animResponse);
+        QString animJsonStr = animDoc.toJson(QJsonDocument::Compact);
+        if (sceneSync_->parseAnimations(animJsonStr.toStdString())) {
+            emit sceneUpdated();
+        }
+    });
 }
 
 }// namespace rbc
@@ -44,8 +44,11 @@ void SceneUpdater::handleSceneUpdated() {
         return;
     }
 
+    // Entity list only changes shape when entities are added or removed
+    bool structureChanged = sceneSync->structureChanged();
+
     // Update scene hierarchy
-    if (context_->sceneHierarchy) {
+    if (context_->sceneHierarchy && structureChanged) {
         context_->sceneHierarchy->updateFromScene(sceneSync);
     }
 
@@ -54,9 +57,13 @@ void SceneUpdater::handleSceneUpdated() {
         context_->resultPanel->updateFromSync(sceneSync);
     }
 
-    // Update editor scene
+    // Update editor scene, modified-only deltas touch just the changed entities
     if (context_->editorScene) {
-        context_->editorScene->updateFromSync(*sceneSync);
+        if (structureChanged) {
+            context_->editorScene->updateFromSync(*sceneSync);
+        } else {
+            context_->editorScene->applyDelta(*sceneSync);
+        }
     }
 
     qDebug() << "SceneUpdater: Scene updated";
@@ -10,6 +10,10 @@ private:
 public:
 
     static void init(py::module &m);
+    // Fiber pool shared by all bindings, bound to the importing thread in init and
+    // destroyed by an atexit hook before the interpreter finalizes.
+    // Bindings running fiber jobs must check it, it is gone after exit starts.
+    [[nodiscard]] static bool has_fiber_scheduler();
     void (*_callback)(py::module &);
     explicit ModuleRegister(void (*callback)(py::module &));
 };
@@ -1,6 +1,11 @@
 #include "builtin/module_register.h"
 #include <luisa/core/stl/unordered_map.h>
 #include <luisa/core/stl/string.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/core/fiber.h>
+namespace {
+luisa::unique_ptr<luisa::fiber::scheduler> fiber_scheduler;
+}// namespace
 ModuleRegister *ModuleRegister::header{};
 ModuleRegister::ModuleRegister(void (*callback)(py::module &))
     : _callback(callback) {
@@ -8,9 +13,20 @@ ModuleRegister::ModuleRegister(void (*callback)(py::module &))
     header = this;
 }
 void ModuleRegister::init(py::module &m) {
+    if (!fiber_scheduler) {
+        fiber_scheduler = luisa::make_unique<luisa::fiber::scheduler>();
+        py::module_::import("atexit").attr("register")(py::cpp_function([]() {
+            // workers may wait for the GIL to finish a python node
+            py::gil_scoped_release release;
+            fiber_scheduler.reset();
+        }));
+    }
     auto ptr = header;
     while (ptr) {
         ptr->_callback(m);
         ptr = ptr->next;
     }
+}
+bool ModuleRegister::has_fiber_scheduler() {
+    return fiber_scheduler != nullptr;
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "builtin/module_register.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <rbc_node/graph_executor.h>
+
+namespace py = pybind11;
+using namespace rbc;
+
+namespace {
+// Python object carried along a graph edge, released under the GIL
+struct PyNodeValue : RCBase {
+    py::object obj;
+    explicit PyNodeValue(py::object &&obj) : obj(std::move(obj)) {}
+    ~PyNodeValue() override {
+        py::gil_scoped_acquire gil;
+        obj = py::object{};
+    }
+};
+py::object to_python(NodeValue const *value) {
+    if (!value) return py::none();
+    if (auto rc = value->try_get<RC<RCBase>>()) {
+        if (auto py_value = dynamic_cast<PyNodeValue *>(rc->get())) {
+            return py_value->obj;
+        }
+    }
+    // native buffers stay on the native side
+    return py::none();
+}
+luisa::string_view status_name(NodeStatus status) {
+    switch (status) {
+        case NodeStatus::Pending: return "pending";
+        case NodeStatus::Completed: return "completed";
+        case NodeStatus::Failed: return "failed";
+        case NodeStatus::Skipped: return "cancelled";
+    }
+    return "pending";
+}
+}// namespace
+
+void register_node_bindings(py::module &m) {
+    py::class_<NodeCache>(m, "NodeCache")
+        .def(py::init([](size_t memory_budget, std::string const &spill_dir) {
+                 return new NodeCache{memory_budget, luisa::filesystem::path{spill_dir}};
+             }),
+             py::arg("memory_budget"), py::arg("spill_dir") = std::string{})
+        .def("set_memory_budget", &NodeCache::set_memory_budget)
+        .def("memory_budget", &NodeCache::memory_budget)
+        .def("clear", &NodeCache::clear)
+        .def("stats", [](NodeCache &self) {
+            auto stats = self.stats();
+            py::dict d;
+            d["hits"] = stats.hits;
+            d["spill_hits"] = stats.spill_hits;
+            d["misses"] = stats.misses;
+            d["evictions"] = stats.evictions;
+            d["spills"] = stats.spills;
+            d["memory_bytes"] = stats.memory_bytes;
+            d["entry_count"] = stats.entry_count;
+            return d;
+        });
+    py::class_<GraphExecutor>(m, "GraphExecutor")
+        .def(py::init<>())
+        // fn(inputs: list) -> tuple of outputs, called with the GIL held
+        .def("add_node", [](GraphExecutor &self, std::string const &name, py::function fn, uint32_t output_count) {
+            auto func = luisa::make_shared<py::function>(std::move(fn));
+            return self.add_node(
+                luisa::string{name},
+                [func, output_count](NodeContext &ctx) {
+                    py::gil_scoped_acquire gil;
+                    try {
+                        py::list inputs;
+                        for (auto i : vstd::range(ctx.input_count())) {
+                            inputs.append(to_python(ctx.input(static_cast<uint32_t>(i))));
+                        }
+                        py::object result = (*func)(inputs);
+                        if (output_count == 0 || result.is_none()) return;
+                        py::tuple outputs = py::isinstance<py::tuple>(result) ? result.cast<py::tuple>() : py::make_tuple(result);
+                        for (auto i : vstd::range(std::min<size_t>(outputs.size(), output_count))) {
+                            ctx.set_output(static_cast<uint32_t>(i), NodeValue{RC<RCBase>{new PyNodeValue{py::reinterpret_borrow<py::object>(outputs[i])}}});
+                        }
+                    } catch (py::error_already_set &e) {
+                        ctx.set_error(luisa::string{e.what()});
+                    }
+                },
+                output_count);
+        })
+        // native nodes run on fiber workers without touching the GIL
+        .def("add_native_node", [](GraphExecutor &self, std::string const &name, std::string const &type_name) {
+            auto entry = NativeNodeRegistry::instance().find(type_name);
+            if (!entry.func) {
+                throw py::key_error("Native node type not registered: " + type_name);
+            }
+            return self.add_node(
+                luisa::string{name},
+                [func = entry.func](NodeContext &ctx) { func(ctx); },
+                entry.output_count);
+        })
+        .def("connect", &GraphExecutor::connect)
+        .def("connect_dependency", &GraphExecutor::connect_dependency)
+        // the executor borrows the cache, keep it alive as long as the executor
+        .def("set_cache", &GraphExecutor::set_cache, py::keep_alive<1, 2>())
+        .def("set_cache_key", [](GraphExecutor &self, uint32_t node, std::string const &node_type, uint64_t param_hash) {
+            self.set_cache_key(node, luisa::string{node_type}, param_hash);
+        })
+        .def("compile", &GraphExecutor::compile)
+        .def("execute", [](GraphExecutor &self) {
+            if (!ModuleRegister::has_fiber_scheduler()) {
+                throw std::runtime_error("rbc_ext_c fiber scheduler is shut down.");
+            }
+            py::gil_scoped_release release;
+            self.execute();
+        })
+        .def("clear_values", &GraphExecutor::clear_values)
+        .def("node_count", &GraphExecutor::node_count)
+        .def("output", [](GraphExecutor &self, uint32_t node, uint32_t slot) {
+            return to_python(self.output(node, slot));
+        })
+        .def("status", [](GraphExecutor &self, uint32_t node) {
+            return std::string{status_name(self.status(node))};
+        })
+        .def("error", [](GraphExecutor &self, uint32_t node) {
+            return std::string{self.error(node)};
+        })
+        // (start_ms, duration_ms) relative to the start of execute
+        .def("timing", [](GraphExecutor &self, uint32_t node) {
+            auto &t = self.timing(node);
+            return py::make_tuple(t.start_ms, t.duration_ms);
+        })
+        .def("from_cache", &GraphExecutor::from_cache)
+        .def("last_execute_ms", &GraphExecutor::last_execute_ms);
+}
+
+static ModuleRegister module_register_register_node_bindings(register_node_bindings);
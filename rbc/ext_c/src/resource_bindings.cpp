@@ -1,9 +1,283 @@
 #include "builtin/module_register.h"
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <rbc_world/resource_base.h>
+#include <rbc_world/entity.h>
+#include <rbc_world/resources/mesh.h>
+#include <rbc_world/resources/texture.h>
+#include <rbc_world/components/skelmesh_component.h>
+#include <rbc_world/util/host_data_view.h>
+#include <luisa/runtime/rhi/pixel.h>
+#include <luisa/runtime/rtx/triangle.h>
+#include <cstring>
 
 namespace py = pybind11;
+using namespace rbc;
+using namespace luisa::compute;
+
+// Views returned here alias resource host memory: they are only valid until the host data is reallocated
+// (e.g. MeshResource::add_property).
+// The owning wrapper is kept alive as the array base.
+// Setters queue a device upload, writes through a view need an explicit mark_dirty().
+namespace {
+struct PyMesh {
+    RC<world::MeshResource> mesh;
+};
+struct PyTexture {
+    RC<world::TextureResource> texture;
+};
+struct PyPose {
+    RC<SkeletalMesh> skel_mesh;
+};
+
+template<typename T>
+RC<T> find_resource(std::string const &guid_str) {
+    auto guid = vstd::Guid::TryParseGuid(guid_str);
+    if (!guid) throw py::value_error("Invalid guid: " + guid_str);
+    auto res = world::load_resource(*guid);
+    if (!res || !res->is_type_of(TypeInfo::get<T>())) {
+        throw py::key_error("Resource not found: " + guid_str);
+    }
+    return std::move(res).cast_static<T>();
+}
+
+luisa::span<std::byte> mesh_host(world::MeshResource &mesh) {
+    auto host = mesh.host_data();
+    if (!host || host->empty()) throw std::runtime_error("Mesh has no host data.");
+    return *host;
+}
+
+// rows of `cols` elements, destination rows are `dst_stride` bytes apart (float3 is padded to 16 bytes)
+template<typename T>
+py::array_t<T> make_view(py::handle base, std::byte *ptr, size_t rows, size_t cols, size_t dst_stride) {
+    return py::array_t<T>(
+        {rows, cols},
+        {dst_stride, sizeof(T)},
+        reinterpret_cast<T *>(ptr),
+        base);
+}
+
+// Copies a (rows, cols) buffer of T into strided host memory without holding the GIL.
+// With inner > 0 the buffer may also be (rows, cols / inner, inner), its two trailing axes form one row.
+template<typename T>
+void copy_rows(py::buffer const &src, std::byte *dst, size_t rows, size_t cols, size_t dst_stride, size_t inner = 0) {
+    auto info = src.request();
+    if (info.format != py::format_descriptor<T>::format()) {
+        throw py::type_error("Unexpected element type " + info.format + ", expected " + py::format_descriptor<T>::format());
+    }
+    auto layout = world::resolve_strided_rows(
+        {reinterpret_cast<ptrdiff_t const *>(info.shape.data()), info.shape.size()},
+        {reinterpret_cast<ptrdiff_t const *>(info.strides.data()), info.strides.size()},
+        sizeof(T), rows, cols, inner);
+    if (!layout) {
+        auto shape = std::to_string(rows) + ", " + std::to_string(cols);
+        if (inner > 0) {
+            shape = std::to_string(rows) + ", " + std::to_string(cols / inner) + ", " + std::to_string(inner) + ") or (" + shape;
+        }
+        throw py::value_error("Unexpected array shape, expected (" + shape + ")");
+    }
+    auto src_ptr = static_cast<std::byte const *>(info.ptr);
+    py::gil_scoped_release release;
+    world::copy_strided_rows(*layout, src_ptr, dst, rows, cols, sizeof(T), dst_stride);
+}
+
+struct PixelFormat {
+    // empty for block-compressed or packed formats, exposed as raw bytes
+    std::string format;
+    size_t element_size{};
+    size_t channels{};
+};
+PixelFormat pixel_format(PixelStorage storage) {
+    switch (storage) {
+        case PixelStorage::BYTE1: return {py::format_descriptor<uint8_t>::format(), 1, 1};
+        case PixelStorage::BYTE2: return {py::format_descriptor<uint8_t>::format(), 1, 2};
+        case PixelStorage::BYTE4: return {py::format_descriptor<uint8_t>::format(), 1, 4};
+        case PixelStorage::SHORT1: return {py::format_descriptor<uint16_t>::format(), 2, 1};
+        case PixelStorage::SHORT2: return {py::format_descriptor<uint16_t>::format(), 2, 2};
+        case PixelStorage::SHORT4: return {py::format_descriptor<uint16_t>::format(), 2, 4};
+        case PixelStorage::INT1: return {py::format_descriptor<int32_t>::format(), 4, 1};
+        case PixelStorage::INT2: return {py::format_descriptor<int32_t>::format(), 4, 2};
+        case PixelStorage::INT4: return {py::format_descriptor<int32_t>::format(), 4, 4};
+        case PixelStorage::HALF1: return {"e", 2, 1};
+        case PixelStorage::HALF2: return {"e", 2, 2};
+        case PixelStorage::HALF4: return {"e", 2, 4};
+        case PixelStorage::FLOAT1: return {py::format_descriptor<float>::format(), 4, 1};
+        case PixelStorage::FLOAT2: return {py::format_descriptor<float>::format(), 4, 2};
+        case PixelStorage::FLOAT4: return {py::format_descriptor<float>::format(), 4, 4};
+        default: return {};
+    }
+}
+luisa::span<std::byte> texture_level(world::TextureResource &texture, uint32_t level) {
+    if (texture.is_vt()) throw std::runtime_error("Virtual texture host data is tiled, no linear view available.");
+    if (level >= texture.mip_level()) throw py::index_error("Mip level out of range.");
+    auto host = texture.host_data();
+    if (!host || host->empty()) throw std::runtime_error("Texture has no host data.");
+    auto range = world::texture_level_range(static_cast<PixelStorage>(texture.pixel_storage()), texture.size(), level);
+    if (range.offset + range.size > host->size()) throw std::runtime_error("Texture host data does not contain the requested mip level.");
+    return luisa::span{*host}.subspan(range.offset, range.size);
+}
+py::array texture_view(py::handle base, world::TextureResource &texture, uint32_t level) {
+    auto data = texture_level(texture, level);
+    auto format = pixel_format(static_cast<PixelStorage>(texture.pixel_storage()));
+    if (format.format.empty()) {
+        return py::array(py::dtype::of<uint8_t>(), {data.size()}, {size_t{1}}, data.data(), base);
+    }
+    auto size = max(texture.size() >> level, uint2(1u));
+    return py::array(
+        py::dtype(format.format),
+        {size_t{size.y}, size_t{size.x}, format.channels},
+        {size.x * format.channels * format.element_size, format.channels * format.element_size, format.element_size},
+        data.data(),
+        base);
+}
+}// namespace
 
 void register_resource_bindings(py::module &m) {
+    py::class_<PyMesh>(m, "Mesh")
+        .def_static("from_guid", [](std::string const &guid) { return PyMesh{find_resource<world::MeshResource>(guid)}; })
+        .def_property_readonly("vertex_count", [](PyMesh &self) { return self.mesh->vertex_count(); })
+        .def_property_readonly("triangle_count", [](PyMesh &self) { return self.mesh->triangle_count(); })
+        .def_property_readonly("uv_count", [](PyMesh &self) { return self.mesh->uv_count(); })
+        .def_property_readonly("has_normal", [](PyMesh &self) { return static_cast<bool>(self.mesh->contained_normal()); })
+        .def_property_readonly("has_tangent", [](PyMesh &self) { return static_cast<bool>(self.mesh->contained_tangent()); })
+        // (vertex_count, 3) float32
+        .def("positions", [](py::object self) {
+            auto &mesh = *self.cast<PyMesh &>().mesh;
+            return make_view<float>(self, mesh_host(mesh).data(), mesh.vertex_count(), 3, sizeof(float3));
+        })
+        .def("normals", [](py::object self) {
+            auto &mesh = *self.cast<PyMesh &>().mesh;
+            if (!mesh.contained_normal()) throw std::runtime_error("Mesh has no normals.");
+            return make_view<float>(self, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.normal, mesh.vertex_count(), 3, sizeof(float3));
+        })
+        .def("tangents", [](py::object self) {
+            auto &mesh = *self.cast<PyMesh &>().mesh;
+            if (!mesh.contained_tangent()) throw std::runtime_error("Mesh has no tangents.");
+            return make_view<float>(self, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.tangent, mesh.vertex_count(), 4, sizeof(float4));
+        })
+        .def("uvs", [](py::object self, uint32_t channel) {
+                 auto &mesh = *self.cast<PyMesh &>().mesh;
+                 if (channel >= mesh.uv_count()) throw py::index_error("UV channel out of range.");
+                 auto offset = world::MeshHostLayout{mesh}.uv + size_t{channel} * mesh.vertex_count() * sizeof(float2);
+                 return make_view<float>(self, mesh_host(mesh).data() + offset, mesh.vertex_count(), 2, sizeof(float2));
+             },
+             py::arg("channel") = 0)
+        // (triangle_count, 3) uint32
+        .def("indices", [](py::object self) {
+            auto &mesh = *self.cast<PyMesh &>().mesh;
+            return make_view<uint32_t>(self, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.triangle, mesh.triangle_count(), 3, sizeof(Triangle));
+        })
+        // raw bytes of a custom property, use ndarray.view() to reinterpret
+        .def("property", [](py::object self, std::string const &name) {
+            auto &mesh = *self.cast<PyMesh &>().mesh;
+            auto data = mesh.get_property_host(name);
+            if (data.empty()) throw py::key_error("Mesh property not found: " + name);
+            return py::array(py::dtype::of<uint8_t>(), {data.size()}, {size_t{1}}, data.data(), self);
+        })
+        .def("set_positions", [](PyMesh &self, py::buffer const &src) {
+            auto &mesh = *self.mesh;
+            copy_rows<float>(src, mesh_host(mesh).data(), mesh.vertex_count(), 3, sizeof(float3));
+            mesh.mark_host_dirty(true);
+        })
+        .def("set_normals", [](PyMesh &self, py::buffer const &src) {
+            auto &mesh = *self.mesh;
+            if (!mesh.contained_normal()) throw std::runtime_error("Mesh has no normals.");
+            copy_rows<float>(src, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.normal, mesh.vertex_count(), 3, sizeof(float3));
+            mesh.mark_host_dirty(true);
+        })
+        .def("set_tangents", [](PyMesh &self, py::buffer const &src) {
+            auto &mesh = *self.mesh;
+            if (!mesh.contained_tangent()) throw std::runtime_error("Mesh has no tangents.");
+            copy_rows<float>(src, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.tangent, mesh.vertex_count(), 4, sizeof(float4));
+            mesh.mark_host_dirty(true);
+        })
+        .def("set_uvs", [](PyMesh &self, py::buffer const &src, uint32_t channel) {
+                 auto &mesh = *self.mesh;
+                 if (channel >= mesh.uv_count()) throw py::index_error("UV channel out of range.");
+                 auto offset = world::MeshHostLayout{mesh}.uv + size_t{channel} * mesh.vertex_count() * sizeof(float2);
+                 copy_rows<float>(src, mesh_host(mesh).data() + offset, mesh.vertex_count(), 2, sizeof(float2));
+                 mesh.mark_host_dirty(true);
+             },
+             py::arg("src"), py::arg("channel") = 0)
+        .def("set_indices", [](PyMesh &self, py::buffer const &src) {
+            auto &mesh = *self.mesh;
+            copy_rows<uint32_t>(src, mesh_host(mesh).data() + world::MeshHostLayout{mesh}.triangle, mesh.triangle_count(), 3, sizeof(Triangle));
+            mesh.mark_host_dirty(false);
+        })
+        // re-upload after writing through the views, vertex-only skips the index range
+        .def("mark_dirty", [](PyMesh &self, bool only_vertex) { self.mesh->mark_host_dirty(only_vertex); }, py::arg("only_vertex") = false);
+
+    py::class_<PyTexture>(m, "Texture")
+        .def_static("from_guid", [](std::string const &guid) { return PyTexture{find_resource<world::TextureResource>(guid)}; })
+        .def_property_readonly("width", [](PyTexture &self) { return self.texture->size().x; })
+        .def_property_readonly("height", [](PyTexture &self) { return self.texture->size().y; })
+        .def_property_readonly("mip_level", [](PyTexture &self) { return self.texture->mip_level(); })
+        .def_property_readonly("pixel_storage", [](PyTexture &self) { return luisa::to_underlying(self.texture->pixel_storage()); })
+        // (height, width, channels), flat uint8 for block-compressed storages
+        .def("host_data", [](py::object self, uint32_t level) { return texture_view(self, *self.cast<PyTexture &>().texture, level); }, py::arg("level") = 0)
+        .def("set_host_data", [](PyTexture &self, py::buffer const &src, uint32_t level) {
+                 auto dst = texture_level(*self.texture, level);
+                 auto info = src.request();
+                 if (static_cast<size_t>(info.size * info.itemsize) != dst.size()) {
+                     throw py::value_error("Texture data size mismatch, expected " + std::to_string(dst.size()) + " bytes");
+                 }
+                 // only dense C-order input can be copied in one piece
+                 auto expected_stride = info.itemsize;
+                 for (auto i = info.ndim; i > 0; --i) {
+                     if (info.strides[i - 1] != expected_stride) throw py::value_error("Texture data must be C-contiguous.");
+                     expected_stride *= info.shape[i - 1];
+                 }
+                 auto src_ptr = info.ptr;
+                 {
+                     py::gil_scoped_release release;
+                     std::memcpy(dst.data(), src_ptr, dst.size());
+                 }
+                 self.texture->mark_host_dirty();
+             },
+             py::arg("src"), py::arg("level") = 0)
+        .def("mark_dirty", [](PyTexture &self) { self.texture->mark_host_dirty(); });
+
+    py::class_<PyPose>(m, "Pose")
+        .def_static("from_entity", [](std::string const &guid_str) {
+            auto guid = vstd::Guid::TryParseGuid(guid_str);
+            if (!guid) throw py::value_error("Invalid guid: " + guid_str);
+            auto obj = world::get_object_ref(*guid);
+            if (!obj || obj->base_type() != world::BaseObjectType::Entity) {
+                throw py::key_error("Entity not found: " + guid_str);
+            }
+            auto comp = static_cast<world::Entity *>(obj.get())->get_component<world::SkelMeshComponent>();
+            if (!comp || !comp->GetRuntimeSkeletalMesh()) {
+                throw py::key_error("Entity has no skeletal mesh: " + guid_str);
+            }
+            return PyPose{RC<SkeletalMesh>{comp->GetRuntimeSkeletalMesh()}};
+        })
+        // (soa_count, 10, 4) float32: translation xyz, rotation xyzw, scale xyz, four bones per SoA element
+        .def("bone_space_transforms", [](py::object self) {
+            auto &bones = self.cast<PyPose &>().skel_mesh->BoneSpaceTransforms;
+            static_assert(sizeof(AnimSOATransform) == 10 * 4 * sizeof(float));
+            return py::array_t<float>(
+                {bones.size(), size_t{10}, size_t{4}},
+                {sizeof(AnimSOATransform), 4 * sizeof(float), sizeof(float)},
+                reinterpret_cast<float *>(bones.data()),
+                self);
+        })
+        // (bone_count, 4, 4) float32, column major
+        .def("component_space_transforms", [](py::object self) {
+            auto &transforms = self.cast<PyPose &>().skel_mesh->GetEditableComponentSpaceTransforms();
+            static_assert(sizeof(AnimFloat4x4) == 16 * sizeof(float));
+            return py::array_t<float>(
+                {transforms.size(), size_t{4}, size_t{4}},
+                {sizeof(AnimFloat4x4), 4 * sizeof(float), sizeof(float)},
+                reinterpret_cast<float *>(transforms.data()),
+                self);
+        })
+        // same (soa_count, 10, 4) layout as bone_space_transforms, (soa_count, 40) is accepted as well
+        .def("set_bone_space_transforms", [](PyPose &self, py::buffer const &src) {
+            auto &bones = self.skel_mesh->BoneSpaceTransforms;
+            copy_rows<float>(src, reinterpret_cast<std::byte *>(bones.data()), bones.size(), 40, sizeof(AnimSOATransform), 4);
+            self.skel_mesh->MarkRenderTransformDirty();
+        });
 }
 
-static ModuleRegister module_register_register_resource_bindings(register_resource_bindings);
\ No newline at end of file
+static ModuleRegister module_register_register_resource_bindings(register_resource_bindings);
@@ -0,0 +1,91 @@
+#include "builtin/module_register.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <rbc_world/base_object.h>
+#include <rbc_world/entity.h>
+#include <rbc_world/components/transform.h>
+
+namespace py = pybind11;
+using namespace rbc;
+
+namespace {
+template<typename T>
+using c_array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+void check_shape(py::array const &arr, size_t count, std::initializer_list<py::ssize_t> inner, char const *name) {
+    bool valid = arr.ndim() == static_cast<py::ssize_t>(inner.size() + 1) && static_cast<size_t>(arr.shape(0)) == count;
+    py::ssize_t dim = 1;
+    for (auto i : inner) {
+        valid &= arr.shape(dim++) == i;
+    }
+    if (!valid) throw py::value_error(std::string("Unexpected shape of ") + name);
+}
+luisa::span<world::InstanceID const> as_ids(c_array<uint64_t> const &ids) {
+    static_assert(sizeof(world::InstanceID) == sizeof(uint64_t));
+    return {reinterpret_cast<world::InstanceID const *>(ids.data()), static_cast<size_t>(ids.size())};
+}
+}// namespace
+
+void register_world_bindings(py::module &m) {
+    // Resolve entity or transform guids once, the returned ids are reused by every batched call.
+    // Entities without a transform map to the invalid id, which batched setters skip.
+    m.def("resolve_transforms", [](std::vector<std::string> const &guids) {
+        c_array<uint64_t> result(static_cast<py::ssize_t>(guids.size()));
+        auto ids = result.mutable_data();
+        for (size_t i = 0; i < guids.size(); ++i) {
+            ids[i] = world::InstanceID::invalid_resource_handle()._placeholder;
+            auto guid = vstd::Guid::TryParseGuid(guids[i]);
+            if (!guid) continue;
+            auto obj = world::get_object(*guid);
+            if (!obj) continue;
+            world::TransformComponent *tr{};
+            if (obj->base_type() == world::BaseObjectType::Entity) {
+                tr = static_cast<world::Entity *>(obj)->get_component<world::TransformComponent>();
+            } else if (obj->is_type_of(TypeInfo::get<world::TransformComponent>())) {
+                tr = static_cast<world::TransformComponent *>(obj);
+            }
+            if (tr) ids[i] = tr->instance_id()._placeholder;
+        }
+        return result;
+    });
+    // matrices: (N, 4, 4) float64, column-major like TransformComponent::trs()
+    m.def("set_transform_matrices", [](c_array<uint64_t> const &ids, c_array<double> const &matrices, bool recursive) {
+             auto count = static_cast<size_t>(ids.size());
+             check_shape(matrices, count, {4, 4}, "matrices");
+             static_assert(sizeof(double4x4) == 16 * sizeof(double));
+             auto id_span = as_ids(ids);
+             luisa::span trs{reinterpret_cast<double4x4 const *>(matrices.data()), count};
+             py::gil_scoped_release release;
+             return world::TransformComponent::set_trs_batch(id_span, trs, recursive, ModuleRegister::has_fiber_scheduler());
+         },
+         py::arg("ids"), py::arg("matrices"), py::arg("recursive") = true);
+    // positions, scales: (N, 3) float64, rotations: (N, 4) float32 quaternion xyzw
+    m.def("set_transforms", [](c_array<uint64_t> const &ids, c_array<double> const &positions, c_array<float> const &rotations, c_array<double> const &scales, bool recursive) {
+             auto count = static_cast<size_t>(ids.size());
+             check_shape(positions, count, {3}, "positions");
+             check_shape(rotations, count, {4}, "rotations");
+             check_shape(scales, count, {3}, "scales");
+             auto id_span = as_ids(ids);
+             auto pos_ptr = positions.data();
+             auto rot_ptr = rotations.data();
+             auto scale_ptr = scales.data();
+             py::gil_scoped_release release;
+             // double3 is padded to 32 bytes, repack the dense rows
+             luisa::vector<double3> pos_vec;
+             luisa::vector<Quaternion> rot_vec;
+             luisa::vector<double3> scale_vec;
+             pos_vec.push_back_uninitialized(count);
+             rot_vec.push_back_uninitialized(count);
+             scale_vec.push_back_uninitialized(count);
+             for (size_t i = 0; i < count; ++i) {
+                 pos_vec[i] = make_double3(pos_ptr[i * 3], pos_ptr[i * 3 + 1], pos_ptr[i * 3 + 2]);
+                 rot_vec[i] = Quaternion{make_float4(rot_ptr[i * 4], rot_ptr[i * 4 + 1], rot_ptr[i * 4 + 2], rot_ptr[i * 4 + 3])};
+                 scale_vec[i] = make_double3(scale_ptr[i * 3], scale_ptr[i * 3 + 1], scale_ptr[i * 3 + 2]);
+             }
+             return world::TransformComponent::set_trs_batch(id_span, pos_vec, rot_vec, scale_vec, recursive, ModuleRegister::has_fiber_scheduler());
+         },
+         py::arg("ids"), py::arg("positions"), py::arg("rotations"), py::arg("scales"), py::arg("recursive") = true);
+}
+
+static ModuleRegister module_register_register_world_bindings(register_world_bindings);
@@ -10,7 +10,7 @@ local function rbc_ext_c_impl()
         enable_exception = true,
         rtti = true
     })
-    add_deps('lc-core')
+    add_deps('lc-core', 'rbc_node')
     add_rules('pybind')
     set_extension('.pyd')
     -- add_deps("rbc_world_v2")
@@ -9,6 +9,7 @@
 #include <luisa/vstl/common.h>
 #include <luisa/vstl/functional.h>
 #include <rbc_node/node_buffer.h>
+#include <rbc_node/remote_device.h>
 #include <luisa/backends/ext/dx_cuda_interop.h>
 
 namespace rbc {
@@ -32,6 +33,7 @@ struct RBC_NODE_API DeviceManager {
 private:
     Context _lc_ctx;
     vstd::HashMap<uint32_t, ComputeDevice> _compute_devices;
+    vstd::HashMap<uint32_t, luisa::unique_ptr<RemoteComputeDevice>> _remote_devices;
     luisa::spin_mutex _render_device_mtx;
     void *_interop_ext{};
     void _sync_render_to_compute(uint32_t compute_index);
@@ -46,6 +48,9 @@ public:
         ComputeDeviceDesc src_device,
         ComputeDeviceDesc dst_device);
     ComputeDevice &get_compute_device(uint32_t index);
+    // Topic the worker process of a remote device has to listen on
+    static luisa::string remote_device_topic(uint32_t index);
+    RemoteComputeDevice &get_remote_device(uint32_t index);
     NodeBuffer create_buffer(RC<BufferDescriptor> buffer_desc, ComputeDeviceDesc src_device_desc, ComputeDeviceDesc dst_device_desc);
     ByteBufferView get_buffer(NodeBuffer const &node_buffer, ComputeDeviceDesc dst_device_desc);
 };
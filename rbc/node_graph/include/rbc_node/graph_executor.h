@@ -0,0 +1,140 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/clock.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/stl/string.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/vstl/common.h>
+#include <luisa/vstl/functional.h>
+#include <rbc_node/node_cache.h>
+namespace rbc {
+enum struct NodeStatus : uint32_t {
+    Pending,
+    Completed,
+    Failed,
+    // an upstream node failed, the node did not run
+    Skipped
+};
+struct NodeTiming {
+    // relative to the start of GraphExecutor::execute
+    double start_ms{};
+    double duration_ms{};
+};
+struct GraphExecutor;
+struct RBC_NODE_API NodeContext {
+    friend struct GraphExecutor;
+
+private:
+    GraphExecutor &_executor;
+    uint32_t _node;
+    NodeContext(GraphExecutor &executor, uint32_t node)
+        : _executor(executor), _node(node) {}
+
+public:
+    [[nodiscard]] uint32_t node() const { return _node; }
+    [[nodiscard]] size_t input_count() const;
+    // Borrowed producer output, nullptr if the slot is unconnected or the producer left it empty
+    [[nodiscard]] NodeValue const *input(uint32_t slot) const;
+    // Move the producer output into dst, only allowed when this node is its sole consumer
+    bool take_input(uint32_t slot, NodeValue &dst);
+    void set_output(uint32_t slot, NodeValue &&value);
+    // Content hash of an output, lets consumers of a non-cached node be memoized
+    void set_output_hash(uint32_t slot, uint64_t hash);
+    // Mark the node failed, every node depending on it is skipped
+    void set_error(luisa::string message);
+};
+// Runs a compiled DAG on the fiber pool, a node is scheduled as soon as all its predecessors finished.
+// Values are moved or borrowed between nodes, never copied.
+// With a NodeCache attached, nodes with a cache key whose inputs are unchanged reuse earlier outputs instead of running.
+struct RBC_NODE_API GraphExecutor {
+    friend struct NodeContext;
+    using NodeFunc = vstd::function<void(NodeContext &)>;
+
+private:
+    struct Port {
+        uint32_t node{~0u};
+        uint32_t slot{};
+    };
+    struct Node {
+        luisa::string name;
+        NodeFunc func;
+        luisa::vector<Port> inputs;
+        // ordering-only edges, no value is passed
+        luisa::vector<uint32_t> dependencies;
+        // invalid variant marks an empty output
+        luisa::vector<NodeValue> outputs;
+        // 0 if the content is unknown
+        luisa::vector<uint64_t> output_hashes;
+        // empty if the node is not cacheable
+        luisa::string cache_type;
+        uint64_t param_hash{};
+        uint64_t cache_key{};
+        bool outputs_taken{};
+        bool from_cache{};
+        luisa::vector<uint32_t> output_consumers;
+        luisa::vector<uint32_t> successors;
+        uint32_t predecessor_count{};
+        std::atomic_uint32_t pending{};
+        std::atomic_bool upstream_failed{};
+        NodeStatus status{NodeStatus::Pending};
+        luisa::string error;
+        NodeTiming timing;
+    };
+    luisa::vector<luisa::unique_ptr<Node>> _nodes;
+    luisa::vector<uint32_t> _roots;
+    NodeCache *_cache{};
+    bool _compiled{};
+    luisa::Clock _clock;
+    double _last_execute_ms{};
+    void _run_node(uint32_t index, luisa::fiber::counter &counter);
+    bool _fetch_cached(Node &node);
+
+public:
+    GraphExecutor();
+    ~GraphExecutor();
+    GraphExecutor(GraphExecutor const &) = delete;
+    GraphExecutor(GraphExecutor &&) = delete;
+    uint32_t add_node(luisa::string name, NodeFunc func, uint32_t output_count);
+    void connect(uint32_t src_node, uint32_t src_slot, uint32_t dst_node, uint32_t dst_slot);
+    // dst_node runs after src_node without consuming any of its outputs
+    void connect_dependency(uint32_t src_node, uint32_t dst_node);
+    // Outputs kept from the last execute go back to the cache instead of being dropped, nullptr disables caching
+    void set_cache(NodeCache *cache) { _cache = cache; }
+    [[nodiscard]] NodeCache *cache() const { return _cache; }
+    // Mark a node as pure, its outputs depend only on the type, the parameters and the inputs
+    void set_cache_key(uint32_t node, luisa::string node_type, uint64_t param_hash);
+    // Build successor lists and find roots, returns false if the graph has a cycle
+    bool compile();
+    // Blocks until every node finished, failed or was skipped
+    void execute();
+    // Drop all node outputs kept from the last execute, cacheable ones are handed to the cache
+    void clear_values();
+    [[nodiscard]] size_t node_count() const { return _nodes.size(); }
+    [[nodiscard]] luisa::string_view node_name(uint32_t node) const { return _nodes[node]->name; }
+    [[nodiscard]] NodeStatus status(uint32_t node) const { return _nodes[node]->status; }
+    [[nodiscard]] luisa::string_view error(uint32_t node) const { return _nodes[node]->error; }
+    [[nodiscard]] NodeTiming const &timing(uint32_t node) const { return _nodes[node]->timing; }
+    [[nodiscard]] bool from_cache(uint32_t node) const { return _nodes[node]->from_cache; }
+    [[nodiscard]] NodeValue const *output(uint32_t node, uint32_t slot) const;
+    [[nodiscard]] double last_execute_ms() const { return _last_execute_ms; }
+};
+// Stateless native node types, looked up by name when a graph is built from a script
+struct RBC_NODE_API NativeNodeRegistry {
+    using NodeFunc = void (*)(NodeContext &);
+    struct Entry {
+        NodeFunc func{};
+        uint32_t output_count{};
+    };
+
+private:
+    vstd::HashMap<luisa::string, Entry> _entries;
+    mutable luisa::spin_mutex _mtx;
+
+public:
+    static NativeNodeRegistry &instance();
+    void register_node(luisa::string name, NodeFunc func, uint32_t output_count);
+    // func is nullptr if the name is not registered
+    [[nodiscard]] Entry find(luisa::string_view name) const;
+};
+}// namespace rbc
@@ -25,8 +25,10 @@ struct alignas(sizeof(uint64_t)) ComputeDeviceDesc {
     }
 };
 struct DeviceManager;
+struct NodeCache;
 struct RBC_NODE_API NodeBuffer {
     friend struct DeviceManager;
+    friend struct NodeCache;
 private:
     RC<BufferDescriptor> _buffer_desc;
     ComputeDeviceDesc _src_device_desc;
@@ -43,6 +45,11 @@ public:
         return *_buffer_desc;
     }
     bool is_interop() const { return _interop_buffer.valid(); }
+    // Empty if the buffer lives on a device
+    luisa::span<std::byte> host_data();
+    luisa::span<std::byte const> host_data() const;
+    // Host memory buffer, no device manager involved
+    static NodeBuffer create_host(size_t size_bytes);
     auto src_device_desc() const { return _src_device_desc; }
     auto dst_device_desc() const { return _dst_device_desc; }
     NodeBuffer(NodeBuffer const &) = delete;
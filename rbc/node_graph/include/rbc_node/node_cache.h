@@ -0,0 +1,92 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/spin_mutex.h>
+#include <luisa/core/stl/filesystem.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/core/stl/string.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/vstl/common.h>
+#include <rbc_core/rc.h>
+#include <rbc_node/node_buffer.h>
+namespace rbc {
+// Value flowing along a graph edge: a device/host buffer or any ref-counted object
+using NodeValue = vstd::variant<NodeBuffer, RC<RCBase>>;
+// Memoized node outputs, keyed by node type, parameter hash and input content hashes.
+// Outputs are moved in and out, a value is never shared between the cache and a running graph.
+// Least recently used entries are evicted past the memory budget, host-only entries are spilled to disk
+// if a spill directory is set.
+struct RBC_NODE_API NodeCache {
+    struct Stats {
+        uint64_t hits{};
+        uint64_t spill_hits{};
+        uint64_t misses{};
+        uint64_t evictions{};
+        uint64_t spills{};
+        size_t memory_bytes{};
+        size_t entry_count{};
+    };
+
+private:
+    struct Entry {
+        luisa::vector<NodeValue> outputs;
+        luisa::vector<uint64_t> output_hashes;
+        size_t size_bytes{};
+        uint64_t key{};
+        // intrusive LRU list, the head is the most recently used
+        Entry *lru_prev{};
+        Entry *lru_next{};
+    };
+    struct SpilledOutput {
+        // empty output slot
+        bool empty{true};
+        uint64_t hash{};
+        RC<BufferDescriptor> buffer_desc;
+        ComputeDeviceDesc src_device_desc;
+        ComputeDeviceDesc dst_device_desc;
+        size_t size_bytes{};
+    };
+    // entries are heap allocated so the LRU links stay valid while the map rehashes
+    vstd::HashMap<uint64_t, luisa::unique_ptr<Entry>> _entries;
+    vstd::HashMap<uint64_t, luisa::vector<SpilledOutput>> _spilled;
+    mutable luisa::spin_mutex _mtx;
+    luisa::filesystem::path _spill_dir;
+    size_t _memory_budget;
+    size_t _memory_bytes{};
+    Entry *_lru_head{};
+    Entry *_lru_tail{};
+    // bumped by clear, spills started before it are dropped
+    uint64_t _epoch{};
+    Stats _stats;
+    [[nodiscard]] luisa::filesystem::path _spill_path(uint64_t key) const;
+    void _lru_unlink(Entry *entry);
+    void _lru_push_front(Entry *entry);
+    // Unlink least recently used entries past the budget, under the lock
+    [[nodiscard]] luisa::vector<luisa::unique_ptr<Entry>> _pick_victims();
+    // Write victims to disk and release them, outside the lock
+    void _spill_victims(luisa::vector<luisa::unique_ptr<Entry>> &&victims, uint64_t epoch);
+    bool _spill(Entry &entry, luisa::vector<SpilledOutput> &spilled) const;
+
+public:
+    explicit NodeCache(size_t memory_budget, luisa::filesystem::path spill_dir = {});
+    ~NodeCache();
+    NodeCache(NodeCache const &) = delete;
+    NodeCache(NodeCache &&) = delete;
+    [[nodiscard]] static uint64_t hash_bytes(luisa::span<std::byte const> data);
+    [[nodiscard]] static uint64_t combine(uint64_t seed, uint64_t value);
+    [[nodiscard]] static uint64_t make_key(luisa::string_view node_type, uint64_t param_hash, luisa::span<uint64_t const> input_hashes);
+    // Buffers count their descriptor size, opaque objects are not accounted
+    [[nodiscard]] static size_t value_size_bytes(NodeValue const &value);
+    // output_hashes are the content hashes of the outputs, handed back by take
+    void put(uint64_t key, luisa::vector<NodeValue> &&outputs, luisa::vector<uint64_t> output_hashes = {});
+    // Move the cached outputs into dst and drop the entry, reloads spilled entries from disk
+    bool take(uint64_t key, luisa::vector<NodeValue> &dst, luisa::vector<uint64_t> &dst_hashes);
+    bool take(uint64_t key, luisa::vector<NodeValue> &dst) {
+        luisa::vector<uint64_t> hashes;
+        return take(key, dst, hashes);
+    }
+    void set_memory_budget(size_t memory_budget);
+    [[nodiscard]] size_t memory_budget() const { return _memory_budget; }
+    void clear();
+    [[nodiscard]] Stats stats() const;
+};
+}// namespace rbc
@@ -0,0 +1,148 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/spin_mutex.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/core/stl/optional.h>
+#include <luisa/core/stl/string.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/vstl/common.h>
+#include <rbc_core/rc.h>
+#include <rbc_node/node_buffer.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+namespace rbc::ipc {
+struct IMessageSender;
+struct IMessageReceiver;
+struct AsyncTypedMessagePop;
+}// namespace rbc::ipc
+namespace rbc {
+struct RemotePort {
+    // buffer_node: slot is the index of a buffer uploaded with the batch
+    static constexpr uint32_t buffer_node = ~0u;
+    uint32_t node{};
+    uint32_t slot{};
+};
+// A sub-graph of native nodes executed by a worker in one round-trip.
+// Node types are looked up in the worker's NativeNodeRegistry.
+struct RBC_NODE_API RemoteBatch {
+    friend struct RemoteComputeDevice;
+
+private:
+    struct Node {
+        luisa::string type;
+        luisa::vector<RemotePort> inputs;
+    };
+    luisa::vector<luisa::span<std::byte const>> _buffers;
+    luisa::vector<Node> _nodes;
+    luisa::vector<RemotePort> _read_backs;
+
+public:
+    // Host data is borrowed until RemoteComputeDevice::submit returns
+    RemotePort add_buffer(luisa::span<std::byte const> host_data);
+    uint32_t add_node(luisa::string type, luisa::span<RemotePort const> inputs);
+    // Returns the index of the value in RemoteFuture::outputs
+    uint32_t read_back(RemotePort port);
+};
+struct RemoteBatchState : RCBase {
+    std::atomic_bool finished{false};
+    // guards outputs and error until finished is set, waiters sleep on cv
+    std::mutex mtx;
+    std::condition_variable cv;
+    // filled by the receive thread as result chunks arrive
+    luisa::vector<luisa::optional<NodeBuffer>> outputs;
+    luisa::string error;
+};
+struct RBC_NODE_API RemoteFuture {
+    friend struct RemoteComputeDevice;
+
+private:
+    RC<RemoteBatchState> _state;
+
+public:
+    [[nodiscard]] bool finished() const { return _state->finished.load(std::memory_order_acquire); }
+    void wait() const;
+    // Returns false if the batch is still running after timeout
+    [[nodiscard]] bool wait_for(std::chrono::milliseconds timeout) const;
+    // Empty if the batch succeeded
+    [[nodiscard]] luisa::string_view error() const;
+    // Host buffers in read_back order, nullopt if the worker did not produce the value
+    [[nodiscard]] luisa::vector<luisa::optional<NodeBuffer>> take_outputs();
+};
+// Client side of an out-of-process compute worker. Buffers are sent in fixed-size chunks
+// while the worker already consumes them, and several batches may be in flight at once.
+// The worker sends heartbeats, if nothing arrives for disconnect_timeout while batches are
+// pending, or the transport fails, every pending batch finishes with an error.
+struct RBC_NODE_API RemoteComputeDevice {
+private:
+    luisa::unique_ptr<ipc::IMessageSender> _sender;
+    luisa::unique_ptr<ipc::IMessageReceiver> _receiver;
+    luisa::spin_mutex _send_mtx;
+    mutable luisa::spin_mutex _pending_mtx;
+    vstd::HashMap<uint64_t, RC<RemoteBatchState>> _pending;
+    size_t _chunk_size;
+    uint64_t _batch_count{};
+    std::chrono::steady_clock::duration _disconnect_timeout;
+    // steady clock ticks of the last message from the worker, or of the submit that made _pending non-empty
+    std::atomic<std::chrono::steady_clock::rep> _last_alive;
+    std::atomic_bool _running{true};
+    std::thread _receive_thread;
+    void _receive_loop();
+    void _touch_alive();
+    [[nodiscard]] bool _timed_out() const;
+    void _fail_pending(luisa::string_view error);
+
+public:
+    static luisa::string client_topic(luisa::string_view topic);
+    static luisa::string worker_topic(luisa::string_view topic);
+    // Interval of the worker heartbeat, disconnect_timeout should be several times larger
+    static constexpr std::chrono::milliseconds heartbeat_interval{100};
+    explicit RemoteComputeDevice(
+        luisa::string_view topic,
+        size_t chunk_size = 256ull * 1024ull,
+        std::chrono::milliseconds disconnect_timeout = std::chrono::seconds{5});
+    ~RemoteComputeDevice();
+    RemoteComputeDevice(RemoteComputeDevice const &) = delete;
+    RemoteComputeDevice(RemoteComputeDevice &&) = delete;
+    RemoteFuture submit(RemoteBatch const &batch);
+    // Ask the worker process to leave its loop
+    void shutdown_worker();
+    [[nodiscard]] size_t pending_count() const;
+};
+// Worker side, usually hosted by a separate process with the native nodes registered.
+// A heartbeat thread runs for the lifetime of the worker once the client has sent its first message.
+struct RBC_NODE_API RemoteComputeWorker {
+private:
+    struct PendingBatch {
+        luisa::vector<luisa::optional<NodeBuffer>> buffers;
+    };
+    luisa::unique_ptr<ipc::IMessageSender> _sender;
+    luisa::unique_ptr<ipc::IMessageReceiver> _receiver;
+    luisa::unique_ptr<ipc::AsyncTypedMessagePop> _poper;
+    vstd::HashMap<uint64_t, PendingBatch> _pending;
+    size_t _chunk_size;
+    // held across the two pushes of a typed message, the heartbeat thread sends concurrently
+    std::mutex _send_mtx;
+    std::mutex _heartbeat_mtx;
+    std::condition_variable _heartbeat_cv;
+    bool _heartbeat_exit{false};
+    std::atomic_bool _connected{false};
+    std::thread _heartbeat_thread;
+    bool _push(uint8_t type, luisa::span<std::byte const> data);
+    void _heartbeat_loop();
+    void _on_buffer_chunk(luisa::span<std::byte const> data);
+    void _on_batch(luisa::span<std::byte const> data);
+    bool _handle_message();
+
+public:
+    explicit RemoteComputeWorker(luisa::string_view topic, size_t chunk_size = 256ull * 1024ull);
+    ~RemoteComputeWorker();
+    RemoteComputeWorker(RemoteComputeWorker const &) = delete;
+    RemoteComputeWorker(RemoteComputeWorker &&) = delete;
+    // Handle at most one incoming message, returns false once the client asked for shutdown
+    bool tick();
+    // Blocks until shutdown, batches run on the fiber pool of this process
+    void run();
+};
+}// namespace rbc
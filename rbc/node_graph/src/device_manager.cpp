@@ -38,6 +38,14 @@ void DeviceManager::add_device(ComputeDeviceDesc const &device_desc) {
             LUISA_ERROR("Render device can not be added manually.");
         } break;
         case ComputeDeviceType::HOST: break;
+        case ComputeDeviceType::REMOTE: {
+            auto iter = _remote_devices.try_emplace(device_desc.device_index);
+            if (!iter.second) {
+                LUISA_WARNING("Trying to add same device, ignored.");
+                break;
+            }
+            iter.first.value() = luisa::make_unique<RemoteComputeDevice>(remote_device_topic(device_desc.device_index));
+        } break;
         case ComputeDeviceType::COMPUTE_DEVICE: {
             auto iter = _compute_devices.try_emplace(device_desc.device_index);
             if (!iter.second) {
@@ -83,6 +91,8 @@ void DeviceManager::make_synchronize(
     detail::_check_device_desc(dst_device);
     // same device
     if (src_device == dst_device || src_device.type == ComputeDeviceType::HOST) return;
+    // remote work is synchronized through RemoteFuture
+    if (src_device.type == ComputeDeviceType::REMOTE) return;
     if (src_device.type == ComputeDeviceType::RENDER_DEVICE && dst_device.type == ComputeDeviceType::COMPUTE_DEVICE) {
         if (get_compute_device(dst_device.device_index)._can_interop) {
             _sync_render_to_compute(dst_device.device_index);
@@ -154,6 +164,16 @@ void DeviceManager::_sync_render_to_compute(uint32_t compute_index) {
         }
     });
 }
+luisa::string DeviceManager::remote_device_topic(uint32_t index) {
+    return luisa::format("rbc_remote_device_{}", index);
+}
+RemoteComputeDevice &DeviceManager::get_remote_device(uint32_t index) {
+    auto iter = _remote_devices.find(index);
+    if (!iter) [[unlikely]] {
+        LUISA_ERROR("Can not find remote device {}", index);
+    }
+    return *iter.value();
+}
 ComputeDevice &DeviceManager::get_compute_device(uint32_t index) {
     auto iter = _compute_devices.find(index);
     if (!iter) [[unlikely]] {
@@ -232,6 +252,8 @@ NodeBuffer DeviceManager::create_buffer(RC<BufferDescriptor> buffer_desc, Comput
             auto &compute_device = get_compute_device(src_device_desc.device_index);
             node_buffer._buffer = compute_device.device.create_byte_buffer(desc.size_bytes());
         } break;
+        // staged in host memory until it is uploaded with a batch
+        case ComputeDeviceType::REMOTE:
         case ComputeDeviceType::HOST: {
             node_buffer._buffer.reset_as<luisa::vector<std::byte>>();
             auto &vec = node_buffer._buffer.force_get<luisa::vector<std::byte>>();
@@ -241,6 +263,7 @@ NodeBuffer DeviceManager::create_buffer(RC<BufferDescriptor> buffer_desc, Comput
             LUISA_ERROR("Unsupported device {}", luisa::to_string(src_device_desc.type));
             break;
     }
+    return node_buffer;
 }
 ByteBufferView DeviceManager::get_buffer(NodeBuffer const &node_buffer, ComputeDeviceDesc dst_device_desc) {
     detail::_check_device_desc(dst_device_desc);
@@ -0,0 +1,257 @@
+#include <rbc_node/graph_executor.h>
+#include <luisa/core/logging.h>
+#include <algorithm>
+namespace rbc {
+size_t NodeContext::input_count() const {
+    return _executor._nodes[_node]->inputs.size();
+}
+NodeValue const *NodeContext::input(uint32_t slot) const {
+    auto &inputs = _executor._nodes[_node]->inputs;
+    if (slot >= inputs.size() || inputs[slot].node == ~0u) return nullptr;
+    auto &port = inputs[slot];
+    auto &value = _executor._nodes[port.node]->outputs[port.slot];
+    return value.valid() ? &value : nullptr;
+}
+bool NodeContext::take_input(uint32_t slot, NodeValue &dst) {
+    auto &inputs = _executor._nodes[_node]->inputs;
+    if (slot >= inputs.size() || inputs[slot].node == ~0u) return false;
+    auto &port = inputs[slot];
+    auto &src = *_executor._nodes[port.node];
+    // other consumers may still be reading it
+    if (src.output_consumers[port.slot] != 1) return false;
+    auto &value = src.outputs[port.slot];
+    if (!value.valid()) return false;
+    dst = std::move(value);
+    value = NodeValue{};
+    src.outputs_taken = true;
+    return true;
+}
+void NodeContext::set_output(uint32_t slot, NodeValue &&value) {
+    auto &outputs = _executor._nodes[_node]->outputs;
+    LUISA_ASSERT(slot < outputs.size(), "Output slot {} out of range {}.", slot, outputs.size());
+    outputs[slot] = std::move(value);
+}
+void NodeContext::set_output_hash(uint32_t slot, uint64_t hash) {
+    auto &output_hashes = _executor._nodes[_node]->output_hashes;
+    LUISA_ASSERT(slot < output_hashes.size(), "Output slot {} out of range {}.", slot, output_hashes.size());
+    output_hashes[slot] = hash;
+}
+void NodeContext::set_error(luisa::string message) {
+    auto &node = *_executor._nodes[_node];
+    node.status = NodeStatus::Failed;
+    node.error = std::move(message);
+}
+
+GraphExecutor::GraphExecutor() = default;
+GraphExecutor::~GraphExecutor() = default;
+uint32_t GraphExecutor::add_node(luisa::string name, NodeFunc func, uint32_t output_count) {
+    auto &node = _nodes.emplace_back(luisa::make_unique<Node>());
+    node->name = std::move(name);
+    node->func = std::move(func);
+    node->outputs.resize(output_count);
+    node->output_consumers.resize(output_count, 0u);
+    node->output_hashes.resize(output_count, 0u);
+    _compiled = false;
+    return static_cast<uint32_t>(_nodes.size() - 1);
+}
+void GraphExecutor::connect(uint32_t src_node, uint32_t src_slot, uint32_t dst_node, uint32_t dst_slot) {
+    LUISA_ASSERT(src_node < _nodes.size() && dst_node < _nodes.size(), "Invalid node index.");
+    auto &src = *_nodes[src_node];
+    auto &dst = *_nodes[dst_node];
+    LUISA_ASSERT(src_slot < src.outputs.size(), "Output slot {} out of range {}.", src_slot, src.outputs.size());
+    if (dst.inputs.size() <= dst_slot) {
+        dst.inputs.resize(dst_slot + 1);
+    }
+    auto &port = dst.inputs[dst_slot];
+    if (port.node != ~0u) {
+        _nodes[port.node]->output_consumers[port.slot]--;
+    }
+    port = Port{src_node, src_slot};
+    src.output_consumers[src_slot]++;
+    _compiled = false;
+}
+void GraphExecutor::set_cache_key(uint32_t node, luisa::string node_type, uint64_t param_hash) {
+    LUISA_ASSERT(node < _nodes.size(), "Invalid node index.");
+    auto &n = *_nodes[node];
+    n.cache_type = std::move(node_type);
+    n.param_hash = param_hash;
+}
+void GraphExecutor::connect_dependency(uint32_t src_node, uint32_t dst_node) {
+    LUISA_ASSERT(src_node < _nodes.size() && dst_node < _nodes.size(), "Invalid node index.");
+    _nodes[dst_node]->dependencies.emplace_back(src_node);
+    _compiled = false;
+}
+bool GraphExecutor::compile() {
+    _roots.clear();
+    for (auto &node : _nodes) {
+        node->successors.clear();
+        node->predecessor_count = 0;
+    }
+    for (auto i : vstd::range(_nodes.size())) {
+        auto &node = *_nodes[i];
+        auto add_edge = [&](uint32_t src) {
+            auto &successors = _nodes[src]->successors;
+            // several edges between the same pair only count once
+            if (std::find(successors.begin(), successors.end(), static_cast<uint32_t>(i)) != successors.end()) return;
+            successors.emplace_back(static_cast<uint32_t>(i));
+            node.predecessor_count++;
+        };
+        for (auto &port : node.inputs) {
+            if (port.node != ~0u) add_edge(port.node);
+        }
+        for (auto src : node.dependencies) {
+            add_edge(src);
+        }
+    }
+    // Kahn's algorithm, only to reject cycles
+    luisa::vector<uint32_t> in_degree;
+    luisa::vector<uint32_t> stack;
+    in_degree.reserve(_nodes.size());
+    for (auto i : vstd::range(_nodes.size())) {
+        in_degree.emplace_back(_nodes[i]->predecessor_count);
+        if (_nodes[i]->predecessor_count == 0) {
+            _roots.emplace_back(static_cast<uint32_t>(i));
+            stack.emplace_back(static_cast<uint32_t>(i));
+        }
+    }
+    size_t visited = 0;
+    while (!stack.empty()) {
+        auto i = stack.back();
+        stack.pop_back();
+        visited++;
+        for (auto s : _nodes[i]->successors) {
+            if (--in_degree[s] == 0) stack.emplace_back(s);
+        }
+    }
+    if (visited != _nodes.size()) {
+        LUISA_WARNING("Node graph has a cycle, {} of {} nodes reachable.", visited, _nodes.size());
+        _roots.clear();
+        return false;
+    }
+    _compiled = true;
+    return true;
+}
+bool GraphExecutor::_fetch_cached(Node &node) {
+    if (!_cache || node.cache_type.empty()) return false;
+    luisa::vector<uint64_t> input_hashes;
+    input_hashes.reserve(node.inputs.size());
+    for (auto &port : node.inputs) {
+        if (port.node == ~0u) {
+            input_hashes.emplace_back(0);
+            continue;
+        }
+        auto hash = _nodes[port.node]->output_hashes[port.slot];
+        // unknown upstream content, can not be memoized
+        if (hash == 0) return false;
+        input_hashes.emplace_back(hash);
+    }
+    node.cache_key = NodeCache::make_key(node.cache_type, node.param_hash, input_hashes);
+    auto output_count = node.output_hashes.size();
+    if (!_cache->take(node.cache_key, node.outputs, node.output_hashes)) return false;
+    // hashes set on the miss come back with the outputs, the rest fall back to the key
+    node.outputs.resize(output_count);
+    node.output_hashes.resize(output_count, 0u);
+    node.from_cache = true;
+    return true;
+}
+void GraphExecutor::_run_node(uint32_t index, luisa::fiber::counter &counter) {
+    auto &node = *_nodes[index];
+    if (node.upstream_failed.load(std::memory_order_acquire)) {
+        node.status = NodeStatus::Skipped;
+    } else {
+        node.timing.start_ms = _clock.toc();
+        if (_fetch_cached(node)) {
+            node.status = NodeStatus::Completed;
+        } else {
+            NodeContext ctx{*this, index};
+            node.func(ctx);
+            if (node.status == NodeStatus::Pending) {
+                node.status = NodeStatus::Completed;
+            }
+        }
+        node.timing.duration_ms = _clock.toc() - node.timing.start_ms;
+        if (node.cache_key != 0 && node.status == NodeStatus::Completed) {
+            for (auto i : vstd::range(node.output_hashes.size())) {
+                auto &hash = node.output_hashes[i];
+                if (hash == 0) hash = NodeCache::combine(node.cache_key, i);
+            }
+        }
+    }
+    bool failed = node.status != NodeStatus::Completed;
+    for (auto s : node.successors) {
+        auto &successor = *_nodes[s];
+        if (failed) {
+            successor.upstream_failed.store(true, std::memory_order_release);
+        }
+        if (successor.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            luisa::fiber::schedule([this, s, &counter]() {
+                _run_node(s, counter);
+            });
+        }
+    }
+    counter.done();
+}
+void GraphExecutor::execute() {
+    if (!_compiled && !compile()) return;
+    clear_values();
+    for (auto &node : _nodes) {
+        node->pending = node->predecessor_count;
+        node->upstream_failed = false;
+        node->status = NodeStatus::Pending;
+        node->error.clear();
+        node->timing = {};
+        node->cache_key = 0;
+        node->outputs_taken = false;
+        node->from_cache = false;
+        std::fill(node->output_hashes.begin(), node->output_hashes.end(), 0ull);
+    }
+    luisa::fiber::counter counter;
+    counter.add(static_cast<uint32_t>(_nodes.size()));
+    _clock.tic();
+    for (auto i : _roots) {
+        luisa::fiber::schedule([this, i, &counter]() {
+            _run_node(i, counter);
+        });
+    }
+    counter.wait();
+    _last_execute_ms = _clock.toc();
+}
+void GraphExecutor::clear_values() {
+    for (auto &node : _nodes) {
+        // a consumer moved part of the outputs away, the rest is incomplete
+        if (_cache && node->cache_key != 0 && node->status == NodeStatus::Completed && !node->outputs_taken) {
+            auto output_count = node->outputs.size();
+            _cache->put(node->cache_key, std::move(node->outputs), node->output_hashes);
+            node->outputs.clear();
+            node->outputs.resize(output_count);
+            node->cache_key = 0;
+            continue;
+        }
+        for (auto &i : node->outputs) {
+            i = NodeValue{};
+        }
+    }
+}
+NodeValue const *GraphExecutor::output(uint32_t node, uint32_t slot) const {
+    auto &outputs = _nodes[node]->outputs;
+    if (slot >= outputs.size() || !outputs[slot].valid()) return nullptr;
+    return &outputs[slot];
+}
+NativeNodeRegistry &NativeNodeRegistry::instance() {
+    static NativeNodeRegistry registry;
+    return registry;
+}
+void NativeNodeRegistry::register_node(luisa::string name, NodeFunc func, uint32_t output_count) {
+    std::lock_guard lck{_mtx};
+    auto iter = _entries.try_emplace(std::move(name), Entry{func, output_count});
+    if (!iter.second) {
+        LUISA_WARNING("Native node {} already registered, ignored.", iter.first.key());
+    }
+}
+NativeNodeRegistry::Entry NativeNodeRegistry::find(luisa::string_view name) const {
+    std::lock_guard lck{_mtx};
+    auto iter = _entries.find(name);
+    if (!iter) return {};
+    return iter.value();
+}
+}// namespace rbc
@@ -7,6 +7,25 @@ NodeBuffer::NodeBuffer(RC<BufferDescriptor> &&buffer_desc,
     : _buffer_desc(std::move(buffer_desc)),
       _src_device_desc(src_device_desc),
       _dst_device_desc(dst_device_desc) {}
+luisa::span<std::byte> NodeBuffer::host_data() {
+    if (auto vec = _buffer.try_get<luisa::vector<std::byte>>()) {
+        return *vec;
+    }
+    return {};
+}
+luisa::span<std::byte const> NodeBuffer::host_data() const {
+    if (auto vec = _buffer.try_get<luisa::vector<std::byte>>()) {
+        return *vec;
+    }
+    return {};
+}
+NodeBuffer NodeBuffer::create_host(size_t size_bytes) {
+    ComputeDeviceDesc host_desc{ComputeDeviceType::HOST, ~0u};
+    NodeBuffer node_buffer{RC<BufferDescriptor>{new BufferDescriptor{nullptr, size_bytes}}, host_desc, host_desc};
+    node_buffer._buffer.reset_as<luisa::vector<std::byte>>();
+    node_buffer._buffer.force_get<luisa::vector<std::byte>>().push_back_uninitialized(size_bytes);
+    return node_buffer;
+}
 NodeBuffer::~NodeBuffer() {
     if (_destruct) {
         _destruct();
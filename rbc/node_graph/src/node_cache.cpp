@@ -0,0 +1,235 @@
+#include <rbc_node/node_cache.h>
+#include <rbc_core/binary_file_writer.h>
+#include <luisa/core/binary_io.h>
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/hash.h>
+namespace rbc {
+NodeCache::NodeCache(size_t memory_budget, luisa::filesystem::path spill_dir)
+    : _spill_dir(std::move(spill_dir)),
+      _memory_budget(memory_budget) {
+    if (!_spill_dir.empty()) {
+        std::error_code ec;
+        luisa::filesystem::create_directories(_spill_dir, ec);
+        if (ec) [[unlikely]] {
+            LUISA_WARNING("Can not create node cache spill directory {}, spilling disabled.", luisa::to_string(_spill_dir));
+            _spill_dir.clear();
+        }
+    }
+}
+NodeCache::~NodeCache() {
+    clear();
+}
+uint64_t NodeCache::hash_bytes(luisa::span<std::byte const> data) {
+    return luisa::hash64(data.data(), data.size_bytes(), luisa::hash64_default_seed);
+}
+uint64_t NodeCache::combine(uint64_t seed, uint64_t value) {
+    return luisa::hash64(&value, sizeof(value), seed);
+}
+uint64_t NodeCache::make_key(luisa::string_view node_type, uint64_t param_hash, luisa::span<uint64_t const> input_hashes) {
+    auto key = combine(luisa::hash64(node_type.data(), node_type.size(), luisa::hash64_default_seed), param_hash);
+    key = combine(key, input_hashes.size());
+    return luisa::hash64(input_hashes.data(), input_hashes.size_bytes(), key);
+}
+size_t NodeCache::value_size_bytes(NodeValue const &value) {
+    if (auto buffer = value.try_get<NodeBuffer>()) {
+        return buffer->buffer_desc().size_bytes();
+    }
+    return 0;
+}
+luisa::filesystem::path NodeCache::_spill_path(uint64_t key) const {
+    return _spill_dir / luisa::format("{:016x}.rbcnc", key);
+}
+void NodeCache::_lru_unlink(Entry *entry) {
+    (entry->lru_prev ? entry->lru_prev->lru_next : _lru_head) = entry->lru_next;
+    (entry->lru_next ? entry->lru_next->lru_prev : _lru_tail) = entry->lru_prev;
+    entry->lru_prev = nullptr;
+    entry->lru_next = nullptr;
+}
+void NodeCache::_lru_push_front(Entry *entry) {
+    entry->lru_prev = nullptr;
+    entry->lru_next = _lru_head;
+    (_lru_head ? _lru_head->lru_prev : _lru_tail) = entry;
+    _lru_head = entry;
+}
+bool NodeCache::_spill(Entry &entry, luisa::vector<SpilledOutput> &spilled) const {
+    // only plain host memory can be written back without a device round-trip
+    for (auto &i : entry.outputs) {
+        if (!i.valid()) continue;
+        auto buffer = i.try_get<NodeBuffer>();
+        if (!buffer || buffer->is_interop() || !buffer->_buffer.is_type_of<luisa::vector<std::byte>>()) {
+            return false;
+        }
+    }
+    BinaryFileWriter writer{luisa::to_string(_spill_path(entry.key))};
+    if (!writer._file) [[unlikely]] {
+        return false;
+    }
+    spilled.reserve(entry.outputs.size());
+    for (auto i : vstd::range(entry.outputs.size())) {
+        auto &output = spilled.emplace_back();
+        output.hash = i < entry.output_hashes.size() ? entry.output_hashes[i] : 0;
+        auto &value = entry.outputs[i];
+        if (!value.valid()) continue;
+        auto &buffer = value.force_get<NodeBuffer>();
+        auto &data = buffer._buffer.force_get<luisa::vector<std::byte>>();
+        writer.write(data);
+        output.empty = false;
+        output.buffer_desc = std::move(buffer._buffer_desc);
+        output.src_device_desc = buffer._src_device_desc;
+        output.dst_device_desc = buffer._dst_device_desc;
+        output.size_bytes = data.size();
+    }
+    return true;
+}
+luisa::vector<luisa::unique_ptr<NodeCache::Entry>> NodeCache::_pick_victims() {
+    luisa::vector<luisa::unique_ptr<Entry>> victims;
+    while (_memory_bytes > _memory_budget && _lru_tail) {
+        auto entry = _lru_tail;
+        _lru_unlink(entry);
+        auto iter = _entries.find(entry->key);
+        _memory_bytes -= entry->size_bytes;
+        _stats.evictions++;
+        victims.emplace_back(std::move(iter.value()));
+        _entries.remove(iter);
+    }
+    return victims;
+}
+void NodeCache::_spill_victims(luisa::vector<luisa::unique_ptr<Entry>> &&victims, uint64_t epoch) {
+    if (_spill_dir.empty()) return;
+    for (auto &victim : victims) {
+        luisa::vector<SpilledOutput> spilled;
+        if (!_spill(*victim, spilled)) continue;
+        std::lock_guard lck{_mtx};
+        // cleared, or put again while the file was written
+        if (epoch != _epoch || _entries.find(victim->key)) {
+            std::error_code ec;
+            luisa::filesystem::remove(_spill_path(victim->key), ec);
+            continue;
+        }
+        _spilled.force_emplace(victim->key, std::move(spilled));
+        _stats.spills++;
+    }
+}
+void NodeCache::put(uint64_t key, luisa::vector<NodeValue> &&outputs, luisa::vector<uint64_t> output_hashes) {
+    size_t size_bytes = 0;
+    for (auto &i : outputs) {
+        if (i.valid()) size_bytes += value_size_bytes(i);
+    }
+    luisa::vector<luisa::unique_ptr<Entry>> victims;
+    uint64_t epoch;
+    {
+        std::lock_guard lck{_mtx};
+        if (auto spilled = _spilled.find(key)) {
+            _spilled.remove(spilled);
+            std::error_code ec;
+            luisa::filesystem::remove(_spill_path(key), ec);
+        }
+        auto iter = _entries.try_emplace(key);
+        auto &entry = iter.first.value();
+        if (iter.second) {
+            entry = luisa::make_unique<Entry>();
+            entry->key = key;
+        } else {
+            _memory_bytes -= entry->size_bytes;
+            _lru_unlink(entry.get());
+        }
+        entry->outputs = std::move(outputs);
+        entry->output_hashes = std::move(output_hashes);
+        entry->size_bytes = size_bytes;
+        _lru_push_front(entry.get());
+        _memory_bytes += size_bytes;
+        victims = _pick_victims();
+        epoch = _epoch;
+    }
+    _spill_victims(std::move(victims), epoch);
+}
+bool NodeCache::take(uint64_t key, luisa::vector<NodeValue> &dst, luisa::vector<uint64_t> &dst_hashes) {
+    luisa::vector<SpilledOutput> spilled;
+    {
+        std::lock_guard lck{_mtx};
+        if (auto iter = _entries.find(key)) {
+            auto &entry = *iter.value();
+            dst = std::move(entry.outputs);
+            dst_hashes = std::move(entry.output_hashes);
+            _memory_bytes -= entry.size_bytes;
+            _lru_unlink(&entry);
+            _entries.remove(iter);
+            _stats.hits++;
+            return true;
+        }
+        auto iter = _spilled.find(key);
+        if (!iter) {
+            _stats.misses++;
+            return false;
+        }
+        spilled = std::move(iter.value());
+        _spilled.remove(iter);
+    }
+    // file IO happens outside the lock, the entry is already unlinked
+    auto path = _spill_path(key);
+    bool success;
+    {
+        luisa::BinaryFileStream file_stream{luisa::to_string(path)};
+        success = file_stream.valid();
+        if (success) {
+            dst.clear();
+            dst.reserve(spilled.size());
+            dst_hashes.clear();
+            dst_hashes.reserve(spilled.size());
+            for (auto &i : spilled) {
+                auto &value = dst.emplace_back();
+                dst_hashes.emplace_back(i.hash);
+                if (i.empty) continue;
+                NodeBuffer buffer{std::move(i.buffer_desc), i.src_device_desc, i.dst_device_desc};
+                buffer._buffer.reset_as<luisa::vector<std::byte>>();
+                auto &data = buffer._buffer.force_get<luisa::vector<std::byte>>();
+                data.push_back_uninitialized(i.size_bytes);
+                file_stream.read(data);
+                value = NodeValue{std::move(buffer)};
+            }
+        }
+    }
+    std::error_code ec;
+    luisa::filesystem::remove(path, ec);
+    std::lock_guard lck{_mtx};
+    if (success) {
+        _stats.hits++;
+        _stats.spill_hits++;
+    } else {
+        LUISA_WARNING("Node cache spill file {} lost.", luisa::to_string(path));
+        _stats.misses++;
+    }
+    return success;
+}
+void NodeCache::set_memory_budget(size_t memory_budget) {
+    luisa::vector<luisa::unique_ptr<Entry>> victims;
+    uint64_t epoch;
+    {
+        std::lock_guard lck{_mtx};
+        _memory_budget = memory_budget;
+        victims = _pick_victims();
+        epoch = _epoch;
+    }
+    _spill_victims(std::move(victims), epoch);
+}
+void NodeCache::clear() {
+    std::lock_guard lck{_mtx};
+    _entries.clear();
+    _lru_head = nullptr;
+    _lru_tail = nullptr;
+    _memory_bytes = 0;
+    _epoch++;
+    for (auto &&i : _spilled) {
+        std::error_code ec;
+        luisa::filesystem::remove(_spill_path(i.first), ec);
+    }
+    _spilled.clear();
+}
+NodeCache::Stats NodeCache::stats() const {
+    std::lock_guard lck{_mtx};
+    auto stats = _stats;
+    stats.memory_bytes = _memory_bytes;
+    stats.entry_count = _entries.size();
+    return stats;
+}
+}// namespace rbc
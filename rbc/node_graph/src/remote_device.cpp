@@ -0,0 +1,493 @@
+#include <rbc_node/remote_device.h>
+#include <rbc_node/graph_executor.h>
+#include <rbc_ipc/message_manager.h>
+#include <luisa/core/logging.h>
+#include <chrono>
+namespace rbc::remote_detail {
+enum struct MessageType : uint8_t {
+    // client -> worker
+    BufferChunk,
+    Batch,
+    Shutdown,
+    // worker -> client
+    ResultChunk,
+    BatchDone,
+    Heartbeat
+};
+struct ChunkHeader {
+    uint64_t batch_id;
+    uint64_t offset;
+    uint64_t total_size;
+    uint32_t index;
+    uint32_t padding;
+};
+struct BatchHeader {
+    uint64_t batch_id;
+    uint32_t buffer_count;
+    uint32_t node_count;
+    uint32_t read_back_count;
+    uint32_t padding;
+};
+struct DoneHeader {
+    uint64_t batch_id;
+    uint32_t output_count;
+    uint32_t error_size;
+};
+struct Writer {
+    luisa::vector<std::byte> data;
+    void push(luisa::span<std::byte const> bytes) {
+        auto size = data.size();
+        data.push_back_uninitialized(bytes.size());
+        std::memcpy(data.data() + size, bytes.data(), bytes.size());
+    }
+    template<typename T>
+    void push(T const &t) {
+        push(luisa::span{reinterpret_cast<std::byte const *>(&t), sizeof(T)});
+    }
+};
+struct Reader {
+    luisa::span<std::byte const> data;
+    luisa::span<std::byte const> pop_bytes(size_t size) {
+        LUISA_ASSERT(data.size() >= size, "Remote message truncated.");
+        auto r = data.subspan(0, size);
+        data = data.subspan(size);
+        return r;
+    }
+    template<typename T>
+    T pop() {
+        T t;
+        std::memcpy(&t, pop_bytes(sizeof(T)).data(), sizeof(T));
+        return t;
+    }
+};
+// an empty buffer still sends one chunk so the receiver learns about it
+template<typename Push>
+static bool send_chunks(
+    Push const &push,
+    MessageType type,
+    uint64_t batch_id,
+    uint32_t index,
+    luisa::span<std::byte const> data,
+    size_t chunk_size,
+    Writer &writer) {
+    size_t offset = 0;
+    do {
+        auto size = std::min(chunk_size, data.size() - offset);
+        writer.data.clear();
+        writer.push(ChunkHeader{batch_id, offset, data.size(), index, 0});
+        writer.push(data.subspan(offset, size));
+        if (!push(type, writer.data)) return false;
+        offset += size;
+    } while (offset < data.size());
+    return true;
+}
+// chunks are written in place, the buffer is allocated by the first one
+static void receive_chunk(
+    luisa::vector<luisa::optional<NodeBuffer>> &buffers,
+    ChunkHeader const &header,
+    luisa::span<std::byte const> payload) {
+    if (buffers.size() <= header.index) {
+        buffers.resize(header.index + 1);
+    }
+    auto &buffer = buffers[header.index];
+    if (!buffer) {
+        buffer.emplace(NodeBuffer::create_host(header.total_size));
+    }
+    auto dst = buffer->host_data();
+    LUISA_ASSERT(header.offset + payload.size() <= dst.size(), "Remote buffer chunk out of range.");
+    std::memcpy(dst.data() + header.offset, payload.data(), payload.size());
+}
+// the header limits a typed message to 24 bits of payload
+static size_t check_chunk_size(size_t chunk_size) {
+    constexpr size_t max_chunk_size = (1u << 24u) - 1u - sizeof(ChunkHeader);
+    LUISA_ASSERT(chunk_size > 0 && chunk_size <= max_chunk_size, "Remote chunk size {} out of range.", chunk_size);
+    return chunk_size;
+}
+struct IdleWait {
+    uint32_t count{};
+    void operator()() {
+        // spin shortly while messages are streaming, then back off
+        if (++count < 1024) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+};
+// returns false if the batch was already finished, e.g. failed by a disconnect
+template<typename Fill>
+static bool finish_state(RemoteBatchState &state, Fill &&fill) {
+    {
+        std::lock_guard lck{state.mtx};
+        if (state.finished.load(std::memory_order_relaxed)) return false;
+        fill();
+        state.finished.store(true, std::memory_order_release);
+    }
+    state.cv.notify_all();
+    return true;
+}
+}// namespace rbc::remote_detail
+
+namespace rbc {
+using namespace remote_detail;
+RemotePort RemoteBatch::add_buffer(luisa::span<std::byte const> host_data) {
+    _buffers.emplace_back(host_data);
+    return RemotePort{RemotePort::buffer_node, static_cast<uint32_t>(_buffers.size() - 1)};
+}
+uint32_t RemoteBatch::add_node(luisa::string type, luisa::span<RemotePort const> inputs) {
+    auto &node = _nodes.emplace_back();
+    node.type = std::move(type);
+    node.inputs = {inputs.begin(), inputs.end()};
+    return static_cast<uint32_t>(_nodes.size() - 1);
+}
+uint32_t RemoteBatch::read_back(RemotePort port) {
+    _read_backs.emplace_back(port);
+    return static_cast<uint32_t>(_read_backs.size() - 1);
+}
+
+void RemoteFuture::wait() const {
+    if (finished()) return;
+    std::unique_lock lck{_state->mtx};
+    _state->cv.wait(lck, [&] { return finished(); });
+}
+bool RemoteFuture::wait_for(std::chrono::milliseconds timeout) const {
+    if (finished()) return true;
+    std::unique_lock lck{_state->mtx};
+    return _state->cv.wait_for(lck, timeout, [&] { return finished(); });
+}
+luisa::string_view RemoteFuture::error() const {
+    wait();
+    return _state->error;
+}
+luisa::vector<luisa::optional<NodeBuffer>> RemoteFuture::take_outputs() {
+    wait();
+    return std::move(_state->outputs);
+}
+
+luisa::string RemoteComputeDevice::client_topic(luisa::string_view topic) {
+    return luisa::format("{}_client", topic);
+}
+luisa::string RemoteComputeDevice::worker_topic(luisa::string_view topic) {
+    return luisa::format("{}_worker", topic);
+}
+RemoteComputeDevice::RemoteComputeDevice(luisa::string_view topic, size_t chunk_size, std::chrono::milliseconds disconnect_timeout)
+    : _sender(ipc::IMessageSender::create(client_topic(topic).c_str(), ipc::EMessageQueueBackend::IPC)),
+      _receiver(ipc::IMessageReceiver::create(worker_topic(topic).c_str(), ipc::EMessageQueueBackend::IPC)),
+      _chunk_size(check_chunk_size(chunk_size)),
+      _disconnect_timeout(disconnect_timeout) {
+    LUISA_ASSERT(disconnect_timeout > heartbeat_interval, "Remote disconnect timeout must exceed the heartbeat interval.");
+    _touch_alive();
+    _receive_thread = std::thread{[this]() { _receive_loop(); }};
+}
+RemoteComputeDevice::~RemoteComputeDevice() {
+    _running = false;
+    _receive_thread.join();
+    _fail_pending("Remote device destroyed.");
+}
+void RemoteComputeDevice::_touch_alive() {
+    _last_alive.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+void RemoteComputeDevice::_fail_pending(luisa::string_view error) {
+    luisa::vector<RC<RemoteBatchState>> states;
+    {
+        std::lock_guard lck{_pending_mtx};
+        states.reserve(_pending.size());
+        for (auto &&i : _pending) {
+            states.emplace_back(std::move(i.second));
+        }
+        _pending.clear();
+    }
+    for (auto &state : states) {
+        finish_state(*state, [&] { state->error = error; });
+    }
+}
+bool RemoteComputeDevice::_timed_out() const {
+    auto expired = [&] {
+        auto last_alive = std::chrono::steady_clock::time_point{std::chrono::steady_clock::duration{_last_alive.load(std::memory_order_relaxed)}};
+        return std::chrono::steady_clock::now() - last_alive > _disconnect_timeout;
+    };
+    if (!expired()) return false;
+    // submit refreshes the clock under the same lock when the first batch goes pending
+    std::lock_guard lck{_pending_mtx};
+    return _pending.size() > 0 && expired();
+}
+size_t RemoteComputeDevice::pending_count() const {
+    std::lock_guard lck{_pending_mtx};
+    return _pending.size();
+}
+void RemoteComputeDevice::_receive_loop() {
+    ipc::AsyncTypedMessagePop poper;
+    poper.reset(_receiver.get());
+    IdleWait idle;
+    while (_running.load(std::memory_order_relaxed)) {
+        if (poper.next_step()) {
+            idle();
+            if (_timed_out()) [[unlikely]] {
+                LUISA_WARNING("Remote worker sent nothing for {} ms, failing pending batches.", std::chrono::duration_cast<std::chrono::milliseconds>(_disconnect_timeout).count());
+                _fail_pending("Remote worker disconnected.");
+            }
+            continue;
+        }
+        idle.count = 0;
+        _touch_alive();
+        auto type = static_cast<MessageType>(poper.id());
+        auto data = poper.steal_data();
+        poper.reset(_receiver.get());
+        Reader reader{data};
+        switch (type) {
+            case MessageType::ResultChunk: {
+                auto header = reader.pop<ChunkHeader>();
+                RC<RemoteBatchState> state;
+                {
+                    std::lock_guard lck{_pending_mtx};
+                    if (auto iter = _pending.find(header.batch_id)) {
+                        state = iter.value();
+                    }
+                }
+                // outputs are only written by this thread, the lock orders it against a disconnect failing the batch
+                if (state) {
+                    std::lock_guard state_lck{state->mtx};
+                    if (!state->finished.load(std::memory_order_relaxed)) {
+                        receive_chunk(state->outputs, header, reader.data);
+                    }
+                }
+            } break;
+            case MessageType::BatchDone: {
+                auto header = reader.pop<DoneHeader>();
+                RC<RemoteBatchState> state;
+                {
+                    std::lock_guard lck{_pending_mtx};
+                    if (auto iter = _pending.find(header.batch_id)) {
+                        state = std::move(iter.value());
+                        _pending.remove(iter);
+                    }
+                }
+                if (!state) break;
+                auto error = reader.pop_bytes(header.error_size);
+                finish_state(*state, [&] {
+                    state->outputs.resize(header.output_count);
+                    state->error = luisa::string{reinterpret_cast<char const *>(error.data()), error.size()};
+                });
+            } break;
+            case MessageType::Heartbeat: break;
+            default:
+                LUISA_WARNING("Unexpected remote message {}.", luisa::to_underlying(type));
+                break;
+        }
+    }
+}
+RemoteFuture RemoteComputeDevice::submit(RemoteBatch const &batch) {
+    RemoteFuture future;
+    future._state = RC<RemoteBatchState>::New();
+    std::lock_guard lck{_send_mtx};
+    auto batch_id = _batch_count++;
+    {
+        std::lock_guard pending_lck{_pending_mtx};
+        // the disconnect timeout counts from the oldest pending submit, not from an idle period before it
+        if (_pending.size() == 0) {
+            _touch_alive();
+        }
+        _pending.force_emplace(batch_id, future._state);
+    }
+    auto push = [&](MessageType type, luisa::span<std::byte const> bytes) {
+        return _sender->push(luisa::to_underlying(type), bytes);
+    };
+    Writer writer;
+    bool success = true;
+    // buffers go first, the worker stages them while the rest is still in flight
+    for (auto i : vstd::range(batch._buffers.size())) {
+        success &= send_chunks(push, MessageType::BufferChunk, batch_id, static_cast<uint32_t>(i), batch._buffers[i], _chunk_size, writer);
+        if (!success) break;
+    }
+    if (success) {
+        writer.data.clear();
+        writer.push(BatchHeader{
+            batch_id,
+            static_cast<uint32_t>(batch._buffers.size()),
+            static_cast<uint32_t>(batch._nodes.size()),
+            static_cast<uint32_t>(batch._read_backs.size()),
+            0});
+        for (auto &node : batch._nodes) {
+            writer.push(static_cast<uint32_t>(node.type.size()));
+            writer.push(luisa::span{reinterpret_cast<std::byte const *>(node.type.data()), node.type.size()});
+            writer.push(static_cast<uint32_t>(node.inputs.size()));
+            writer.push(luisa::as_bytes(luisa::span<RemotePort const>{node.inputs}));
+        }
+        writer.push(luisa::as_bytes(luisa::span<RemotePort const>{batch._read_backs}));
+        success = push(MessageType::Batch, writer.data);
+    }
+    // a broken transport loses every batch in flight, not only this one
+    if (!success) [[unlikely]] {
+        _fail_pending("Remote worker disconnected.");
+    }
+    return future;
+}
+void RemoteComputeDevice::shutdown_worker() {
+    std::lock_guard lck{_send_mtx};
+    if (!_sender->push(luisa::to_underlying(MessageType::Shutdown), {})) [[unlikely]] {
+        _fail_pending("Remote worker disconnected.");
+    }
+}
+
+RemoteComputeWorker::RemoteComputeWorker(luisa::string_view topic, size_t chunk_size)
+    : _sender(ipc::IMessageSender::create(RemoteComputeDevice::worker_topic(topic).c_str(), ipc::EMessageQueueBackend::IPC)),
+      _receiver(ipc::IMessageReceiver::create(RemoteComputeDevice::client_topic(topic).c_str(), ipc::EMessageQueueBackend::IPC)),
+      _poper(luisa::make_unique<ipc::AsyncTypedMessagePop>()),
+      _chunk_size(check_chunk_size(chunk_size)) {
+    _poper->reset(_receiver.get());
+    _heartbeat_thread = std::thread{[this]() { _heartbeat_loop(); }};
+}
+RemoteComputeWorker::~RemoteComputeWorker() {
+    {
+        std::lock_guard lck{_heartbeat_mtx};
+        _heartbeat_exit = true;
+    }
+    _heartbeat_cv.notify_all();
+    _heartbeat_thread.join();
+}
+bool RemoteComputeWorker::_push(uint8_t type, luisa::span<std::byte const> data) {
+    std::lock_guard lck{_send_mtx};
+    return _sender->push(type, data);
+}
+void RemoteComputeWorker::_heartbeat_loop() {
+    std::unique_lock lck{_heartbeat_mtx};
+    while (!_heartbeat_cv.wait_for(lck, RemoteComputeDevice::heartbeat_interval, [&] { return _heartbeat_exit; })) {
+        // the first push blocks until a receiver exists, so stay quiet until the client talked to us
+        if (!_connected.load(std::memory_order_acquire)) continue;
+        _push(luisa::to_underlying(MessageType::Heartbeat), {});
+    }
+}
+void RemoteComputeWorker::_on_buffer_chunk(luisa::span<std::byte const> data) {
+    Reader reader{data};
+    auto header = reader.pop<ChunkHeader>();
+    auto &batch = _pending.try_emplace(header.batch_id).first.value();
+    receive_chunk(batch.buffers, header, reader.data);
+}
+void RemoteComputeWorker::_on_batch(luisa::span<std::byte const> data) {
+    Reader reader{data};
+    auto header = reader.pop<BatchHeader>();
+    PendingBatch batch;
+    if (auto iter = _pending.find(header.batch_id)) {
+        batch = std::move(iter.value());
+        _pending.remove(iter);
+    }
+    batch.buffers.resize(header.buffer_count);
+
+    GraphExecutor executor;
+    luisa::vector<uint32_t> output_counts;
+    luisa::string error;
+    for (auto i : vstd::range(header.buffer_count)) {
+        executor.add_node(
+            "buffer",
+            [&buffer = batch.buffers[i]](NodeContext &ctx) {
+                if (buffer) {
+                    ctx.set_output(0, NodeValue{std::move(*buffer)});
+                }
+            },
+            1);
+        output_counts.emplace_back(1);
+    }
+    auto node_index = [&](RemotePort port) {
+        return port.node == RemotePort::buffer_node ? port.slot : header.buffer_count + port.node;
+    };
+    // a port may only reference buffers or earlier nodes, so the batch can not contain a cycle
+    auto valid_port = [&](RemotePort port, uint32_t node_count) {
+        if (port.node == RemotePort::buffer_node) return port.slot < header.buffer_count;
+        return port.node < node_count && port.slot < output_counts[node_index(port)];
+    };
+    auto &registry = NativeNodeRegistry::instance();
+    for (auto i : vstd::range(header.node_count)) {
+        auto type_bytes = reader.pop_bytes(reader.pop<uint32_t>());
+        luisa::string_view type{reinterpret_cast<char const *>(type_bytes.data()), type_bytes.size()};
+        auto input_count = reader.pop<uint32_t>();
+        auto entry = registry.find(type);
+        if (!entry.func && error.empty()) {
+            error = luisa::format("Native node type {} not registered.", type);
+        }
+        uint32_t index;
+        if (entry.func) {
+            index = executor.add_node(luisa::string{type}, [func = entry.func](NodeContext &ctx) { func(ctx); }, entry.output_count);
+        } else {
+            index = executor.add_node(luisa::string{type}, [](NodeContext &) {}, 0);
+        }
+        output_counts.emplace_back(entry.output_count);
+        for (auto slot : vstd::range(input_count)) {
+            auto port = reader.pop<RemotePort>();
+            if (!error.empty()) continue;
+            if (!valid_port(port, static_cast<uint32_t>(i))) {
+                error = luisa::format("Node {} input {} references an invalid port.", type, slot);
+                continue;
+            }
+            executor.connect(node_index(port), port.slot, index, static_cast<uint32_t>(slot));
+        }
+    }
+    luisa::vector<RemotePort> read_backs;
+    read_backs.resize(header.read_back_count);
+    for (auto &i : read_backs) {
+        i = reader.pop<RemotePort>();
+    }
+    if (error.empty()) {
+        if (executor.compile()) {
+            executor.execute();
+        }
+        for (auto i : vstd::range(executor.node_count())) {
+            auto status = executor.status(static_cast<uint32_t>(i));
+            if (status == NodeStatus::Failed) {
+                error = luisa::format("Node {} failed: {}", executor.node_name(static_cast<uint32_t>(i)), executor.error(static_cast<uint32_t>(i)));
+                break;
+            }
+        }
+    }
+
+    auto push = [&](MessageType type, luisa::span<std::byte const> bytes) {
+        return _push(luisa::to_underlying(type), bytes);
+    };
+    Writer writer;
+    for (auto i : vstd::range(read_backs.size())) {
+        auto port = read_backs[i];
+        if (!error.empty() || !valid_port(port, header.node_count)) continue;
+        auto value = executor.output(node_index(port), port.slot);
+        auto buffer = value ? value->try_get<NodeBuffer>() : nullptr;
+        // only host memory can cross the process boundary
+        if (!buffer || buffer->src_device_desc().type != ComputeDeviceType::HOST) continue;
+        if (!send_chunks(push, MessageType::ResultChunk, header.batch_id, static_cast<uint32_t>(i), buffer->host_data(), _chunk_size, writer)) [[unlikely]] {
+            LUISA_WARNING("Remote client disconnected.");
+            return;
+        }
+    }
+    writer.data.clear();
+    writer.push(DoneHeader{header.batch_id, header.read_back_count, static_cast<uint32_t>(error.size())});
+    writer.push(luisa::span{reinterpret_cast<std::byte const *>(error.data()), error.size()});
+    push(MessageType::BatchDone, writer.data);
+}
+bool RemoteComputeWorker::_handle_message() {
+    _connected.store(true, std::memory_order_release);
+    auto type = static_cast<MessageType>(_poper->id());
+    auto data = _poper->steal_data();
+    _poper->reset(_receiver.get());
+    switch (type) {
+        case MessageType::BufferChunk: _on_buffer_chunk(data); break;
+        case MessageType::Batch: _on_batch(data); break;
+        case MessageType::Shutdown: return false;
+        default:
+            LUISA_WARNING("Unexpected remote message {}.", luisa::to_underlying(type));
+            break;
+    }
+    return true;
+}
+bool RemoteComputeWorker::tick() {
+    if (_poper->next_step()) return true;
+    return _handle_message();
+}
+void RemoteComputeWorker::run() {
+    IdleWait idle;
+    while (true) {
+        if (_poper->next_step()) {
+            idle();
+            continue;
+        }
+        idle.count = 0;
+        if (!_handle_message()) return;
+    }
+}
+}// namespace rbc
@@ -9,7 +9,7 @@ local function rbc_runtime_impl()
         project_kind = 'shared'
     })
     add_defines('RBC_NODE_API=LUISA_DECLSPEC_DLL_EXPORT')
-    add_deps('rbc_runtime')
+    add_deps('rbc_runtime', 'rbc_ipc')
     set_pcxxheader('src/zz_pch.h')
     add_files('src/**.cpp')
 end
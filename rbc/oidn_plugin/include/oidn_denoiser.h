@@ -66,6 +66,7 @@ struct DenoiserExt : public vstd::IOperatorNewBase {
         LDR_LINEAR,
         LDR_SRGB
     };
+    // For CPU denoisers out_device_ptr must point to caller-owned host memory holding the whole image
     struct Image {
         size_t offset{};
         size_t pixel_stride{};
@@ -139,6 +140,10 @@ struct Denoiser : public luisa::enable_shared_from_this<Denoiser> {
     virtual void init(DenoiserExt::DenoiserInput const &input) noexcept = 0;
     virtual void execute(bool async) noexcept = 0;
     virtual void reset() noexcept = 0;
+    // Wait for the last async execute, outputs are valid after this returns
+    virtual void sync() noexcept {}
+    // Denoise cost of the last finished execute, 0 if not measured
+    [[nodiscard]] virtual double ms_per_mpixel() const noexcept { return 0.0; }
     void execute() noexcept { execute(false); }
     virtual ~Denoiser() noexcept = default;
 };
@@ -158,6 +163,15 @@ public:
     explicit DXOidnDenoiserExt(Device const &device) noexcept;
     luisa::shared_ptr<Denoiser> create() noexcept override;
 };
+// Host-image denoiser for headless rendering, no graphics device is required.
+// Frames larger than tile_size are denoised tile by tile, each tile extended by tile_overlap pixels on every side.
+struct CPUOidnDenoiserExt : public DenoiserExtDerive<DenoiserExt::Tag::CPU> {
+    uint32_t tile_size;
+    uint32_t tile_overlap;
+    explicit CPUOidnDenoiserExt(uint32_t tile_size = 1024u, uint32_t tile_overlap = 128u) noexcept
+        : tile_size{tile_size}, tile_overlap{tile_overlap} {}
+    luisa::shared_ptr<Denoiser> create() noexcept override;
+};
 #if defined(_MSC_VER) && !defined(GAME_MODULE_STATIC)
 #ifdef OIDN_EXPORT
 #define OIDN_API LUISA_EXPORT_API
@@ -170,3 +184,5 @@ public:
 
 }// namespace rbc
 OIDN_API rbc::DenoiserExt *rbc_create_oidn(luisa::compute::Device const &device);
+// nullptr if the CPU has no OIDN support
+OIDN_API rbc::DenoiserExt *rbc_create_oidn_cpu(uint32_t tile_size, uint32_t tile_overlap);
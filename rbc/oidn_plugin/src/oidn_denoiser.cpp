@@ -4,12 +4,75 @@
 #include <luisa/core/logging.h>
 #include <luisa/runtime/stream.h>
 #include <luisa/backends/ext/dx_custom_cmd.h>
+#include <luisa/core/clock.h>
 #include <shared_mutex>
+#include <condition_variable>
+#include <thread>
 // #include <dxcuda_interop/interop_ext.h>
 #include <luisa/backends/ext/dx_cuda_interop.h>
 #include <luisa/backends/ext/vk_cuda_interop.h>
 
 namespace rbc {
+namespace oidn_detail {
+static void commit_device(oidn::DeviceRef &device) noexcept {
+    device.setErrorFunction([](void *, oidn::Error err, const char *message) noexcept {
+        switch (err) {
+            case oidn::Error::None:
+                break;
+            case oidn::Error::Cancelled:
+                LUISA_WARNING_WITH_LOCATION("OIDN denoiser cancelled: {}.", message);
+                break;
+            default:
+                LUISA_ERROR_WITH_LOCATION("OIDN denoiser error {}: `{}`.", magic_enum::enum_name(err), message);
+        }
+    });
+    device.commit();
+}
+static oidn::Format get_format(DenoiserExt::ImageFormat fmt) noexcept {
+    if (fmt == DenoiserExt::ImageFormat::FLOAT1) return oidn::Format::Float;
+    if (fmt == DenoiserExt::ImageFormat::FLOAT2) return oidn::Format::Float2;
+    if (fmt == DenoiserExt::ImageFormat::FLOAT3) return oidn::Format::Float3;
+    if (fmt == DenoiserExt::ImageFormat::FLOAT4) return oidn::Format::Float4;
+    if (fmt == DenoiserExt::ImageFormat::HALF1) return oidn::Format::Half;
+    if (fmt == DenoiserExt::ImageFormat::HALF2) return oidn::Format::Half2;
+    if (fmt == DenoiserExt::ImageFormat::HALF3) return oidn::Format::Half3;
+    if (fmt == DenoiserExt::ImageFormat::HALF4) return oidn::Format::Half4;
+    LUISA_ERROR_WITH_LOCATION("Invalid image format: {}.", (int)fmt);
+}
+static void set_filter_properties(oidn::FilterRef &filter, DenoiserExt::DenoiserInput const &input, DenoiserExt::Image const &image) noexcept {
+    switch (image.color_space) {
+        case DenoiserExt::ImageColorSpace::HDR:
+            filter.set("hdr", true);
+            break;
+        case DenoiserExt::ImageColorSpace::LDR_LINEAR:
+            filter.set("hdr", false);
+            filter.set("srgb", false);
+            break;
+        case DenoiserExt::ImageColorSpace::LDR_SRGB:
+            filter.set("hdr", false);
+            filter.set("srgb", true);
+            break;
+        default:
+            LUISA_ERROR_WITH_LOCATION("Invalid image color space: {}.", (int)image.color_space);
+    }
+    if (image.input_scale != 1.0) {
+        filter.set("inputScale", image.input_scale);
+    }
+    if (input.filter_quality == DenoiserExt::FilterQuality::FAST) {
+        filter.set("filter", oidn::Quality::Balanced);
+    } else if (input.filter_quality == DenoiserExt::FilterQuality::ACCURATE) {
+        filter.set("filter", oidn::Quality::High);
+    }
+}
+static void set_prefilter_properties(oidn::FilterRef &filter, DenoiserExt::DenoiserInput const &input) noexcept {
+    if (input.prefilter_mode == DenoiserExt::PrefilterMode::NONE) return;
+    if (input.prefilter_mode == DenoiserExt::PrefilterMode::FAST) {
+        filter.set("quality", oidn::Quality::Balanced);
+    } else if (input.prefilter_mode == DenoiserExt::PrefilterMode::ACCURATE) {
+        filter.set("quality", oidn::Quality::High);
+    }
+}
+}// namespace oidn_detail
 
 struct OidnDenoiser : public Denoiser {
 protected:
@@ -53,18 +116,7 @@ public:
 
 OidnDenoiser::OidnDenoiser(DeviceInterface *device, oidn::DeviceRef &&oidn_device) noexcept
     : _device(device), _oidn_device(std::move(oidn_device)) {
-    _oidn_device.setErrorFunction([](void *, oidn::Error err, const char *message) noexcept {
-        switch (err) {
-            case oidn::Error::None:
-                break;
-            case oidn::Error::Cancelled:
-                LUISA_WARNING_WITH_LOCATION("OIDN denoiser cancelled: {}.", message);
-                break;
-            default:
-                LUISA_ERROR_WITH_LOCATION("OIDN denoiser error {}: `{}`.", magic_enum::enum_name(err), message);
-        }
-    });
-    _oidn_device.commit();
+    oidn_detail::commit_device(_oidn_device);
 }
 
 void OidnDenoiser::reset() noexcept {
@@ -80,50 +132,7 @@ void OidnDenoiser::init(DenoiserExt::DenoiserInput const &input) noexcept {
     std::unique_lock lock{_mutex};
 
     reset();
-    auto get_format = [](DenoiserExt::ImageFormat fmt) noexcept {
-        if (fmt == DenoiserExt::ImageFormat::FLOAT1) return oidn::Format::Float;
-        if (fmt == DenoiserExt::ImageFormat::FLOAT2) return oidn::Format::Float2;
-        if (fmt == DenoiserExt::ImageFormat::FLOAT3) return oidn::Format::Float3;
-        if (fmt == DenoiserExt::ImageFormat::FLOAT4) return oidn::Format::Float4;
-        if (fmt == DenoiserExt::ImageFormat::HALF1) return oidn::Format::Half;
-        if (fmt == DenoiserExt::ImageFormat::HALF2) return oidn::Format::Half2;
-        if (fmt == DenoiserExt::ImageFormat::HALF3) return oidn::Format::Half3;
-        if (fmt == DenoiserExt::ImageFormat::HALF4) return oidn::Format::Half4;
-        LUISA_ERROR_WITH_LOCATION("Invalid image format: {}.", (int)fmt);
-    };
-    auto set_filter_properties = [&](oidn::FilterRef &filter, const DenoiserExt::Image &image) noexcept {
-        switch (image.color_space) {
-            case DenoiserExt::ImageColorSpace::HDR:
-                filter.set("hdr", true);
-                break;
-            case DenoiserExt::ImageColorSpace::LDR_LINEAR:
-                filter.set("hdr", false);
-                filter.set("srgb", false);
-                break;
-            case DenoiserExt::ImageColorSpace::LDR_SRGB:
-                filter.set("hdr", false);
-                filter.set("srgb", true);
-                break;
-            default:
-                LUISA_ERROR_WITH_LOCATION("Invalid image color space: {}.", (int)image.color_space);
-        }
-        if (image.input_scale != 1.0) {
-            filter.set("inputScale", image.input_scale);
-        }
-        if (input.filter_quality == DenoiserExt::FilterQuality::FAST) {
-            filter.set("filter", oidn::Quality::Balanced);
-        } else if (input.filter_quality == DenoiserExt::FilterQuality::ACCURATE) {
-            filter.set("filter", oidn::Quality::High);
-        }
-    };
-    auto set_prefilter_properties = [&](oidn::FilterRef &filter) noexcept {
-        if (input.prefilter_mode == DenoiserExt::PrefilterMode::NONE) return;
-        if (input.prefilter_mode == DenoiserExt::PrefilterMode::FAST) {
-            filter.set("quality", oidn::Quality::Balanced);
-        } else if (input.prefilter_mode == DenoiserExt::PrefilterMode::ACCURATE) {
-            filter.set("quality", oidn::Quality::High);
-        }
-    };
+    using namespace oidn_detail;
     bool has_albedo = false;
     bool has_normal = false;
     const DenoiserExt::Image *albedo_image = nullptr;
@@ -139,7 +148,7 @@ void OidnDenoiser::init(DenoiserExt::DenoiserInput const &input) noexcept {
                 _albedo_prefilter.setImage("output", _albedo_buffer, get_format(f.image.format), input.width, input.height, 0, f.image.pixel_stride, f.image.row_stride);
                 has_albedo = true;
                 albedo_image = &f.image;
-                set_prefilter_properties(_albedo_prefilter);
+                set_prefilter_properties(_albedo_prefilter, input);
                 _albedo_prefilter.commit();
             } else if (f.name == "normal") {
                 LUISA_ASSERT(!has_normal, "Normal feature already set.");
@@ -150,7 +159,7 @@ void OidnDenoiser::init(DenoiserExt::DenoiserInput const &input) noexcept {
                 _normal_prefilter.setImage("output", _normal_buffer, get_format(f.image.format), input.width, input.height, 0, f.image.pixel_stride, f.image.row_stride);
                 has_normal = true;
                 normal_image = &f.image;
-                set_prefilter_properties(_normal_prefilter);
+                set_prefilter_properties(_normal_prefilter, input);
                 _normal_prefilter.commit();
             } else {
                 LUISA_ERROR_WITH_LOCATION("Invalid feature name: {}.", f.name);
@@ -173,7 +182,7 @@ void OidnDenoiser::init(DenoiserExt::DenoiserInput const &input) noexcept {
         if (has_normal) {
             filter.setImage("normal", _normal_buffer, get_format(normal_image->format), input.width, input.height, 0, normal_image->pixel_stride, normal_image->row_stride);
         }
-        set_filter_properties(filter, in);
+        set_filter_properties(filter, input, in);
 
         if (input.prefilter_mode != DenoiserExt::PrefilterMode::NONE || !input.noisy_features) {
             filter.set("cleanAux", true);
@@ -252,7 +261,253 @@ luisa::shared_ptr<Denoiser> DXOidnDenoiserExt::create() noexcept {
         return luisa::make_shared<DXOidnDenoiser>(_device, oidn::newCUDADevice(cuda_device, nullptr));
     }
 }
+struct CPUOidnDenoiser : public Denoiser {
+private:
+    // Host copy of a caller image, the caller may overwrite its memory while an async execute runs
+    struct Staging {
+        DenoiserExt::Image image;
+        std::byte const *caller_data;
+        luisa::vector<std::byte> data;
+        oidn::BufferRef buffer;
+    };
+    struct Tile {
+        // region written to the output
+        uint2 inner_offset;
+        uint2 inner_size;
+        // region fed to the filter, the inner region extended by the overlap
+        uint2 offset;
+        uint2 size;
+    };
+    oidn::DeviceRef _oidn_device;
+    uint32_t _tile_size;
+    uint32_t _tile_overlap;
+    uint32_t _width{};
+    uint32_t _height{};
+    luisa::vector<Staging> _inputs;
+    luisa::vector<DenoiserExt::Image> _outputs;
+    luisa::vector<oidn::FilterRef> _filters;
+    luisa::vector<Tile> _tiles;
+    vstd::optional<Staging> _albedo;
+    vstd::optional<Staging> _normal;
+    oidn::FilterRef _albedo_prefilter;
+    oidn::FilterRef _normal_prefilter;
+    luisa::vector<std::byte> _tile_scratch;
+    oidn::BufferRef _tile_scratch_buffer;
+    // started by the first async execute and kept for the denoiser lifetime
+    std::thread _worker;
+    std::mutex _worker_mtx;
+    std::condition_variable _worker_cv;
+    bool _job_pending{false};
+    bool _worker_exit{false};
+    std::atomic<double> _ms_per_mpixel{0.0};
+
+    Staging _create_staging(DenoiserExt::Image const &img) noexcept {
+        LUISA_ASSERT(img.out_device_ptr, "CPU denoiser requires host memory in out_device_ptr.");
+        Staging staging{img, static_cast<std::byte const *>(img.out_device_ptr) + img.offset, {}, {}};
+        staging.image.offset = 0;
+        staging.data.push_back_uninitialized(img.size_bytes);
+        staging.buffer = _oidn_device.newBuffer(staging.data.data(), staging.data.size());
+        return staging;
+    }
+    static void _copy_from_caller(Staging &staging) noexcept {
+        std::memcpy(staging.data.data(), staging.caller_data, staging.data.size());
+    }
+    void _set_tile_images(oidn::FilterRef &filter, size_t input_index, Tile const &tile) noexcept {
+        using namespace oidn_detail;
+        auto set_image = [&](char const *name, Staging const &staging) {
+            auto &img = staging.image;
+            filter.setImage(
+                name, staging.buffer, get_format(img.format),
+                tile.size.x, tile.size.y,
+                tile.offset.y * img.row_stride + tile.offset.x * img.pixel_stride,
+                img.pixel_stride, img.row_stride);
+        };
+        set_image("color", _inputs[input_index]);
+        if (_albedo) set_image("albedo", *_albedo);
+        if (_normal) set_image("normal", *_normal);
+        auto &out = _outputs[input_index];
+        auto ele_size = DenoiserExt::size(out.format);
+        filter.setImage(
+            "output", _tile_scratch_buffer, get_format(out.format),
+            tile.size.x, tile.size.y,
+            0, ele_size, ele_size * tile.size.x);
+    }
+    void _write_tile_output(size_t input_index, Tile const &tile) noexcept {
+        auto &out = _outputs[input_index];
+        auto ele_size = DenoiserExt::size(out.format);
+        auto dst_base = static_cast<std::byte *>(out.out_device_ptr) + out.offset;
+        auto local = tile.inner_offset - tile.offset;
+        for (auto y : vstd::range(tile.inner_size.y)) {
+            auto src = _tile_scratch.data() + ((local.y + y) * tile.size.x + local.x) * ele_size;
+            auto dst = dst_base + (tile.inner_offset.y + y) * out.row_stride + tile.inner_offset.x * out.pixel_stride;
+            if (out.pixel_stride == ele_size) {
+                std::memcpy(dst, src, tile.inner_size.x * ele_size);
+            } else {
+                for (auto x : vstd::range(tile.inner_size.x)) {
+                    std::memcpy(dst + x * out.pixel_stride, src + x * ele_size, ele_size);
+                }
+            }
+        }
+    }
+    void _denoise() noexcept {
+        luisa::Clock clk;
+        if (_albedo_prefilter) _albedo_prefilter.execute();
+        if (_normal_prefilter) _normal_prefilter.execute();
+        for (auto &tile : _tiles) {
+            for (auto i : vstd::range(_filters.size())) {
+                auto &filter = _filters[i];
+                _set_tile_images(filter, i, tile);
+                filter.commit();
+                filter.execute();
+                _write_tile_output(i, tile);
+            }
+        }
+        auto ms = clk.toc();
+        _ms_per_mpixel = ms / (static_cast<double>(_width) * _height * 1e-6);
+        LUISA_VERBOSE("OIDN CPU denoise {}x{} in {} tiles: {:.2f} ms, {:.2f} ms/MPixel.", _width, _height, _tiles.size(), ms, _ms_per_mpixel.load());
+    }
+    void _worker_loop() noexcept {
+        std::unique_lock lck{_worker_mtx};
+        while (true) {
+            _worker_cv.wait(lck, [&] { return _job_pending || _worker_exit; });
+            if (!_job_pending) return;
+            lck.unlock();
+            _denoise();
+            lck.lock();
+            _job_pending = false;
+            _worker_cv.notify_all();
+        }
+    }
+
+public:
+    CPUOidnDenoiser(uint32_t tile_size, uint32_t tile_overlap) noexcept
+        : _oidn_device(oidn::newDevice(oidn::DeviceType::CPU)),
+          _tile_size(std::max(tile_size, 16u)),
+          _tile_overlap(tile_overlap) {
+        oidn_detail::commit_device(_oidn_device);
+    }
+    ~CPUOidnDenoiser() noexcept override {
+        {
+            std::lock_guard lck{_worker_mtx};
+            _worker_exit = true;
+        }
+        _worker_cv.notify_all();
+        if (_worker.joinable()) {
+            _worker.join();
+        }
+    }
+    void sync() noexcept override {
+        std::unique_lock lck{_worker_mtx};
+        _worker_cv.wait(lck, [&] { return !_job_pending; });
+    }
+    [[nodiscard]] double ms_per_mpixel() const noexcept override {
+        return _ms_per_mpixel.load();
+    }
+    void reset() noexcept override {
+        sync();
+        _inputs.clear();
+        _outputs.clear();
+        _filters.clear();
+        _tiles.clear();
+        _albedo.destroy();
+        _normal.destroy();
+        _albedo_prefilter = {};
+        _normal_prefilter = {};
+        _tile_scratch_buffer = {};
+        _tile_scratch.clear();
+    }
+    void init(DenoiserExt::DenoiserInput const &input) noexcept override {
+        using namespace oidn_detail;
+        reset();
+        LUISA_ASSERT(!input.inputs.empty(), "Empty input.");
+        LUISA_ASSERT(input.inputs.size() == input.outputs.size(), "Input/output count mismatch.");
+        _width = input.width;
+        _height = input.height;
+        bool prefilter = input.prefilter_mode != DenoiserExt::PrefilterMode::NONE;
+        // features are prefiltered once on the whole frame, tiles then read them as clean aux images
+        auto create_prefilter = [&](Staging &staging) {
+            auto filter = _oidn_device.newFilter("RT");
+            auto &img = staging.image;
+            filter.setImage("color", staging.buffer, get_format(img.format), _width, _height, 0, img.pixel_stride, img.row_stride);
+            filter.setImage("output", staging.buffer, get_format(img.format), _width, _height, 0, img.pixel_stride, img.row_stride);
+            set_prefilter_properties(filter, input);
+            filter.commit();
+            return filter;
+        };
+        for (auto &f : input.features) {
+            if (f.name == "albedo") {
+                LUISA_ASSERT(!_albedo, "Albedo feature already set.");
+                _albedo.create(_create_staging(f.image));
+                if (prefilter) _albedo_prefilter = create_prefilter(*_albedo);
+            } else if (f.name == "normal") {
+                LUISA_ASSERT(!_normal, "Normal feature already set.");
+                _normal.create(_create_staging(f.image));
+                if (prefilter) _normal_prefilter = create_prefilter(*_normal);
+            } else {
+                LUISA_ERROR_WITH_LOCATION("Invalid feature name: {}.", f.name);
+            }
+        }
+        size_t max_ele_size = 0;
+        for (auto i : vstd::range(input.inputs.size())) {
+            auto &out = input.outputs[i];
+            LUISA_ASSERT(out.out_device_ptr, "CPU denoiser requires host memory in out_device_ptr.");
+            _inputs.emplace_back(_create_staging(input.inputs[i]));
+            _outputs.emplace_back(out);
+            max_ele_size = std::max(max_ele_size, DenoiserExt::size(out.format));
+            auto filter = _oidn_device.newFilter("RT");
+            set_filter_properties(filter, input, input.inputs[i]);
+            if (prefilter || !input.noisy_features) {
+                filter.set("cleanAux", true);
+            }
+            _filters.emplace_back(std::move(filter));
+        }
+        uint2 max_tile_size{};
+        for (uint32_t y = 0; y < _height; y += _tile_size)
+            for (uint32_t x = 0; x < _width; x += _tile_size) {
+                Tile tile;
+                tile.inner_offset = make_uint2(x, y);
+                tile.inner_size = min(make_uint2(_width, _height) - tile.inner_offset, make_uint2(_tile_size));
+                tile.offset = make_uint2(
+                    x > _tile_overlap ? x - _tile_overlap : 0u,
+                    y > _tile_overlap ? y - _tile_overlap : 0u);
+                auto end = min(tile.inner_offset + tile.inner_size + _tile_overlap, make_uint2(_width, _height));
+                tile.size = end - tile.offset;
+                max_tile_size = max(max_tile_size, tile.size);
+                _tiles.emplace_back(tile);
+            }
+        _tile_scratch.push_back_uninitialized(static_cast<size_t>(max_tile_size.x) * max_tile_size.y * max_ele_size);
+        _tile_scratch_buffer = _oidn_device.newBuffer(_tile_scratch.data(), _tile_scratch.size());
+    }
+    // Inputs are copied before returning, so with async the caller can render the next frame into the same memory
+    void execute(bool async) noexcept override {
+        sync();
+        for (auto &i : _inputs) _copy_from_caller(i);
+        if (_albedo) _copy_from_caller(*_albedo);
+        if (_normal) _copy_from_caller(*_normal);
+        if (async) {
+            if (!_worker.joinable()) {
+                _worker = std::thread([this]() { _worker_loop(); });
+            }
+            {
+                std::lock_guard lck{_worker_mtx};
+                _job_pending = true;
+            }
+            _worker_cv.notify_all();
+        } else {
+            _denoise();
+        }
+    }
+};
+luisa::shared_ptr<Denoiser> CPUOidnDenoiserExt::create() noexcept {
+    return luisa::make_shared<CPUOidnDenoiser>(tile_size, tile_overlap);
+}
 }// namespace rbc
 OIDN_API rbc::DenoiserExt *rbc_create_oidn(luisa::compute::Device const &device) {
     return new rbc::DXOidnDenoiserExt(device);
 }
+OIDN_API rbc::DenoiserExt *rbc_create_oidn_cpu(uint32_t tile_size, uint32_t tile_overlap) {
+    if (!oidn::isCPUDeviceSupported()) {
+        return nullptr;
+    }
+    return new rbc::CPUOidnDenoiserExt(tile_size, tile_overlap);
+}
@@ -14,6 +14,8 @@ struct DenoisePack {
     luisa::compute::Buffer<float> external_input;
     luisa::compute::Buffer<float> external_output;
     vstd::function<void()> denoise_callback;
+    // cost of the last finished denoise, 0 if the denoiser does not measure it
+    vstd::function<double()> ms_per_mpixel;
 };
 struct RenderPlugin : Plugin {
     struct PipeCtxStub {};
@@ -1,6 +1,7 @@
 #include <rbc_render/post_process/aces.h>
 #include <rbc_render/pipeline.h>
 #include <luisa/vstl/common.h>
+#include <array>
 #include <rbc_render/utils//color_space.h>
 
 namespace rbc {
@@ -37,22 +38,25 @@ auto ColorToInverseGamma(float4 color) {
 }
 
 void post_process_aces_get_curve(ACESParameters const &desc, float4 *curve_host_data, bool is_hdr) {
+    // every curve is baked over the same uniform times, then interleaved
+    std::array<std::array<float, curve_precision>, 4> baked;
+    auto bake = [&](Curve const &curve, size_t channel) {
+        curve.sample_uniform(0.0f, 1.0f / float(curve_precision), baked[channel]);
+    };
+    bake(desc.hueVsHueCurve, 0);
+    bake(desc.hueVsSatCurve, 1);
+    bake(desc.satVsSatCurve, 2);
+    bake(desc.lumVsSatCurve, 3);
     for (auto i : vstd::range(curve_precision)) {
-        auto time = (float(i) + 0.0f) / float(curve_precision);
-        auto x = desc.hueVsHueCurve.sample_node(time);
-        auto y = desc.hueVsSatCurve.sample_node(time);
-        auto z = desc.satVsSatCurve.sample_node(time);
-        auto w = desc.lumVsSatCurve.sample_node(time);
-        curve_host_data[i] = float4(x, y, z, w);
+        curve_host_data[i] = float4(baked[0][i], baked[1][i], baked[2][i], baked[3][i]);
     }
     if (!is_hdr) {
+        bake(desc.redCurve, 0);
+        bake(desc.greenCurve, 1);
+        bake(desc.blueCurve, 2);
+        bake(desc.masterCurve, 3);
         for (auto i : vstd::range(curve_precision)) {
-            auto time = (float(i) + 0.0f) / float(curve_precision);
-            auto m = desc.masterCurve.sample_node(time);
-            auto r = desc.redCurve.sample_node(time);
-            auto g = desc.greenCurve.sample_node(time);
-            auto b = desc.blueCurve.sample_node(time);
-            curve_host_data[uint(i) + curve_precision] = float4(r, g, b, m);
+            curve_host_data[uint(i) + curve_precision] = float4(baked[0][i], baked[1][i], baked[2][i], baked[3][i]);
         }
     }
 }
@@ -258,6 +258,10 @@ void PreparePass::early_update(Pipeline const &pipeline, PipelineContext const &
     if (frane_settings.frame_index == 0) {
         pass_ctx->last_cam = ctx.cam;
     }
+    if (frane_settings.delta_time > 0.f) {
+        auto cam_speed = length(make_float3(ctx.cam.position - pass_ctx->last_cam.position)) / frane_settings.delta_time;
+        ctx.scene->tex_streamer().set_camera_motion(cam_speed);
+    }
     // pass_ctx->last_cam.position += make_double3(frane_settings.global_offset);
 
     jitter_data.last_jitter = pass_ctx->last_jitter;
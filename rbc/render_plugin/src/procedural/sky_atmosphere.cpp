@@ -141,7 +141,7 @@ bool SkyAtmosphere::update(CommandList &cmdlist, Stream &stream, BindlessAllocat
     if (_sky_id == ~0u) {
         _sky_id = bdls_alloc.allocate_tex2d(img_view, Sampler::point_edge());
     } else if (sky_id_dirty) {
-        bdls_alloc.image_heap().emplace_on_update(_sky_id, img_view, Sampler::point_edge());
+        bdls_alloc.update_tex2d(_sky_id, img_view, Sampler::point_edge());
     }
     sky_id_dirty = false;
     return update;
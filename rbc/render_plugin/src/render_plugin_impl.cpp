@@ -10,6 +10,8 @@ namespace rbc {
 struct DenoiserStream {
     luisa::shared_ptr<Denoiser> denoiser;
     DenoiserExt::DenoiserInput input;
+    // backing memory of every image, only used by the CPU denoiser
+    luisa::vector<std::byte> host_memory;
     DenoiserStream(
         luisa::shared_ptr<Denoiser> &&denoiser,
         uint2 res)
@@ -25,7 +27,9 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
     enum struct OidnSupport : uint8_t {
         UnChecked,
         UnSupported,
-        Supported
+        Supported,
+        // no interop with the render backend, denoise host copies on the OIDN CPU device
+        CPUFallback
     };
     OidnSupport oidn_support{OidnSupport::UnChecked};
     std::mutex oidn_mtx;
@@ -171,7 +175,8 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
                     LUISA_WARNING("OIDN not support for reason: invalid check args.");
                     break;
                 case 2:
-                    LUISA_WARNING("OIDN not support for reason: unsupported backend.");
+                    LUISA_INFO("OIDN interop not support by backend {}, fallback to CPU denoiser.", render_device.backend_name());
+                    oidn_support = OidnSupport::CPUFallback;
                     break;
                 case 3:
                     LUISA_WARNING("OIDN not support for reason: plugin not found.");
@@ -181,17 +186,22 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
                     break;
             }
         }
-        if (oidn_support != OidnSupport::Supported) return false;
+        if (oidn_ext) return true;
+        if (oidn_support != OidnSupport::Supported && oidn_support != OidnSupport::CPUFallback) return false;
         oidn_module = PluginManager::instance().load_module("oidn_plugin");
         if (!oidn_module) {
             LUISA_WARNING("OIDN not support for reason: plugin not found.");
-            oidn_support != OidnSupport::UnSupported;
+            oidn_support = OidnSupport::UnSupported;
             return false;
         }
-        oidn_ext = oidn_module->invoke<rbc::DenoiserExt *(luisa::compute::Device const &device)>("rbc_create_oidn", render_device.lc_device());
+        if (oidn_support == OidnSupport::Supported) {
+            oidn_ext = oidn_module->invoke<rbc::DenoiserExt *(luisa::compute::Device const &device)>("rbc_create_oidn", render_device.lc_device());
+        } else {
+            oidn_ext = oidn_module->invoke<rbc::DenoiserExt *(uint32_t tile_size, uint32_t tile_overlap)>("rbc_create_oidn_cpu", 1024u, 128u);
+        }
         if (!oidn_ext) {
             LUISA_WARNING("OIDN not support for reason: plugin not found.");
-            oidn_support != OidnSupport::UnSupported;
+            oidn_support = OidnSupport::UnSupported;
             return false;
         }
         return true;
@@ -199,7 +209,7 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
     DenoisePack create_denoise_task(
         luisa::compute::Stream &stream,
         uint2 render_resolution) override {
-        if (oidn_support != OidnSupport::Supported) {
+        if (!oidn_ext) {
             LUISA_ERROR("Denoiser not supported.");
         }
         bool init = false;
@@ -214,6 +224,7 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
 
         auto &denoiser = *iter.value().denoiser;
         auto &input = iter.value().input;
+        bool cpu = oidn_ext->tag() == DenoiserExt::Tag::CPU;
 
         // check if the resolution is changed
         if (input.width != render_resolution.x || input.height != render_resolution.y) {
@@ -229,9 +240,64 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
             input.noisy_features = true;
             input.filter_quality = DenoiserExt::FilterQuality::ACCURATE;
             input.prefilter_mode = DenoiserExt::PrefilterMode::ACCURATE;
+            if (cpu) {
+                auto images = {&input.features[0].image, &input.features[1].image, &input.inputs[0], &input.outputs[0]};
+                size_t size_bytes = 0;
+                for (auto img : images) size_bytes += img->size_bytes;
+                auto &host_memory = iter.value().host_memory;
+                host_memory.clear();
+                host_memory.push_back_uninitialized(size_bytes);
+                size_bytes = 0;
+                for (auto img : images) {
+                    img->out_device_ptr = host_memory.data() + size_bytes;
+                    size_bytes += img->size_bytes;
+                }
+            }
             denoiser.init(input);
         }
 
+        if (cpu) {
+            // render into device buffers, the callback round-trips them through the host images.
+            // Frame N is denoised on the worker while frame N+1 is path traced, its result is
+            // uploaded by the next callback, so the output lags one frame behind the input.
+            auto &device = RenderDevice::instance().lc_device();
+            auto &albedo = input.features[0].image;
+            auto &normal = input.features[1].image;
+            auto &noisy = input.inputs[0];
+            auto &output = input.outputs[0];
+            DenoisePack pack{
+                .external_albedo = device.create_buffer<float>(albedo.size_bytes / sizeof(float)),
+                .external_normal = device.create_buffer<float>(normal.size_bytes / sizeof(float)),
+                .external_input = device.create_buffer<float>(noisy.size_bytes / sizeof(float)),
+                .external_output = device.create_buffer<float>(output.size_bytes / sizeof(float))};
+            pack.denoise_callback = [&denoiser, &stream,
+                                     albedo_view = pack.external_albedo.view(), albedo_host = albedo.out_device_ptr,
+                                     normal_view = pack.external_normal.view(), normal_host = normal.out_device_ptr,
+                                     input_view = pack.external_input.view(), input_host = noisy.out_device_ptr,
+                                     output_view = pack.external_output.view(), output_host = output.out_device_ptr,
+                                     in_flight = false]() mutable {
+                // the worker only touches its own staging copies and output_host
+                stream << albedo_view.copy_to(albedo_host)
+                       << normal_view.copy_to(normal_host)
+                       << input_view.copy_to(input_host)
+                       << synchronize();
+                if (in_flight) {
+                    denoiser.sync();
+                } else {
+                    // nothing denoised yet, the first frame waits for its own result
+                    denoiser.execute(false);
+                }
+                // the worker writes output_host again once the next job starts
+                stream << output_view.copy_from(output_host)
+                       << synchronize();
+                if (in_flight) {
+                    denoiser.execute(true);
+                }
+                in_flight = true;
+            };
+            pack.ms_per_mpixel = [&denoiser]() { return denoiser.ms_per_mpixel(); };
+            return pack;
+        }
         auto *denoise_ext = static_cast<DXOidnDenoiserExt *>(oidn_ext);
         return DenoisePack{
             .external_albedo = denoise_ext->buffer_from_image<float>(input.features[0].image),
@@ -241,7 +307,8 @@ struct RenderPluginImpl : RenderPlugin, RBCStruct {
             .denoise_callback = [&denoiser, &stream]() {
                 stream << synchronize();
                 denoiser.execute();
-            }};
+            },
+            .ms_per_mpixel = [&denoiser]() { return denoiser.ms_per_mpixel(); }};
     }
     void destroy_denoise_task(luisa::compute::Stream &stream) override {
         _denoisers.remove(stream.handle());
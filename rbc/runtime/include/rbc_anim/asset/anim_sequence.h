@@ -5,7 +5,19 @@
 
 namespace rbc {
 
-struct AnimOptimizationOverride {};
+// Import-time keyframe reduction, see ozz::animation::offline::AnimationOptimizer
+// Errors are measured at `distance` meters from each joint and accumulated down the hierarchy,
+// so a tolerance on a root joint also bounds the drift of its children.
+struct AnimOptimizationSetting {
+    float tolerance = 1e-3f;
+    float distance = 1e-1f;
+};
+struct AnimOptimizationOverride {
+    bool enabled = true;
+    AnimOptimizationSetting setting;
+    // joint name -> setting, e.g. tighter tolerances for fingers and face
+    luisa::vector<std::pair<luisa::string, AnimOptimizationSetting>> joints;
+};
 
 // The Runtime AnimSequence Asset
 struct AnimSequence final {
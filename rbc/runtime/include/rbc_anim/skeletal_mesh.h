@@ -7,6 +7,7 @@
 #include "rbc_world/resources/anim_graph.h"
 #include "rbc_world/resources/skelmesh.h"
 #include "rbc_anim/anim_instance.h"
+#include "rbc_anim/system/anim_update_system.h"
 #include "rbc_core/rc.h"
 
 #include "rbc_anim/render/render_data.h"
@@ -38,9 +39,11 @@ struct AnimationEvaluationContext {
     luisa::vector<AnimSOATransform> BoneSpaceTransforms;
     luisa::vector<AnimFloat4x4> CachedComponentSpaceTransforms;
     luisa::vector<AnimSOATransform> CachedBoneSpaceTransforms;
+    luisa::vector<AnimSOATransform> InterpolatedBoneSpaceTransforms;// scratch for blending towards cached
     // flags
     bool bDoInterpolation;
     bool bDoEvaluation;
+    float InterpolationAlpha = 1.0f;// weight of the cached pose when interpolating
 
     void Init(AnimInstance *InInstance, SkeletalMesh *InSkelMesh) {
         anim_instance = InInstance;
@@ -146,6 +149,9 @@ public:
     void SetUseGPUSkin(bool InSetUseGPUSkin) { bUseGPUSkin = InSetUseGPUSkin; }
     bool IsUseGPUSkin() const { return bUseGPUSkin; }
     bool IsInitialized() const { return bInitialized; }
+    // visibility inputs of the animation budget, see AnimUpdateSystem
+    void SetScreenSize(float InScreenSize) { update_rate_params.ScreenSize = InScreenSize; }
+    void SetAnimVisibility(bool bInVisible) { update_rate_params.bVisible = bInVisible; }
 
 public:
     // Get & Set
@@ -192,6 +198,7 @@ public:
     bool bRenderStateCreated = false;
 
     AnimationEvaluationContext anim_eval_context;
+    AnimUpdateRateParams update_rate_params;
     luisa::vector<AnimFloat4x4> ComponentSpaceTransformsArray[2];
 
     int32_t CurrentEditableComponentTransformsIdx = 0;
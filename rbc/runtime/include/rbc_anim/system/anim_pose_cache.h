@@ -0,0 +1,79 @@
+#pragma once
+#include <rbc_config.h>
+#include "rbc_anim/types.h"
+#include <luisa/core/stl/hash.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/core/stl/unordered_map.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/core/spin_mutex.h>
+#include <cstring>
+
+namespace rbc {
+
+// all fields are 8 bytes, the key is hashed and compared as raw memory
+struct AnimPoseCacheKey {
+    const void *graph = nullptr;
+    const void *clip = nullptr;
+    const void *skeleton = nullptr;
+    int64_t node_id = INVALID_INDEX;
+    int64_t quantized_time = 0;
+    int64_t num_soa_bones = 0;
+    bool operator==(const AnimPoseCacheKey &rhs) const {
+        return std::memcmp(this, &rhs, sizeof(AnimPoseCacheKey)) == 0;
+    }
+};
+struct AnimPoseCacheKeyHash {
+    size_t operator()(const AnimPoseCacheKey &key) const {
+        return luisa::hash64(&key, sizeof(AnimPoseCacheKey), luisa::hash64_default_seed);
+    }
+};
+
+struct AnimPoseCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    [[nodiscard]] float HitRate() const {
+        const uint64_t total = hits + misses;
+        return total > 0 ? static_cast<float>(hits) / static_cast<float>(total) : 0.0f;
+    }
+};
+
+/**
+ * AnimPoseCache
+ * ==============================
+ * Per frame cache of sampled local space poses.
+ * Instances running the same AnimGraph node on the same clip at the same (quantized) time
+ * on the same skeleton sample once, the result is stored immutable and shared by every later hit.
+ * NewFrame drops all entries, the counters of the finished frame stay readable until the next one.
+ * Hosts that never call NewFrame stay bounded by MaxEntries, a full cache is dropped on the next Add.
+ */
+struct RBC_RUNTIME_API AnimPoseCache {
+public:
+    using SharedPose = luisa::shared_ptr<const luisa::vector<AnimSOATransform>>;
+
+    bool bEnabled = true;
+    // sample times are snapped to multiples of this, 0 keys on the exact time
+    // a positive quantum shares instances that are slightly out of step, at the cost of quantized playback
+    float TimeQuantum = 0.0f;
+    size_t MaxEntries = 1024;
+
+    void NewFrame();
+    // snaps InOutTime in place so every sharer samples the same time, returns the key part
+    [[nodiscard]] int64_t QuantizeTime(float &InOutTime) const;
+    // counts a hit or a miss
+    [[nodiscard]] SharedPose Find(const AnimPoseCacheKey &InKey);
+    // returns the stored entry, which is the earlier one if another evaluation got there first
+    SharedPose Add(const AnimPoseCacheKey &InKey, luisa::span<const AnimSOATransform> InBones);
+
+    [[nodiscard]] AnimPoseCacheStats GetFrameStats() const { return last_frame_stats; }
+    [[nodiscard]] AnimPoseCacheStats GetTotalStats() const { return total_stats; }
+    [[nodiscard]] size_t GetNumEntries() const { return entries.size(); }
+
+private:
+    luisa::spin_mutex mtx;
+    luisa::unordered_map<AnimPoseCacheKey, SharedPose, AnimPoseCacheKeyHash> entries;
+    AnimPoseCacheStats frame_stats;
+    AnimPoseCacheStats last_frame_stats;
+    AnimPoseCacheStats total_stats;
+};
+
+}// namespace rbc
@@ -1 +1,105 @@
 #pragma once
+#include <rbc_config.h>
+#include "rbc_anim/system/anim_pose_cache.h"
+#include <luisa/core/stl/vector.h>
+#include <luisa/core/spin_mutex.h>
+
+namespace rbc {
+
+struct SkeletalMesh;
+
+/**
+ * AnimUpdateRateParams
+ * ==============================
+ * Per SkeletalMesh update rate optimization state
+ * - UpdateRate 1: update and evaluate every frame
+ * - UpdateRate N: update with accumulated delta time and evaluate every N frames
+ * - Interpolated: evaluate every N frames, blend towards the evaluated pose in the frames between
+ * - Culled: update every N frames, never evaluate
+ */
+struct AnimUpdateRateParams {
+    // Inputs, fed by rendering/visibility every frame
+    float ScreenSize = 1.0f;// projected bounds height / viewport height
+    bool bVisible = true;
+
+    // Outputs of the budget allocator
+    int32_t UpdateRate = 1;
+    bool bInterpolateSkippedFrames = false;
+    bool bSkipEvaluation = false;
+
+    // Runtime state
+    int32_t FramesSinceUpdate = 0;// seeded per mesh on register to stagger meshes sharing a rate
+    float AccumulatedDeltaTime = 0.0f;
+    bool bUpdatedThisFrame = true;
+    // Smoothed tick cost in ms, measured separately on update frames and skipped frames
+    float UpdateCostMs = 0.0f;
+    float SkipCostMs = 0.0f;
+
+    // advance one frame, returns true if the anim instance should update this frame
+    bool Advance(float InDeltaTime_s, bool bForceUpdate);
+    // consume the delta time accumulated since the last update
+    float ConsumeDeltaTime();
+    // frames left until the next update, 0 on the frame before it
+    [[nodiscard]] int32_t GetFramesUntilNextUpdate() const;
+    // blend weight towards the last evaluated pose, reaches 1 right before the next evaluation
+    [[nodiscard]] float GetInterpolationAlpha() const;
+    [[nodiscard]] bool ShouldInterpolate() const { return bInterpolateSkippedFrames && UpdateRate > 1 && !bSkipEvaluation; }
+    void RecordTickCost(float InCostMs, float InSmoothing);
+    // estimated per frame cost at the given rate
+    [[nodiscard]] float EstimateCostMs(int32_t InUpdateRate, bool bInInterpolate) const;
+};
+
+struct AnimBudgetSettings {
+    float BudgetMs = 1.0f;// animation CPU time of all skeletal meshes per frame
+    int32_t MaxUpdateRate = 8;
+    int32_t MaxInterpolatedRate = 4;// beyond this skipped frames hold the pose
+    bool bInterpolate = true;
+    // meshes covering at least this much of the screen want every frame,
+    // smaller ones start at proportionally lower rates
+    float FullRateScreenSize = 0.25f;
+    float CostSmoothing = 0.1f;
+};
+
+/**
+ * AnimUpdateSystem
+ * ==============================
+ * Animation budget allocator and owner of the per frame pose cache,
+ * BeginFrame should run once per frame before ticking skeletal meshes.
+ * Meshes are sorted by significance (screen size, culled last), each gets the lowest rate its
+ * screen size allows, lowered further until the estimated frame cost fits into BudgetMs while
+ * leaving room for every less significant mesh at MaxUpdateRate.
+ * Meshes not touched by the allocator keep UpdateRate 1, i.e. the old tick every frame behaviour.
+ */
+struct RBC_RUNTIME_API AnimUpdateSystem {
+public:
+    static AnimUpdateSystem &instance();
+
+    void Register(SkeletalMesh *InSkelMesh);
+    void Unregister(SkeletalMesh *InSkelMesh);
+    // drops last frame's cached poses and allocates this frame's budget
+    void BeginFrame();
+    void AllocateBudget();
+
+    // allocation core, returns the estimated frame cost in ms
+    // InParams is reordered by significance
+    static float AssignUpdateRates(luisa::span<AnimUpdateRateParams *> InParams, const AnimBudgetSettings &InSettings);
+    // ScreenSize of a bounding sphere seen from InDistance, InTanHalfFov is tan(vertical fov / 2)
+    static float ComputeScreenSize(float InBoundsRadius, float InDistance, float InTanHalfFov);
+
+    [[nodiscard]] float GetEstimatedCostMs() const { return estimated_cost_ms; }
+    [[nodiscard]] size_t GetNumRegistered() const { return skel_meshes.size(); }
+    AnimPoseCache &GetPoseCache() { return pose_cache; }
+
+public:
+    AnimBudgetSettings settings;
+
+private:
+    luisa::spin_mutex mtx;
+    AnimPoseCache pose_cache;
+    luisa::vector<SkeletalMesh *> skel_meshes;
+    luisa::vector<AnimUpdateRateParams *> scratch_params;
+    uint32_t next_frame_offset = 0;
+    float estimated_cost_ms = 0.0f;
+};
+
+}// namespace rbc
@@ -16,6 +16,7 @@
 #include "ozz/animation/runtime/sampling_job.h"
 #include "ozz/geometry/runtime/skinning_job.h"
 #include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/blending_job.h"
 
 namespace rbc {
 
@@ -35,6 +36,7 @@ using AnimSkinningJob = ozz::geometry::SkinningJob;
 using AnimLocalToModelJob = ozz::animation::LocalToModelJob;
 using AnimSamplingJob = ozz::animation::SamplingJob;
 using AnimSamplingJobContext = ozz::animation::SamplingJob::Context;
+using AnimBlendingJob = ozz::animation::BlendingJob;
 // raw asset
 using RawAnimationAsset = ozz::animation::offline::RawAnimation;
 using RawSkeletonAsset = ozz::animation::offline::RawSkeleton;
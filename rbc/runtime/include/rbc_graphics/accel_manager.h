@@ -23,6 +23,12 @@ public:
     using InstanceInfo = geometry::InstanceInfo;
     using ProceduralType = geometry::ProceduralType;
     using DrawListMap = luisa::vector<RasterMesh>;
+    struct MeshInstanceTransform {
+        float4x4 transform;
+        uint inst_id;
+        uint8_t visibility_mask{0xffu};
+        bool opaque{true};
+    };
     struct AccelElement {
         float4x4 transform;
         vstd::variant<MeshManager::MeshData *, ProceduralPrimitive> mesh_data;
@@ -137,6 +143,11 @@ public:
         float4x4 transform,
         uint8_t visibility_mask,
         bool opaque);
+    // Batched set_mesh_instance for transform-only updates, inst_id must be unique in the batch.
+    // Instance elements are written in parallel, accel modifications are recorded once per instance.
+    void set_mesh_instances(
+        CommandList &cmdlist,
+        luisa::span<MeshInstanceTransform const> updates);
     void set_procedural_instance(
         uint inst_id,
         float4x4 transform,
@@ -215,6 +226,10 @@ public:
         DisposeQueue &disp_queue,
         uint inst_idx);
 
+    // Patch instances whose material or procedural meta node was moved by BufferAllocator::compact
+    void relocate_buffer_nodes(
+        BufferUploader &uploader,
+        luisa::span<BufferAllocator::Relocation const> relocations);
     void build_accel(CommandList &cmdlist);
     void update_last_transform(
         CommandList &cmdlist);
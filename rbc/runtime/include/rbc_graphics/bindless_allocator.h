@@ -7,6 +7,7 @@
 #include <luisa/runtime/bindless_array.h>
 #include <luisa/runtime/device.h>
 #include <luisa/runtime/command_list.h>
+#include <rbc_core/shared_atomic_mutex.h>
 namespace rbc
 {
 #include <utils/heap_indices.hpp>
@@ -14,23 +15,57 @@ using namespace luisa;
 using namespace luisa::compute;
 struct BindlessManager;
 // API is thread safe
+// Heaps grow on commit() when allocations run past their size, freed slots are reused after the frame that removed them completes.
 struct RBC_RUNTIME_API BindlessAllocator
 {
+    static constexpr uint max_heap_size = 1u << 20u;
+
 private:
     friend struct BindlessManager;
     using Modification = BindlessArray::Modification;
+    // Host copy of a heap slot, re-emplaced into the new array when the heap grows
+    struct Slot
+    {
+        uint64 handle{ invalid_resource_handle };
+        Sampler sampler;
+    };
+    // Slots owned by one thread, free lists are refilled in batches under _mtx
+    struct ThreadCache
+    {
+        vector<uint> free[3];
+        luisa::spin_mutex retired_mtx;
+        vector<uint> retired[3];
+    };
+    static constexpr uint _cache_batch = 64u;
     string_view _name(uint index) const;
+    Device* _device;
     BindlessArray _buffer_heap;
     BindlessArray _image_heap;
     BindlessArray _volume_heap;
+    // global free lists, only touched when a thread cache is refilled
     vector<uint> _vec[3];
+    // slots below _next were handed out at least once
+    uint _next[3]{};
     vector<uint64_t> _reserved_handles[3];
     bool _require_sync{ false };
-    std::array<vector<uint>, 3> _free_queue;
+    // guards the heap arrays, _slots and _capacity, exclusive only while growing
+    rbc::shared_atomic_mutex _heap_mtx;
+    vector<Slot> _slots[3];
+    uint _capacity[3]{};
+    luisa::spin_mutex _caches_mtx;
+    vector<unique_ptr<ThreadCache>> _caches;
+    uint64_t _cache_id;
 #ifndef NDEBUG
     vstd::HashMap<uint> _allocated_map[3];
     bool _no_warning = false;
 #endif
+    BindlessArray& _heap(uint index);
+    ThreadCache& _local_cache();
+    void _refill(uint index, vector<uint>& free_list);
+    uint _allocate(uint index, uint64 handle, Sampler sampler);
+    // invalid_resource_handle clears the slot
+    void _set_slot(uint index, uint slot, uint64 handle, Sampler sampler);
+    void _grow(CommandList& cmdlist, uint index);
     bool _set_reserve(uint idx, uint64_t handle, uint type);
     void _set_reserved_buffer(uint idx, uint64 handle);
     void _set_reserved_tex2d(uint idx, uint64 handle, Sampler sampler);
@@ -115,6 +150,11 @@ public:
     {
         return _allocate_tex3d(volume.handle(), sampler);
     }
+    // Point an allocated slot at another texture
+    void update_tex2d(uint value, Image<float> const& img, Sampler sampler)
+    {
+        _set_slot(1, value, img.handle(), sampler);
+    }
     void deallocate_buffer(uint value)
     {
         _deallocate(0, value);
@@ -133,6 +173,10 @@ public:
     [[nodiscard]] auto& image_heap() { return _image_heap; }
     [[nodiscard]] auto const& volume_heap() const { return _volume_heap; }
     [[nodiscard]] auto& volume_heap() { return _volume_heap; }
+    [[nodiscard]] uint buffer_capacity() const { return _capacity[0]; }
+    [[nodiscard]] uint image_capacity() const { return _capacity[1]; }
+    [[nodiscard]] uint volume_capacity() const { return _capacity[2]; }
+    // Grows heaps if needed and records pending heap updates, call from the render thread before heaps are bound.
     void commit(CommandList& cmdlist);
 };
 } // namespace rbc
\ No newline at end of file
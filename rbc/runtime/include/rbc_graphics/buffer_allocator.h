@@ -1,6 +1,7 @@
 #pragma once
 #include <rbc_config.h>
 #include "first_fit.h"
+#include "tlsf_allocator.h"
 #include <luisa/runtime/buffer.h>
 #include <luisa/runtime/device.h>
 #include "dispose_queue.h"
@@ -11,43 +12,67 @@
 namespace rbc {
 using namespace luisa::compute;
 struct RBC_RUNTIME_API BufferAllocator {
+public:
+	enum struct AllocateType : uint32_t {
+		FirstFit,
+		BestFit,
+		// two-level segregated fit, O(1) allocate and free
+		TLSF
+	};
+
 private:
-	rbc::FirstFit _fit;
+	// only the backend chosen at construction is created
+	vstd::optional<rbc::FirstFit> _fit;
+	vstd::optional<rbc::TLSFAllocator> _tlsf;
 	// thread-safe area
 	Buffer<uint> _buffer;
+	// staging for compaction copies whose source and destination overlap
+	Buffer<uint> _scratch;
 	size_t _capacity;
+	size_t _min_capacity;
 	bool _dirty{true};
+	void _copy_within(Device& device, CommandList& cmd_list, DisposeQueue& disp_queue, size_t src_bytes, size_t dst_bytes, size_t size_bytes);
 
 public:
-	enum struct AllocateType : uint32_t {
-		FirstFit,
-		BestFit
-	};
 	struct Node {
 		friend struct BufferAllocator;
 
 	private:
-		rbc::FirstFit::Node* _fit_node;
+		// FirstFit::Node or TLSFAllocator::Node, depends on the backend
+		void* _handle;
+		size_t _offset;
+		size_t _size;
 
 	public:
-		Node() : _fit_node(nullptr) {}
+		Node() : _handle(nullptr), _offset(0), _size(0) {}
 		Node(Node const&) = default;
 		template<typename T>
 		BufferView<T> view(BufferAllocator& a) const {
-			auto uint_view = a._buffer.view(_fit_node->offset() / sizeof(uint), _fit_node->size() / sizeof(uint));
+			auto uint_view = a._buffer.view(_offset / sizeof(uint), _size / sizeof(uint));
 			if constexpr (std::is_same_v<T, uint>) {
 				return uint_view;
 			} else {
 				return uint_view.as<T>();
 			}
 		}
-		[[nodiscard]] auto offset_bytes() const noexcept { return _fit_node->offset(); }
-		[[nodiscard]] auto size_bytes() const noexcept { return _fit_node->size(); }
+		[[nodiscard]] auto offset_bytes() const noexcept { return _offset; }
+		[[nodiscard]] auto size_bytes() const noexcept { return _size; }
 		operator bool() const {
-			return _fit_node != nullptr;
+			return _handle != nullptr;
 		}
+		// same allocation, offsets of a stale copy may differ after compaction
+		[[nodiscard]] bool same_block(Node const& node) const noexcept { return _handle == node._handle; }
 	};
-	BufferAllocator(Device& device, uint capacity = 65536);
+	// nodes without user data are never moved by compaction
+	static constexpr uint64_t pinned_user_data = ~0ull;
+	struct Relocation {
+		Node node;
+		size_t old_offset_bytes;
+		uint64_t user_data;
+	};
+	using BeforeCopyFunc = vstd::FuncRef<void(Buffer<uint> const& old_buffer, Buffer<uint> const& new_buffer)>;
+	// backend FirstFit honors FirstFit and BestFit per allocation, TLSF ignores the per-allocation type
+	BufferAllocator(Device& device, uint capacity = 65536, AllocateType backend = AllocateType::TLSF);
 	Node allocate(
 		Device& device,
 		CommandList& cmd_list,
@@ -57,6 +82,27 @@ public:
 		AllocateType alloc_type = AllocateType::FirstFit);
 	Buffer<uint> const& buffer() const { return _buffer; }
 	void free(Node node);
+	// Opt a node into compaction, the owner is found again by user_data in the relocation callback.
+	// TLSF backend only, FirstFit nodes stay pinned.
+	void set_relocatable(Node const& node, uint64_t user_data);
+	// Slide relocatable nodes down into the holes before them, copying at most max_copy_bytes per call.
+	// Adjacent nodes move with one copy command. relocate receives the moved nodes to patch their owners,
+	// who must not write through stale copies of the nodes afterwards. Returns whether anything moved.
+	bool compact(
+		Device& device,
+		CommandList& cmd_list,
+		DisposeQueue& disp_queue,
+		size_t max_copy_bytes,
+		vstd::FuncRef<void(luisa::span<Relocation const>)> relocate);
+	// Recreate a smaller buffer when the used prefix takes less than occupancy_threshold of the capacity.
+	// The new capacity keeps at least half of it free, never below the initial capacity.
+	bool try_shrink(
+		Device& device,
+		CommandList& cmd_list,
+		DisposeQueue& disp_queue,
+		float occupancy_threshold,
+		BeforeCopyFunc before_copy);
+	[[nodiscard]] size_t capacity() const { return _capacity; }
 	~BufferAllocator();
 	void mark_clean() {_dirty = false;}
 	bool dirty() const {return _dirty;}
@@ -40,6 +40,9 @@ private:
     };
 
     vstd::HashMap<uint64, vstd::unordered_map<CmdKey, CmdValue, CmdKeyHash>> _copy_cmd;
+    // committed values keep their capacity, so steady per-frame uploads stop re-growing the vectors
+    vector<CmdValue> _free_values;
+    CmdValue _make_cmd_value(BufferView<uint> origin_buffer);
     void commit_cmd(
         CmdKey const& key, CmdValue& value,
         CommandList& cmdlist,
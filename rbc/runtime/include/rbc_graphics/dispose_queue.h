@@ -3,6 +3,7 @@
 #include <luisa/runtime/command_list.h>
 #include <luisa/runtime/stream.h>
 #include <luisa/vstl/common.h>
+#include <rbc_core/pool_allocator.h>
 namespace rbc {
 using namespace luisa;
 using namespace luisa::compute;
@@ -10,29 +11,41 @@ struct RBC_RUNTIME_API DisposeQueue {
 	struct Element {
 		void* ptr;
 		vstd::func_ptr_t<void(void*)> dtor;
+		// storage belongs to the frame arena, only the destructor runs
+		bool from_arena;
 	};
 	vstd::vector<Element> _elements;
-
-public:
+	ArenaPoolAllocator* _frame_arena{nullptr};
 	template<typename T>
-		requires(!std::is_reference_v<T> && std::is_move_constructible_v<T> && !std::is_trivially_destructible_v<T>)
-	void dispose_after_queue(T&& t) {
-		auto& e = _elements.emplace_back();
-		e.ptr = vengine_malloc(sizeof(T));
+	Element _make_element(T&& t) {
+		Element e;
+		e.from_arena = _frame_arena != nullptr;
+		e.ptr = e.from_arena ? _frame_arena->allocate(sizeof(T), alignof(T)) : vengine_malloc(sizeof(T));
 		e.dtor = [](void* ptr) {
 			reinterpret_cast<T*>(ptr)->~T();
 		};
 		new (e.ptr) T(std::move(t));
+		return e;
+	}
+	static void _dispose(Element const& e) {
+		e.dtor(e.ptr);
+		if (!e.from_arena) vengine_free(e.ptr);
+	}
+
+public:
+	// Arena that stays alive until this queue's elements are disposed, set by the frame owner.
+	// Boxes of disposed objects and other transient host data of the frame are allocated from it.
+	void set_frame_arena(ArenaPoolAllocator* arena) { _frame_arena = arena; }
+	[[nodiscard]] ArenaPoolAllocator* frame_arena() const { return _frame_arena; }
+	template<typename T>
+		requires(!std::is_reference_v<T> && std::is_move_constructible_v<T> && !std::is_trivially_destructible_v<T>)
+	void dispose_after_queue(T&& t) {
+		_elements.emplace_back(_make_element(std::move(t)));
 	}
 	template<typename T, typename Mtx>
 		requires(!std::is_reference_v<T> && std::is_move_constructible_v<T> && !std::is_trivially_destructible_v<T>)
 	void dispose_after_queue(T&& t, Mtx& mtx) {
-		Element e;
-		e.ptr = vengine_malloc(sizeof(T));
-		e.dtor = [](void* ptr) {
-			reinterpret_cast<T*>(ptr)->~T();
-		};
-		new (e.ptr) T(std::move(t));
+		auto e = _make_element(std::move(t));
 		std::lock_guard<Mtx> lck{mtx};
 		_elements.emplace_back(e);
 	}
@@ -41,6 +41,10 @@ private:
     vstd::LockFreeArrayQueue<vstd::unique_ptr<HostBufferManager>> _temp_buffers;
     vstd::unique_ptr<HostBufferManager> _temp_buffer;
 
+    // [SINGLETON] 帧内临时 host 内存, 在帧的 fence 之后重置
+    vstd::LockFreeArrayQueue<vstd::unique_ptr<ArenaPoolAllocator>> _frame_arenas;
+    vstd::unique_ptr<ArenaPoolAllocator> _frame_arena;
+
     // [SINGLETON]
 
     // [SINGLETON]
@@ -57,6 +61,10 @@ private:
     TextureUploader _tex_uploader;
     vstd::optional<TexStreamManager> _tex_streamer;
 
+    // compaction budget of the buffer allocator per frame
+    size_t _compact_bytes_per_frame{256ull * 1024ull};
+    float _shrink_occupancy{0.25f};
+
     luisa::spin_mutex _evt_mtx;
     vstd::HashMap<vstd::string, SceneManagerEvent *> _before_render_evts;
     vstd::HashMap<vstd::string, SceneManagerEvent *> _on_frame_end_evts;
@@ -82,6 +90,8 @@ public:
     [[nodiscard]] AccelManager &accel_manager();
     [[nodiscard]] auto &mat_manager() { return _mat_mng; }
     [[nodiscard]] auto &host_upload_buffer() { return *_temp_buffer; }
+    // Valid until the current frame finished on device, nothing allocated from it is destructed
+    [[nodiscard]] auto &frame_arena() { return *_frame_arena; }
     [[nodiscard]] auto &buffer_uploader() { return _uploader; }
     [[nodiscard]] auto &frame_mem_io_list() { return _frame_mem_io_list; }
     void set_io_cmdlist_require_sync() { _io_cmdlist_require_sync = true; }
@@ -58,7 +58,11 @@ struct RBC_RUNTIME_API ShaderManager : RBCStruct {
         ReloadFunc reload_func{nullptr};
         luisa::spin_mutex local_mtx;
         luisa::fiber::event _evt;
+        // wall time of the load or compile, for the startup report
+        float load_ms{0.f};
         bool support_preload{true};
+        // loaded from the manifest before anyone asked for it
+        bool preloaded{false};
         ShaderVariant()
             : _evt(luisa::fiber::event::Mode::Auto) {
         }
@@ -80,7 +84,7 @@ struct RBC_RUNTIME_API ShaderManager : RBCStruct {
 
 private:
     Device &_device;
-    vstd::spin_mutex _mtx;
+    mutable vstd::spin_mutex _mtx;
     luisa::filesystem::path _shader_path;
     std::atomic_uint64_t _all_shader_count{};
     std::atomic_uint64_t _finished_shaders{};
@@ -211,14 +215,21 @@ public:
     fiber::counter reload_shaders(Device &device);
     vstd::unique_ptr<vstd::IRange<string_view>> loaded_shaders() const;
     vstd::vector<char> loaded_shaders_json(luisa::filesystem::path const &shader_path) const;
-    void preload_shaders(
+    // Shaders already known to the manager are skipped, lazy loads of the others wait for their preload.
+    fiber::counter preload_shaders(
         Device &device,
         luisa::filesystem::path const &shader_path,
         vstd::string_view json);
 
-    void preload_shaders(
+    fiber::counter preload_shaders(
         Device &device,
         luisa::filesystem::path const &shader_path,
         vstd::vector<std::pair<vstd::string, vstd::vector<Type const *>>> &&registed_shaders);
+    // Manifest of the shaders used by the last session, kept next to the shaders
+    [[nodiscard]] luisa::filesystem::path manifest_path() const;
+    fiber::counter preload_manifest();
+    bool save_manifest() const;
+    // Logs time-to-first-frame and the load time of every shader, slowest first
+    void report_load_times(double first_frame_ms) const;
 };
 }// namespace rbc
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/basic_types.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/runtime/rhi/pixel.h>
+namespace rbc {
+using namespace luisa;
+using namespace luisa::compute;
+// CPU block-compression encoder, blocks are encoded in parallel on the fiber pool
+struct RBC_RUNTIME_API BCEncoder {
+    enum struct Format : uint32_t {
+        // RGB color, 1-bit alpha is ignored
+        BC1,
+        // RGB color + interpolated alpha
+        BC3,
+        // single channel (R)
+        BC4,
+        // two channels (RG), for tangent-space normals
+        BC5,
+        // RGBA color, higher quality than BC1/BC3 (mode 6 only)
+        BC7,
+        // unsigned HDR RGB from float sources, alpha is dropped (mode 11 only)
+        BC6H
+    };
+    enum struct Quality : uint32_t {
+        // bounding-box endpoints
+        Fast,
+        // principal-axis endpoints + one least-squares refinement
+        Normal,
+        // iterative refinement and exhaustive p-bit/endpoint search
+        High
+    };
+    [[nodiscard]] static PixelStorage pixel_storage(Format format);
+    // FLOAT4 for BC6H, BYTE4 for every other format
+    [[nodiscard]] static PixelStorage source_storage(Format format);
+    [[nodiscard]] static size_t block_size(Format format);
+    [[nodiscard]] static size_t encoded_size(Format format, uint2 size);
+    // src is tightly packed source_storage(format) texels, partial edge blocks clamp to the border
+    static void encode(
+        Format format,
+        Quality quality,
+        luisa::span<std::byte const> src,
+        uint2 size,
+        luisa::span<std::byte> dst);
+    // Decode to source_storage(format) texels, used for validation and error metrics
+    static void decode(
+        Format format,
+        luisa::span<std::byte const> src,
+        uint2 size,
+        luisa::span<std::byte> dst);
+};
+}// namespace rbc
@@ -0,0 +1,28 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/basic_types.h>
+#include <luisa/core/stl/memory.h>
+#include <luisa/runtime/rhi/pixel.h>
+namespace rbc {
+using namespace luisa;
+using namespace luisa::compute;
+// CPU mip chain generation for import-time cooking, rows are filtered in parallel on the fiber pool
+struct RBC_RUNTIME_API MipGenerator {
+    enum struct ColorSpace : uint32_t {
+        Linear,
+        // color channels of 8-bit textures are averaged in linear space, alpha stays linear
+        SRGB
+    };
+    [[nodiscard]] static bool is_supported(PixelStorage storage);
+    // Size of level `level` in the chain, matches the layout used by TextureResource
+    [[nodiscard]] static uint2 level_size(uint2 size, uint level);
+    [[nodiscard]] static size_t chain_size_bytes(PixelStorage storage, uint2 size, uint mip_level);
+    // data holds the whole tightly packed chain with level 0 filled, levels [1, mip_level) are written in place
+    static bool generate(
+        PixelStorage storage,
+        uint2 size,
+        uint mip_level,
+        ColorSpace color_space,
+        luisa::span<std::byte> data);
+};
+}// namespace rbc
@@ -15,7 +15,9 @@
 #include <rbc_graphics/host_buffer_manager.h>
 #include <rbc_core/shared_atomic_mutex.h>
 #include "luisa/core/logging.h"
+#include <luisa/core/clock.h>
 #include "tile_streamer.h"
+#include "vt_cache.h"
 #include <luisa/runtime/sparse_command_list.h>
 
 namespace rbc {
@@ -72,16 +74,26 @@ public:
             return luisa::hash64(&c, sizeof(Coord), luisa::hash64_default_seed);
         }
     };
+    // Per-chunk feedback of one readback, scratch storage reused every frame
+    struct ChunkRequest {
+        uint8_t requested_level;
+        uint8_t dst_level;
+        bool visible;
+        bool evict;
+    };
     struct TexIndex : public luisa::enable_shared_from_this<TexIndex>, RBCStruct {
         BufferAllocator::Node node;
         SparseImage<float> img;
         TexPath path;
         IOFile tex_file;
+        // tile table of a cooked container, empty if tiles are stored raw
+        VTCache cache;
         vector<SparseHeap> heaps;
         TileStreamer streamer;
         uint bindless_idx;
         uint loaded_countdown;
         uint vector_idx{std::numeric_limits<uint>::max()};
+        vstd::vector<ChunkRequest> chunk_requests;
         luisa::move_only_function<void()> init_callback;
         SparseHeap &get_heap(uint2 tile_idx, uint level) {
             uint2 res = streamer.resolution();
@@ -94,6 +106,7 @@ public:
             sz += tile_idx.y * res.x + tile_idx.x;
             return heaps[sz];
         }
+        size_t get_tile_index(uint2 tile_idx, uint level);
         size_t get_byte_offset(uint2 tile_idx, uint level);
         template<typename... Args>
             requires(luisa::is_constructible_v<TileStreamer, Args && ...>)
@@ -116,6 +129,29 @@ public:
         uint offset;
         uint value;
     };
+    struct StreamStats {
+        // chunks the GPU feedback reported as sampled
+        uint64_t feedback_tiles{0};
+        // sampled chunks already resident at (or finer than) the requested level
+        uint64_t resident_tiles{0};
+        uint64_t loaded_tiles{0};
+        uint64_t unloaded_tiles{0};
+        uint64_t evicted_tiles{0};
+        uint64_t prefetched_tiles{0};
+        // bytes read from storage, the compressed size for tiles of a cooked container
+        uint64_t read_bytes{0};
+        // decoded bytes uploaded to sparse tiles, from files and runtime callbacks alike
+        uint64_t upload_bytes{0};
+        [[nodiscard]] double hit_rate() const {
+            return feedback_tiles == 0 ? 1.0 : double(resident_tiles) / double(feedback_tiles);
+        }
+        StreamStats &operator+=(StreamStats const &rhs);
+    };
+    struct PrefetchConfig {
+        // prefetch radius in chunks per world unit/second of camera speed
+        float tiles_per_speed{0.05f};
+        uint max_radius{2};
+    };
 private:
     Device &_device;
     Stream &_async_stream;
@@ -139,6 +175,22 @@ private:
         vstd::vector<shared_ptr<TexIndex>> depended_texs;
     };
     vstd::LockFreeArrayQueue<FrameResource> _frame_res;
+    // compressed tiles read from cooked container, waiting for decode and upload
+    struct DecodeTile {
+        TexIndex *tex_idx;
+        VTCache::Tile tile;
+        uint2 tile_idx;
+        uint level;
+        luisa::vector<std::byte> payload;
+    };
+    struct DecodeBatch {
+        vector<DecodeTile> tiles;
+        FrameResource frame_res;
+    };
+    vstd::LockFreeArrayQueue<DecodeBatch> _decode_batches;
+    std::atomic_uint _pending_decode_batches = 0;
+    uint64_t _last_mem_io_fence = 0;
+    void _decode_tiles();
     vstd::LockFreeArrayQueue<vstd::vector<uint>> _frame_datas;
     struct UInt3Equal {
         bool operator()(uint3 const &a, uint3 const &b) const {
@@ -159,8 +211,15 @@ private:
     mutable std::atomic_size_t _allocated_size{0};
     // Make sure readback processor serial with load & unload
     luisa::spin_mutex _uploader_mtx;
-    size_t _allocate_size_limits;
+    std::atomic_size_t _allocate_size_limits;
     size_t _memoryless_threshold;
+    PrefetchConfig _prefetch_config;
+    std::atomic<float> _camera_speed{0.f};
+    mutable luisa::spin_mutex _stats_mtx;
+    StreamStats _last_frame_stats;
+    StreamStats _total_stats;
+    luisa::Clock _stats_clk;
+    void _mark_evictions(vstd::span<uint const> readback, size_t required_bytes);
     const uint8_t _lru_frame;
     const uint8_t _lru_frame_memoryless;
     IOCommandList _process_readback(vstd::span<uint const> readback, SparseCommandList &map_cmdlist);
@@ -194,6 +253,18 @@ public:
     [[nodiscard]] auto const &level_buffer() const { return _level_buffer.buffer(); }
     [[nodiscard]] auto countdown() const { return _countdown; }
     [[nodiscard]] auto &io_service() { return _io_service; }
+    [[nodiscard]] size_t allocated_size() const { return _allocated_size.load(); }
+    [[nodiscard]] size_t memory_budget() const { return _allocate_size_limits.load(); }
+    // Residency budget of sparse tiles, tiles least recently sampled are evicted first once exceeded
+    void set_memory_budget(size_t bytes) { _allocate_size_limits = bytes; }
+    void set_prefetch_config(PrefetchConfig const &config) { _prefetch_config = config; }
+    // Camera speed (world unit per second) drives neighbor-tile prefetch radius, 0 disables prefetch
+    void set_camera_motion(float camera_speed) { _camera_speed = camera_speed; }
+    [[nodiscard]] StreamStats last_frame_stats() const;
+    [[nodiscard]] StreamStats total_stats() const;
+    // bytes per second uploaded since last reset_stats()
+    [[nodiscard]] double upload_bandwidth() const;
+    void reset_stats();
 
     static const uint chunk_resolution;
     static TexStreamManager *instance();
@@ -0,0 +1,51 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/core/stl/string.h>
+#include <luisa/core/stl/memory.h>
+namespace rbc {
+enum struct VTCodec : uint32_t {
+    None = 0,
+    LZ4 = 1
+};
+// Cooked virtual-texture container:
+// [Header][Tile x tile_count][payloads...]
+// tiles are ordered the same as the raw tiled layout (level-major, row-major inside a level)
+struct RBC_RUNTIME_API VTCache {
+    static constexpr uint32_t magic = 0x43545652u;// "RVTC"
+    static constexpr uint32_t version = 2u;
+    // a raw tiled file is only taken as a container if magic, version and codec all match
+    // and the tile table fits the file
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t tile_count;
+        // codec the container was cooked with, tiles use it or None
+        VTCodec codec;
+        uint64_t tile_size_bytes;
+    };
+    struct Tile {
+        // relative to the container begin
+        uint64_t offset_bytes;
+        uint32_t size_bytes;
+        // tiles that do not shrink are stored raw
+        VTCodec codec;
+    };
+    luisa::vector<Tile> tiles;
+    uint64_t tile_size_bytes{};
+    VTCodec codec{VTCodec::None};
+
+    [[nodiscard]] explicit operator bool() const { return !tiles.empty(); }
+    // tiled_data must be laid out as TextureResource::pack_to_tile produces
+    [[nodiscard]] static luisa::vector<std::byte> cook(
+        luisa::span<std::byte const> tiled_data,
+        uint64_t tile_size_bytes,
+        VTCodec codec);
+    // Return false if the file does not contain a cooked container at offset
+    bool read_table(luisa::string const &path, uint64_t file_offset);
+    static bool decode(
+        Tile const &tile,
+        luisa::span<std::byte const> payload,
+        luisa::span<std::byte> dst);
+};
+}// namespace rbc
@@ -0,0 +1,86 @@
+#pragma once
+#include <rbc_config.h>
+#include <luisa/vstl/pool.h>
+#include <array>
+namespace rbc {
+// Two-level segregated fit suballocator over an offset range, allocate and free are O(1).
+// Bookkeeping lives on the host, so it can manage device buffers.
+struct RBC_RUNTIME_API TLSFAllocator {
+    static constexpr uint32_t sl_index_count_log2 = 5u;
+    static constexpr uint32_t sl_index_count = 1u << sl_index_count_log2;
+    static constexpr uint32_t fl_index_count = 64u - sl_index_count_log2 + 1u;
+
+public:
+    struct RBC_RUNTIME_API Node {
+
+    private:
+        // physical neighbors, ordered by offset
+        Node *_prev_phys{nullptr};
+        Node *_next_phys{nullptr};
+        // free list of the size class, only valid while free
+        Node *_prev_free{nullptr};
+        Node *_next_free{nullptr};
+        size_t _offset{0u};
+        size_t _size{0u};
+        uint64_t _user_data{~0ull};
+        bool _free{false};
+
+    private:
+        friend struct TLSFAllocator;
+
+    public:
+        Node() noexcept;
+        Node(Node &&) noexcept = delete;
+        Node(const Node &) noexcept = delete;
+        Node &operator=(Node &&) noexcept = delete;
+        Node &operator=(const Node &) noexcept = delete;
+        [[nodiscard]] auto offset() const noexcept { return _offset; }
+        [[nodiscard]] auto size() const noexcept { return _size; }
+        [[nodiscard]] auto is_free() const noexcept { return _free; }
+        // next block by offset, free or not
+        [[nodiscard]] auto next() const noexcept { return _next_phys; }
+        // opaque value of the owner, kept until the block is freed
+        [[nodiscard]] auto user_data() const noexcept { return _user_data; }
+        void set_user_data(uint64_t user_data) noexcept { _user_data = user_data; }
+    };
+
+private:
+    vstd::Pool<Node, true> _node_pool;
+    std::array<std::array<Node *, sl_index_count>, fl_index_count> _blocks{};
+    std::array<uint32_t, fl_index_count> _sl_bitmap{};
+    Node *_head{nullptr};
+    Node *_tail{nullptr};
+    uint64_t _fl_bitmap{0u};
+    size_t _size;
+    size_t _alignment;
+    size_t _free_bytes{0u};
+
+private:
+    static void _mapping(size_t size, uint32_t &fl, uint32_t &sl) noexcept;
+    void _insert_free(Node *node) noexcept;
+    void _remove_free(Node *node) noexcept;
+    [[nodiscard]] Node *_search(size_t size) noexcept;
+    void _reset() noexcept;
+
+public:
+    explicit TLSFAllocator(size_t size, size_t alignment) noexcept;
+    ~TLSFAllocator() noexcept;
+    TLSFAllocator(TLSFAllocator &&) noexcept;
+    TLSFAllocator(const TLSFAllocator &) noexcept = delete;
+    [[nodiscard]] Node *allocate(size_t size) noexcept;
+    void free(Node *node) noexcept;
+    [[nodiscard]] auto size() const noexcept { return _size; }
+    [[nodiscard]] auto alignment() const noexcept { return _alignment; }
+    [[nodiscard]] auto free_bytes() const noexcept { return _free_bytes; }
+    // Largest free block, walks one free list
+    [[nodiscard]] size_t largest_free_size() const noexcept;
+    // Block at offset 0, walk the range with Node::next()
+    [[nodiscard]] Node *first_block() const noexcept { return _head; }
+    // End of the last used block, memory after it is free
+    [[nodiscard]] size_t used_end() const noexcept;
+    // Move the used blocks from hole->next() to last down by the size of the free block hole, used for compaction.
+    // Contents are not touched, the caller copies them. Returns the free block that now follows last.
+    Node *slide_down(Node *hole, Node *last) noexcept;
+    void clean_all() noexcept;
+};
+}// namespace rbc
@@ -60,8 +60,9 @@ T *create_object_with_guid(vstd::Guid const &guid) {
 [[nodiscard]] RBC_RUNTIME_API RC<BaseObject> get_object_ref(vstd::Guid const &guid);
 [[nodiscard]] RBC_RUNTIME_API uint64_t object_count();
 [[nodiscard]] RBC_RUNTIME_API BaseObjectType base_type_of(vstd::Guid const &type_id);
-RBC_RUNTIME_API void _zz_clear_dirty_transform();
-RBC_RUNTIME_API void _zz_on_before_rendering();
+// pass parallel = false when no fiber scheduler is bound to the calling thread
+RBC_RUNTIME_API void _zz_clear_dirty_transform(bool parallel = true);
+RBC_RUNTIME_API void _zz_on_before_rendering(bool parallel = true);
 
 template<typename T, BaseObjectType base_type_v>
 struct BaseObjectDerive;
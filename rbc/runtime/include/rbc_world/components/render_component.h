@@ -7,8 +7,10 @@ namespace rbc::world {
 struct MeshResource;
 struct MaterialResource;
 
+void _flush_render_transforms();
 struct RBC_RUNTIME_API RenderComponent final : ComponentDerive<RenderComponent> {
     DECLARE_WORLD_COMPONENT_FRIEND(RenderComponent)
+    friend void _flush_render_transforms();
 private:
     RenderComponent(Entity *entity);
     ~RenderComponent();
@@ -3,6 +3,10 @@
 #include "rbc_world/resources/skelmesh.h"
 #include "rbc_anim/skeletal_mesh.h"
 #include "rbc_world/components/render_component.h"
+#include <luisa/runtime/rtx/aabb.h>
+namespace rbc {
+struct Camera;
+}// namespace rbc
 namespace rbc::world {
 
 struct RBC_RUNTIME_API SkelMeshComponent final : ComponentDerive<SkelMeshComponent> {
@@ -14,6 +18,9 @@ private:
 
     RC<SkelMeshResource> _skel_mesh_ref;// the animatable skeletal mesh resource
     RC<SkeletalMesh> runtime_skel_mesh; // the runtime skeletal mesh
+    // rest pose bounds of the skin mesh, computed on the first update_visibility
+    luisa::compute::AABB _local_bounds{};
+    bool _local_bounds_valid = false;
 
 
 public:
@@ -31,8 +38,12 @@ public:
 
     void StartUpdateRender(RenderComponent &render, luisa::span<RC<MaterialResource> const> mats);
     MeshResource *GetRuntimeMesh() const;
+    SkeletalMesh *GetRuntimeSkeletalMesh() const { return runtime_skel_mesh.get(); }
 
 public:
+    // feed the animation budget with the frustum culling state and screen size of the rest pose bounds,
+    // call once per frame before AnimUpdateSystem::BeginFrame
+    void update_visibility(Camera const &cam);
     void tick(float delta_time = 0.0f);
     void update_render();
     void remove_object();
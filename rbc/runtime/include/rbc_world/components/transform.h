@@ -1,6 +1,7 @@
 #pragma once
 #include <luisa/core/mathematics.h>
 #include <luisa/core/stl/vector.h>
+#include <atomic>
 #include <rbc_world/base_object.h>
 #include <rbc_world/component.h>
 #include <rbc_core/quaternion.h>
@@ -9,8 +10,8 @@ struct Entity;
 
 struct RBC_RUNTIME_API TransformComponent final : ComponentDerive<TransformComponent> {
     DECLARE_WORLD_COMPONENT_FRIEND(TransformComponent)
-    RBC_RUNTIME_API friend void _zz_clear_dirty_transform();
-    RBC_RUNTIME_API friend void _zz_on_before_rendering();
+    RBC_RUNTIME_API friend void _zz_clear_dirty_transform(bool parallel);
+    RBC_RUNTIME_API friend void _zz_on_before_rendering(bool parallel);
 private:
     TransformComponent *_parent{};
     luisa::unordered_set<TransformComponent *> _children;
@@ -18,8 +19,9 @@ private:
     double3 _scale{1, 1, 1};
     Quaternion _rotation;
     double4x4 _trs;
-    bool _dirty : 1 {};
-    bool _decomposed : 1 {true};
+    // set by the first mark_dirty of a frame from any thread, so an id is queued once
+    std::atomic_bool _dirty{};
+    bool _decomposed{true};
     TransformComponent(Entity *entity);
     vstd::HashMap<
         InstanceID,
@@ -30,6 +32,11 @@ private:
     void try_decompose();
     void traversal(double4x4 const &new_trs);
     void _execute_on_update_event();
+    // Merge the ids queued by every thread, resolve them and reset their dirty flags
+    // parallel resolves the buckets with luisa::fiber::parallel, which needs a bound fiber scheduler
+    static void _drain_dirty(luisa::vector<TransformComponent *> &transforms, bool parallel);
+    template<typename Func>
+    static size_t _apply_batch(luisa::span<InstanceID const> ids, bool recursive, bool parallel, Func &&func);
     ~TransformComponent();
 public:
     double3 position();
@@ -54,12 +61,31 @@ public:
         Quaternion const &rotation,
         double3 const &scale,
         bool recursive);
+    // Bulk set_trs for many transforms in one call, e.g. from Python or simulation nodes.
+    // Ids must be unique, unknown ids and non-transform objects are skipped, returns the applied count.
+    // With recursive, transforms that have children are applied first, ancestors before descendants
+    // whatever the batch order, then the leaves. Every value is the final world matrix.
+    // parallel uses luisa::fiber::parallel and needs a fiber scheduler bound to the calling thread.
+    // Matrices are column-major, same as trs().
+    static size_t set_trs_batch(
+        luisa::span<InstanceID const> ids,
+        luisa::span<double4x4 const> trs,
+        bool recursive,
+        bool parallel = true);
+    static size_t set_trs_batch(
+        luisa::span<InstanceID const> ids,
+        luisa::span<double3 const> positions,
+        luisa::span<Quaternion const> rotations,
+        luisa::span<double3 const> scales,
+        bool recursive,
+        bool parallel = true);
     void add_children(TransformComponent *tr);
     bool remove_children(TransformComponent *tr);
     [[nodiscard]] auto const &position() const { return _position; }
     [[nodiscard]] auto const &rotation() const { return _rotation; }
     [[nodiscard]] auto const &scale() const { return _scale; }
     [[nodiscard]] auto const &children() const { return _children; }
+    [[nodiscard]] bool dirty() const { return _dirty.load(std::memory_order_relaxed); }
     [[nodiscard]] double4x4 trs() const {
         return _trs;
     }
@@ -3,16 +3,38 @@
 #include "rbc_world/resources/anim_sequence.h"
 #include "rbc_world/resources/skeleton.h"
 
+namespace tinygltf {
+struct Model;
+}// namespace tinygltf
+
+namespace ozz::animation::offline {
+class OzzImporter;
+class AnimationOptimizer;
+}// namespace ozz::animation::offline
+
 namespace rbc::world {
 
 struct RBC_RUNTIME_API GltfAnimSequenceImporter final : IAnimSequenceImporter {
     [[nodiscard]] luisa::string_view extension() const override { return ".gltf"; }
     [[nodiscard]] bool import(AnimSequenceResource *resource, luisa::filesystem::path const &path) override;
+    // model names must be fixed up by GltfOzzImporter::FixupModelNames, source_name is only used for logging
+    [[nodiscard]] bool import_from_model(AnimSequenceResource *resource, tinygltf::Model const &model, luisa::string_view source_name);
+    // copies the optimization settings into optimizer, per-joint overrides are matched to joint_names by name,
+    // returns the number of overrides applied, source_name is only used for logging
+    static size_t configure_optimizer(
+        ozz::animation::offline::AnimationOptimizer &optimizer,
+        AnimOptimizationOverride const &optimization,
+        luisa::span<const char *const> joint_names,
+        luisa::string_view source_name);
 
     // dependencies
     RC<SkeletonResource> ref_skel;
     luisa::string chosen_anim_name;
     float sampling_rate = 30.0f;
+    AnimOptimizationOverride optimization;
+
+private:
+    bool import_anim(AnimSequenceResource *resource, ozz::animation::offline::OzzImporter &importer, luisa::string_view source_name);
 };
 
 }// namespace rbc::world
\ No newline at end of file
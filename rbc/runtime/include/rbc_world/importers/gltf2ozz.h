@@ -11,6 +11,12 @@ class GltfOzzImporter : public ozz::animation::offline::OzzImporter {
 public:
     GltfOzzImporter();
 
+    // Imports from a document parsed elsewhere, it must outlive the importer and have its names fixed up
+    bool Load(const tinygltf::Model &_model);
+
+    // Gives unnamed or duplicated scenes, nodes and animations unique names, skeleton joints and skin remaps rely on them
+    static bool FixupModelNames(tinygltf::Model &_model);
+
 private:
     bool Load(const char *_filename) override;
 
@@ -55,7 +61,8 @@ private:
     }
 
     tinygltf::TinyGLTF m_loader;
-    tinygltf::Model m_model;
+    tinygltf::Model m_owned_model;
+    const tinygltf::Model *m_model{&m_owned_model};
 };
 
 }// namespace rbc
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <rbc_world/resource_importer.h>
 #include <rbc_world/util/gltf.h>
+#include <rbc_world/util/glb.h>
 
 namespace rbc::world {
 
@@ -11,6 +12,8 @@ struct RBC_RUNTIME_API GltfMeshImporter final : IMeshImporter {
     [[nodiscard]] luisa::string_view extension() const override { return ".gltf"; }
 
     bool import(MeshResource *resource, luisa::filesystem::path const &path) override;
+    // Shares a document already parsed by the caller, e.g. GltfSceneLoader
+    static bool import_from_model(MeshResource *resource, tinygltf::Model const &model);
     static bool import_from_data(MeshResource *resource, GltfImportData &import_data);
 };
 
@@ -21,6 +24,9 @@ struct RBC_RUNTIME_API GlbMeshImporter final : IMeshImporter {
     [[nodiscard]] luisa::string_view extension() const override { return ".glb"; }
 
     bool import(MeshResource *resource, luisa::filesystem::path const &path) override;
+    // Converts straight from the mapped BIN chunk into the mesh host data, primitives in parallel.
+    // The document must be self_contained().
+    static bool import_from_glb(MeshResource *resource, GlbDocument const &doc);
 };
 
 }// namespace rbc::world
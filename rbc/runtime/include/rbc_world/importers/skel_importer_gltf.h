@@ -2,11 +2,24 @@
 
 #include "rbc_world/resources/skeleton.h"
 
+namespace tinygltf {
+struct Model;
+}// namespace tinygltf
+
+namespace ozz::animation::offline {
+class OzzImporter;
+}// namespace ozz::animation::offline
+
 namespace rbc {
 
 struct RBC_RUNTIME_API GltfSkeletonImporter final : ISkeletonImporter {
     [[nodiscard]] luisa::string_view extension() const override { return ".gltf"; }
     [[nodiscard]] bool import(SkeletonResource *resource, luisa::filesystem::path const &path) override;
+    // model names must be fixed up by GltfOzzImporter::FixupModelNames
+    [[nodiscard]] bool import_from_model(SkeletonResource *resource, tinygltf::Model const &model);
+
+private:
+    bool import_skeleton(SkeletonResource *resource, ozz::animation::offline::OzzImporter &importer);
 };
 
 }// namespace rbc
\ No newline at end of file
@@ -8,6 +8,8 @@ namespace rbc {
 struct RBC_RUNTIME_API GltfSkinImporter final : ISkinImporter {
     [[nodiscard]] luisa::string_view extension() const override { return ".gltf"; }
     [[nodiscard]] bool import(SkinResource *resource, luisa::filesystem::path const &path) override;
+    // model names must be fixed up by GltfOzzImporter::FixupModelNames
+    [[nodiscard]] static bool import_from_model(SkinResource *resource, tinygltf::Model const &model);
 };
 
 }// namespace rbc
\ No newline at end of file
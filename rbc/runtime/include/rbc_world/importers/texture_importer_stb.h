@@ -18,6 +18,13 @@ struct RBC_RUNTIME_API StbTextureImporter final : ITextureImporter {
         luisa::filesystem::path const &path,
         uint mip_level,
         bool to_vt) override;
+    // Decodes an encoded image already in memory, e.g. embedded in a glTF buffer, thread-safe
+    [[nodiscard]] static bool import_from_memory(
+        RC<TextureResource> resource,
+        TextureLoader *loader,
+        luisa::span<std::byte const> data,
+        uint mip_level,
+        bool to_vt);
 };
 
 }// namespace rbc::world
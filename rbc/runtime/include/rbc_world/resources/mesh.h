@@ -11,6 +11,8 @@ struct DeviceTransformingMesh;
 }// namespace rbc
 
 namespace rbc::world {
+// uploads the queued host data, runs in _zz_on_before_rendering
+RBC_RUNTIME_API void _flush_dirty_meshes();
 
 struct SkinAttrib {
     uint16_t joint_id;
@@ -21,6 +23,7 @@ struct IMeshImporter;
 
 struct RBC_RUNTIME_API MeshResource final : ResourceBaseImpl<MeshResource> {
     DECLARE_WORLD_OBJECT_FRIEND(MeshResource)
+    friend void _flush_dirty_meshes();
     using BaseType = ResourceBaseImpl<MeshResource>;
     struct CustomProperty {
         size_t offset_bytes;
@@ -42,6 +45,8 @@ private:
     bool _contained_normal : 1 {};
     bool _contained_tangent : 1 {};
     vstd::HashMap<luisa::string, CustomProperty> _custom_properties;
+    // vertex-only / full upload bits, non-zero while queued in _flush_dirty_meshes
+    std::atomic_uint8_t _host_dirty{};
 
     MeshResource();
     ~MeshResource();
@@ -62,6 +67,10 @@ public:
 
     // [pos: float3]  [normal: float3] [tangent: float4] [uvs: float2[]] [triangle: int]
     [[nodiscard]] luisa::vector<std::byte> *host_data();
+    // Host data was edited in place, the device copy is re-uploaded before the next frame renders
+    void mark_host_dirty(bool only_vertex = false);
+    // queued by mark_host_dirty and not yet taken by the next flush
+    [[nodiscard]] bool host_dirty() const { return _host_dirty.load(std::memory_order_relaxed) != 0; }
     [[nodiscard]] bool is_transforming_mesh() const;
     [[nodiscard]] MeshResource *origin_mesh() const { return _origin_mesh.get(); }
 
@@ -1,6 +1,8 @@
 #pragma once
 #include <rbc_world/resource_base.h>
 #include <rbc_plugin/generated/resource_meta.hpp>
+#include <rbc_graphics/texture/vt_cache.h>
+#include <rbc_graphics/texture/bc_encoder.h>
 
 namespace rbc {
 struct DeviceResource;
@@ -13,9 +15,12 @@ struct VTLoadFlag : RCBase {
     std::atomic_bool finished{false};
 };
 struct TextureLoader;
+// uploads the queued host data, runs in _zz_on_before_rendering
+RBC_RUNTIME_API void _flush_dirty_textures();
 
 struct RBC_RUNTIME_API TextureResource final : ResourceBaseImpl<TextureResource> {
     friend struct TextureLoader;
+    friend void _flush_dirty_textures();
     DECLARE_WORLD_OBJECT_FRIEND(TextureResource)
     using BaseType = ResourceBaseImpl<TextureResource>;
 
@@ -28,18 +33,30 @@ private:
     uint32_t _mip_level{};
     RC<VTLoadFlag> _vt_finished{};
     bool _is_vt{};
+    VTCodec _vt_codec{VTCodec::None};
+    std::atomic_bool _host_dirty{};
     TextureResource();
     ~TextureResource();
     void _pack_to_tile_level(uint level, luisa::span<std::byte const> src, luisa::span<std::byte> dst);
 public:
     bool is_vt() const;
     bool pack_to_tile();
+    // Encode every mip level of host data to a block-compressed format on CPU, must be called before pack_to_tile.
+    // The texture must be in BCEncoder::source_storage(format): FLOAT4 for BC6H, BYTE4 otherwise
+    bool compress_to_bc(BCEncoder::Format format, BCEncoder::Quality quality);
+    // Virtual texture saved with a codec is written as a cooked VTCache container
+    void set_vt_codec(VTCodec codec) { _vt_codec = codec; }
+    [[nodiscard]] auto vt_codec() const { return _vt_codec; }
     [[nodiscard]] DeviceImage *get_image() const;
     [[nodiscard]] DeviceSparseImage *get_sparse_image() const;
     [[nodiscard]] auto pixel_storage() const { return _pixel_storage; }
     [[nodiscard]] auto size() const { return _size; }
     [[nodiscard]] auto mip_level() const { return _mip_level; }
     [[nodiscard]] luisa::vector<std::byte> *host_data();
+    // Host data was edited in place, every mip level is re-uploaded before the next frame renders
+    void mark_host_dirty();
+    // queued by mark_host_dirty and not yet taken by the next flush
+    [[nodiscard]] bool host_dirty() const { return _host_dirty.load(std::memory_order_relaxed); }
     [[nodiscard]] uint64_t desire_size_bytes() const;
     [[nodiscard]] uint32_t heap_index() const;
     void create_empty(
@@ -1,19 +1,33 @@
 #pragma once
 #include <rbc_world/resources/texture.h>
-#include <rbc_graphics/texture/pack_texture.h>
+#include <rbc_graphics/texture/mip_generator.h>
 namespace rbc::world {
+// Import-time texture cooking: mips, block compression and tile packing all run on CPU fibers, no device is required
 struct RBC_RUNTIME_API TextureLoader {
 private:
-    vstd::optional<PackTexture> _pack_tex;
-    CommandList _cmdlist;
-    TimelineEvent _event;
-    std::atomic_uint64_t _finished_fence{1};
-    vstd::SingleThreadArrayQueue<std::pair<vstd::function<void()>, uint64_t>> _after_device_task;
-    std::mutex _mtx;
     luisa::fiber::counter _counter;
-    void _try_execute();
+    MipGenerator::ColorSpace _color_space{MipGenerator::ColorSpace::Linear};
+    struct BCCompression {
+        BCEncoder::Format format;
+        BCEncoder::Quality quality;
+    };
+    luisa::optional<BCCompression> _bc_compression;
+    VTCodec _vt_codec{VTCodec::LZ4};
 
 public:
+    // Textures processed after this call are block-compressed on CPU after mip generation:
+    // BYTE4 to format, FLOAT4 (e.g. EXR) to BC6H, every other storage stays uncompressed
+    void set_bc_compression(BCEncoder::Format format, BCEncoder::Quality quality) {
+        _bc_compression = BCCompression{format, quality};
+    }
+    void disable_bc_compression() { _bc_compression.reset(); }
+    // Color space used to filter mips of 8-bit textures processed after this call
+    void set_color_space(MipGenerator::ColorSpace color_space) { _color_space = color_space; }
+    [[nodiscard]] auto color_space() const { return _color_space; }
+    // Virtual textures processed after this call are saved as a VTCache container cooked with codec,
+    // VTCodec::None keeps the raw tiled layout
+    void set_vt_codec(VTCodec codec) { _vt_codec = codec; }
+    [[nodiscard]] auto vt_codec() const { return _vt_codec; }
     void process_texture(RC<TextureResource> const &tex, uint mip_level, bool to_vt);
     void finish_task();
 };
@@ -0,0 +1,88 @@
+#pragma once
+// Streaming GLB access without tinygltf
+#include <rbc_config.h>
+#include <rbc_core/mapped_file.h>
+#include <luisa/core/stl/vector.h>
+#include <luisa/core/stl/string.h>
+#include <array>
+
+namespace rbc::world {
+
+// Accessor resolved against the mapped BIN chunk, elements may be strided
+struct GlbAccessorView {
+    std::byte const *data{nullptr};
+    size_t count{0};
+    size_t stride{0};
+    int component_type{0};// TINYGLTF_COMPONENT_TYPE_*
+    int components{0};
+    bool normalized{false};
+    [[nodiscard]] bool valid() const { return data != nullptr; }
+    [[nodiscard]] size_t element_size() const;
+    [[nodiscard]] std::byte const *element(size_t index) const { return data + index * stride; }
+    // Component c of element index converted to float, normalized integers are mapped to [0, 1]
+    [[nodiscard]] float read_float(size_t index, int c) const;
+    [[nodiscard]] uint32_t read_uint(size_t index, int c) const;
+    // Largest component 0 over all elements, e.g. to range check indices, 0 when empty
+    [[nodiscard]] uint32_t max_uint() const;
+};
+
+struct GlbPrimitive {
+    static constexpr uint32_t max_uv_sets = 8;
+    int mode{-1};
+    int position{-1};
+    int normal{-1};
+    int tangent{-1};
+    std::array<int, max_uv_sets> uvs;
+    int indices{-1};
+    int joints{-1};
+    int weights{-1};
+    GlbPrimitive() { uvs.fill(-1); }
+};
+
+/**
+ * @brief Memory-mapped .glb file
+ * Only the JSON chunk is parsed, and only the parts needed for geometry.
+ * Accessors point straight into the mapped BIN chunk, nothing is copied.
+ */
+struct RBC_RUNTIME_API GlbDocument {
+private:
+    struct Accessor {
+        int buffer_view{-1};
+        size_t byte_offset{0};
+        size_t count{0};
+        int component_type{0};
+        int components{0};
+        bool normalized{false};
+    };
+    struct BufferView {
+        int buffer{-1};
+        size_t byte_offset{0};
+        size_t byte_length{0};
+        size_t byte_stride{0};
+        bool in_bin{false};
+    };
+    MappedFile _file;
+    luisa::string_view _json;
+    luisa::span<std::byte const> _bin;
+    luisa::vector<Accessor> _accessors;
+    luisa::vector<BufferView> _buffer_views;
+    luisa::vector<GlbPrimitive> _primitives;
+    bool _self_contained{true};
+    bool _parse_json();
+
+public:
+    GlbDocument() = default;
+    GlbDocument(GlbDocument const &) = delete;
+    GlbDocument(GlbDocument &&) = default;
+    bool open(luisa::filesystem::path const &path);
+    [[nodiscard]] luisa::string_view json() const { return _json; }
+    [[nodiscard]] luisa::span<std::byte const> bin() const { return _bin; }
+    // false if any buffer view lives outside the BIN chunk (external .bin or data URI)
+    [[nodiscard]] bool self_contained() const { return _self_contained; }
+    // primitives of all meshes, in declaration order
+    [[nodiscard]] luisa::span<GlbPrimitive const> primitives() const { return _primitives; }
+    // invalid view for missing or out of range accessors
+    [[nodiscard]] GlbAccessorView accessor(int index) const;
+};
+
+}// namespace rbc::world
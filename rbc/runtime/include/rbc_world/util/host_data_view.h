@@ -0,0 +1,57 @@
+#pragma once
+// Layout of resource host data for external views, e.g. the NumPy views of the python bindings
+#include <rbc_config.h>
+#include <luisa/core/basic_types.h>
+#include <luisa/core/stl/optional.h>
+#include <luisa/core/stl/span.h>
+#include <luisa/runtime/rhi/pixel.h>
+#include <cstddef>
+
+namespace rbc::world {
+struct MeshResource;
+
+// Byte offsets of the attribute ranges in MeshResource::host_data, same order as DeviceMesh::get_mesh_size
+struct RBC_RUNTIME_API MeshHostLayout {
+    size_t normal{};
+    size_t tangent{};
+    size_t uv{};// uv channel c starts at uv + c * vertex_count * sizeof(float2)
+    size_t triangle{};
+    size_t end{};
+    explicit MeshHostLayout(MeshResource const &mesh);
+};
+
+// Byte range of one mip level in TextureResource::host_data, levels are stored back to back
+struct TextureLevelRange {
+    size_t offset{};
+    size_t size{};
+};
+[[nodiscard]] RBC_RUNTIME_API TextureLevelRange texture_level_range(luisa::compute::PixelStorage storage, luisa::uint2 size, uint32_t level);
+
+// Strides of a source array resolved against (rows, cols) destination elements,
+// element c of a row sits at (c / row_inner) * mid_stride + (c % row_inner) * col_stride
+struct StridedRows {
+    ptrdiff_t row_stride{};
+    ptrdiff_t mid_stride{};
+    ptrdiff_t col_stride{};
+    size_t row_inner{};
+};
+// Accepts a (rows, cols) source, with inner > 0 also (rows, cols / inner, inner) whose two trailing axes form one row.
+// Strides are in bytes, returns nullopt for any other shape.
+[[nodiscard]] RBC_RUNTIME_API luisa::optional<StridedRows> resolve_strided_rows(
+    luisa::span<ptrdiff_t const> shape,
+    luisa::span<ptrdiff_t const> strides,
+    size_t element_size,
+    size_t rows,
+    size_t cols,
+    size_t inner = 0);
+// Copies (rows, cols) elements into dst, whose rows are dst_stride bytes apart (float3 rows are padded to 16 bytes)
+RBC_RUNTIME_API void copy_strided_rows(
+    StridedRows const &layout,
+    std::byte const *src,
+    std::byte *dst,
+    size_t rows,
+    size_t cols,
+    size_t element_size,
+    size_t dst_stride);
+
+}// namespace rbc::world
@@ -1,5 +1,8 @@
 #include "rbc_anim/graph/AnimNode_SequencePlayer.h"
 #include "rbc_anim/anim_record.h"
+#include "rbc_anim/anim_instance.h"
+#include "rbc_anim/bone_container.h"
+#include "rbc_anim/system/anim_update_system.h"
 #include <tracy_wrapper.h>
 
 namespace rbc {
@@ -30,7 +33,32 @@ void AnimNode_SequencePlayer::Evaluate_AnyThread(PoseContext &Output) {
         extract_ctx.current_time = internal_time_accumulator;
         // extract_ctx.delta_time_record = delta_time_record;
 
+        auto &update_system = AnimUpdateSystem::instance();
+        auto &pose_cache = update_system.GetPoseCache();
+        // a single skeletal mesh has nobody to share with, skip the copies
+        if (!pose_cache.bEnabled || update_system.GetNumRegistered() < 2) {
+            anim_seq->ref_seq().GetAnimationPose(pose_data, extract_ctx);
+            return;
+        }
+        // instances sharing graph, clip, time and skeleton sample once per frame
+        float sample_time = internal_time_accumulator;
+        AnimPoseCacheKey key;
+        key.graph = Output.anim_instance_proxy ? Output.anim_instance_proxy->GetAnimInstanceObject()->GetAnimGraph() : nullptr;
+        key.clip = anim_seq;
+        key.skeleton = Output.Pose.GetBoneContainer().GetReferenceSkeleton();
+        key.node_id = NodeID;
+        key.quantized_time = pose_cache.QuantizeTime(sample_time);
+        key.num_soa_bones = Output.Pose.GetNumBones();
+        auto &bones = Output.Pose.GetBones();
+        if (auto cached = pose_cache.Find(key)) {
+            for (auto i = 0; i < bones.size(); i++) {
+                bones[i] = (*cached)[i];
+            }
+            return;
+        }
+        extract_ctx.current_time = sample_time;
         anim_seq->ref_seq().GetAnimationPose(pose_data, extract_ctx);
+        pose_cache.Add(key, bones);
     } else {
         Output.ResetToRefPose();
     }
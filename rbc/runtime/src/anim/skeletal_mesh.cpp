@@ -1,466 +1,519 @@
-#include "rbc_config.h"
-#include "rbc_anim/skeletal_mesh.h"
-#include "rbc_anim/anim_instance.h"
-#include "rbc_anim/animation_runtime.h"
-#include "rbc_anim/render/skelmesh_render_cpu_skin.h"
-#include "rbc_core/memory.h"
-
-namespace rbc {
-
-bool SkeletalMesh::InitAnim() {
-    if (bInitialized) { return true; }
-
-    ref_skeleton = ref_skelmesh->ref_skeleton;
-    ref_skin = ref_skelmesh->ref_skin;
-
-    auto *skelmesh = GetSkelMeshResource();
-    // initialize anim instance
-    anim_instance = RC<AnimInstance>::New();
-    anim_instance->InitAnimInstance(skelmesh->ref_anim_graph);// binding node graph
-    anim_instance->BindSkelMesh(this);
-    anim_instance->InitializeAnimation();// init AnimNodeProxy and parse node graph
-
-    // const SkinResource *skin = GetSkinResource().get_installed();
-    // const MeshResource *mesh = GetSkinResource().get_installed()->ref_mesh.get_installed();
-    // all done, init anim internally
-    InitAnim_Internal();
-    bInitialized = true;
-    return true;
-}
-
-void SkeletalMesh::DestroyAnim() {
-    anim_instance.reset();
-    bInitialized = false;
-}
-
-void SkeletalMesh::AllocateTransformData() {
-    // Allocate Transform SwapBuffer base on NumBones
-    const int32_t NumBones = GetRefSkeleton().GetNumBones();
-    if (GetNumComponentSpaceTransforms() != NumBones) {
-        for (auto &comp_space_transforms : ComponentSpaceTransformsArray) {
-            LUISA_INFO("Allocating ComponentSpace Transform with {} Bones", NumBones);
-            comp_space_transforms.clear();
-            comp_space_transforms.resize_uninitialized(NumBones);
-            // Initialize with Identity
-            for (auto i = 0; i < NumBones; i++) {
-                comp_space_transforms[i] = AnimFloat4x4::identity();
-            }
-        }
-    }
-    bHasValidBoneTransform = false;
-    // Reset the animation stuff when changing mesh.
-}
-
-void SkeletalMesh::DeallocateTransformData() {
-    LUISA_INFO("Deallocate Transform Data");
-    for (auto &comp_space_transform : ComponentSpaceTransformsArray) {
-        comp_space_transform.clear();
-    }
-}
-
-void SkeletalMesh::InitAnim_Internal() {
-    LUISA_INFO("InitAnim_Internal");
-    render_data = luisa::make_unique<SkeletalMeshRenderData>();
-    render_data->static_mesh_ = ref_skelmesh->ref_skin->ref_mesh.get();
-    render_data->InitializeWithRefSkeleton(GetRefSkeleton());
-
-    AllocateTransformData();// 从asset中复制一份到当前SkeletalMesh作为运行时ComponentSpace的DualBuffer
-    RecalcRequiredBones(GetPredictedLODLevel());
-    ResetToRefPose();
-    RefreshBoneTransforms();
-    // UpdateComponentToWorlds
-}
-
-// RAII Phase End
-// ====================================================================
-
-// ========================= GameThread Phase =========================
-void SkeletalMesh::Tick(float InDeltaTime_s) {
-    // LUISA_INFO("SkelMesh Ticking..");
-    // LOD Changed?
-    TickPose(InDeltaTime_s);// Do Update Here
-    RefreshBoneTransforms();// Dispatch Evaluation Tasks Here
-}
-
-void SkeletalMesh::TickPose(float InDeltaTime_s) {
-    // Control Tick Rate
-    TickAnimation(InDeltaTime_s, true);
-}
-
-void SkeletalMesh::TickAnimation(float InDeltaTime_s, bool bNeedsValidRootMotion) {
-    if (!bAnimationEnabled) { return; }
-    if (!bRequiredBonesUpToDate) {
-        RecalcRequiredBones(GetPredictedLODLevel());
-    }
-    // TickAnimationInstance
-    // bNeedsQueuedAnimEventsDispatched = true
-    TickAnimInstances(InDeltaTime_s, bNeedsValidRootMotion);
-    // Conditionally Dispatch Events
-}
-
-void SkeletalMesh::TickAnimInstances(float InDeltaTime_s, bool bNeedsValidRootMotion) {
-    if (!bAnimationEnabled) { return; }
-    // {PreUpdateLinkedInstances}
-    // {LinkedInstance->UpdateAnimation}
-    if (anim_instance) {
-        anim_instance->UpdateAnimation(InDeltaTime_s, bNeedsValidRootMotion, AnimInstance::EUpdateAnimationFlag::ForceParallelUpdate);
-    }
-}
-// GameThread Tick Phase End
-// ====================================================================
-
-void SkeletalMesh::FlipEditableSpaceBases() {
-    if (bNeedToFlipSpaceBaseBuffers) {
-        bNeedToFlipSpaceBaseBuffers = false;
-        CurrentEditableComponentTransformsIdx = 1 - CurrentEditableComponentTransformsIdx;
-        CurrentReadComponentTransformsIdx = 1 - CurrentReadComponentTransformsIdx;
-        // Update Queue
-        // Update Revision Number
-    }
-}
-
-void SkeletalMesh::SetBoneSpaceTransforms(luisa::span<const AnimSOATransform> InBoneSpaceTransforms) {
-    BoneSpaceTransforms.resize_uninitialized(InBoneSpaceTransforms.size());
-    for (auto i = 0; i < InBoneSpaceTransforms.size(); i++) {
-        BoneSpaceTransforms[i] = InBoneSpaceTransforms[i];
-    }
-}
-
-bool SkeletalMesh::ShouldBlendPhysicsBones() {
-    return false;// 当前不需要考虑PhysicsBones
-}
-
-luisa::shared_ptr<BoneContainer> SkeletalMesh::GetSharedRequiredBones() {
-    if (shared_required_bones == nullptr) {
-        shared_required_bones = luisa::make_shared<BoneContainer>();
-    }
-    return shared_required_bones;
-}
-
-void SkeletalMesh::ResetToRefPose() {
-    LUISA_INFO("Reseting To RefPose");
-    // asset rest pose -> BoneSpace
-    auto rest_view = GetRefSkeleton().JointRestPoses();
-    SetBoneSpaceTransforms(rest_view);
-    // Initial BoneSpace -> Editing Component Space
-    FillComponentSpaceTransforms(BoneSpaceTransforms, FillComponentSpaceTransformsRequiredBones, GetEditableComponentSpaceTransforms());
-
-    // Editing ComponentSpace -> Reading ComponentSpace
-    //! Flip Editable Space Bases 1
-    bNeedToFlipSpaceBaseBuffers = true;
-    FlipEditableSpaceBases();
-}
-
-void SkeletalMesh::RefreshBoneTransforms() {
-    if (!bAnimationEnabled) { return; }
-    const bool bShouldDoEvaluation = true;
-    const bool bShouldDoInterpolation = false;
-    const bool bDoParallelEvaluation = true;
-
-    //! Initialize Anim Evaluation Context ==> CompleteParallelAnimationEvaluation to clear
-    anim_eval_context.Init(anim_instance.get(), this);
-
-    anim_eval_context.bDoEvaluation = bShouldDoEvaluation;
-    anim_eval_context.bDoInterpolation = bShouldDoInterpolation;
-
-    // Duplicate to cache bones
-    // force ref pos
-    // dispatch task
-    if (bDoParallelEvaluation) {
-        DispatchParallelEvaluationTasks();
-    }
-}
-
-void SkeletalMesh::RecalcRequiredBones(int32_t LODIndex) {
-    ComputeRequiredBones(RequiredBones, FillComponentSpaceTransformsRequiredBones, LODIndex);
-    // Reset Anim Pose to Reference Pose
-    auto ref_pose = GetRefSkeleton().JointRestPoses();
-    BoneSpaceTransforms.resize_uninitialized(ref_pose.size());
-    for (auto i = 0; i < ref_pose.size(); i++) {
-        BoneSpaceTransforms[i] = ref_pose[i];
-    }
-    LUISA_INFO("Reset BoneSpace Transforms with RestPose with {} SOABones", ref_pose.size());
-
-    // Clear Cached Bone Containers
-    if (anim_instance) {
-        anim_instance->RecalcRequiredBones();
-    }
-    // For Linked Instance, RecalcRequiredBones
-    // For PostAnimInstance, RecalcRequiredBones
-    // Mark Curve Up to date
-    // Invalidate Cached Bones
-    bRequiredBonesUpToDate = true;
-    // Broadcast Messages
-}
-void SkeletalMesh::RecalcRequiredCurves() {
-    RBC_UNIMPLEMENTED();
-}
-
-void SkeletalMesh::ComputeRequiredBones(luisa::vector<BoneIndexType> &OutRequiredBones, luisa::vector<BoneIndexType> &OutFillComponentSpaceTransformRequiredBones, int32_t LODIndex) const {
-    OutRequiredBones.clear();
-    OutFillComponentSpaceTransformRequiredBones.clear();
-
-    auto *skelmesh = GetSkelMeshResource();
-    if (!render_data) {
-        LUISA_ERROR("SkeletalMesh has no render data!");
-        return;
-    }
-    OutRequiredBones = render_data->required_bones;// Copy from render data
-    AnimationRuntime::EnsureParentsPresent(OutRequiredBones, GetRefSkeleton());
-    luisa::sort(OutRequiredBones.begin(), OutRequiredBones.end());
-}
-
-void SkeletalMesh::CreateRenderState_Concurrent(RenderDevice *device) {
-    if (bUseGPUSkin) {
-        LUISA_ERROR("GPUSkin Unimplemented");
-        RBC_UNIMPLEMENTED();
-        // render_object_ = SkrNew<SkeletalMeshRenderObjectGPUSkin>(this, InRenderDevice);
-    } else {
-        LUISA_INFO("Creating CPUSkin RenderObject");
-        render_object_ = RBCNew<SkeletalMeshRenderObjectCPUSkin>(this, device);
-    }
-    bRenderStateCreated = true;
-}
-
-void SkeletalMesh::DestroyRenderState_Concurrent() {
-    if (render_object_) {
-        render_object_->ReleaseResources();
-        RBCDelete(render_object_);
-    }
-
-    DeallocateTransformData();
-    bRenderStateCreated = false;
-}
-
-void SkeletalMesh::DoDeferredRenderUpdate_Concurrent(AnimRenderState &state) {
-    if (bRenderTransformDirty) {
-    }
-    if (bRenderDynamicDataDirty) {
-        SendRenderDynamicData_Concurrent(state);
-    }
-}
-
-void SkeletalMesh::SendRenderDynamicData_Concurrent(AnimRenderState &state) {
-    bRenderDynamicDataDirty = false;
-    {
-        // cycle counter
-        int32_t useLOD = GetPredictedLODLevel();
-
-        SkinResource &ref_skin = GetSkinResource();
-        if (ref_skin.loaded()) {
-            SkeletalMeshSceneProxyDynamicData data{this};
-            render_object_->Update(state, 0, data, &ref_skin);
-            bForceMeshObjectUpdate = false;
-        }
-    }
-}
-
-void SkeletalMesh::PerformAnimationProcessing(SkeletalMesh *InSkeletalMesh, AnimInstance *InAnimInstance, bool bInDoEvaluation, bool bForceRefPose, luisa::vector<AnimSOATransform> &OutBoneSpaceTransforms, luisa::vector<AnimFloat4x4> &OutComponentSpaceTransforms) {
-    if (!InSkeletalMesh) { return; }
-    // update anim instance
-    if (InAnimInstance && InAnimInstance->NeedsUpdate()) {
-        InAnimInstance->ParallelUpdateAnimation();
-    }
-
-    // do nothing of no output required
-    // SKR_LOG_FMT_INFO(u8"Processing Animation Process withOutBoneSpaceTransforms {}", OutBoneSpaceTransforms.size());
-
-    if (bInDoEvaluation && OutBoneSpaceTransforms.size() > 0) {
-        CompactPose EvaluatedPose;
-        EvaluateAnimation(InSkeletalMesh, InAnimInstance, bForceRefPose, EvaluatedPose);
-        EvaluatePostProcessMeshInstance();
-        FinalizePoseEvaluationResult(this, OutBoneSpaceTransforms, EvaluatedPose);
-        // FinalizeAttributeEvaluationResults(EvaluatedPose.GetBoneContainer(), Attributes, OutAttributes);
-        // LocalAtoms
-        InSkeletalMesh->FillComponentSpaceTransforms(OutBoneSpaceTransforms, FillComponentSpaceTransformsRequiredBones, OutComponentSpaceTransforms);
-    }
-}
-
-void SkeletalMesh::EvaluateAnimation(SkeletalMesh *InSkelMesh, AnimInstance *InAnimInstance, bool bInForceRefPose, CompactPose &OutPose) const {
-    // OutputRootBoneTranslation
-    // OutCurve
-    // OutPose
-    // OutAttributes
-    if (!InSkelMesh) {
-        return;
-    }
-    {
-        // Construct Evaluation Data
-        ParallelEvaluationData OutData{OutPose};
-        InAnimInstance->ParallelEvaluateAnimation(bInForceRefPose, InSkelMesh, OutData);
-    }
-}
-
-void SkeletalMesh::EvaluatePostProcessMeshInstance() {
-    // placeholder for postprocess eval
-}
-
-void SkeletalMesh::ParallelUpdateAnimation() {
-    // actual update animation instance state
-    // SKR_LOG_INFO(u8"ParallelUpdateAnimation");
-}
-
-void SkeletalMesh::ParallelDuplicateAndInterpolate() {}
-
-luisa::vector<AnimFloat4x4> &SkeletalMesh::GetEditableComponentSpaceTransforms() {
-    return ComponentSpaceTransformsArray[CurrentEditableComponentTransformsIdx];
-}
-
-const luisa::vector<AnimFloat4x4> &SkeletalMesh::GetComponentSpaceTransforms() const {
-    return ComponentSpaceTransformsArray[CurrentReadComponentTransformsIdx];
-}
-
-size_t SkeletalMesh::GetNumComponentSpaceTransforms() const {
-    return GetComponentSpaceTransforms().size();
-}
-
-//! IMPORTANT: Perform Local To Model Job
-void SkeletalMesh::FillComponentSpaceTransforms(luisa::span<const AnimSOATransform> InBoneSpaceTransforms, luisa::span<const BoneIndexType> InFillComponentSpaceTransformsRequiredBones, luisa::vector<AnimFloat4x4> &OutComponentSpaceTransforms) const {
-    const auto NumBones = InBoneSpaceTransforms.size();
-    if (NumBones <= 0) {
-        return;
-    }
-    LUISA_INFO("Running LocalToMotion Job");
-    AnimLocalToModelJob ltm_job;
-    ltm_job.skeleton = &(GetRefSkeleton().GetRawSkeleton());
-    ltm_job.input = {
-        (const AnimSOATransform *)InBoneSpaceTransforms.data(),
-        InBoneSpaceTransforms.size()};
-    ltm_job.output = {
-        (AnimFloat4x4 *)OutComponentSpaceTransforms.data(),
-        OutComponentSpaceTransforms.size()};
-    if (!ltm_job.Run()) {
-        LUISA_ERROR("Failed to run LocalToModelJob");
-    }
-
-}// namespace skr
-
-void SkeletalMesh::SwapEvaluationContextBuffers() {
-    LUISA_INFO("Swaping Evaluation Context Buffer");
-    std::swap(anim_eval_context.BoneSpaceTransforms, BoneSpaceTransforms);
-    std::swap(anim_eval_context.ComponentSpaceTransforms, GetEditableComponentSpaceTransforms());
-}
-
-/**
- * FinalizePoseEvaluationResult
- * ====================================================
- * Get output bone space transforms from final pose generated by AnimGraph execution
- */
-void SkeletalMesh::FinalizePoseEvaluationResult(const SkeletalMesh *InSkelMesh, luisa::vector<AnimSOATransform> &OutBoneSpaceTransforms, CompactPose &InFinalPose) {
-    const luisa::span<const AnimSOATransform> ref_bone_pose = GetRefSkeleton().JointRestPoses();
-    OutBoneSpaceTransforms.resize_uninitialized(ref_bone_pose.size());
-    for (auto i = 0; i < ref_bone_pose.size(); i++) {
-        OutBoneSpaceTransforms[i] = ref_bone_pose[i];
-    }
-
-    if (InFinalPose.IsValid() && InFinalPose.GetNumBones() > 0) {
-
-        InFinalPose.NormalizeRotation();
-        const auto FillReferencePose = [&](int32_t begin_index, int32_t end_index) {
-            for (int32_t mesh_pose_index = begin_index; mesh_pose_index < end_index; ++mesh_pose_index) {
-                OutBoneSpaceTransforms[mesh_pose_index] = ref_bone_pose[mesh_pose_index];
-            }
-        };
-
-        int32_t last_pose_index = 0;
-        const int32_t bone_count = ref_bone_pose.size();
-        // OutBoneSpaceTransforms.resize_default(bone_count);
-        for (auto i = 0; i < bone_count; i++) {
-            OutBoneSpaceTransforms[i] = InFinalPose.GetBones()[i];
-        }
-    }
-}
-
-void SkeletalMesh::FinalizeBoneTransforms() {
-    FlipEditableSpaceBases();// 将写入完成的BoneSpace翻转到读取Space
-    bHasValidBoneTransform = true;
-}
-
-void SkeletalMesh::FinalizeAnimationUpdate() {
-    // flip bone buffers and post anim notification
-    FinalizeBoneTransforms();
-    // [NOT_IMPLEMENTED]: UpdateChildTransforms() UpdateOverlaps() UpdateBounds()
-    MarkRenderTransformDirty();
-    MarkRenderDynamicDataDirty();
-}
-
-void SkeletalMesh::PostAnimEvaluation() {
-    // actual do post anim evaluation
-    // - If Interpolation
-
-    if (bDuplicateToCacheBones) {
-    }
-    if (bDoEvaluation) {
-        // update curves
-        // update morph targets
-        // DoInstanceEvaluation()
-        //! 更新状态，需要翻转骨骼
-        bNeedToFlipSpaceBaseBuffers = true;
-
-        if (!ShouldBlendPhysicsBones()) {
-            // flip bone buffer and request render
-            FinalizeAnimationUpdate();
-        }
-    }
-}
-
-// get & set
-void SkeletalMesh::MarkRenderTransformDirty() { bRenderTransformDirty = true; }
-void SkeletalMesh::MarkRenderDynamicDataDirty() { bRenderDynamicDataDirty = true; }
-bool SkeletalMesh::IsDynamicDataDirty() const { return bRenderDynamicDataDirty; }
-void SkeletalMesh::EnableAnimation() { bAnimationEnabled = true; }
-void SkeletalMesh::DisableAnimation() { bAnimationEnabled = false; }
-bool SkeletalMesh::IsAnimationEnabled() const { return bAnimationEnabled; }
-
-// Task Interface
-// ================================================================================
-// 这部分函数会在未来改为Workgraph异步Task，在开发过程中暂时保持同步，方便其他部分
-// ================================================================================
-void SkeletalMesh::DispatchParallelEvaluationTasks() {
-    SwapEvaluationContextBuffers();// edit buffers -> context buffers
-    ParallelAnimationEvaluation(); // do evaluation
-
-    CompleteParallelAnimationEvaluation(true);
-}
-
-void SkeletalMesh::ParallelAnimationEvaluation() {
-
-    if (anim_eval_context.bDoInterpolation) {
-        LUISA_INFO("Perform Animation with Interop");
-        PerformAnimationProcessing(
-            anim_eval_context.skel_mesh,
-            anim_eval_context.anim_instance,
-            anim_eval_context.bDoEvaluation,
-            false,
-            anim_eval_context.CachedBoneSpaceTransforms,
-            anim_eval_context.CachedComponentSpaceTransforms);
-    } else {
-        LUISA_INFO("Perform Animation with No Interop");
-        PerformAnimationProcessing(
-            anim_eval_context.skel_mesh,
-            anim_eval_context.anim_instance,
-            anim_eval_context.bDoEvaluation,
-            false,
-            anim_eval_context.BoneSpaceTransforms,
-            anim_eval_context.ComponentSpaceTransforms);
-    }
-
-    // actual sampling and fetch current pose
-    // SKR_LOG_INFO(u8"ParallelEvaluateAnimationAnimation");
-}
-
-void SkeletalMesh::CompleteParallelAnimationEvaluation(bool bDoPostAnimEvaluation) {
-    // TODO: Release current ParallelEvaluationTask list
-    if (bDoPostAnimEvaluation) {
-        // swap back
-        SwapEvaluationContextBuffers();
-        PostAnimEvaluation();
-    }
-    anim_eval_context.Clear();
-}
-
-// ================================================================================
-// Task Interface End
-// ================================================================================
-
+#include "rbc_config.h"
+#include "rbc_anim/skeletal_mesh.h"
+#include "rbc_anim/anim_instance.h"
+#include "rbc_anim/animation_runtime.h"
+#include "rbc_anim/render/skelmesh_render_cpu_skin.h"
+#include "rbc_core/memory.h"
+#include <luisa/core/clock.h>
+
+namespace rbc {
+
+bool SkeletalMesh::InitAnim() {
+    if (bInitialized) { return true; }
+
+    ref_skeleton = ref_skelmesh->ref_skeleton;
+    ref_skin = ref_skelmesh->ref_skin;
+
+    auto *skelmesh = GetSkelMeshResource();
+    // initialize anim instance
+    anim_instance = RC<AnimInstance>::New();
+    anim_instance->InitAnimInstance(skelmesh->ref_anim_graph);// binding node graph
+    anim_instance->BindSkelMesh(this);
+    anim_instance->InitializeAnimation();// init AnimNodeProxy and parse node graph
+
+    // const SkinResource *skin = GetSkinResource().get_installed();
+    // const MeshResource *mesh = GetSkinResource().get_installed()->ref_mesh.get_installed();
+    // all done, init anim internally
+    InitAnim_Internal();
+    AnimUpdateSystem::instance().Register(this);
+    bInitialized = true;
+    return true;
+}
+
+void SkeletalMesh::DestroyAnim() {
+    AnimUpdateSystem::instance().Unregister(this);
+    anim_instance.reset();
+    bInitialized = false;
+}
+
+void SkeletalMesh::AllocateTransformData() {
+    // Allocate Transform SwapBuffer base on NumBones
+    const int32_t NumBones = GetRefSkeleton().GetNumBones();
+    if (GetNumComponentSpaceTransforms() != NumBones) {
+        for (auto &comp_space_transforms : ComponentSpaceTransformsArray) {
+            LUISA_INFO("Allocating ComponentSpace Transform with {} Bones", NumBones);
+            comp_space_transforms.clear();
+            comp_space_transforms.resize_uninitialized(NumBones);
+            // Initialize with Identity
+            for (auto i = 0; i < NumBones; i++) {
+                comp_space_transforms[i] = AnimFloat4x4::identity();
+            }
+        }
+    }
+    bHasValidBoneTransform = false;
+    // Reset the animation stuff when changing mesh.
+}
+
+void SkeletalMesh::DeallocateTransformData() {
+    LUISA_INFO("Deallocate Transform Data");
+    for (auto &comp_space_transform : ComponentSpaceTransformsArray) {
+        comp_space_transform.clear();
+    }
+}
+
+void SkeletalMesh::InitAnim_Internal() {
+    LUISA_INFO("InitAnim_Internal");
+    render_data = luisa::make_unique<SkeletalMeshRenderData>();
+    render_data->static_mesh_ = ref_skelmesh->ref_skin->ref_mesh.get();
+    render_data->InitializeWithRefSkeleton(GetRefSkeleton());
+
+    AllocateTransformData();// 从asset中复制一份到当前SkeletalMesh作为运行时ComponentSpace的DualBuffer
+    RecalcRequiredBones(GetPredictedLODLevel());
+    ResetToRefPose();
+    RefreshBoneTransforms();
+    // UpdateComponentToWorlds
+}
+
+// RAII Phase End
+// ====================================================================
+
+// ========================= GameThread Phase =========================
+void SkeletalMesh::Tick(float InDeltaTime_s) {
+    // LUISA_INFO("SkelMesh Ticking..");
+    // LOD Changed?
+    luisa::Clock clk;
+    // Update Rate Optimization, skipped frames only accumulate delta time
+    if (update_rate_params.Advance(InDeltaTime_s, !bHasValidBoneTransform)) {
+        TickPose(update_rate_params.ConsumeDeltaTime());// Do Update Here
+    }
+    RefreshBoneTransforms();// Dispatch Evaluation Tasks Here
+    update_rate_params.RecordTickCost(static_cast<float>(clk.toc()), AnimUpdateSystem::instance().settings.CostSmoothing);
+}
+
+void SkeletalMesh::TickPose(float InDeltaTime_s) {
+    // Control Tick Rate
+    TickAnimation(InDeltaTime_s, true);
+}
+
+void SkeletalMesh::TickAnimation(float InDeltaTime_s, bool bNeedsValidRootMotion) {
+    if (!bAnimationEnabled) { return; }
+    if (!bRequiredBonesUpToDate) {
+        RecalcRequiredBones(GetPredictedLODLevel());
+    }
+    // TickAnimationInstance
+    // bNeedsQueuedAnimEventsDispatched = true
+    TickAnimInstances(InDeltaTime_s, bNeedsValidRootMotion);
+    // Conditionally Dispatch Events
+}
+
+void SkeletalMesh::TickAnimInstances(float InDeltaTime_s, bool bNeedsValidRootMotion) {
+    if (!bAnimationEnabled) { return; }
+    // {PreUpdateLinkedInstances}
+    // {LinkedInstance->UpdateAnimation}
+    if (anim_instance) {
+        anim_instance->UpdateAnimation(InDeltaTime_s, bNeedsValidRootMotion, AnimInstance::EUpdateAnimationFlag::ForceParallelUpdate);
+    }
+}
+// GameThread Tick Phase End
+// ====================================================================
+
+void SkeletalMesh::FlipEditableSpaceBases() {
+    if (bNeedToFlipSpaceBaseBuffers) {
+        bNeedToFlipSpaceBaseBuffers = false;
+        CurrentEditableComponentTransformsIdx = 1 - CurrentEditableComponentTransformsIdx;
+        CurrentReadComponentTransformsIdx = 1 - CurrentReadComponentTransformsIdx;
+        // Update Queue
+        // Update Revision Number
+    }
+}
+
+void SkeletalMesh::SetBoneSpaceTransforms(luisa::span<const AnimSOATransform> InBoneSpaceTransforms) {
+    BoneSpaceTransforms.resize_uninitialized(InBoneSpaceTransforms.size());
+    for (auto i = 0; i < InBoneSpaceTransforms.size(); i++) {
+        BoneSpaceTransforms[i] = InBoneSpaceTransforms[i];
+    }
+}
+
+bool SkeletalMesh::ShouldBlendPhysicsBones() {
+    return false;// 当前不需要考虑PhysicsBones
+}
+
+luisa::shared_ptr<BoneContainer> SkeletalMesh::GetSharedRequiredBones() {
+    if (shared_required_bones == nullptr) {
+        shared_required_bones = luisa::make_shared<BoneContainer>();
+    }
+    return shared_required_bones;
+}
+
+void SkeletalMesh::ResetToRefPose() {
+    LUISA_INFO("Reseting To RefPose");
+    // asset rest pose -> BoneSpace
+    auto rest_view = GetRefSkeleton().JointRestPoses();
+    SetBoneSpaceTransforms(rest_view);
+    // Initial BoneSpace -> Editing Component Space
+    FillComponentSpaceTransforms(BoneSpaceTransforms, FillComponentSpaceTransformsRequiredBones, GetEditableComponentSpaceTransforms());
+
+    // Editing ComponentSpace -> Reading ComponentSpace
+    //! Flip Editable Space Bases 1
+    bNeedToFlipSpaceBaseBuffers = true;
+    FlipEditableSpaceBases();
+}
+
+void SkeletalMesh::RefreshBoneTransforms() {
+    if (!bAnimationEnabled) { return; }
+    // culled meshes still evaluate once to get a valid pose
+    const bool bNeedsValidPose = !bHasValidBoneTransform;
+    const bool bShouldDoEvaluation = update_rate_params.bUpdatedThisFrame && (!update_rate_params.bSkipEvaluation || bNeedsValidPose);
+    const bool bShouldDoInterpolation = update_rate_params.ShouldInterpolate();
+    const bool bDoParallelEvaluation = true;
+    if (!bShouldDoEvaluation && !bShouldDoInterpolation) {
+        // hold the last pose, nothing to send to render
+        return;
+    }
+
+    //! Initialize Anim Evaluation Context ==> CompleteParallelAnimationEvaluation to clear
+    anim_eval_context.Init(anim_instance.get(), this);
+
+    anim_eval_context.bDoEvaluation = bShouldDoEvaluation;
+    anim_eval_context.bDoInterpolation = bShouldDoInterpolation;
+    anim_eval_context.InterpolationAlpha = bNeedsValidPose ? 1.0f : update_rate_params.GetInterpolationAlpha();
+
+    // Duplicate to cache bones
+    // force ref pos
+    // dispatch task
+    if (bDoParallelEvaluation) {
+        DispatchParallelEvaluationTasks();
+    }
+}
+
+void SkeletalMesh::RecalcRequiredBones(int32_t LODIndex) {
+    ComputeRequiredBones(RequiredBones, FillComponentSpaceTransformsRequiredBones, LODIndex);
+    // Reset Anim Pose to Reference Pose
+    auto ref_pose = GetRefSkeleton().JointRestPoses();
+    BoneSpaceTransforms.resize_uninitialized(ref_pose.size());
+    for (auto i = 0; i < ref_pose.size(); i++) {
+        BoneSpaceTransforms[i] = ref_pose[i];
+    }
+    LUISA_INFO("Reset BoneSpace Transforms with RestPose with {} SOABones", ref_pose.size());
+
+    // Clear Cached Bone Containers
+    if (anim_instance) {
+        anim_instance->RecalcRequiredBones();
+    }
+    // For Linked Instance, RecalcRequiredBones
+    // For PostAnimInstance, RecalcRequiredBones
+    // Mark Curve Up to date
+    // Invalidate Cached Bones
+    bRequiredBonesUpToDate = true;
+    // Broadcast Messages
+}
+void SkeletalMesh::RecalcRequiredCurves() {
+    RBC_UNIMPLEMENTED();
+}
+
+void SkeletalMesh::ComputeRequiredBones(luisa::vector<BoneIndexType> &OutRequiredBones, luisa::vector<BoneIndexType> &OutFillComponentSpaceTransformRequiredBones, int32_t LODIndex) const {
+    OutRequiredBones.clear();
+    OutFillComponentSpaceTransformRequiredBones.clear();
+
+    auto *skelmesh = GetSkelMeshResource();
+    if (!render_data) {
+        LUISA_ERROR("SkeletalMesh has no render data!");
+        return;
+    }
+    OutRequiredBones = render_data->required_bones;// Copy from render data
+    AnimationRuntime::EnsureParentsPresent(OutRequiredBones, GetRefSkeleton());
+    luisa::sort(OutRequiredBones.begin(), OutRequiredBones.end());
+}
+
+void SkeletalMesh::CreateRenderState_Concurrent(RenderDevice *device) {
+    if (bUseGPUSkin) {
+        LUISA_ERROR("GPUSkin Unimplemented");
+        RBC_UNIMPLEMENTED();
+        // render_object_ = SkrNew<SkeletalMeshRenderObjectGPUSkin>(this, InRenderDevice);
+    } else {
+        LUISA_INFO("Creating CPUSkin RenderObject");
+        render_object_ = RBCNew<SkeletalMeshRenderObjectCPUSkin>(this, device);
+    }
+    bRenderStateCreated = true;
+}
+
+void SkeletalMesh::DestroyRenderState_Concurrent() {
+    if (render_object_) {
+        render_object_->ReleaseResources();
+        RBCDelete(render_object_);
+    }
+
+    DeallocateTransformData();
+    bRenderStateCreated = false;
+}
+
+void SkeletalMesh::DoDeferredRenderUpdate_Concurrent(AnimRenderState &state) {
+    if (bRenderTransformDirty) {
+    }
+    if (bRenderDynamicDataDirty) {
+        SendRenderDynamicData_Concurrent(state);
+    }
+}
+
+void SkeletalMesh::SendRenderDynamicData_Concurrent(AnimRenderState &state) {
+    bRenderDynamicDataDirty = false;
+    {
+        // cycle counter
+        int32_t useLOD = GetPredictedLODLevel();
+
+        SkinResource &ref_skin = GetSkinResource();
+        if (ref_skin.loaded()) {
+            SkeletalMeshSceneProxyDynamicData data{this};
+            render_object_->Update(state, 0, data, &ref_skin);
+            bForceMeshObjectUpdate = false;
+        }
+    }
+}
+
+void SkeletalMesh::PerformAnimationProcessing(SkeletalMesh *InSkeletalMesh, AnimInstance *InAnimInstance, bool bInDoEvaluation, bool bForceRefPose, luisa::vector<AnimSOATransform> &OutBoneSpaceTransforms, luisa::vector<AnimFloat4x4> &OutComponentSpaceTransforms) {
+    if (!InSkeletalMesh) { return; }
+    // update anim instance
+    if (InAnimInstance && InAnimInstance->NeedsUpdate()) {
+        InAnimInstance->ParallelUpdateAnimation();
+    }
+
+    // do nothing of no output required
+    // SKR_LOG_FMT_INFO(u8"Processing Animation Process withOutBoneSpaceTransforms {}", OutBoneSpaceTransforms.size());
+
+    if (bInDoEvaluation && OutBoneSpaceTransforms.size() > 0) {
+        CompactPose EvaluatedPose;
+        EvaluateAnimation(InSkeletalMesh, InAnimInstance, bForceRefPose, EvaluatedPose);
+        EvaluatePostProcessMeshInstance();
+        FinalizePoseEvaluationResult(this, OutBoneSpaceTransforms, EvaluatedPose);
+        // FinalizeAttributeEvaluationResults(EvaluatedPose.GetBoneContainer(), Attributes, OutAttributes);
+        // LocalAtoms
+        InSkeletalMesh->FillComponentSpaceTransforms(OutBoneSpaceTransforms, FillComponentSpaceTransformsRequiredBones, OutComponentSpaceTransforms);
+    }
+}
+
+void SkeletalMesh::EvaluateAnimation(SkeletalMesh *InSkelMesh, AnimInstance *InAnimInstance, bool bInForceRefPose, CompactPose &OutPose) const {
+    // OutputRootBoneTranslation
+    // OutCurve
+    // OutPose
+    // OutAttributes
+    if (!InSkelMesh) {
+        return;
+    }
+    {
+        // Construct Evaluation Data
+        ParallelEvaluationData OutData{OutPose};
+        InAnimInstance->ParallelEvaluateAnimation(bInForceRefPose, InSkelMesh, OutData);
+    }
+}
+
+void SkeletalMesh::EvaluatePostProcessMeshInstance() {
+    // placeholder for postprocess eval
+}
+
+void SkeletalMesh::ParallelUpdateAnimation() {
+    // actual update animation instance state
+    // SKR_LOG_INFO(u8"ParallelUpdateAnimation");
+}
+
+void SkeletalMesh::ParallelDuplicateAndInterpolate() {
+    // blend the displayed pose towards the last evaluated pose in the cached buffers
+    auto &cached = anim_eval_context.CachedBoneSpaceTransforms;
+    auto &current = anim_eval_context.BoneSpaceTransforms;
+    if (cached.empty()) { return; }
+    const float alpha = anim_eval_context.InterpolationAlpha;
+    if (alpha >= 1.0f || current.size() != cached.size()) {
+        current.resize_uninitialized(cached.size());
+        for (auto i = 0; i < cached.size(); i++) {
+            current[i] = cached[i];
+        }
+    } else {
+        auto &blended = anim_eval_context.InterpolatedBoneSpaceTransforms;
+        blended.resize_uninitialized(cached.size());
+        AnimBlendingJob::Layer layers[2];
+        layers[0].weight = 1.0f - alpha;
+        layers[0].transform = {(const AnimSOATransform *)current.data(), current.size()};
+        layers[1].weight = alpha;
+        layers[1].transform = {(const AnimSOATransform *)cached.data(), cached.size()};
+        const auto rest_pose = GetRefSkeleton().JointRestPoses();
+        AnimBlendingJob blend_job;
+        blend_job.layers = {layers, 2};
+        blend_job.rest_pose = {rest_pose.data(), rest_pose.size()};
+        blend_job.output = {(AnimSOATransform *)blended.data(), blended.size()};
+        if (!blend_job.Run()) {
+            LUISA_ERROR("Failed to run BlendingJob");
+            return;
+        }
+        std::swap(current, blended);
+    }
+    FillComponentSpaceTransforms(current, FillComponentSpaceTransformsRequiredBones, anim_eval_context.ComponentSpaceTransforms);
+}
+
+luisa::vector<AnimFloat4x4> &SkeletalMesh::GetEditableComponentSpaceTransforms() {
+    return ComponentSpaceTransformsArray[CurrentEditableComponentTransformsIdx];
+}
+
+const luisa::vector<AnimFloat4x4> &SkeletalMesh::GetComponentSpaceTransforms() const {
+    return ComponentSpaceTransformsArray[CurrentReadComponentTransformsIdx];
+}
+
+size_t SkeletalMesh::GetNumComponentSpaceTransforms() const {
+    return GetComponentSpaceTransforms().size();
+}
+
+//! IMPORTANT: Perform Local To Model Job
+void SkeletalMesh::FillComponentSpaceTransforms(luisa::span<const AnimSOATransform> InBoneSpaceTransforms, luisa::span<const BoneIndexType> InFillComponentSpaceTransformsRequiredBones, luisa::vector<AnimFloat4x4> &OutComponentSpaceTransforms) const {
+    const auto NumBones = InBoneSpaceTransforms.size();
+    if (NumBones <= 0) {
+        return;
+    }
+    LUISA_INFO("Running LocalToMotion Job");
+    AnimLocalToModelJob ltm_job;
+    ltm_job.skeleton = &(GetRefSkeleton().GetRawSkeleton());
+    ltm_job.input = {
+        (const AnimSOATransform *)InBoneSpaceTransforms.data(),
+        InBoneSpaceTransforms.size()};
+    ltm_job.output = {
+        (AnimFloat4x4 *)OutComponentSpaceTransforms.data(),
+        OutComponentSpaceTransforms.size()};
+    if (!ltm_job.Run()) {
+        LUISA_ERROR("Failed to run LocalToModelJob");
+    }
+
+}// namespace skr
+
+void SkeletalMesh::SwapEvaluationContextBuffers() {
+    LUISA_INFO("Swaping Evaluation Context Buffer");
+    std::swap(anim_eval_context.BoneSpaceTransforms, BoneSpaceTransforms);
+    std::swap(anim_eval_context.ComponentSpaceTransforms, GetEditableComponentSpaceTransforms());
+}
+
+/**
+ * FinalizePoseEvaluationResult
+ * ====================================================
+ * Get output bone space transforms from final pose generated by AnimGraph execution
+ */
+void SkeletalMesh::FinalizePoseEvaluationResult(const SkeletalMesh *InSkelMesh, luisa::vector<AnimSOATransform> &OutBoneSpaceTransforms, CompactPose &InFinalPose) {
+    const luisa::span<const AnimSOATransform> ref_bone_pose = GetRefSkeleton().JointRestPoses();
+    OutBoneSpaceTransforms.resize_uninitialized(ref_bone_pose.size());
+    for (auto i = 0; i < ref_bone_pose.size(); i++) {
+        OutBoneSpaceTransforms[i] = ref_bone_pose[i];
+    }
+
+    if (InFinalPose.IsValid() && InFinalPose.GetNumBones() > 0) {
+
+        InFinalPose.NormalizeRotation();
+        const auto FillReferencePose = [&](int32_t begin_index, int32_t end_index) {
+            for (int32_t mesh_pose_index = begin_index; mesh_pose_index < end_index; ++mesh_pose_index) {
+                OutBoneSpaceTransforms[mesh_pose_index] = ref_bone_pose[mesh_pose_index];
+            }
+        };
+
+        int32_t last_pose_index = 0;
+        const int32_t bone_count = ref_bone_pose.size();
+        // OutBoneSpaceTransforms.resize_default(bone_count);
+        for (auto i = 0; i < bone_count; i++) {
+            OutBoneSpaceTransforms[i] = InFinalPose.GetBones()[i];
+        }
+    }
+}
+
+void SkeletalMesh::FinalizeBoneTransforms() {
+    FlipEditableSpaceBases();// 将写入完成的BoneSpace翻转到读取Space
+    bHasValidBoneTransform = true;
+}
+
+void SkeletalMesh::FinalizeAnimationUpdate() {
+    // flip bone buffers and post anim notification
+    FinalizeBoneTransforms();
+    // [NOT_IMPLEMENTED]: UpdateChildTransforms() UpdateOverlaps() UpdateBounds()
+    MarkRenderTransformDirty();
+    MarkRenderDynamicDataDirty();
+}
+
+void SkeletalMesh::PostAnimEvaluation() {
+    // actual do post anim evaluation
+    // - If Interpolation
+
+    if (bDuplicateToCacheBones) {
+    }
+    if (bDoEvaluation) {
+        // update curves
+        // update morph targets
+        // DoInstanceEvaluation()
+        //! 更新状态，需要翻转骨骼
+        bNeedToFlipSpaceBaseBuffers = true;
+
+        if (!ShouldBlendPhysicsBones()) {
+            // flip bone buffer and request render
+            FinalizeAnimationUpdate();
+        }
+    }
+}
+
+// get & set
+void SkeletalMesh::MarkRenderTransformDirty() { bRenderTransformDirty = true; }
+void SkeletalMesh::MarkRenderDynamicDataDirty() { bRenderDynamicDataDirty = true; }
+bool SkeletalMesh::IsDynamicDataDirty() const { return bRenderDynamicDataDirty; }
+void SkeletalMesh::EnableAnimation() { bAnimationEnabled = true; }
+void SkeletalMesh::DisableAnimation() { bAnimationEnabled = false; }
+bool SkeletalMesh::IsAnimationEnabled() const { return bAnimationEnabled; }
+
+// Task Interface
+// ================================================================================
+// 这部分函数会在未来改为Workgraph异步Task，在开发过程中暂时保持同步，方便其他部分
+// ================================================================================
+void SkeletalMesh::DispatchParallelEvaluationTasks() {
+    SwapEvaluationContextBuffers();// edit buffers -> context buffers
+    ParallelAnimationEvaluation(); // do evaluation
+
+    CompleteParallelAnimationEvaluation(true);
+}
+
+void SkeletalMesh::ParallelAnimationEvaluation() {
+    if (!anim_eval_context.bDoEvaluation) {
+        // skipped frame, only move towards the last evaluated pose
+        ParallelDuplicateAndInterpolate();
+        return;
+    }
+
+    if (anim_eval_context.bDoInterpolation) {
+        LUISA_INFO("Perform Animation with Interop");
+        anim_eval_context.CachedComponentSpaceTransforms.resize_uninitialized(GetNumComponentSpaceTransforms());
+        PerformAnimationProcessing(
+            anim_eval_context.skel_mesh,
+            anim_eval_context.anim_instance,
+            anim_eval_context.bDoEvaluation,
+            false,
+            anim_eval_context.CachedBoneSpaceTransforms,
+            anim_eval_context.CachedComponentSpaceTransforms);
+        ParallelDuplicateAndInterpolate();
+    } else {
+        LUISA_INFO("Perform Animation with No Interop");
+        PerformAnimationProcessing(
+            anim_eval_context.skel_mesh,
+            anim_eval_context.anim_instance,
+            anim_eval_context.bDoEvaluation,
+            false,
+            anim_eval_context.BoneSpaceTransforms,
+            anim_eval_context.ComponentSpaceTransforms);
+    }
+
+    // actual sampling and fetch current pose
+    // SKR_LOG_INFO(u8"ParallelEvaluateAnimationAnimation");
+}
+
+void SkeletalMesh::CompleteParallelAnimationEvaluation(bool bDoPostAnimEvaluation) {
+    // TODO: Release current ParallelEvaluationTask list
+    if (bDoPostAnimEvaluation) {
+        // swap back
+        SwapEvaluationContextBuffers();
+        PostAnimEvaluation();
+    }
+    anim_eval_context.Clear();
+}
+
+// ================================================================================
+// Task Interface End
+// ================================================================================
+
 }// namespace rbc
\ No newline at end of file
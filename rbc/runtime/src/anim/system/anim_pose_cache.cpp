@@ -0,0 +1,53 @@
+#include "rbc_anim/system/anim_pose_cache.h"
+#include <cmath>
+#include <mutex>
+
+namespace rbc {
+
+void AnimPoseCache::NewFrame() {
+    std::lock_guard lck{mtx};
+    entries.clear();
+    last_frame_stats = frame_stats;
+    frame_stats = {};
+}
+
+int64_t AnimPoseCache::QuantizeTime(float &InOutTime) const {
+    if (TimeQuantum <= 0.0f) {
+        int32_t bits;
+        std::memcpy(&bits, &InOutTime, sizeof(bits));
+        return bits;
+    }
+    const auto quantized = static_cast<int64_t>(std::llround(InOutTime / TimeQuantum));
+    InOutTime = static_cast<float>(quantized) * TimeQuantum;
+    return quantized;
+}
+
+AnimPoseCache::SharedPose AnimPoseCache::Find(const AnimPoseCacheKey &InKey) {
+    std::lock_guard lck{mtx};
+    auto it = entries.find(InKey);
+    if (it == entries.end()) {
+        ++frame_stats.misses;
+        ++total_stats.misses;
+        return {};
+    }
+    ++frame_stats.hits;
+    ++total_stats.hits;
+    return it->second;
+}
+
+AnimPoseCache::SharedPose AnimPoseCache::Add(const AnimPoseCacheKey &InKey, luisa::span<const AnimSOATransform> InBones) {
+    // copy outside the lock, a racing evaluation of the same key just loses its copy
+    auto pose = luisa::make_shared<luisa::vector<AnimSOATransform>>();
+    pose->resize_uninitialized(InBones.size());
+    for (auto i = 0; i < InBones.size(); i++) {
+        (*pose)[i] = InBones[i];
+    }
+    std::lock_guard lck{mtx};
+    if (entries.size() >= MaxEntries) {
+        // nobody started a new frame, held poses stay valid through their shared_ptr
+        entries.clear();
+    }
+    return entries.try_emplace(InKey, std::move(pose)).first->second;
+}
+
+}// namespace rbc
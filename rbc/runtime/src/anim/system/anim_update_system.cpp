@@ -0,0 +1,146 @@
+#include "rbc_anim/system/anim_update_system.h"
+#include "rbc_anim/skeletal_mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace rbc {
+
+// AnimUpdateRateParams
+// ================================================================================
+bool AnimUpdateRateParams::Advance(float InDeltaTime_s, bool bForceUpdate) {
+    AccumulatedDeltaTime += InDeltaTime_s;
+    ++FramesSinceUpdate;
+    bUpdatedThisFrame = bForceUpdate || FramesSinceUpdate >= std::max(UpdateRate, 1);
+    if (bUpdatedThisFrame) {
+        FramesSinceUpdate = 0;
+    }
+    return bUpdatedThisFrame;
+}
+
+float AnimUpdateRateParams::ConsumeDeltaTime() {
+    const float DeltaTime = AccumulatedDeltaTime;
+    AccumulatedDeltaTime = 0.0f;
+    return DeltaTime;
+}
+
+int32_t AnimUpdateRateParams::GetFramesUntilNextUpdate() const {
+    return std::max(std::max(UpdateRate, 1) - 1 - FramesSinceUpdate, 0);
+}
+
+float AnimUpdateRateParams::GetInterpolationAlpha() const {
+    // the pose is evaluated at the current time on update frames, the displayed pose trails it and
+    // closes the remaining gap evenly over the frames left, reaching it right before the next update
+    return 1.0f / static_cast<float>(GetFramesUntilNextUpdate() + 1);
+}
+
+void AnimUpdateRateParams::RecordTickCost(float InCostMs, float InSmoothing) {
+    float &Cost = bUpdatedThisFrame ? UpdateCostMs : SkipCostMs;
+    Cost = Cost > 0.0f ? Cost + (InCostMs - Cost) * InSmoothing : InCostMs;
+}
+
+float AnimUpdateRateParams::EstimateCostMs(int32_t InUpdateRate, bool bInInterpolate) const {
+    const int32_t Rate = std::max(InUpdateRate, 1);
+    if (Rate == 1) {
+        return UpdateCostMs;
+    }
+    // skipped frames without interpolation only accumulate delta time
+    const float SkipCost = bInInterpolate ? SkipCostMs : 0.0f;
+    return (UpdateCostMs + SkipCost * static_cast<float>(Rate - 1)) / static_cast<float>(Rate);
+}
+
+// AnimUpdateSystem
+// ================================================================================
+AnimUpdateSystem &AnimUpdateSystem::instance() {
+    static AnimUpdateSystem system;
+    return system;
+}
+
+void AnimUpdateSystem::Register(SkeletalMesh *InSkelMesh) {
+    std::lock_guard lck{mtx};
+    if (std::find(skel_meshes.begin(), skel_meshes.end(), InSkelMesh) != skel_meshes.end()) {
+        return;
+    }
+    skel_meshes.emplace_back(InSkelMesh);
+    InSkelMesh->update_rate_params.FramesSinceUpdate = static_cast<int32_t>(next_frame_offset++ % static_cast<uint32_t>(std::max(settings.MaxUpdateRate, 1)));
+}
+
+void AnimUpdateSystem::Unregister(SkeletalMesh *InSkelMesh) {
+    std::lock_guard lck{mtx};
+    auto it = std::find(skel_meshes.begin(), skel_meshes.end(), InSkelMesh);
+    if (it != skel_meshes.end()) {
+        *it = skel_meshes.back();
+        skel_meshes.pop_back();
+    }
+}
+
+void AnimUpdateSystem::BeginFrame() {
+    pose_cache.NewFrame();
+    AllocateBudget();
+}
+
+void AnimUpdateSystem::AllocateBudget() {
+    std::lock_guard lck{mtx};
+    scratch_params.clear();
+    for (auto *skel_mesh : skel_meshes) {
+        scratch_params.emplace_back(&skel_mesh->update_rate_params);
+    }
+    estimated_cost_ms = AssignUpdateRates(scratch_params, settings);
+}
+
+float AnimUpdateSystem::AssignUpdateRates(luisa::span<AnimUpdateRateParams *> InParams, const AnimBudgetSettings &InSettings) {
+    const int32_t MaxRate = std::max(InSettings.MaxUpdateRate, 1);
+    const auto Significance = [](const AnimUpdateRateParams *Params) {
+        return Params->bVisible ? Params->ScreenSize : -1.0f;
+    };
+    std::stable_sort(InParams.begin(), InParams.end(), [&](const AnimUpdateRateParams *A, const AnimUpdateRateParams *B) {
+        return Significance(A) > Significance(B);
+    });
+    const auto ShouldInterpolate = [&](int32_t Rate) {
+        return InSettings.bInterpolate && Rate > 1 && Rate <= InSettings.MaxInterpolatedRate;
+    };
+
+    // every mesh is guaranteed at least MaxRate, reserve that before handing out the rest
+    float Reserved = 0.0f;
+    for (auto *Params : InParams) {
+        Reserved += Params->EstimateCostMs(MaxRate, false);
+    }
+    float Remaining = InSettings.BudgetMs;
+    float Total = 0.0f;
+    for (auto *Params : InParams) {
+        Reserved -= Params->EstimateCostMs(MaxRate, false);
+        if (!Params->bVisible) {
+            // culled: keep time flowing, skip evaluation entirely
+            Params->UpdateRate = MaxRate;
+            Params->bInterpolateSkippedFrames = false;
+            Params->bSkipEvaluation = true;
+        } else {
+            int32_t Rate = 1;
+            if (Params->ScreenSize < InSettings.FullRateScreenSize) {
+                const float Ratio = InSettings.FullRateScreenSize / std::max(Params->ScreenSize, 1e-4f);
+                Rate = static_cast<int32_t>(std::min(std::ceil(Ratio), static_cast<float>(MaxRate)));
+            }
+            const float Allowed = Remaining - Reserved;
+            while (Rate < MaxRate && Params->EstimateCostMs(Rate, ShouldInterpolate(Rate)) > Allowed) {
+                ++Rate;
+            }
+            Params->UpdateRate = Rate;
+            Params->bInterpolateSkippedFrames = ShouldInterpolate(Rate);
+            Params->bSkipEvaluation = false;
+        }
+        const float Cost = Params->EstimateCostMs(Params->UpdateRate, Params->ShouldInterpolate());
+        Remaining -= Cost;
+        Total += Cost;
+    }
+    return Total;
+}
+
+float AnimUpdateSystem::ComputeScreenSize(float InBoundsRadius, float InDistance, float InTanHalfFov) {
+    // camera inside the bounds
+    if (InDistance <= InBoundsRadius) { return 1.0f; }
+    // projected diameter over the viewport height at that distance
+    const float ScreenSize = InBoundsRadius / (InDistance * std::max(InTanHalfFov, 1e-4f));
+    return std::min(ScreenSize, 1.0f);
+}
+
+}// namespace rbc
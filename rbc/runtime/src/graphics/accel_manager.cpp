@@ -2,7 +2,18 @@
 #include <luisa/core/fiber.h>
 #include <luisa/runtime/raster/raster_scene.h>
 #include <rbc_graphics/shader_manager.h>
+#include <cstddef>
 namespace rbc {
+namespace {
+// BufferAllocator relocation user data, node kind in the high half, instance id in the low half
+enum struct RelocationKind : uint64_t {
+    MeshMaterial = 1,
+    ProceduralMeta = 2
+};
+uint64_t relocation_user_data(RelocationKind kind, uint inst_id) {
+    return (luisa::to_underlying(kind) << 32u) | inst_id;
+}
+}// namespace
 
 namespace accel_detail {
 static const AccelOption tlas_option{
@@ -71,6 +82,39 @@ void AccelManager::set_mesh_instance(
             inst_id);
     }
 }
+void AccelManager::set_mesh_instances(
+    CommandList &cmdlist,
+    luisa::span<MeshInstanceTransform const> updates) {
+    if (updates.empty()) return;
+    _dirty = true;
+    luisa::fiber::parallel(
+        updates.size(), [&](size_t i) {
+            auto &update = updates[i];
+            auto &ele = _accel_elements[_insts[update.inst_id].accel_id];
+            if (!ele.mesh_data.is_type_of<MeshManager::MeshData *>()) [[unlikely]] {
+                LUISA_ERROR("Accel instance type mismatch.");
+            }
+            ele.transform = update.transform;
+            ele.visibility_mask = update.visibility_mask;
+            ele.opaque = update.opaque;
+        },
+        256);
+    if (!_accel) return;
+    for (auto &update : updates) {
+        auto accel_id = _insts[update.inst_id].accel_id;
+        auto t = _accel_elements[accel_id].mesh_data.force_get<MeshManager::MeshData *>();
+        if (!t->pack.mesh) {
+            t->build_mesh(_device, cmdlist, AccelOption{.allow_compaction = false});
+        }
+        _accel.set(
+            accel_id,
+            t->pack.mesh,
+            update.transform,
+            update.visibility_mask,
+            update.opaque,
+            update.inst_id);
+    }
+}
 void AccelManager::_init_default_procedural_blas(
     CommandList &cmdlist,
     DisposeQueue &disp_queue) {
@@ -221,13 +265,15 @@ void AccelManager::_update_procedural_instance(
         uploader.swap_buffer(old_buffer, new_buffer);
     };
     prim_data.visit([&]<typename T>(T const &t) {
-        if (!inst.meta_node)
+        if (!inst.meta_node) {
             inst.meta_node = buffer_allocator.allocate(
                 _device,
                 cmdlist,
                 disp_queue,
                 sizeof(T),
                 before_copy);
+            buffer_allocator.set_relocatable(inst.meta_node, relocation_user_data(RelocationKind::ProceduralMeta, inst_id));
+        }
         auto bf_view = inst.meta_node.view<T>(buffer_allocator);
         uploader.emplace_copy_cmd(bf_view, &t);
         type.meta_byte_offset = bf_view.offset_bytes();
@@ -264,13 +310,15 @@ void AccelManager::_update_mesh_instance(
         auto before_copy = [&](Buffer<uint> const &old_buffer, Buffer<uint> const &new_buffer) {
             uploader.swap_buffer(old_buffer, new_buffer);
         };
-        if (!inst.material_node)
+        if (!inst.material_node) {
             inst.material_node = buffer_allocator.allocate(
                 _device,
                 cmdlist,
                 disp_queue,
                 mat_codes.size_bytes(),
                 before_copy);
+            buffer_allocator.set_relocatable(inst.material_node, relocation_user_data(RelocationKind::MeshMaterial, inst_id));
+        }
         mat_index = inst.material_node.offset_bytes() / sizeof(uint);
         auto bf_view = inst.material_node.view<uint>(buffer_allocator);
         if (mat_codes.size() < 16) {
@@ -520,6 +568,32 @@ void AccelManager::_swap_last(BufferUploader &uploader, auto &inst, DisposeQueue
         _accel.pop_back();
     inst.accel_id = ~0u - 1u;
 }
+void AccelManager::relocate_buffer_nodes(
+    BufferUploader &uploader,
+    luisa::span<BufferAllocator::Relocation const> relocations) {
+    for (auto &r : relocations) {
+        auto inst_id = static_cast<uint>(r.user_data & 0xffffffffull);
+        switch (static_cast<RelocationKind>(r.user_data >> 32u)) {
+            case RelocationKind::MeshMaterial: {
+                // other accel managers share the allocator
+                if (inst_id >= _insts.size() || !_insts[inst_id].material_node.same_block(r.node)) break;
+                _insts[inst_id].material_node = r.node;
+                uint mat_index = r.node.offset_bytes() / sizeof(uint);
+                auto field = _inst_buffer.view().as<uint>().subview(
+                    (inst_id * sizeof(InstanceInfo) + offsetof(InstanceInfo, mat_index)) / sizeof(uint), 1);
+                uploader.emplace_copy_cmd(field, &mat_index);
+            } break;
+            case RelocationKind::ProceduralMeta: {
+                if (inst_id >= _procedural_insts.size() || !_procedural_insts[inst_id].meta_node.same_block(r.node)) break;
+                _procedural_insts[inst_id].meta_node = r.node;
+                auto meta_byte_offset = static_cast<uint>(r.node.offset_bytes());
+                auto field = _procedural_type_buffer.view().as<uint>().subview(
+                    (inst_id * sizeof(ProceduralType) + offsetof(ProceduralType, meta_byte_offset)) / sizeof(uint), 1);
+                uploader.emplace_copy_cmd(field, &meta_byte_offset);
+            } break;
+        }
+    }
+}
 void AccelManager::remove_mesh_instance(
     BufferAllocator &buffer_allocator,
     BufferUploader &uploader,
@@ -676,10 +750,18 @@ void AccelManager::make_draw_list(
     if (buffer_size == 0) {
         return;
     }
-    luisa::vector<RasterElement> elem_host;
+    // host copy lives in the frame arena when there is one, it is recycled after the frame's fence
+    luisa::vector<RasterElement> elem_vec;
+    luisa::span<RasterElement> elem_host;
+    if (auto arena = after_sync_dispqueue.frame_arena()) {
+        elem_host = arena->allocate_array<RasterElement>(buffer_size.load());
+    } else {
+        elem_vec.push_back_uninitialized(buffer_size.load());
+        elem_host = elem_vec;
+    }
+    size_t elem_count = 0;
     constexpr auto aligned_size = (65536 + sizeof(RasterElement) - 1) / sizeof(RasterElement);
     auto desired_buffer_size = (buffer_size.load() + aligned_size - 1) / aligned_size * aligned_size;
-    elem_host.reserve(buffer_size.load());
     out_draw_meshes.reserve(out_draw_meshes.size() + mesh_map->size());
     for (auto &drawcall : *mesh_map) {
         auto &mesh = drawcall.first;
@@ -691,7 +773,7 @@ void AccelManager::make_draw_list(
         for (auto submesh_idx : vstd::range(std::max<uint>(mesh->submesh_offset.size(), 1))) {
             auto &instance_indices = inst_list.instance_indices[submesh_idx];
             if (instance_indices.empty()) continue;
-            auto obj_id = elem_host.size();
+            auto obj_id = elem_count;
             uint buffer_offset = submesh_idx < mesh->submesh_offset.size() ? mesh->submesh_offset[submesh_idx] : 0;
             auto buffer_size = (submesh_idx + 1) < mesh->submesh_offset.size() ? mesh->submesh_offset[submesh_idx + 1] : mesh->triangle_size;
             buffer_size -= buffer_offset;
@@ -705,7 +787,7 @@ void AccelManager::make_draw_list(
                 obj_id);
             for (auto &i : instance_indices) {
                 auto &inst = _accel_elements[i];
-                auto &elem = elem_host.emplace_back();
+                auto &elem = elem_host[elem_count++];
                 elem.local_to_world_and_inst_id = inst.transform;
 
                 reinterpret_cast<uint &>(elem.local_to_world_and_inst_id[2][3]) = buffer_offset;
@@ -721,7 +803,9 @@ void AccelManager::make_draw_list(
     }
     out_data_buffer = _raster_transform_buffer.view(0, buffer_size.load());
     cmdlist << out_data_buffer.copy_from(elem_host.data());
-    after_commit_dispqueue.dispose_after_queue(std::move(elem_host));
+    if (!elem_vec.empty()) {
+        after_commit_dispqueue.dispose_after_queue(std::move(elem_vec));
+    }
     mesh_map->clear();
     _cache_maps.enqueue(std::move(*mesh_map));
 }
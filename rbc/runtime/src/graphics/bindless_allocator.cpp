@@ -1,6 +1,9 @@
 #include <rbc_graphics/bindless_allocator.h>
 #include <luisa/core/logging.h>
 #include <luisa/core/stl/algorithm.h>
+#include <algorithm>
+#include <bit>
+#include <shared_mutex>
 namespace rbc
 {
 string_view BindlessAllocator::_name(uint index) const
@@ -17,123 +20,248 @@ string_view BindlessAllocator::_name(uint index) const
         return {};
     }
 }
-uint BindlessAllocator::_allocate_buffer(uint64 handle)
+namespace
+{
+std::atomic_uint64_t _cache_generation{};
+} // namespace
+
+BindlessArray& BindlessAllocator::_heap(uint index)
 {
-    uint v;
+    switch (index)
     {
-        std::lock_guard lck{ _mtx };
-        auto& vec = _vec[0];
-        if (vec.empty()) [[unlikely]]
-        {
-            LUISA_ERROR("Allocator {} empty.", _name(0));
-        }
-        v = vec.back();
-        vec.pop_back();
-#ifndef NDEBUG
-        if (!_allocated_map[0].try_emplace(v).second)
-        {
-            LUISA_ERROR("Allocator {} internal error, possibly multi-thread?", _name(0));
-        }
-#endif
+    case 0:
+        return _buffer_heap;
+    case 1:
+        return _image_heap;
+    default:
+        return _volume_heap;
     }
-    _buffer_heap.emplace_buffer_handle_on_update(v, handle, 0);
-    return v;
 }
-uint BindlessAllocator::_allocate_tex2d(uint64 handle, Sampler sampler)
+
+BindlessAllocator::ThreadCache& BindlessAllocator::_local_cache()
 {
-    uint v;
+    // keyed by allocator id, entries of destroyed allocators are never matched again
+    thread_local vector<std::pair<uint64_t, ThreadCache*>> local;
+    for (auto& i : local)
     {
-        std::lock_guard lck{ _mtx };
-        auto& vec = _vec[1];
-        if (vec.empty()) [[unlikely]]
-        {
-            LUISA_ERROR("Allocator {} empty.", _name(1));
-        }
-        v = vec.back();
-        vec.pop_back();
-#ifndef NDEBUG
-        if (!_allocated_map[1].try_emplace(v).second)
-        {
-            LUISA_ERROR("Allocator {} internal error, possibly multi-thread?", _name(1));
-        }
-#endif
+        if (i.first == _cache_id) return *i.second;
     }
-    _image_heap.emplace_tex2d_handle_on_update(v, handle, sampler);
-    return v;
+    ThreadCache* cache;
+    {
+        std::lock_guard lck{ _caches_mtx };
+        cache = _caches.emplace_back(luisa::make_unique<ThreadCache>()).get();
+    }
+    local.emplace_back(_cache_id, cache);
+    return *cache;
 }
-uint BindlessAllocator::_allocate_tex3d(uint64 handle, Sampler sampler)
+
+void BindlessAllocator::_refill(uint index, vector<uint>& free_list)
 {
-    uint v;
+    std::lock_guard lck{ _mtx };
+    if (_capacity[index] == 0) [[unlikely]]
     {
-        std::lock_guard lck{ _mtx };
-        auto& vec = _vec[2];
-        if (vec.empty()) [[unlikely]]
-        {
-            LUISA_ERROR("Allocator {} empty.", _name(2));
-        }
-        v = vec.back();
-        vec.pop_back();
+        LUISA_ERROR("Allocator {} disabled.", _name(index));
+    }
+    auto& vec = _vec[index];
+    if (!vec.empty())
+    {
+        auto count = std::min<size_t>(vec.size(), _cache_batch);
+        vstd::push_back_all(free_list, luisa::span{ vec.data() + vec.size() - count, count });
+        vec.resize(vec.size() - count);
+        return;
+    }
+    auto begin = _next[index];
+    auto end = std::min(begin + _cache_batch, max_heap_size);
+    if (begin >= end) [[unlikely]]
+    {
+        LUISA_ERROR("Allocator {} exceeds {} slots.", _name(index), max_heap_size);
+    }
+    _next[index] = end;
+    // lowest slot is popped first
+    vstd::push_back_func(free_list, end - begin, [end](size_t i) { return static_cast<uint>(end - 1 - i); });
+    auto& slots = _slots[index];
+    if (slots.size() < end)
+    {
+        std::lock_guard heap_lck{ _heap_mtx };
+        slots.resize(end);
+    }
+}
+
+uint BindlessAllocator::_allocate(uint index, uint64 handle, Sampler sampler)
+{
+    auto& free_list = _local_cache().free[index];
+    if (free_list.empty()) [[unlikely]]
+    {
+        _refill(index, free_list);
+    }
+    auto v = free_list.back();
+    free_list.pop_back();
 #ifndef NDEBUG
-        if (!_allocated_map[2].try_emplace(v).second)
+    {
+        std::lock_guard lck{ _mtx };
+        if (!_allocated_map[index].try_emplace(v).second)
         {
-            LUISA_ERROR("Allocator {} internal error, possibly multi-thread?", _name(2));
+            LUISA_ERROR("Allocator {} internal error, possibly multi-thread?", _name(index));
         }
-#endif
     }
-    _volume_heap.emplace_tex3d_handle_on_update(v, handle, sampler);
+#endif
+    _set_slot(index, v, handle, sampler);
     return v;
 }
-void BindlessAllocator::_deallocate(uint index, uint value)
+
+void BindlessAllocator::_set_slot(uint index, uint slot, uint64 handle, Sampler sampler)
 {
-    std::lock_guard lck{ _mtx };
-#ifndef NDEBUG
-    auto iter = _allocated_map[index].find(value);
-    if (!iter)
+    std::shared_lock lck{ _heap_mtx };
+    _slots[index][slot] = Slot{ handle, sampler };
+    // slots past the heap size are emplaced when the heap grows in commit()
+    if (slot >= _capacity[index]) return;
+    auto& heap = _heap(index);
+    if (handle == invalid_resource_handle)
     {
-        LUISA_ERROR("Invalid {} list free value {}", _name(index), value);
+        switch (index)
+        {
+        case 0:
+            heap.remove_buffer_on_update(slot);
+            break;
+        case 1:
+            heap.remove_tex2d_on_update(slot);
+            break;
+        case 2:
+            heap.remove_tex3d_on_update(slot);
+            break;
+        }
+        return;
     }
-    _allocated_map[index].remove(iter);
-#endif
-    _free_queue[index].emplace_back(value);
     switch (index)
     {
     case 0:
-        _buffer_heap.remove_buffer_on_update(value);
+        heap.emplace_buffer_handle_on_update(slot, handle, 0);
         break;
     case 1:
-        _image_heap.remove_tex2d_on_update(value);
+        heap.emplace_tex2d_handle_on_update(slot, handle, sampler);
         break;
     case 2:
-        _volume_heap.remove_tex3d_on_update(value);
+        heap.emplace_tex3d_handle_on_update(slot, handle, sampler);
         break;
     }
 }
 
-void BindlessAllocator::commit(CommandList& cmdlist)
+uint BindlessAllocator::_allocate_buffer(uint64 handle)
 {
-    _require_sync = false;
-    if (_buffer_heap && _buffer_heap.dirty())
+    return _allocate(0, handle, {});
+}
+uint BindlessAllocator::_allocate_tex2d(uint64 handle, Sampler sampler)
+{
+    return _allocate(1, handle, sampler);
+}
+uint BindlessAllocator::_allocate_tex3d(uint64 handle, Sampler sampler)
+{
+    return _allocate(2, handle, sampler);
+}
+void BindlessAllocator::_deallocate(uint index, uint value)
+{
+#ifndef NDEBUG
+    {
+        std::lock_guard lck{ _mtx };
+        auto iter = _allocated_map[index].find(value);
+        if (!iter)
+        {
+            LUISA_ERROR("Invalid {} list free value {}", _name(index), value);
+        }
+        _allocated_map[index].remove(iter);
+    }
+#endif
+    _set_slot(index, value, invalid_resource_handle, {});
+    // shaders of in-flight frames may still read the slot, it is recycled after the next commit completes
+    auto& cache = _local_cache();
+    std::lock_guard lck{ cache.retired_mtx };
+    cache.retired[index].emplace_back(value);
+}
+
+void BindlessAllocator::_grow(CommandList& cmdlist, uint index)
+{
+    auto& slots = _slots[index];
+    auto old_size = _capacity[index];
+    if (slots.size() <= old_size) return;
+    auto size = std::min(std::max(old_size * 2u, std::bit_ceil(static_cast<uint>(slots.size()))), max_heap_size);
+    constexpr BindlessSlotType slot_types[] = {
+        BindlessSlotType::BUFFER_ONLY,
+        BindlessSlotType::TEXTURE2D_ONLY,
+        BindlessSlotType::TEXTURE3D_ONLY
+    };
+    auto new_heap = _device->create_bindless_array(size, slot_types[index]);
+    // copy every live descriptor from the host mirror, pending modifications of the old heap are included
+    for (auto i : vstd::range(slots.size()))
     {
-        cmdlist << _buffer_heap.update();
+        auto& slot = slots[i];
+        if (slot.handle == invalid_resource_handle) continue;
+        switch (index)
+        {
+        case 0:
+            new_heap.emplace_buffer_handle_on_update(i, slot.handle, 0);
+            break;
+        case 1:
+            new_heap.emplace_tex2d_handle_on_update(i, slot.handle, slot.sampler);
+            break;
+        case 2:
+            new_heap.emplace_tex3d_handle_on_update(i, slot.handle, slot.sampler);
+            break;
+        }
     }
-    if (_image_heap && _image_heap.dirty())
+    LUISA_INFO("Bindless allocator {} grows from {} to {} slots.", _name(index), old_size, size);
+    auto& heap = _heap(index);
+    // commands recorded before this commit still reference the old heap
+    cmdlist.add_callback([old_heap = std::move(heap)]() {});
+    heap = std::move(new_heap);
+    _capacity[index] = size;
+}
+
+void BindlessAllocator::commit(CommandList& cmdlist)
+{
+    _require_sync = false;
+    std::array<vector<uint>, 3> free_queue;
     {
-        cmdlist << _image_heap.update();
+        std::lock_guard lck{ _caches_mtx };
+        for (auto& cache : _caches)
+        {
+            std::lock_guard cache_lck{ cache->retired_mtx };
+            for (auto i : vstd::range(3))
+            {
+                vstd::push_back_all(free_queue[i], luisa::span{ cache->retired[i] });
+                cache->retired[i].clear();
+            }
+        }
     }
-    if (_volume_heap && _volume_heap.dirty())
     {
-        cmdlist << _volume_heap.update();
+        std::lock_guard lck{ _heap_mtx };
+        for (auto i : vstd::range(3))
+        {
+            if (_capacity[i] > 0)
+            {
+                _grow(cmdlist, i);
+            }
+        }
+        if (_buffer_heap && _buffer_heap.dirty())
+        {
+            cmdlist << _buffer_heap.update();
+        }
+        if (_image_heap && _image_heap.dirty())
+        {
+            cmdlist << _image_heap.update();
+        }
+        if (_volume_heap && _volume_heap.dirty())
+        {
+            cmdlist << _volume_heap.update();
+        }
     }
-    std::lock_guard lck{ _mtx };
-    if (!(_free_queue[0].empty() && _free_queue[1].empty() && _free_queue[2].empty()))
+    if (!(free_queue[0].empty() && free_queue[1].empty() && free_queue[2].empty()))
     {
-        cmdlist.add_callback([this, free_queue = std::move(_free_queue)]() {
+        // the removals above are applied by this command list, slots are safe to reuse once it completes
+        cmdlist.add_callback([this, free_queue = std::move(free_queue)]() {
+            std::lock_guard lck{ _mtx };
+            for (auto i : vstd::range(3))
             {
-                std::lock_guard lck{ _mtx };
-                for (auto i : vstd::range(3))
-                {
-                    vstd::push_back_all(_vec[i], luisa::span{ free_queue[i] });
-                }
+                vstd::push_back_all(_vec[i], luisa::span{ free_queue[i] });
             }
         });
     }
@@ -146,6 +274,8 @@ BindlessAllocator::BindlessAllocator(
     uint volume_size,
     vector<uint>&& reserved
 )
+    : _device{ &device }
+    , _cache_id{ ++_cache_generation }
 {
     if (buffer_size > 0)
     {
@@ -170,8 +300,10 @@ BindlessAllocator::BindlessAllocator(
             reserved_idx = reserved[i];
         }
         LUISA_ASSERT(reserved_idx < size);
-        auto last = size - 1;
-        vstd::push_back_func(_vec[i], size - reserved_idx, [last, reserved_idx](auto i) { return last - i; });
+        LUISA_ASSERT(size <= max_heap_size);
+        _capacity[i] = size;
+        _next[i] = reserved_idx;
+        _slots[i].resize(size);
     }
     for (auto i = 0; i < 3; ++i)
     {
@@ -200,26 +332,17 @@ bool BindlessAllocator::_set_reserve(uint idx, uint64_t handle, uint type)
 void BindlessAllocator::_set_reserved_buffer(uint idx, uint64 handle)
 {
     if (!_set_reserve(idx, handle, 0)) return;
-    if (handle != invalid_resource_handle)
-        _buffer_heap.emplace_buffer_handle_on_update(idx, handle, 0);
-    else
-        _buffer_heap.remove_buffer_on_update(idx);
+    _set_slot(0, idx, handle, {});
 }
 void BindlessAllocator::_set_reserved_tex2d(uint idx, uint64 handle, Sampler sampler)
 {
     if (!_set_reserve(idx, handle, 1)) return;
-    if (handle != invalid_resource_handle)
-        _image_heap.emplace_tex2d_handle_on_update(idx, handle, sampler);
-    else
-        _image_heap.remove_tex2d_on_update(idx);
+    _set_slot(1, idx, handle, sampler);
 }
 void BindlessAllocator::_set_reserved_tex3d(uint idx, uint64 handle, Sampler sampler)
 {
     if (!_set_reserve(idx, handle, 2)) return;
-    if (handle != invalid_resource_handle)
-        _volume_heap.emplace_tex3d_handle_on_update(idx, handle, sampler);
-    else
-        _volume_heap.remove_tex3d_on_update(idx);
+    _set_slot(2, idx, handle, sampler);
 }
 
 BindlessAllocator::~BindlessAllocator()
@@ -1,9 +1,15 @@
 #include <rbc_graphics/buffer_allocator.h>
 namespace rbc {
-BufferAllocator::BufferAllocator(Device& device, uint capacity)
-	: _fit(static_cast<size_t>(std::numeric_limits<uint>::max()) * sizeof(uint), alignof(uint)),
-	  _buffer(device.create_buffer<uint>(capacity / sizeof(uint))),
-	  _capacity(capacity) {
+BufferAllocator::BufferAllocator(Device& device, uint capacity, AllocateType backend)
+	: _buffer(device.create_buffer<uint>(capacity / sizeof(uint))),
+	  _capacity(capacity),
+	  _min_capacity(capacity) {
+	auto size = static_cast<size_t>(std::numeric_limits<uint>::max()) * sizeof(uint);
+	if (backend == AllocateType::TLSF) {
+		_tlsf.create(size, alignof(uint));
+	} else {
+		_fit.create(size, alignof(uint));
+	}
 }
 auto BufferAllocator::allocate(
 	Device& device,
@@ -13,14 +19,19 @@ auto BufferAllocator::allocate(
 	vstd::FuncRef<void(Buffer<uint> const& old_buffer, Buffer<uint> const& new_buffer)> before_copy,
 	AllocateType alloc_type) -> Node {
 	size = (size + 3) & (~3);
-	auto fit_node = [&]() {
-		if (alloc_type == AllocateType::FirstFit) {
-			return _fit.allocate(size);
-		} else {
-			return _fit.allocate(size);
-		}
-	}();
-	size_t buffer_size = fit_node->offset() + fit_node->size();
+	Node n;
+	if (_tlsf) {
+		auto tlsf_node = _tlsf->allocate(size);
+		n._handle = tlsf_node;
+		n._offset = tlsf_node->offset();
+		n._size = tlsf_node->size();
+	} else {
+		auto fit_node = alloc_type == AllocateType::BestFit ? _fit->allocate_best_fit(size) : _fit->allocate(size);
+		n._handle = fit_node;
+		n._offset = fit_node->offset();
+		n._size = fit_node->size();
+	}
+	size_t buffer_size = n._offset + n._size;
 	if (buffer_size > _capacity) {
 		size_t new_capa = _capacity;
 		do {
@@ -37,12 +48,114 @@ auto BufferAllocator::allocate(
 			_buffer = std::move(new_buffer);
 		}
 	}
-	Node n;
-	n._fit_node = fit_node;
 	return n;
 }
 void BufferAllocator::free(Node node) {
-	_fit.free(node._fit_node);
+	if (_tlsf) {
+		_tlsf->free(static_cast<TLSFAllocator::Node*>(node._handle));
+	} else {
+		_fit->free(static_cast<FirstFit::Node*>(node._handle));
+	}
+}
+void BufferAllocator::set_relocatable(Node const& node, uint64_t user_data) {
+	if (_tlsf && node) {
+		static_cast<TLSFAllocator::Node*>(node._handle)->set_user_data(user_data);
+	}
+}
+void BufferAllocator::_copy_within(Device& device, CommandList& cmd_list, DisposeQueue& disp_queue, size_t src_bytes, size_t dst_bytes, size_t size_bytes) {
+	auto count = size_bytes / sizeof(uint);
+	auto src = _buffer.view(src_bytes / sizeof(uint), count);
+	auto dst = _buffer.view(dst_bytes / sizeof(uint), count);
+	if (src_bytes - dst_bytes >= size_bytes) {
+		cmd_list << dst.copy_from(src);
+		return;
+	}
+	if (_scratch.size() < count) {
+		if (_scratch) {
+			disp_queue.dispose_after_queue(std::move(_scratch));
+		}
+		_scratch = device.create_buffer<uint>(count);
+	}
+	cmd_list << _scratch.view(0, count).copy_from(src)
+			 << dst.copy_from(_scratch.view(0, count));
+}
+bool BufferAllocator::compact(
+	Device& device,
+	CommandList& cmd_list,
+	DisposeQueue& disp_queue,
+	size_t max_copy_bytes,
+	vstd::FuncRef<void(luisa::span<Relocation const>)> relocate) {
+	if (!_tlsf) return false;
+	luisa::vector<Relocation> relocations;
+	size_t copied = 0;
+	auto block = _tlsf->first_block();
+	while (block && copied < max_copy_bytes) {
+		if (!block->is_free()) {
+			block = block->next();
+			continue;
+		}
+		auto hole = block;
+		auto first = hole->next();
+		// only free space after the hole
+		if (!first) break;
+		// longest run of relocatable nodes within the budget, at least one
+		TLSFAllocator::Node* last{nullptr};
+		size_t run_bytes = 0;
+		for (auto p = first; p && !p->is_free() && p->user_data() != pinned_user_data; p = p->next()) {
+			if (last && copied + run_bytes + p->size() > max_copy_bytes) break;
+			last = p;
+			run_bytes += p->size();
+		}
+		if (!last) {
+			// pinned node right after the hole
+			block = first->next();
+			continue;
+		}
+		auto reloc_start = relocations.size();
+		for (auto p = first;; p = p->next()) {
+			auto& r = relocations.emplace_back();
+			r.node._handle = p;
+			r.node._size = p->size();
+			r.old_offset_bytes = p->offset();
+			r.user_data = p->user_data();
+			if (p == last) break;
+		}
+		_copy_within(device, cmd_list, disp_queue, first->offset(), hole->offset(), run_bytes);
+		copied += run_bytes;
+		block = _tlsf->slide_down(hole, last);
+		for (auto i = reloc_start; i < relocations.size(); ++i) {
+			auto& r = relocations[i];
+			r.node._offset = static_cast<TLSFAllocator::Node*>(r.node._handle)->offset();
+		}
+	}
+	if (relocations.empty()) return false;
+	relocate(relocations);
+	return true;
+}
+bool BufferAllocator::try_shrink(
+	Device& device,
+	CommandList& cmd_list,
+	DisposeQueue& disp_queue,
+	float occupancy_threshold,
+	BeforeCopyFunc before_copy) {
+	if (!_tlsf || _capacity <= _min_capacity) return false;
+	auto used = _tlsf->used_end();
+	if (static_cast<double>(used) >= static_cast<double>(_capacity) * occupancy_threshold) return false;
+	size_t new_capa = _capacity;
+	while (new_capa / 2 >= _min_capacity && used * 2 <= new_capa / 2) {
+		new_capa /= 2;
+	}
+	if (new_capa == _capacity) return false;
+	_capacity = new_capa;
+	_dirty = true;
+	auto new_buffer = device.create_buffer<uint>(_capacity / sizeof(uint));
+	before_copy(_buffer, new_buffer);
+	if (used > 0) {
+		cmd_list << new_buffer.view(0, used / sizeof(uint)).copy_from(_buffer.view(0, used / sizeof(uint)));
+	}
+	disp_queue.dispose_after_queue(std::move(_buffer));
+	_buffer = std::move(new_buffer);
+	return true;
 }
 BufferAllocator::~BufferAllocator() {
 }
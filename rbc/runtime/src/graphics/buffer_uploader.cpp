@@ -89,6 +89,9 @@ bool BufferUploader::commit(
         {
             non_empty = true;
             commit_cmd(i.first, i.second, cmdlist, temp_buffer);
+            i.second.indices.clear();
+            i.second.datas.clear();
+            _free_values.emplace_back(std::move(i.second));
         }
     }
     _copy_cmd.clear();
@@ -111,6 +114,20 @@ void BufferUploader::_swap_buffer(
     _copy_cmd.emplace(buffer.handle(), std::move(map));
 }
 
+auto BufferUploader::_make_cmd_value(BufferView<uint> origin_buffer) -> CmdValue
+{
+    if (_free_values.empty())
+    {
+        return CmdValue{
+            origin_buffer
+        };
+    }
+    auto value = std::move(_free_values.back());
+    _free_values.pop_back();
+    value.origin_buffer = origin_buffer;
+    return value;
+}
+
 auto BufferUploader::_get_copy_cmd(
     BufferView<uint> origin_buffer,
     uint64 struct_size,
@@ -125,9 +142,7 @@ auto BufferUploader::_get_copy_cmd(
     auto iter = map.try_emplace(
         key,
         vstd::lazy_eval([&]() {
-            return CmdValue{
-                origin_buffer
-            };
+            return _make_cmd_value(origin_buffer);
         })
     );
     return iter.first->second;
@@ -149,15 +164,15 @@ void* BufferUploader::emplace_copy_cmd(
     auto iter = map.try_emplace(
         key,
         vstd::lazy_eval([&]() {
-            return CmdValue{
-                origin_buffer
-            };
+            return _make_cmd_value(origin_buffer);
         })
     );
     auto& v = iter.first->second;
-    for (auto i : vstd::range(offset, offset + size))
+    auto start_ind = v.indices.size();
+    v.indices.push_back_uninitialized(size);
+    for (auto i : vstd::range(size))
     {
-        v.indices.emplace_back(i);
+        v.indices[start_ind + i] = static_cast<uint>(offset + i);
     }
     auto start_idx = v.datas.size();
     v.datas.push_back_uninitialized(size * struct_size);
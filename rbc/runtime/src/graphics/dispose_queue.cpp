@@ -4,15 +4,13 @@ void DisposeQueue::on_frame_end(Stream& stream) {
 	if (_elements.empty()) return;
 	stream << [e = std::move(_elements)]() {
 		for (auto&& i : e) {
-			i.dtor(i.ptr);
-			vengine_free(i.ptr);
+			_dispose(i);
 		}
 	};
 }
 void  DisposeQueue::force_clear() {
 	for (auto&& i : _elements) {
-		i.dtor(i.ptr);
-		vengine_free(i.ptr);
+		_dispose(i);
 	}
 	_elements.clear();
 }
@@ -21,8 +19,7 @@ void DisposeQueue::on_frame_end(CommandList& cmdlist) {
 	if (_elements.empty()) return;
 	cmdlist.add_callback([e = std::move(_elements)]() {
 		for (auto&& i : e) {
-			i.dtor(i.ptr);
-			vengine_free(i.ptr);
+			_dispose(i);
 		}
 	});
 }
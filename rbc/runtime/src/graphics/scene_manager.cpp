@@ -14,6 +14,7 @@ SceneManager::SceneManager(
       _device(device),
       _mesh_mng(device),
       _temp_buffer(vstd::make_unique<HostBufferManager>(device)),
+      _frame_arena(vstd::make_unique<ArenaPoolAllocator>()),
       _bdls_mng(device),
       _uploader(),
       _bf_alloc(device),
@@ -23,6 +24,7 @@ SceneManager::SceneManager(
     ShaderManager::create_instance(device, shader_path);
     _tex_streamer.create(
         device, copy_stream, io_service, cmdlist, _bdls_mng);
+    _dsp_queue.set_frame_arena(_frame_arena.get());
     set_instance(this);
 }
 
@@ -132,6 +134,20 @@ void SceneManager::before_rendering(
         i->build_accel(cmdlist);
     }
     _uploader.commit(cmdlist, *_temp_buffer);
+    // compact after the pending uploads, instance patches are committed in the same command list
+    auto relocate = [&](luisa::span<BufferAllocator::Relocation const> relocations) {
+        for (auto &i : _accel_mngs) {
+            i->relocate_buffer_nodes(_uploader, relocations);
+        }
+    };
+    if (_bf_alloc.compact(_device, cmdlist, dispose_queue(), _compact_bytes_per_frame, relocate)) {
+        _uploader.commit(cmdlist, *_temp_buffer);
+    }
+    _bf_alloc.try_shrink(
+        _device, cmdlist, dispose_queue(), _shrink_occupancy,
+        [&](Buffer<uint> const &old_buffer, Buffer<uint> const &new_buffer) {
+            _uploader.swap_buffer(old_buffer, new_buffer);
+        });
     sync_bindless_heap(cmdlist, stream);
     _mesh_mng.execute_compute_bounding(
         cmdlist,
@@ -155,6 +171,14 @@ void SceneManager::prepare_frame() {
             _temp_buffer = vstd::make_unique<HostBufferManager>(_device);
         }
     }
+    if (!_frame_arena) {
+        if (auto new_frame_arena = _frame_arenas.pop()) {
+            _frame_arena = std::move(*new_frame_arena);
+        } else {
+            _frame_arena = vstd::make_unique<ArenaPoolAllocator>();
+        }
+        _dsp_queue.set_frame_arena(_frame_arena.get());
+    }
 }
 bool SceneManager::on_frame_end(
     CommandList &cmdlist,
@@ -186,6 +210,14 @@ bool SceneManager::on_frame_end(
 
     // push dispose queue callback
     _dsp_queue.on_frame_end(cmdlist);
+    // reset after the dispose callback above, which still destructs objects boxed in the arena
+    if (_frame_arena) {
+        _dsp_queue.set_frame_arena(nullptr);
+        cmdlist.add_callback([a = std::move(_frame_arena), this]() mutable {
+            a->reset();
+            _frame_arenas.push(std::move(a));
+        });
+    }
 
     // dispose after commit
     auto disp = vstd::scope_exit([&]() {
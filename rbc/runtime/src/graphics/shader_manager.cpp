@@ -1,6 +1,9 @@
 #include <rbc_graphics/shader_manager.h>
 #include <luisa/core/stl/algorithm.h>
 #include <luisa/core/logging.h>
+#include <luisa/core/clock.h>
+#include <luisa/core/binary_file_stream.h>
+#include <rbc_core/binary_file_writer.h>
 #include <yyjson.h>
 
 namespace rbc {
@@ -96,7 +99,7 @@ auto ShaderManager::_load_shader(
     if (!support_preload)
         value.support_preload = false;
     bool is_equal = true;
-    if (iter.second || value.arg_types.empty()) {
+    auto assign_arg_types = [&]() {
         luisa::visit(
             [&]<typename T>(T const &t) {
                 if constexpr (std::is_same_v<typename T::value_type, Variable>) {
@@ -106,6 +109,9 @@ auto ShaderManager::_load_shader(
                 }
             },
             args);
+    };
+    if (iter.second || value.arg_types.empty()) {
+        assign_arg_types();
     } else {
         is_equal = luisa::visit([&]<typename T>(T const &t) {
             if (value.arg_types.size() != t.size()) return false;
@@ -121,11 +127,22 @@ auto ShaderManager::_load_shader(
                                 args);
     }
     if (!is_equal) [[unlikely]] {
-        LUISA_ERROR("Load same shader {} multiple-times with different type.", can_path_str);
+        if (!value.preloaded) {
+            LUISA_ERROR("Load same shader {} multiple-times with different type.", can_path_str);
+        }
+        // the manifest is older than the shader
+        LUISA_WARNING("Preloaded shader {} has stale argument types, reloading.", can_path_str);
+        value.shader.dispose();
+        value.arg_types.clear();
+        value.preloaded = false;
+        assign_arg_types();
     }
     _all_shader_count++;
-    if (!value.shader.valid())
+    if (!value.shader.valid()) {
+        luisa::Clock clk;
         value.shader = create_func(can_path_str);
+        value.load_ms = static_cast<float>(clk.toc());
+    }
     _finished_shaders++;
     if (!value.shader.valid()) {
         _mtx.lock();
@@ -152,8 +169,9 @@ vstd::vector<char> ShaderManager::loaded_shaders_json(luisa::filesystem::path co
     vec.reserve(1024);
     vec.push_back('{');
     bool first = true;
+    std::lock_guard lck{_mtx};
     for (auto &&i : _shaders) {
-        if (!i.second.support_preload)
+        if (!i.second.support_preload || !i.second.shader.valid())
             continue;
         if (!first) [[likely]] {
             vec.push_back(',');
@@ -192,17 +210,27 @@ void ShaderManager::get_preload_progress(uint64_t &all_shader_count, uint64_t &f
     all_shader_count = _all_shader_count;
     finished_shader_count = _finished_shaders;
 }
-void ShaderManager::preload_shaders(
+fiber::counter ShaderManager::preload_shaders(
     Device &device,
     luisa::filesystem::path const &shader_path,
     vstd::vector<std::pair<vstd::string, vstd::vector<Type const *>>> &&registed_shaders) {
-    auto size = registed_shaders.size();
-    for (auto &i : registed_shaders) {
-        _shaders.try_emplace(i.first);
+    {
+        // never replace a shader that is loading or in use
+        std::lock_guard lck{_mtx};
+        size_t count = 0;
+        for (auto &i : registed_shaders) {
+            if (!_shaders.try_emplace(i.first).second) continue;
+            if (&registed_shaders[count] != &i)
+                registed_shaders[count] = std::move(i);
+            ++count;
+        }
+        registed_shaders.resize(count);
     }
+    auto size = registed_shaders.size();
+    if (size == 0) return {};
     _all_shader_count = size;
     _finished_shaders = 0;
-    fiber::async_parallel(size, [this, &device, shader_path, registed_shaders = std::move(registed_shaders)](size_t i) mutable {
+    return fiber::async_parallel(size, [this, &device, shader_path, registed_shaders = std::move(registed_shaders)](size_t i) mutable {
         auto &js = registed_shaders[i];
         luisa::string &path_str = js.first;
         _mtx.lock();
@@ -221,6 +249,7 @@ void ShaderManager::preload_shaders(
         if (!std::filesystem::exists(path)) {
             return;
         }
+        luisa::Clock clk;
         auto dev_impl = device.impl();
         luisa::span<const Type *const> arg_types_span = arg_types;
         auto load_result = dev_impl->load_shader(path_str, arg_types_span);
@@ -233,9 +262,11 @@ void ShaderManager::preload_shaders(
             ShaderDispatchCmdEncoder::compute_uniform_size(arg_types_span)};
         v.shader = std::move(shader_base);
         v.arg_types = std::move(std::move(arg_types));
+        v.load_ms = static_cast<float>(clk.toc());
+        v.preloaded = true;
     });
 }
-void ShaderManager::preload_shaders(
+fiber::counter ShaderManager::preload_shaders(
     Device &device,
     luisa::filesystem::path const &shader_path, vstd::string_view json_str) {
     yyjson_alc alc{
@@ -268,7 +299,68 @@ void ShaderManager::preload_shaders(
         // _json_deser_func(self, func_table, ctx, ptr, json_doc->root);
         yyjson_doc_free(json_doc);
     }
-    preload_shaders(device, shader_path, std::move(arr));
+    return preload_shaders(device, shader_path, std::move(arr));
+}
+luisa::filesystem::path ShaderManager::manifest_path() const {
+    return _shader_path / "shader_manifest.json";
+}
+fiber::counter ShaderManager::preload_manifest() {
+    auto path = manifest_path();
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return {};
+    }
+    luisa::BinaryFileStream file_stream(luisa::to_string(path));
+    if (!file_stream.valid()) {
+        LUISA_WARNING("Read shader manifest {} failed.", luisa::to_string(path));
+        return {};
+    }
+    luisa::string json;
+    json.resize(file_stream.length());
+    file_stream.read({reinterpret_cast<std::byte *>(json.data()), json.size()});
+    return preload_shaders(_device, _shader_path, json);
+}
+bool ShaderManager::save_manifest() const {
+    auto json = loaded_shaders_json(_shader_path);
+    BinaryFileWriter writer(luisa::to_string(manifest_path()));
+    if (!writer._file) [[unlikely]] {
+        LUISA_WARNING("Write shader manifest {} failed.", luisa::to_string(manifest_path()));
+        return false;
+    }
+    writer.write({reinterpret_cast<std::byte const *>(json.data()), json.size()});
+    return true;
+}
+void ShaderManager::report_load_times(double first_frame_ms) const {
+    struct LoadTime {
+        luisa::string_view name;
+        float ms;
+        bool preloaded;
+    };
+    vstd::vector<LoadTime> times;
+    double preload_ms = 0, lazy_ms = 0;
+    size_t preload_count = 0;
+    {
+        std::lock_guard lck{_mtx};
+        times.reserve(_shaders.size());
+        for (auto &&i : _shaders) {
+            if (!i.second.shader.valid()) continue;
+            times.emplace_back(LoadTime{i.first, i.second.load_ms, i.second.preloaded});
+            if (i.second.preloaded) {
+                preload_ms += i.second.load_ms;
+                ++preload_count;
+            } else {
+                lazy_ms += i.second.load_ms;
+            }
+        }
+    }
+    std::sort(times.begin(), times.end(), [](auto &a, auto &b) { return a.ms > b.ms; });
+    // the sums are per-shader wall times, preloads overlap each other
+    LUISA_INFO(
+        "Time to first frame {:.2f} ms, {} shaders: {} preloaded ({:.2f} ms), {} on demand ({:.2f} ms).",
+        first_frame_ms, times.size(), preload_count, preload_ms, times.size() - preload_count, lazy_ms);
+    for (auto &i : times) {
+        LUISA_INFO("    {:>8.2f} ms {} {}", i.ms, i.preloaded ? "preload  " : "on demand", i.name);
+    }
 }
 struct ReloadLogic {
     using Map = vstd::HashMap<string, ShaderManager::ShaderVariant>;
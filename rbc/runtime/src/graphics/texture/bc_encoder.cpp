@@ -0,0 +1,731 @@
+#include <rbc_graphics/texture/bc_encoder.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+namespace rbc::bc_detail {
+using Quality = BCEncoder::Quality;
+// Pixels are kept as SoA float lanes so the 16-pixel loops below are vectorized by the compiler.
+// No intrinsics on purpose: the same source builds for x64 and ARM, every hot loop runs over the
+// 16 pixel lanes with branchless selects, which GCC/Clang/MSVC turn into SSE/AVX/NEON code.
+struct Block {
+    float c[4][16];
+};
+static constexpr float bc1_weights[4] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+static constexpr float bc4_weights[8] = {0.f, 1.f, 1.f / 7.f, 2.f / 7.f, 3.f / 7.f, 4.f / 7.f, 5.f / 7.f, 6.f / 7.f};
+static constexpr uint bc7_weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static void load_block(uint8_t const *src, uint2 size, uint bx, uint by, Block &block) {
+    for (uint y = 0; y < 4; ++y)
+        for (uint x = 0; x < 4; ++x) {
+            auto px = std::min(bx * 4 + x, size.x - 1);
+            auto py = std::min(by * 4 + y, size.y - 1);
+            auto ptr = src + (static_cast<size_t>(py) * size.x + px) * 4;
+            for (uint ch = 0; ch < 4; ++ch) {
+                block.c[ch][y * 4 + x] = ptr[ch];
+            }
+        }
+}
+///////////// BC6H unsigned half floats, kept as half bit patterns scaled to [0, 255]
+// Fitting in half-bit space is close to fitting in log space, which suits HDR data.
+static constexpr float bc6h_max_half = 31743.f;// 0x7BFF, 65504
+static uint16_t float_to_half_bits(float f) {
+    // BC6H UF16 stores no sign, NaN and negative values map to 0
+    if (!(f > 0.f)) return 0;
+    f = std::min(f, 65504.f);
+    if (f < 6.103515625e-05f) {
+        // subnormal half, multiples of 2^-24
+        return static_cast<uint16_t>(std::lround(f * 16777216.f));
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &f, 4);
+    // round to nearest even on the 13 dropped mantissa bits
+    bits += 0xFFFu + ((bits >> 13u) & 1u);
+    auto exponent = ((bits >> 23u) & 0xFFu) - 112u;
+    return static_cast<uint16_t>((exponent << 10u) | ((bits >> 13u) & 0x3FFu));
+}
+static float half_bits_to_float(uint16_t h) {
+    auto exponent = static_cast<int>((h >> 10u) & 31u);
+    auto mantissa = static_cast<float>(h & 0x3FFu);
+    if (exponent == 0) return std::ldexp(mantissa, -24);
+    return std::ldexp(mantissa + 1024.f, exponent - 25);
+}
+static void load_block_half(float const *src, uint2 size, uint bx, uint by, Block &block) {
+    for (uint y = 0; y < 4; ++y)
+        for (uint x = 0; x < 4; ++x) {
+            auto px = std::min(bx * 4 + x, size.x - 1);
+            auto py = std::min(by * 4 + y, size.y - 1);
+            auto ptr = src + (static_cast<size_t>(py) * size.x + px) * 4;
+            for (uint ch = 0; ch < 3; ++ch) {
+                block.c[ch][y * 4 + x] = float_to_half_bits(ptr[ch]) * (255.f / bc6h_max_half);
+            }
+            block.c[3][y * 4 + x] = 255.f;
+        }
+}
+static inline float clamp255(float v) {
+    return std::clamp(v, 0.f, 255.f);
+}
+// Nearest palette entry of every pixel, the palette is the outer loop so each step is a 16-lane
+// compare and select. Ties keep the lower index.
+template<uint N, uint P>
+static void nearest_entries(float const *const (&lanes)[N], float const (&palette)[P][N], uint palette_size, float (&best)[16], uint (&best_idx)[16]) {
+    float b[16];
+    uint b_idx[16];
+    for (uint i = 0; i < 16; ++i) {
+        b[i] = std::numeric_limits<float>::max();
+        b_idx[i] = 0;
+    }
+    for (uint p = 0; p < palette_size; ++p) {
+        float err[16]{};
+        for (uint ch = 0; ch < N; ++ch) {
+            auto lane = lanes[ch];
+            auto entry = palette[p][ch];
+            for (uint i = 0; i < 16; ++i) {
+                float d = lane[i] - entry;
+                err[i] += d * d;
+            }
+        }
+        for (uint i = 0; i < 16; ++i) {
+            uint closer_mask = 0u - static_cast<uint>(err[i] < b[i]);
+            b_idx[i] = (p & closer_mask) | (b_idx[i] & ~closer_mask);
+            b[i] = std::min(err[i], b[i]);
+        }
+    }
+    std::memcpy(best, b, sizeof(b));
+    std::memcpy(best_idx, b_idx, sizeof(b_idx));
+}
+
+// Endpoints spanning the block along its principal axis (Normal/High) or its bounding box (Fast)
+template<uint N>
+static void initial_endpoints(Block const &block, Quality quality, float (&e0)[N], float (&e1)[N]) {
+    if (quality == Quality::Fast) {
+        for (uint ch = 0; ch < N; ++ch) {
+            float lo = 255.f, hi = 0.f;
+            for (uint i = 0; i < 16; ++i) {
+                lo = std::min(lo, block.c[ch][i]);
+                hi = std::max(hi, block.c[ch][i]);
+            }
+            // inset the box to reduce the error of the interpolated entries
+            float inset = (hi - lo) / 16.f;
+            e0[ch] = hi - inset;
+            e1[ch] = lo + inset;
+        }
+        return;
+    }
+    float mean[N];
+    for (uint ch = 0; ch < N; ++ch) {
+        float sum = 0;
+        for (uint i = 0; i < 16; ++i) sum += block.c[ch][i];
+        mean[ch] = sum / 16.f;
+    }
+    float cov[N][N];
+    for (uint a = 0; a < N; ++a)
+        for (uint b = a; b < N; ++b) {
+            float sum = 0;
+            for (uint i = 0; i < 16; ++i) sum += (block.c[a][i] - mean[a]) * (block.c[b][i] - mean[b]);
+            cov[a][b] = cov[b][a] = sum;
+        }
+    // power iteration starting from the widest channel
+    float axis[N]{};
+    uint widest = 0;
+    for (uint ch = 1; ch < N; ++ch) {
+        if (cov[ch][ch] > cov[widest][widest]) widest = ch;
+    }
+    axis[widest] = 1.f;
+    for (uint iter = 0; iter < 8; ++iter) {
+        float next[N];
+        float len = 0;
+        for (uint a = 0; a < N; ++a) {
+            next[a] = 0;
+            for (uint b = 0; b < N; ++b) next[a] += cov[a][b] * axis[b];
+            len = std::max(len, std::abs(next[a]));
+        }
+        if (len < 1e-6f) break;
+        for (uint a = 0; a < N; ++a) axis[a] = next[a] / len;
+    }
+    float t_min = 0.f, t_max = 0.f;
+    for (uint i = 0; i < 16; ++i) {
+        float t = 0;
+        for (uint ch = 0; ch < N; ++ch) t += (block.c[ch][i] - mean[ch]) * axis[ch];
+        t_min = std::min(t_min, t);
+        t_max = std::max(t_max, t);
+    }
+    float len2 = 0;
+    for (uint ch = 0; ch < N; ++ch) len2 += axis[ch] * axis[ch];
+    if (len2 > 0) {
+        t_min /= len2;
+        t_max /= len2;
+    }
+    for (uint ch = 0; ch < N; ++ch) {
+        e0[ch] = clamp255(mean[ch] + axis[ch] * t_max);
+        e1[ch] = clamp255(mean[ch] + axis[ch] * t_min);
+    }
+}
+
+// Least-squares endpoints for fixed per-pixel interpolation weights t (weight of e1)
+template<uint N>
+static bool least_squares(Block const &block, float const (&t)[16], float (&e0)[N], float (&e1)[N]) {
+    float aa = 0, bb = 0, ab = 0;
+    float ax[N]{}, bx[N]{};
+    for (uint i = 0; i < 16; ++i) {
+        float a = 1.f - t[i];
+        float b = t[i];
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (uint ch = 0; ch < N; ++ch) {
+            ax[ch] += a * block.c[ch][i];
+            bx[ch] += b * block.c[ch][i];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1e-6f) return false;
+    float inv_det = 1.f / det;
+    for (uint ch = 0; ch < N; ++ch) {
+        e0[ch] = clamp255((ax[ch] * bb - bx[ch] * ab) * inv_det);
+        e1[ch] = clamp255((bx[ch] * aa - ax[ch] * ab) * inv_det);
+    }
+    return true;
+}
+
+///////////// BC1 color
+static inline uint16_t pack565(float const (&c)[3]) {
+    auto r = static_cast<uint>(std::lround(c[0] * 31.f / 255.f));
+    auto g = static_cast<uint>(std::lround(c[1] * 63.f / 255.f));
+    auto b = static_cast<uint>(std::lround(c[2] * 31.f / 255.f));
+    return static_cast<uint16_t>((r << 11u) | (g << 5u) | b);
+}
+static inline void unpack565(uint16_t v, float (&c)[3]) {
+    uint r = (v >> 11u) & 31u, g = (v >> 5u) & 63u, b = v & 31u;
+    c[0] = static_cast<float>((r << 3u) | (r >> 2u));
+    c[1] = static_cast<float>((g << 2u) | (g >> 4u));
+    c[2] = static_cast<float>((b << 3u) | (b >> 2u));
+}
+struct BC1Result {
+    uint16_t c0, c1;
+    uint32_t indices;
+    float error;
+};
+// four-color mode fit, c0 and c1 are reordered so that c0 >= c1
+static BC1Result bc1_fit(Block const &block, uint16_t c0, uint16_t c1, float (&t)[16]) {
+    if (c0 < c1) std::swap(c0, c1);
+    float e0[3], e1[3];
+    unpack565(c0, e0);
+    unpack565(c1, e1);
+    float palette[4][3];
+    for (uint p = 0; p < 4; ++p)
+        for (uint ch = 0; ch < 3; ++ch)
+            palette[p][ch] = e0[ch] + (e1[ch] - e0[ch]) * bc1_weights[p];
+    BC1Result result{c0, c1, 0u, 0.f};
+    float best[16];
+    uint best_idx[16];
+    // c0 == c1 only encodes index 0
+    nearest_entries<3, 4>({block.c[0], block.c[1], block.c[2]}, palette, c0 == c1 ? 1u : 4u, best, best_idx);
+    for (uint i = 0; i < 16; ++i) {
+        result.indices |= best_idx[i] << (2u * i);
+        result.error += best[i];
+        t[i] = bc1_weights[best_idx[i]];
+    }
+    return result;
+}
+static BC1Result bc1_encode(Block const &block, Quality quality) {
+    float e0[3], e1[3];
+    initial_endpoints<3>(block, quality, e0, e1);
+    float t[16];
+    auto result = bc1_fit(block, pack565(e0), pack565(e1), t);
+    uint iterations = quality == Quality::Fast ? 0u : (quality == Quality::Normal ? 1u : 4u);
+    for (uint iter = 0; iter < iterations; ++iter) {
+        if (!least_squares<3>(block, t, e0, e1)) break;
+        float new_t[16];
+        auto refined = bc1_fit(block, pack565(e0), pack565(e1), new_t);
+        if (refined.error >= result.error) break;
+        result = refined;
+        std::memcpy(t, new_t, sizeof(t));
+    }
+    return result;
+}
+static void write_bc1(BC1Result const &r, uint8_t *dst) {
+    std::memcpy(dst, &r.c0, 2);
+    std::memcpy(dst + 2, &r.c1, 2);
+    std::memcpy(dst + 4, &r.indices, 4);
+}
+
+///////////// BC4 single channel
+struct BC4Result {
+    uint8_t e0, e1;
+    uint64_t indices;
+    float error;
+};
+static BC4Result bc4_fit(float const *v, uint8_t e0, uint8_t e1) {
+    BC4Result result{e0, e1, 0u, 0.f};
+    float palette[8][1];
+    for (uint p = 0; p < 8; ++p) palette[p][0] = e0 + (static_cast<float>(e1) - e0) * bc4_weights[p];
+    float best[16];
+    uint best_idx[16];
+    nearest_entries<1, 8>({v}, palette, e0 == e1 ? 1u : 8u, best, best_idx);
+    for (uint i = 0; i < 16; ++i) {
+        result.indices |= static_cast<uint64_t>(best_idx[i]) << (3u * i);
+        result.error += best[i];
+    }
+    return result;
+}
+static void bc4_encode(float const *v, Quality quality, uint8_t *dst) {
+    float lo = 255.f, hi = 0.f;
+    for (uint i = 0; i < 16; ++i) {
+        lo = std::min(lo, v[i]);
+        hi = std::max(hi, v[i]);
+    }
+    // eight-value mode requires e0 > e1
+    auto e0 = static_cast<uint8_t>(std::lround(hi));
+    auto e1 = static_cast<uint8_t>(std::lround(lo));
+    auto result = bc4_fit(v, e0, e1);
+    if (quality != Quality::Fast && e0 > e1) {
+        int range = quality == Quality::High ? 6 : 2;
+        range = std::min(range, (e0 - e1) / 2);
+        for (int d0 = 0; d0 <= range; ++d0)
+            for (int d1 = 0; d1 <= range; ++d1) {
+                if (d0 == 0 && d1 == 0) continue;
+                auto r = bc4_fit(v, static_cast<uint8_t>(e0 - d0), static_cast<uint8_t>(e1 + d1));
+                if (r.error < result.error) result = r;
+            }
+    }
+    dst[0] = result.e0;
+    dst[1] = result.e1;
+    for (uint i = 0; i < 6; ++i) {
+        dst[2 + i] = static_cast<uint8_t>(result.indices >> (8u * i));
+    }
+}
+
+///////////// BC7 mode 6: RGBA, one subset, 7-bit endpoints + unique p-bit, 4-bit indices
+struct BC7Result {
+    uint8_t e[2][4];// 7-bit
+    uint8_t p[2];
+    uint8_t indices[16];
+    float error;
+};
+static void bc7_fit(Block const &block, BC7Result &r, float (&t)[16]) {
+    float ep[2][4];
+    for (uint i = 0; i < 2; ++i)
+        for (uint ch = 0; ch < 4; ++ch)
+            ep[i][ch] = static_cast<float>((r.e[i][ch] << 1u) | r.p[i]);
+    float palette[16][4];
+    for (uint p = 0; p < 16; ++p)
+        for (uint ch = 0; ch < 4; ++ch)
+            palette[p][ch] = static_cast<float>(((64u - bc7_weights[p]) * static_cast<uint>(ep[0][ch]) + bc7_weights[p] * static_cast<uint>(ep[1][ch]) + 32u) >> 6u);
+    r.error = 0;
+    float best[16];
+    uint best_idx[16];
+    nearest_entries<4, 16>({block.c[0], block.c[1], block.c[2], block.c[3]}, palette, 16u, best, best_idx);
+    for (uint i = 0; i < 16; ++i) {
+        r.indices[i] = static_cast<uint8_t>(best_idx[i]);
+        r.error += best[i];
+        t[i] = bc7_weights[best_idx[i]] / 64.f;
+    }
+}
+static void bc7_quantize(float const (&e)[4], uint8_t p, uint8_t (&dst)[4]) {
+    for (uint ch = 0; ch < 4; ++ch) {
+        dst[ch] = static_cast<uint8_t>(std::clamp<long>(std::lround((e[ch] - p) / 2.f), 0, 127));
+    }
+}
+static float bc7_quantize_error(float const (&e)[4], uint8_t p) {
+    uint8_t q[4];
+    bc7_quantize(e, p, q);
+    float err = 0;
+    for (uint ch = 0; ch < 4; ++ch) {
+        float d = e[ch] - static_cast<float>((q[ch] << 1u) | p);
+        err += d * d;
+    }
+    return err;
+}
+static BC7Result bc7_from_endpoints(Block const &block, Quality quality, float const (&e0)[4], float const (&e1)[4], float (&t)[16]) {
+    BC7Result best{};
+    best.error = std::numeric_limits<float>::max();
+    auto try_pbits = [&](uint8_t p0, uint8_t p1) {
+        BC7Result r{};
+        r.p[0] = p0;
+        r.p[1] = p1;
+        bc7_quantize(e0, p0, r.e[0]);
+        bc7_quantize(e1, p1, r.e[1]);
+        float new_t[16];
+        bc7_fit(block, r, new_t);
+        if (r.error < best.error) {
+            best = r;
+            std::memcpy(t, new_t, sizeof(new_t));
+        }
+    };
+    if (quality == Quality::High) {
+        for (uint8_t p0 = 0; p0 < 2; ++p0)
+            for (uint8_t p1 = 0; p1 < 2; ++p1)
+                try_pbits(p0, p1);
+    } else {
+        // choose the p-bit closest to each endpoint independently
+        try_pbits(
+            bc7_quantize_error(e0, 0) <= bc7_quantize_error(e0, 1) ? 0 : 1,
+            bc7_quantize_error(e1, 0) <= bc7_quantize_error(e1, 1) ? 0 : 1);
+    }
+    return best;
+}
+static BC7Result bc7_encode(Block const &block, Quality quality) {
+    float e0[4], e1[4];
+    initial_endpoints<4>(block, quality, e0, e1);
+    float t[16];
+    auto result = bc7_from_endpoints(block, quality, e0, e1, t);
+    uint iterations = quality == Quality::Fast ? 0u : (quality == Quality::Normal ? 1u : 3u);
+    for (uint iter = 0; iter < iterations; ++iter) {
+        if (!least_squares<4>(block, t, e0, e1)) break;
+        float new_t[16];
+        auto refined = bc7_from_endpoints(block, quality, e0, e1, new_t);
+        if (refined.error >= result.error) break;
+        result = refined;
+        std::memcpy(t, new_t, sizeof(t));
+    }
+    // the anchor index (pixel 0) has an implicit zero MSB
+    if (result.indices[0] >= 8) {
+        for (uint ch = 0; ch < 4; ++ch) std::swap(result.e[0][ch], result.e[1][ch]);
+        std::swap(result.p[0], result.p[1]);
+        for (auto &i : result.indices) i = static_cast<uint8_t>(15u - i);
+    }
+    return result;
+}
+struct BitWriter {
+    uint8_t *dst;
+    uint pos{0};
+    void write(uint value, uint bits) {
+        for (uint i = 0; i < bits; ++i, ++pos) {
+            if ((value >> i) & 1u) dst[pos >> 3u] |= static_cast<uint8_t>(1u << (pos & 7u));
+        }
+    }
+};
+struct BitReader {
+    uint8_t const *src;
+    uint pos{0};
+    uint read(uint bits) {
+        uint value = 0;
+        for (uint i = 0; i < bits; ++i, ++pos) {
+            value |= ((src[pos >> 3u] >> (pos & 7u)) & 1u) << i;
+        }
+        return value;
+    }
+};
+static void write_bc7(BC7Result const &r, uint8_t *dst) {
+    std::memset(dst, 0, 16);
+    BitWriter writer{dst};
+    writer.write(1u << 6u, 7);
+    for (uint ch = 0; ch < 4; ++ch) {
+        writer.write(r.e[0][ch], 7);
+        writer.write(r.e[1][ch], 7);
+    }
+    writer.write(r.p[0], 1);
+    writer.write(r.p[1], 1);
+    writer.write(r.indices[0], 3);
+    for (uint i = 1; i < 16; ++i) writer.write(r.indices[i], 4);
+}
+
+///////////// BC6H mode 11: RGB, one region, 10-bit endpoints, 4-bit indices
+static inline uint bc6h_unquantize(uint q) {
+    if (q == 0) return 0;
+    if (q == 1023) return 0xFFFFu;
+    return ((q << 16u) + 0x8000u) >> 10u;
+}
+// decoded half bits of a palette entry, same math as the hardware decoder
+static inline uint bc6h_interpolate(uint q0, uint q1, uint w) {
+    auto v = ((64u - w) * bc6h_unquantize(q0) + w * bc6h_unquantize(q1) + 32u) >> 6u;
+    return (v * 31u) >> 6u;
+}
+static uint16_t bc6h_quantize(float e) {
+    // inverse of finish/unquantize, then pick the best of the neighbours
+    auto target = e * (bc6h_max_half / 255.f);
+    auto guess = static_cast<int>(std::lround(target * 64.f / 31.f * 1024.f / 65536.f));
+    uint16_t best = 0;
+    float best_err = std::numeric_limits<float>::max();
+    for (int q = guess - 1; q <= guess + 1; ++q) {
+        if (q < 0 || q > 1023) continue;
+        float err = std::abs(static_cast<float>(bc6h_interpolate(q, q, 0)) - target);
+        if (err < best_err) {
+            best_err = err;
+            best = static_cast<uint16_t>(q);
+        }
+    }
+    return best;
+}
+struct BC6HResult {
+    uint16_t e[2][3];
+    uint8_t indices[16];
+    float error;
+};
+static BC6HResult bc6h_fit(Block const &block, float const (&e0)[3], float const (&e1)[3], float (&t)[16]) {
+    BC6HResult r{};
+    for (uint ch = 0; ch < 3; ++ch) {
+        r.e[0][ch] = bc6h_quantize(e0[ch]);
+        r.e[1][ch] = bc6h_quantize(e1[ch]);
+    }
+    float palette[16][3];
+    for (uint p = 0; p < 16; ++p)
+        for (uint ch = 0; ch < 3; ++ch)
+            palette[p][ch] = bc6h_interpolate(r.e[0][ch], r.e[1][ch], bc7_weights[p]) * (255.f / bc6h_max_half);
+    float best[16];
+    uint best_idx[16];
+    nearest_entries<3, 16>({block.c[0], block.c[1], block.c[2]}, palette, 16u, best, best_idx);
+    for (uint i = 0; i < 16; ++i) {
+        r.indices[i] = static_cast<uint8_t>(best_idx[i]);
+        r.error += best[i];
+        t[i] = bc7_weights[best_idx[i]] / 64.f;
+    }
+    return r;
+}
+static BC6HResult bc6h_encode(Block const &block, Quality quality) {
+    float e0[3], e1[3];
+    initial_endpoints<3>(block, quality, e0, e1);
+    float t[16];
+    auto result = bc6h_fit(block, e0, e1, t);
+    uint iterations = quality == Quality::Fast ? 0u : (quality == Quality::Normal ? 1u : 4u);
+    for (uint iter = 0; iter < iterations; ++iter) {
+        if (!least_squares<3>(block, t, e0, e1)) break;
+        float new_t[16];
+        auto refined = bc6h_fit(block, e0, e1, new_t);
+        if (refined.error >= result.error) break;
+        result = refined;
+        std::memcpy(t, new_t, sizeof(t));
+    }
+    // the anchor index (pixel 0) has an implicit zero MSB
+    if (result.indices[0] >= 8) {
+        for (uint ch = 0; ch < 3; ++ch) std::swap(result.e[0][ch], result.e[1][ch]);
+        for (auto &i : result.indices) i = static_cast<uint8_t>(15u - i);
+    }
+    return result;
+}
+static void write_bc6h(BC6HResult const &r, uint8_t *dst) {
+    std::memset(dst, 0, 16);
+    BitWriter writer{dst};
+    writer.write(0x03u, 5);
+    for (uint i = 0; i < 2; ++i)
+        for (uint ch = 0; ch < 3; ++ch)
+            writer.write(r.e[i][ch], 10);
+    writer.write(r.indices[0], 3);
+    for (uint i = 1; i < 16; ++i) writer.write(r.indices[i], 4);
+}
+
+///////////// decoders
+static void decode_bc1(uint8_t const *src, uint8_t (&out)[16][4], bool force_four_color) {
+    uint16_t c0, c1;
+    uint32_t indices;
+    std::memcpy(&c0, src, 2);
+    std::memcpy(&c1, src + 2, 2);
+    std::memcpy(&indices, src + 4, 4);
+    float e0[3], e1[3];
+    unpack565(c0, e0);
+    unpack565(c1, e1);
+    float palette[4][4];
+    for (uint ch = 0; ch < 3; ++ch) {
+        palette[0][ch] = e0[ch];
+        palette[1][ch] = e1[ch];
+        if (c0 > c1 || force_four_color) {
+            palette[2][ch] = (2.f * e0[ch] + e1[ch]) / 3.f;
+            palette[3][ch] = (e0[ch] + 2.f * e1[ch]) / 3.f;
+        } else {
+            palette[2][ch] = (e0[ch] + e1[ch]) / 2.f;
+            palette[3][ch] = 0.f;
+        }
+    }
+    for (uint p = 0; p < 4; ++p) palette[p][3] = 255.f;
+    if (!(c0 > c1 || force_four_color)) palette[3][3] = 0.f;
+    for (uint i = 0; i < 16; ++i) {
+        auto idx = (indices >> (2u * i)) & 3u;
+        for (uint ch = 0; ch < 4; ++ch) out[i][ch] = static_cast<uint8_t>(std::lround(palette[idx][ch]));
+    }
+}
+static void decode_bc4(uint8_t const *src, uint8_t (&out)[16][4], uint channel) {
+    uint8_t e0 = src[0], e1 = src[1];
+    float palette[8];
+    palette[0] = e0;
+    palette[1] = e1;
+    if (e0 > e1) {
+        for (uint p = 2; p < 8; ++p) palette[p] = ((8.f - p) * e0 + (p - 1.f) * e1) / 7.f;
+    } else {
+        for (uint p = 2; p < 6; ++p) palette[p] = ((6.f - p) * e0 + (p - 1.f) * e1) / 5.f;
+        palette[6] = 0.f;
+        palette[7] = 255.f;
+    }
+    uint64_t indices = 0;
+    for (uint i = 0; i < 6; ++i) indices |= static_cast<uint64_t>(src[2 + i]) << (8u * i);
+    for (uint i = 0; i < 16; ++i) {
+        out[i][channel] = static_cast<uint8_t>(std::lround(palette[(indices >> (3u * i)) & 7u]));
+    }
+}
+static void decode_bc7(uint8_t const *src, uint8_t (&out)[16][4]) {
+    BitReader reader{src};
+    if (reader.read(7) != (1u << 6u)) {
+        // only mode 6 is produced by this encoder
+        std::memset(out, 0, sizeof(out));
+        return;
+    }
+    uint e[2][4];
+    for (uint ch = 0; ch < 4; ++ch) {
+        e[0][ch] = reader.read(7);
+        e[1][ch] = reader.read(7);
+    }
+    uint p0 = reader.read(1), p1 = reader.read(1);
+    for (uint ch = 0; ch < 4; ++ch) {
+        e[0][ch] = (e[0][ch] << 1u) | p0;
+        e[1][ch] = (e[1][ch] << 1u) | p1;
+    }
+    for (uint i = 0; i < 16; ++i) {
+        auto idx = reader.read(i == 0 ? 3 : 4);
+        auto w = bc7_weights[idx];
+        for (uint ch = 0; ch < 4; ++ch) out[i][ch] = static_cast<uint8_t>(((64u - w) * e[0][ch] + w * e[1][ch] + 32u) >> 6u);
+    }
+}
+static void decode_bc6h(uint8_t const *src, float (&out)[16][4]) {
+    BitReader reader{src};
+    if (reader.read(5) != 0x03u) {
+        // only mode 11 is produced by this encoder
+        std::memset(out, 0, sizeof(out));
+        return;
+    }
+    uint e[2][3];
+    for (uint i = 0; i < 2; ++i)
+        for (uint ch = 0; ch < 3; ++ch)
+            e[i][ch] = reader.read(10);
+    for (uint i = 0; i < 16; ++i) {
+        auto w = bc7_weights[reader.read(i == 0 ? 3 : 4)];
+        for (uint ch = 0; ch < 3; ++ch) {
+            out[i][ch] = half_bits_to_float(static_cast<uint16_t>(bc6h_interpolate(e[0][ch], e[1][ch], w)));
+        }
+        out[i][3] = 1.f;
+    }
+}
+}// namespace rbc::bc_detail
+
+namespace rbc {
+PixelStorage BCEncoder::pixel_storage(Format format) {
+    switch (format) {
+        case Format::BC1: return PixelStorage::BC1;
+        case Format::BC3: return PixelStorage::BC3;
+        case Format::BC4: return PixelStorage::BC4;
+        case Format::BC5: return PixelStorage::BC5;
+        case Format::BC7: return PixelStorage::BC7;
+        case Format::BC6H: return PixelStorage::BC6;
+    }
+    RBC_UNREACHABLE();
+}
+PixelStorage BCEncoder::source_storage(Format format) {
+    return format == Format::BC6H ? PixelStorage::FLOAT4 : PixelStorage::BYTE4;
+}
+size_t BCEncoder::block_size(Format format) {
+    return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+}
+size_t BCEncoder::encoded_size(Format format, uint2 size) {
+    auto blocks = (size + 3u) / 4u;
+    return static_cast<size_t>(blocks.x) * blocks.y * block_size(format);
+}
+void BCEncoder::encode(
+    Format format,
+    Quality quality,
+    luisa::span<std::byte const> src,
+    uint2 size,
+    luisa::span<std::byte> dst) {
+    using namespace bc_detail;
+    auto texel_size = pixel_storage_size(source_storage(format), make_uint3(1u));
+    LUISA_ASSERT(src.size_bytes() >= static_cast<size_t>(size.x) * size.y * texel_size, "Source size {} too small for {}x{} texels.", src.size_bytes(), size.x, size.y);
+    LUISA_ASSERT(dst.size_bytes() >= encoded_size(format, size), "Destination size {} too small.", dst.size_bytes());
+    auto blocks = (size + 3u) / 4u;
+    auto src_ptr = reinterpret_cast<uint8_t const *>(src.data());
+    auto dst_ptr = reinterpret_cast<uint8_t *>(dst.data());
+    auto bsize = block_size(format);
+    luisa::fiber::parallel(blocks.y, [&](uint by) {
+        Block block;
+        for (uint bx = 0; bx < blocks.x; ++bx) {
+            if (format == Format::BC6H) {
+                load_block_half(reinterpret_cast<float const *>(src_ptr), size, bx, by, block);
+            } else {
+                load_block(src_ptr, size, bx, by, block);
+            }
+            auto out = dst_ptr + (static_cast<size_t>(by) * blocks.x + bx) * bsize;
+            switch (format) {
+                case Format::BC1:
+                    write_bc1(bc1_encode(block, quality), out);
+                    break;
+                case Format::BC3:
+                    bc4_encode(block.c[3], quality, out);
+                    write_bc1(bc1_encode(block, quality), out + 8);
+                    break;
+                case Format::BC4:
+                    bc4_encode(block.c[0], quality, out);
+                    break;
+                case Format::BC5:
+                    bc4_encode(block.c[0], quality, out);
+                    bc4_encode(block.c[1], quality, out + 8);
+                    break;
+                case Format::BC7:
+                    write_bc7(bc7_encode(block, quality), out);
+                    break;
+                case Format::BC6H:
+                    write_bc6h(bc6h_encode(block, quality), out);
+                    break;
+            }
+        }
+    });
+}
+void BCEncoder::decode(
+    Format format,
+    luisa::span<std::byte const> src,
+    uint2 size,
+    luisa::span<std::byte> dst) {
+    using namespace bc_detail;
+    LUISA_ASSERT(src.size_bytes() >= encoded_size(format, size), "Source size {} too small.", src.size_bytes());
+    auto texel_size = pixel_storage_size(source_storage(format), make_uint3(1u));
+    LUISA_ASSERT(dst.size_bytes() >= static_cast<size_t>(size.x) * size.y * texel_size, "Destination size {} too small for {}x{} texels.", dst.size_bytes(), size.x, size.y);
+    auto blocks = (size + 3u) / 4u;
+    auto src_ptr = reinterpret_cast<uint8_t const *>(src.data());
+    auto dst_ptr = reinterpret_cast<uint8_t *>(dst.data());
+    auto bsize = block_size(format);
+    luisa::fiber::parallel(blocks.y, [&](uint by) {
+        for (uint bx = 0; bx < blocks.x; ++bx) {
+            auto in = src_ptr + (static_cast<size_t>(by) * blocks.x + bx) * bsize;
+            if (format == Format::BC6H) {
+                float out[16][4];
+                decode_bc6h(in, out);
+                for (uint y = 0; y < 4; ++y)
+                    for (uint x = 0; x < 4; ++x) {
+                        auto px = bx * 4 + x, py = by * 4 + y;
+                        if (px >= size.x || py >= size.y) continue;
+                        std::memcpy(dst_ptr + (static_cast<size_t>(py) * size.x + px) * 16, out[y * 4 + x], 16);
+                    }
+                continue;
+            }
+            uint8_t out[16][4]{};
+            switch (format) {
+                case Format::BC1:
+                    decode_bc1(in, out, false);
+                    break;
+                case Format::BC3:
+                    decode_bc1(in + 8, out, true);
+                    decode_bc4(in, out, 3);
+                    break;
+                case Format::BC4:
+                    decode_bc4(in, out, 0);
+                    for (auto &i : out) i[3] = 255;
+                    break;
+                case Format::BC5:
+                    decode_bc4(in, out, 0);
+                    decode_bc4(in + 8, out, 1);
+                    for (auto &i : out) i[3] = 255;
+                    break;
+                case Format::BC7:
+                    decode_bc7(in, out);
+                    break;
+                case Format::BC6H:
+                    break;
+            }
+            for (uint y = 0; y < 4; ++y)
+                for (uint x = 0; x < 4; ++x) {
+                    auto px = bx * 4 + x, py = by * 4 + y;
+                    if (px >= size.x || py >= size.y) continue;
+                    std::memcpy(dst_ptr + (static_cast<size_t>(py) * size.x + px) * 4, out[y * 4 + x], 4);
+                }
+        }
+    });
+}
+}// namespace rbc
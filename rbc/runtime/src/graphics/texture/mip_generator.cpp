@@ -0,0 +1,167 @@
+#include <rbc_graphics/texture/mip_generator.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/vector.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+namespace rbc::mip_detail {
+struct SRGBTable {
+    std::array<float, 256> decode;
+    // indexed by linear value quantized to 16 bits, fine enough to round-trip every 8-bit code
+    std::array<uint8_t, 65536> encode;
+    SRGBTable() {
+        for (uint i = 0; i < 256; ++i) {
+            auto v = i / 255.f;
+            decode[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+        }
+        for (uint i = 0; i < 65536; ++i) {
+            auto v = i / 65535.f;
+            auto s = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.f / 2.4f) - 0.055f;
+            encode[i] = static_cast<uint8_t>(std::clamp(s * 255.f + 0.5f, 0.f, 255.f));
+        }
+    }
+    static SRGBTable const &instance() {
+        static SRGBTable table;
+        return table;
+    }
+};
+// Rows are processed as flat lanes with branch-free inner loops so the compiler vectorizes the filter,
+// no intrinsics for the same x64/ARM reason as the BC encoder. Only sRGB table lookups stay scalar.
+// Sum of each 2x2 quad times scale, an odd last column is dropped and a single column is clamped
+template<typename T, uint C>
+static void filter_row(T const *row0, T const *row1, uint src_width, uint dst_width, float scale, float *dst) {
+    // size_t indices, wrapping uint math would keep the loop from being vectorized
+    size_t pairs = std::min(dst_width, src_width / 2);
+    for (size_t x = 0; x < pairs; ++x)
+        for (size_t c = 0; c < C; ++c) {
+            auto i = x * 2 * C + c;
+            // 8-bit sums stay exact in int
+            dst[x * C + c] = static_cast<float>((row0[i] + row0[i + C]) + (row1[i] + row1[i + C])) * scale;
+        }
+    for (size_t x = pairs; x < dst_width; ++x)
+        for (size_t c = 0; c < C; ++c) {
+            auto i0 = std::min<size_t>(x * 2, src_width - 1) * C + c;
+            auto i1 = std::min<size_t>(x * 2 + 1, src_width - 1) * C + c;
+            dst[x * C + c] = static_cast<float>((row0[i0] + row0[i1]) + (row1[i0] + row1[i1])) * scale;
+        }
+}
+// Same quads with sRGB color channels decoded to linear first, alpha stays linear
+template<uint C>
+static void filter_row_srgb(uint8_t const *row0, uint8_t const *row1, uint src_width, uint dst_width, float *dst) {
+    auto &decode = SRGBTable::instance().decode;
+    auto quad = [&](size_t i0, size_t i1, size_t c) {
+        if (c < 3) return ((decode[row0[i0]] + decode[row0[i1]]) + (decode[row1[i0]] + decode[row1[i1]])) * 0.25f;
+        return static_cast<float>((row0[i0] + row0[i1]) + (row1[i0] + row1[i1])) * (0.25f / 255.f);
+    };
+    size_t pairs = std::min(dst_width, src_width / 2);
+    for (size_t x = 0; x < pairs; ++x)
+        for (size_t c = 0; c < C; ++c) {
+            auto i = x * 2 * C + c;
+            dst[x * C + c] = quad(i, i + C, c);
+        }
+    for (size_t x = pairs; x < dst_width; ++x)
+        for (size_t c = 0; c < C; ++c) {
+            dst[x * C + c] = quad(std::min<size_t>(x * 2, src_width - 1) * C + c, std::min<size_t>(x * 2 + 1, src_width - 1) * C + c, c);
+        }
+}
+template<uint C>
+static void store_row(float const *src, size_t lanes, bool srgb, uint8_t *dst) {
+    for (size_t i = 0; i < lanes; ++i) {
+        dst[i] = static_cast<uint8_t>(std::clamp(src[i], 0.f, 1.f) * 255.f + 0.5f);
+    }
+    if (srgb) {
+        auto &table = SRGBTable::instance();
+        for (size_t i = 0; i < lanes; i += C)
+            for (size_t c = 0; c < std::min(C, 3u); ++c) {
+                dst[i + c] = table.encode[static_cast<uint>(std::clamp(src[i + c], 0.f, 1.f) * 65535.f + 0.5f)];
+            }
+    }
+}
+// 2x2 box filter, the last row/column of odd-sized levels is clamped
+template<typename T, uint C>
+static void downsample(T const *src, uint2 src_size, T *dst, uint2 dst_size, bool srgb) {
+    constexpr uint rows_per_task = 16;
+    luisa::fiber::parallel((dst_size.y + rows_per_task - 1) / rows_per_task, [&](uint task) {
+        // filtered float row of 8-bit textures before it is quantized
+        luisa::vector<float> out;
+        if constexpr (std::is_same_v<T, uint8_t>) {
+            out.push_back_uninitialized(static_cast<size_t>(dst_size.x) * C);
+        }
+        auto y_end = std::min((task + 1) * rows_per_task, dst_size.y);
+        for (uint y = task * rows_per_task; y < y_end; ++y) {
+            auto row0 = src + static_cast<size_t>(std::min(y * 2, src_size.y - 1)) * src_size.x * C;
+            auto row1 = src + static_cast<size_t>(std::min(y * 2 + 1, src_size.y - 1)) * src_size.x * C;
+            auto dst_row = dst + static_cast<size_t>(y) * dst_size.x * C;
+            if constexpr (std::is_same_v<T, float>) {
+                filter_row<float, C>(row0, row1, src_size.x, dst_size.x, 0.25f, dst_row);
+            } else {
+                if (srgb) {
+                    filter_row_srgb<C>(row0, row1, src_size.x, dst_size.x, out.data());
+                } else {
+                    filter_row<uint8_t, C>(row0, row1, src_size.x, dst_size.x, 0.25f / 255.f, out.data());
+                }
+                store_row<C>(out.data(), out.size(), srgb, dst_row);
+            }
+        }
+    });
+}
+template<typename T, uint C>
+static void generate_chain(uint2 size, uint mip_level, bool srgb, std::byte *data) {
+    auto src = reinterpret_cast<T *>(data);
+    for (uint level = 1; level < mip_level; ++level) {
+        auto src_size = MipGenerator::level_size(size, level - 1);
+        auto dst_size = MipGenerator::level_size(size, level);
+        auto dst = src + static_cast<size_t>(src_size.x) * src_size.y * C;
+        downsample<T, C>(src, src_size, dst, dst_size, srgb);
+        src = dst;
+    }
+}
+}// namespace rbc::mip_detail
+
+namespace rbc {
+bool MipGenerator::is_supported(PixelStorage storage) {
+    switch (storage) {
+        case PixelStorage::BYTE1:
+        case PixelStorage::BYTE2:
+        case PixelStorage::BYTE4:
+        case PixelStorage::FLOAT1:
+        case PixelStorage::FLOAT2:
+        case PixelStorage::FLOAT4:
+            return true;
+        default:
+            return false;
+    }
+}
+uint2 MipGenerator::level_size(uint2 size, uint level) {
+    return max(uint2(1u), size >> level);
+}
+size_t MipGenerator::chain_size_bytes(PixelStorage storage, uint2 size, uint mip_level) {
+    size_t size_bytes = 0;
+    for (uint level = 0; level < mip_level; ++level) {
+        size_bytes += pixel_storage_size(storage, make_uint3(level_size(size, level), 1u));
+    }
+    return size_bytes;
+}
+bool MipGenerator::generate(
+    PixelStorage storage,
+    uint2 size,
+    uint mip_level,
+    ColorSpace color_space,
+    luisa::span<std::byte> data) {
+    using namespace mip_detail;
+    if (!is_supported(storage)) return false;
+    LUISA_ASSERT(data.size_bytes() >= chain_size_bytes(storage, size, mip_level), "Mip chain buffer size {} too small.", data.size_bytes());
+    bool srgb = color_space == ColorSpace::SRGB;
+    switch (storage) {
+        case PixelStorage::BYTE1: generate_chain<uint8_t, 1>(size, mip_level, false, data.data()); break;
+        case PixelStorage::BYTE2: generate_chain<uint8_t, 2>(size, mip_level, false, data.data()); break;
+        case PixelStorage::BYTE4: generate_chain<uint8_t, 4>(size, mip_level, srgb, data.data()); break;
+        case PixelStorage::FLOAT1: generate_chain<float, 1>(size, mip_level, false, data.data()); break;
+        case PixelStorage::FLOAT2: generate_chain<float, 2>(size, mip_level, false, data.data()); break;
+        case PixelStorage::FLOAT4: generate_chain<float, 4>(size, mip_level, false, data.data()); break;
+        default: break;
+    }
+    return true;
+}
+}// namespace rbc
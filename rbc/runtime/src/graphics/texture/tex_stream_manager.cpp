@@ -95,17 +95,20 @@ TexStreamManager::TexStreamManager(
     counter.wait();
 }
 
-size_t TexStreamManager::TexIndex::get_byte_offset(uint2 tile_idx, uint level) {
-    size_t size_offset = 0;
-    size_t tile_size = pixel_storage_size(img.storage(), uint3(chunk_resolution, chunk_resolution, 1));
+size_t TexStreamManager::TexIndex::get_tile_index(uint2 tile_idx, uint level) {
+    size_t index = 0;
     uint2 res = streamer.resolution();
     for (auto i : vstd::range(level)) {
         LUISA_ASSERT(res.x >= 1 && res.y >= 1, "Resolution must be larger than 0.");
-        size_offset += res.x * res.y * tile_size;
+        index += res.x * res.y;
         res >>= 1u;
     }
-    size_offset += (tile_idx.x + tile_idx.y * res.x) * tile_size;
-    return size_offset;
+    index += tile_idx.x + tile_idx.y * res.x;
+    return index;
+}
+size_t TexStreamManager::TexIndex::get_byte_offset(uint2 tile_idx, uint level) {
+    size_t tile_size = pixel_storage_size(img.storage(), uint3(chunk_resolution, chunk_resolution, 1));
+    return get_tile_index(tile_idx, level) * tile_size;
 }
 void TexStreamManager::CopyStreamCallback::operator()() {
     stream << event->wait(fence);
@@ -131,6 +134,7 @@ void TexStreamManager::_async_logic() {
         _unmap_lists.remove(i);
     }
 
+    _decode_tiles();
     if (auto res = _frame_res.pop()) {
         inqueue_frame--;
         auto evt = luisa::fiber::async(
@@ -280,6 +284,9 @@ TexStreamManager::~TexStreamManager() {
     if (_last_io_fence > 0) {
         _io_service.synchronize(_last_io_fence);
     }
+    if (_last_mem_io_fence > 0) {
+        RenderDevice::instance().mem_io_service()->synchronize(_last_mem_io_fence);
+    }
     _main_stream_event.synchronize(signalled_fence + 1);
 }
 
@@ -308,6 +315,12 @@ auto TexStreamManager::load_sparse_img(
     _dispose_map_mtx.unlock();
     v->img = std::move(img);
     v->path = std::move(path);
+    if (auto file_path = v->path.try_get<FilePath>()) {
+        if (v->cache.read_table(file_path->first, file_path->second)) {
+            LUISA_ASSERT(v->cache.tiles.size() >= v->streamer.count(), "Virtual texture cache {} has {} tiles, requires {}.", file_path->first, v->cache.tiles.size(), v->streamer.count());
+            LUISA_ASSERT(v->cache.tile_size_bytes == pixel_storage_size(storage, uint3(chunk_resolution, chunk_resolution, 1)), "Virtual texture cache {} tile size {} mismatch.", file_path->first, v->cache.tile_size_bytes);
+        }
+    }
     v->heaps.resize(v->streamer.count());
     v->init_callback = std::move(init_callback);
     {
@@ -377,21 +390,87 @@ void TexStreamManager::unload_sparse_img(
     _loaded_texs.remove(iter);
 }
 
+void TexStreamManager::_mark_evictions(vstd::span<uint const> readback, size_t required_bytes) {
+    struct Candidate {
+        uint frame_diff;
+        uint level;
+        uint tex;
+        uint chunk;
+    };
+    luisa::spin_mutex candidate_mtx;
+    vstd::vector<Candidate> candidates;
+    luisa::fiber::parallel(_tex_indices.size(), [&](size_t idx) {
+        auto &tex_idx = *_tex_indices[idx];
+        uint const *rb_ptr = readback.data() + tex_idx.node.offset_bytes() / sizeof(uint);
+        uint chunk_count = tex_idx.node.size_bytes() / sizeof(uint);
+        uint last_level = tex_idx.img.mip_levels() - 1;
+        uint2 tile_count = (tex_idx.img.size() + (chunk_resolution - 1u)) / chunk_resolution;
+        vstd::vector<Candidate> local_candidates;
+        for (auto chunk_idx : vstd::range(chunk_count)) {
+            uint last_updated_countdown = rb_ptr[chunk_idx] >> 4u;
+            if (last_updated_countdown > tex_idx.loaded_countdown) continue;
+            uint frame_diff = last_updated_countdown - _countdown;
+            // never evict what the current frame is sampling
+            if (frame_diff == 0) continue;
+            uint2 tile_idx;
+            tile_idx.y = chunk_idx / tile_count.x;
+            tile_idx.x = chunk_idx - (tile_idx.y * tile_count.x);
+            uint current_level = tex_idx.streamer.tile_level(tile_idx);
+            if (current_level >= last_level) continue;
+            local_candidates.emplace_back(Candidate{frame_diff, current_level, static_cast<uint>(idx), chunk_idx});
+        }
+        if (local_candidates.empty()) return;
+        std::lock_guard lck{candidate_mtx};
+        candidates.insert(candidates.end(), local_candidates.begin(), local_candidates.end());
+    });
+    // least recently sampled first, then the finest level as it holds the most memory
+    luisa::sort(candidates.begin(), candidates.end(), [](Candidate const &a, Candidate const &b) {
+        if (a.frame_diff != b.frame_diff) return a.frame_diff > b.frame_diff;
+        return a.level < b.level;
+    });
+    size_t freed_bytes = 0;
+    for (auto &i : candidates) {
+        if (freed_bytes >= required_bytes) break;
+        auto &tex_idx = *_tex_indices[i.tex];
+        tex_idx.chunk_requests[i.chunk].evict = true;
+        // a tile of level n is shared by 4^n chunks
+        freed_bytes += pixel_storage_size(tex_idx.img.storage(), uint3(chunk_resolution, chunk_resolution, 1)) >> (2u * i.level);
+    }
+}
+
 IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readback, SparseCommandList &map_cmdlist) {
     FrameResource frame_res;
     IOCommandList io_cmdlist;
-    luisa::spin_mutex depended_tex_mtx, io_mtx, map_mtx, frame_res_mtx;
+    luisa::spin_mutex depended_tex_mtx, io_mtx, map_mtx, frame_res_mtx, stats_mtx;
+    StreamStats frame_stats;
 
     vstd::vector<shared_ptr<TexIndex>> depended_texs;
+    vector<DecodeTile> decode_tiles;
     std::atomic_size_t predict_allocated_size = 0;
-    std::atomic_size_t chunk_size_bytes = 0;
     std::atomic_size_t already_allocated = _allocated_size.load();
+    const size_t budget = _allocate_size_limits.load();
+    const bool memoryless = already_allocated + _memoryless_threshold >= budget;
+    for (auto &i : _tex_indices) {
+        i->chunk_requests.resize(i->node.size_bytes() / sizeof(uint));
+        for (auto &req : i->chunk_requests) {
+            req.evict = false;
+        }
+    }
+    if (memoryless) {
+        _mark_evictions(readback, already_allocated + _memoryless_threshold - budget);
+    }
+    uint prefetch_radius = 0;
+    if (!memoryless) {
+        prefetch_radius = std::min<uint>(_prefetch_config.max_radius, static_cast<uint>(_camera_speed.load() * _prefetch_config.tiles_per_speed));
+    }
     auto size = _tex_indices.size();
     luisa::fiber::parallel(size, [&](size_t idx) {
         if (idx >= _tex_indices.size()) return;
         auto tex_idx_ptr = _tex_indices[idx];
         auto &tex_idx = *tex_idx_ptr;
         size_t chunk_allocated_size = 0;
+        StreamStats tex_stats;
+        const size_t chunk_size_bytes = pixel_storage_size(tex_idx.img.storage(), uint3(chunk_resolution, chunk_resolution, 1));
 
         vstd::unordered_map<Coord, bool, CoordHash> load_cmds;
         auto load = [&](uint2 tile_idx, uint level) {
@@ -403,7 +482,7 @@ IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readbac
         };
         auto check = [&](uint2 tile_idx, uint level) {
             chunk_allocated_size += chunk_size_bytes;
-            return already_allocated + chunk_allocated_size < _allocate_size_limits;
+            return already_allocated + chunk_allocated_size < budget;
         };
         rbc::detail::TexStreamCallback<decltype(load) &, decltype(unload) &, decltype(check) &> callback{load, unload, check};
         std::array<vstd::vector<uint2>, 14> runtime_tiles;
@@ -412,42 +491,80 @@ IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readbac
         auto node_offset = tex_idx.node.offset_bytes() / sizeof(uint);
         uint const *rb_ptr = readback.data() + node_offset;
         uint chunk_count = tex_idx.node.size_bytes() / sizeof(uint);
-        chunk_size_bytes = pixel_storage_size(tex_idx.img.storage(), uint3(chunk_resolution, chunk_resolution, 1));
         uint2 tile_size = uint2(chunk_resolution) / tex_idx.img.tile_size();
         size_t unload_cmd_idx = std::numeric_limits<size_t>::max();
         auto last_level = tex_idx.img.mip_levels() - 1;
         uint2 tile_count = (tex_idx.img.size() + (chunk_resolution - 1u)) / chunk_resolution;
         uint lru_frame;
-        if (already_allocated >= _allocate_size_limits - _memoryless_threshold) {
+        if (memoryless) {
             lru_frame = _lru_frame_memoryless;
         } else {
             lru_frame = _lru_frame;
         }
+        auto chunk_coord = [&](uint chunk_idx) {
+            uint2 tile_idx;
+            tile_idx.y = chunk_idx / tile_count.x;
+            tile_idx.x = chunk_idx - (tile_idx.y * tile_count.x);
+            return tile_idx;
+        };
+        // Resolve the level every chunk wants from feedback
         for (auto chunk_idx : vstd::range(chunk_count)) {
-            if ((size_t)rb_ptr < 99999) {
-                LUISA_WARNING("{}", (size_t)readback.data());
-            }
+            auto &req = tex_idx.chunk_requests[chunk_idx];
             auto rb_value = rb_ptr[chunk_idx];
             uint last_updated_countdown = rb_value >> 4u;
             uint dst_level = rb_value & 15u;
+            uint2 tile_idx = chunk_coord(chunk_idx);
+            uint current_level = tex_idx.streamer.tile_level(tile_idx);
             // this readback is earlier than SparseImage's loaded frame
             if (last_updated_countdown > tex_idx.loaded_countdown) {
+                req.requested_level = current_level;
+                req.dst_level = current_level;
+                req.visible = false;
                 continue;
             }
             uint frame_diff = last_updated_countdown - _countdown;
-            uint2 tile_idx;
-            tile_idx.y = chunk_idx / tile_count.x;
-            tile_idx.x = chunk_idx - (tile_idx.y * tile_count.x);
+            req.visible = frame_diff == 0;
+            req.requested_level = std::min<uint>(dst_level, last_level);
+            if (req.visible) {
+                tex_stats.feedback_tiles++;
+                if (current_level <= req.requested_level) {
+                    tex_stats.resident_tiles++;
+                }
+            }
             auto &cur_lru_frame = tex_idx.streamer.frame_lru(tile_idx);
             if (frame_diff <= _lru_frame_memoryless || cur_lru_frame == 0) {
                 cur_lru_frame = lru_frame;
             } else {
                 cur_lru_frame = std::min<uint8_t>(cur_lru_frame, lru_frame);
             }
-            chunk_allocated_size = predict_allocated_size;
             dst_level += frame_diff / cur_lru_frame;
-            dst_level = std::min<uint>(dst_level, last_level);
-
+            if (req.evict) {
+                dst_level = std::max<uint>(dst_level, current_level + 1);
+                tex_stats.evicted_tiles++;
+            }
+            req.dst_level = std::min<uint>(dst_level, last_level);
+        }
+        // Prefetch the next coarser mip of the neighbors of sampled chunks, the camera is moving toward them
+        if (prefetch_radius > 0) {
+            int radius = static_cast<int>(prefetch_radius);
+            for (auto chunk_idx : vstd::range(chunk_count)) {
+                auto const &req = tex_idx.chunk_requests[chunk_idx];
+                if (!req.visible) continue;
+                uint8_t prefetch_level = std::min<uint>(req.requested_level + 1u, last_level);
+                int2 center = make_int2(chunk_coord(chunk_idx));
+                for (int y = std::max(center.y - radius, 0); y <= std::min(center.y + radius, static_cast<int>(tile_count.y) - 1); ++y)
+                    for (int x = std::max(center.x - radius, 0); x <= std::min(center.x + radius, static_cast<int>(tile_count.x) - 1); ++x) {
+                        auto &neighbor = tex_idx.chunk_requests[y * tile_count.x + x];
+                        if (neighbor.visible || neighbor.evict || neighbor.dst_level <= prefetch_level) continue;
+                        neighbor.dst_level = prefetch_level;
+                        tex_stats.prefetched_tiles++;
+                    }
+            }
+        }
+        for (auto chunk_idx : vstd::range(chunk_count)) {
+            uint2 tile_idx = chunk_coord(chunk_idx);
+            uint dst_level = tex_idx.chunk_requests[chunk_idx].dst_level;
+            chunk_allocated_size = predict_allocated_size;
             uint current_level = tex_idx.streamer.tile_level(tile_idx);
             if (current_level != dst_level) {
                 uint can_reach_level = tex_idx.streamer.can_load(callback, tile_idx, dst_level);
@@ -461,10 +578,24 @@ IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readbac
                 }
             }
         }
+        for (auto &i : load_cmds) {
+            if (i.second) {
+                tex_stats.loaded_tiles++;
+            } else {
+                tex_stats.unloaded_tiles++;
+            }
+        }
         bool runtime_dirty = false;
+        std::atomic_uint64_t read_bytes = 0;
+        std::atomic_uint64_t upload_bytes = 0;
         tex_idx.path.visit([&]<typename T>(T const &t) {
             auto tex_pixel_size = pixel_storage_size(tex_idx.img.storage(), uint3(chunk_resolution, chunk_resolution, 1));
             const bool is_runtime_vt = std::is_same_v<T, RuntimeVTCallback>;
+            if constexpr (!is_runtime_vt) {
+                if (!tex_idx.tex_file && !load_cmds.empty()) [[unlikely]] {
+                    tex_idx.tex_file = IOFile{t.first};
+                }
+            }
             auto iter = load_cmds.begin();
             luisa::spin_mutex load_cmd_ite_mtx;
             luisa::fiber::parallel(
@@ -497,13 +628,30 @@ IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readbac
                             std::lock_guard lck{map_mtx};
                             map_cmdlist << std::move(map_cmd);
                         }
+                        upload_bytes += tex_pixel_size;
                         if constexpr (is_runtime_vt) {
                             runtime_dirty = true;
                             runtime_tiles[level].emplace_back(tile_idx);
+                        } else if (tex_idx.cache) {
+                            // compressed payload goes to host memory first, decoded in _decode_tiles
+                            auto const &tile = tex_idx.cache.tiles[tex_idx.get_tile_index(tile_idx, level)];
+                            luisa::vector<std::byte> payload;
+                            payload.push_back_uninitialized(tile.size_bytes);
+                            read_bytes += tile.size_bytes;
+                            IOCommand io_cmd{
+                                tex_idx.tex_file,
+                                t.second + tile.offset_bytes,
+                                luisa::span{payload}};
+                            std::lock_guard lck{io_mtx};
+                            io_cmdlist << std::move(io_cmd);
+                            decode_tiles.emplace_back(DecodeTile{
+                                .tex_idx = &tex_idx,
+                                .tile = tile,
+                                .tile_idx = tile_idx,
+                                .level = level,
+                                .payload = std::move(payload)});
                         } else {
-                            if (!tex_idx.tex_file) [[unlikely]] {
-                                tex_idx.tex_file = IOFile{t.first};
-                            }
+                            read_bytes += tex_pixel_size;
                             IOCommand io_cmd{
                                 tex_idx.tex_file,
                                 t.second + tex_idx.get_byte_offset(tile_idx, level),
@@ -534,13 +682,75 @@ IOCommandList TexStreamManager::_process_readback(vstd::span<uint const> readbac
                 }
             }
         });
+        tex_stats.read_bytes = read_bytes;
+        tex_stats.upload_bytes = upload_bytes;
+        std::lock_guard lck{stats_mtx};
+        frame_stats += tex_stats;
     });
-    io_cmdlist.add_callback([this, frame_res = std::move(frame_res), depended_texs = std::move(depended_texs)]() mutable {
-        frame_res.depended_texs = std::move(depended_texs);
-        _frame_res.push(std::move(frame_res));
-    });
+    {
+        std::lock_guard lck{_stats_mtx};
+        _last_frame_stats = frame_stats;
+        _total_stats += frame_stats;
+    }
+    if (decode_tiles.empty()) {
+        io_cmdlist.add_callback([this, frame_res = std::move(frame_res), depended_texs = std::move(depended_texs)]() mutable {
+            frame_res.depended_texs = std::move(depended_texs);
+            _frame_res.push(std::move(frame_res));
+        });
+    } else {
+        // frame resource is released after decoded tiles are uploaded
+        _pending_decode_batches++;
+        io_cmdlist.add_callback([this, decode_tiles = std::move(decode_tiles), frame_res = std::move(frame_res), depended_texs = std::move(depended_texs)]() mutable {
+            frame_res.depended_texs = std::move(depended_texs);
+            _decode_batches.push(std::move(decode_tiles), std::move(frame_res));
+        });
+    }
     return io_cmdlist;
 }
+
+void TexStreamManager::_decode_tiles() {
+    auto mem_io_service = RenderDevice::instance().mem_io_service();
+    while (auto batch = _decode_batches.pop()) {
+        auto &tiles = batch->tiles;
+        luisa::vector<size_t> offsets;
+        offsets.push_back_uninitialized(tiles.size());
+        size_t size_bytes = 0;
+        for (auto i : vstd::range(tiles.size())) {
+            offsets[i] = size_bytes;
+            size_bytes += tiles[i].tex_idx->cache.tile_size_bytes;
+        }
+        luisa::vector<std::byte> decoded;
+        decoded.push_back_uninitialized(size_bytes);
+        luisa::fiber::parallel(
+            tiles.size(),
+            [&](size_t i) {
+                auto &t = tiles[i];
+                auto dst = luisa::span{decoded}.subspan(offsets[i], t.tex_idx->cache.tile_size_bytes);
+                if (!VTCache::decode(t.tile, t.payload, dst)) [[unlikely]] {
+                    LUISA_WARNING("Corrupted virtual texture tile ({}, {}) level {}.", t.tile_idx.x, t.tile_idx.y, t.level);
+                    std::memset(dst.data(), 0, dst.size_bytes());
+                }
+                t.payload = {};
+            },
+            4);
+        IOCommandList upload_cmdlist;
+        for (auto i : vstd::range(tiles.size())) {
+            auto &t = tiles[i];
+            upload_cmdlist << IOCommand{
+                IOCommand::SrcType{static_cast<void const *>(decoded.data() + offsets[i])},
+                0,
+                IOTextureSubView{
+                    t.tex_idx->img.view(t.level),
+                    t.tile_idx * uint2(chunk_resolution),
+                    uint2(chunk_resolution)}};
+        }
+        upload_cmdlist.add_callback([this, decoded = std::move(decoded), frame_res = std::move(batch->frame_res)]() mutable {
+            _frame_res.push(std::move(frame_res));
+        });
+        _last_mem_io_fence = mem_io_service->execute(std::move(upload_cmdlist));
+        _pending_decode_batches--;
+    }
+}
 TexStreamManager::SparseHeap::SparseHeap(
     TexStreamManager *self,
     size_t size)
@@ -557,6 +767,38 @@ TexStreamManager::SparseHeap::~SparseHeap() {
     }
 }
 
+auto TexStreamManager::StreamStats::operator+=(StreamStats const &rhs) -> StreamStats & {
+    feedback_tiles += rhs.feedback_tiles;
+    resident_tiles += rhs.resident_tiles;
+    loaded_tiles += rhs.loaded_tiles;
+    unloaded_tiles += rhs.unloaded_tiles;
+    evicted_tiles += rhs.evicted_tiles;
+    prefetched_tiles += rhs.prefetched_tiles;
+    read_bytes += rhs.read_bytes;
+    upload_bytes += rhs.upload_bytes;
+    return *this;
+}
+auto TexStreamManager::last_frame_stats() const -> StreamStats {
+    std::lock_guard lck{_stats_mtx};
+    return _last_frame_stats;
+}
+auto TexStreamManager::total_stats() const -> StreamStats {
+    std::lock_guard lck{_stats_mtx};
+    return _total_stats;
+}
+double TexStreamManager::upload_bandwidth() const {
+    std::lock_guard lck{_stats_mtx};
+    auto seconds = _stats_clk.toc() * 1e-3;
+    if (seconds <= 0.0) return 0.0;
+    return static_cast<double>(_total_stats.upload_bytes) / seconds;
+}
+void TexStreamManager::reset_stats() {
+    std::lock_guard lck{_stats_mtx};
+    _last_frame_stats = {};
+    _total_stats = {};
+    _stats_clk.tic();
+}
+
 void TexStreamManager::force_sync() {
     _async_load_evt.wait();
     while (_copy_stream_callbacks.length() > 0) {
@@ -567,6 +809,17 @@ void TexStreamManager::force_sync() {
     if (_last_io_fence > 0) {
         _io_service.synchronize(_last_io_fence);
     }
+    // io callbacks hand batches over asynchronously
+    while (_pending_decode_batches.load() > 0) {
+        {
+            std::lock_guard lck{_async_mtx};
+            _decode_tiles();
+        }
+        std::this_thread::yield();
+    }
+    if (_last_mem_io_fence > 0) {
+        RenderDevice::instance().mem_io_service()->synchronize(_last_mem_io_fence);
+    }
 }
 
 void TexStreamManager::before_rendering(
@@ -0,0 +1,114 @@
+#include <rbc_graphics/texture/vt_cache.h>
+#include <rbc_core/utils/lz4_codec.h>
+#include <luisa/core/binary_file_stream.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/logging.h>
+namespace rbc {
+luisa::vector<std::byte> VTCache::cook(
+    luisa::span<std::byte const> tiled_data,
+    uint64_t tile_size_bytes,
+    VTCodec codec) {
+    LUISA_ASSERT(tile_size_bytes > 0 && tiled_data.size() % tile_size_bytes == 0, "Tiled data size {} is not aligned to tile size {}.", tiled_data.size(), tile_size_bytes);
+    auto tile_count = tiled_data.size() / tile_size_bytes;
+    luisa::vector<Tile> tiles;
+    tiles.push_back_uninitialized(tile_count);
+    // compress every tile into its own bound-sized slot, then pack
+    luisa::vector<std::byte> scratch;
+    auto slot_size = lz4::compress_bound(tile_size_bytes);
+    if (codec != VTCodec::None) {
+        scratch.push_back_uninitialized(slot_size * tile_count);
+    }
+    luisa::fiber::parallel(
+        tile_count,
+        [&](size_t i) {
+            auto src = tiled_data.subspan(i * tile_size_bytes, tile_size_bytes);
+            auto &tile = tiles[i];
+            tile.codec = VTCodec::None;
+            tile.size_bytes = static_cast<uint32_t>(tile_size_bytes);
+            if (codec == VTCodec::LZ4) {
+                auto size = lz4::compress(src, luisa::span{scratch}.subspan(i * slot_size, slot_size));
+                if (size > 0 && size < tile_size_bytes) {
+                    tile.codec = VTCodec::LZ4;
+                    tile.size_bytes = static_cast<uint32_t>(size);
+                }
+            }
+        },
+        16);
+    uint64_t offset = sizeof(Header) + tile_count * sizeof(Tile);
+    for (auto &i : tiles) {
+        i.offset_bytes = offset;
+        offset += i.size_bytes;
+    }
+    luisa::vector<std::byte> result;
+    result.push_back_uninitialized(offset);
+    Header header{
+        .magic = magic,
+        .version = version,
+        .tile_count = static_cast<uint32_t>(tile_count),
+        .codec = codec,
+        .tile_size_bytes = tile_size_bytes};
+    std::memcpy(result.data(), &header, sizeof(Header));
+    std::memcpy(result.data() + sizeof(Header), tiles.data(), tiles.size_bytes());
+    luisa::fiber::parallel(
+        tile_count,
+        [&](size_t i) {
+            auto &tile = tiles[i];
+            auto src = tile.codec == VTCodec::None ? tiled_data.data() + i * tile_size_bytes : scratch.data() + i * slot_size;
+            std::memcpy(result.data() + tile.offset_bytes, src, tile.size_bytes);
+        },
+        64);
+    return result;
+}
+
+bool VTCache::read_table(luisa::string const &path, uint64_t file_offset) {
+    tiles.clear();
+    luisa::BinaryFileStream file_stream{path, file_offset};
+    if (!file_stream.valid() || file_stream.length() < file_offset + sizeof(Header)) return false;
+    // length() is the whole file, offsets in the table are relative to the container
+    auto container_size = file_stream.length() - file_offset;
+    Header header;
+    file_stream.read({reinterpret_cast<std::byte *>(&header), sizeof(Header)});
+    if (header.magic != magic) return false;
+    if (header.version != version) [[unlikely]] {
+        LUISA_WARNING("Virtual texture cache {} version {} mismatch, requires {}.", path, header.version, version);
+        return false;
+    }
+    if ((header.codec != VTCodec::None && header.codec != VTCodec::LZ4) || header.tile_count == 0 || header.tile_size_bytes == 0) [[unlikely]] {
+        LUISA_WARNING("Virtual texture cache {} has unknown codec {} or an empty tile table.", path, luisa::to_underlying(header.codec));
+        return false;
+    }
+    auto table_end = sizeof(Header) + uint64_t{header.tile_count} * sizeof(Tile);
+    if (container_size < table_end) [[unlikely]] {
+        return false;
+    }
+    tiles.push_back_uninitialized(header.tile_count);
+    file_stream.read({reinterpret_cast<std::byte *>(tiles.data()), tiles.size_bytes()});
+    for (auto const &tile : tiles) {
+        bool valid_codec = tile.codec == VTCodec::None ? tile.size_bytes == header.tile_size_bytes : tile.codec == header.codec;
+        if (!valid_codec || tile.offset_bytes < table_end || tile.offset_bytes + tile.size_bytes > container_size) [[unlikely]] {
+            LUISA_WARNING("Virtual texture cache {} has a corrupted tile table.", path);
+            tiles.clear();
+            return false;
+        }
+    }
+    tile_size_bytes = header.tile_size_bytes;
+    codec = header.codec;
+    return true;
+}
+
+bool VTCache::decode(
+    Tile const &tile,
+    luisa::span<std::byte const> payload,
+    luisa::span<std::byte> dst) {
+    switch (tile.codec) {
+        case VTCodec::None:
+            if (payload.size() != dst.size()) return false;
+            std::memcpy(dst.data(), payload.data(), dst.size());
+            return true;
+        case VTCodec::LZ4:
+            return lz4::decompress(payload, dst) == dst.size();
+        default:
+            return false;
+    }
+}
+}// namespace rbc
@@ -0,0 +1,281 @@
+#include <rbc_graphics/tlsf_allocator.h>
+#include <luisa/core/logging.h>
+#include <algorithm>
+#include <bit>
+#include <limits>
+namespace rbc
+{
+TLSFAllocator::Node::Node() noexcept = default;
+
+TLSFAllocator::TLSFAllocator(size_t size, size_t alignment) noexcept
+    : _node_pool{ 256 }
+    , _size{ size }
+    , _alignment{ std::bit_ceil(alignment) }
+{
+    _reset();
+}
+
+TLSFAllocator::~TLSFAllocator() noexcept
+{
+    if (_size == 0u) return;
+    if (_free_bytes != _size) [[unlikely]]
+    {
+        LUISA_WARNING_WITH_LOCATION("Leaks in TLSF allocator ({} bytes in use).", _size - _free_bytes);
+    }
+    _node_pool.destroy_all();
+}
+
+TLSFAllocator::TLSFAllocator(TLSFAllocator&& another) noexcept
+    : _node_pool{ std::move(another._node_pool) }
+    , _blocks{ another._blocks }
+    , _sl_bitmap{ another._sl_bitmap }
+    , _head{ another._head }
+    , _tail{ another._tail }
+    , _fl_bitmap{ another._fl_bitmap }
+    , _size{ another._size }
+    , _alignment{ another._alignment }
+    , _free_bytes{ another._free_bytes }
+{
+    another._blocks = {};
+    another._sl_bitmap = {};
+    another._head = nullptr;
+    another._tail = nullptr;
+    another._fl_bitmap = 0u;
+    another._size = 0u;
+    another._free_bytes = 0u;
+}
+
+void TLSFAllocator::_mapping(size_t size, uint32_t& fl, uint32_t& sl) noexcept
+{
+    // sizes below sl_index_count map linearly to the first level
+    if (size < sl_index_count)
+    {
+        fl = 0u;
+        sl = static_cast<uint32_t>(size);
+        return;
+    }
+    auto f = static_cast<uint32_t>(std::bit_width(size)) - 1u;
+    sl = static_cast<uint32_t>(size >> (f - sl_index_count_log2)) ^ sl_index_count;
+    fl = f - sl_index_count_log2 + 1u;
+}
+
+void TLSFAllocator::_insert_free(Node* node) noexcept
+{
+    uint32_t fl, sl;
+    _mapping(node->_size, fl, sl);
+    auto& head = _blocks[fl][sl];
+    node->_prev_free = nullptr;
+    node->_next_free = head;
+    if (head) head->_prev_free = node;
+    head = node;
+    node->_free = true;
+    _sl_bitmap[fl] |= 1u << sl;
+    _fl_bitmap |= 1ull << fl;
+    _free_bytes += node->_size;
+}
+
+void TLSFAllocator::_remove_free(Node* node) noexcept
+{
+    uint32_t fl, sl;
+    _mapping(node->_size, fl, sl);
+    if (node->_prev_free) node->_prev_free->_next_free = node->_next_free;
+    if (node->_next_free) node->_next_free->_prev_free = node->_prev_free;
+    auto& head = _blocks[fl][sl];
+    if (head == node)
+    {
+        head = node->_next_free;
+        if (!head)
+        {
+            _sl_bitmap[fl] &= ~(1u << sl);
+            if (!_sl_bitmap[fl]) _fl_bitmap &= ~(1ull << fl);
+        }
+    }
+    node->_prev_free = nullptr;
+    node->_next_free = nullptr;
+    node->_free = false;
+    _free_bytes -= node->_size;
+}
+
+TLSFAllocator::Node* TLSFAllocator::_search(size_t size) noexcept
+{
+    // round up to the next class, so every block found is large enough
+    if (size >= sl_index_count)
+    {
+        auto round = (size_t{ 1 } << (std::bit_width(size) - 1u - sl_index_count_log2)) - 1u;
+        if (size > std::numeric_limits<size_t>::max() - round) [[unlikely]]
+            return nullptr;
+        size += round;
+    }
+    uint32_t fl, sl;
+    _mapping(size, fl, sl);
+    if (fl >= fl_index_count) [[unlikely]]
+        return nullptr;
+    auto sl_map = _sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map)
+    {
+        auto fl_map = fl + 1u < 64u ? _fl_bitmap & (~0ull << (fl + 1u)) : 0ull;
+        if (!fl_map)
+            return nullptr;
+        fl = static_cast<uint32_t>(std::countr_zero(fl_map));
+        sl_map = _sl_bitmap[fl];
+    }
+    sl = static_cast<uint32_t>(std::countr_zero(sl_map));
+    return _blocks[fl][sl];
+}
+
+void TLSFAllocator::_reset() noexcept
+{
+    _blocks = {};
+    _sl_bitmap = {};
+    _fl_bitmap = 0u;
+    _free_bytes = 0u;
+    auto node = _node_pool.create();
+    node->_offset = 0u;
+    node->_size = _size;
+    _head = node;
+    _tail = node;
+    _insert_free(node);
+}
+
+TLSFAllocator::Node* TLSFAllocator::allocate(size_t size) noexcept
+{
+    auto mask = _alignment - 1u;
+    auto aligned_size = ((size == 0u ? 1u : size) + mask) & ~mask;
+    auto node = _search(aligned_size);
+    if (node == nullptr)
+        return nullptr;
+    _remove_free(node);
+    // has remaining size, split the node
+    if (node->_size - aligned_size >= _alignment)
+    {
+        auto rest = _node_pool.create();
+        rest->_offset = node->_offset + aligned_size;
+        rest->_size = node->_size - aligned_size;
+        rest->_prev_phys = node;
+        rest->_next_phys = node->_next_phys;
+        if (rest->_next_phys)
+            rest->_next_phys->_prev_phys = rest;
+        else
+            _tail = rest;
+        node->_next_phys = rest;
+        node->_size = aligned_size;
+        _insert_free(rest);
+    }
+    return node;
+}
+
+void TLSFAllocator::free(Node* node) noexcept
+{
+    if (node == nullptr) [[unlikely]]
+        return;
+    if (node->_free) [[unlikely]]
+    {
+        LUISA_ERROR_WITH_LOCATION(
+            "Invalid node for TLSF allocator "
+            "(offset = {}, size = {}).",
+            node->_offset, node->_size
+        );
+    }
+    // merge with prev
+    if (auto prev = node->_prev_phys; prev && prev->_free)
+    {
+        _remove_free(prev);
+        prev->_size += node->_size;
+        prev->_next_phys = node->_next_phys;
+        if (prev->_next_phys)
+            prev->_next_phys->_prev_phys = prev;
+        else
+            _tail = prev;
+        _node_pool.destroy(node);
+        node = prev;
+    }
+    // merge with next
+    if (auto next = node->_next_phys; next && next->_free)
+    {
+        _remove_free(next);
+        node->_size += next->_size;
+        node->_next_phys = next->_next_phys;
+        if (node->_next_phys)
+            node->_next_phys->_prev_phys = node;
+        else
+            _tail = node;
+        _node_pool.destroy(next);
+    }
+    node->_user_data = ~0ull;
+    _insert_free(node);
+}
+
+size_t TLSFAllocator::used_end() const noexcept
+{
+    if (!_tail) return 0u;
+    return _tail->_free ? _tail->_offset : _size;
+}
+
+TLSFAllocator::Node* TLSFAllocator::slide_down(Node* hole, Node* last) noexcept
+{
+    if (!hole->_free || hole->_next_phys == nullptr || last->_free) [[unlikely]]
+    {
+        LUISA_ERROR_WITH_LOCATION(
+            "Invalid slide for TLSF allocator "
+            "(offset = {}, size = {}).",
+            hole->_offset, hole->_size
+        );
+    }
+    auto hole_size = hole->_size;
+    _remove_free(hole);
+    // unlink the hole
+    auto first = hole->_next_phys;
+    auto prev = hole->_prev_phys;
+    if (prev)
+        prev->_next_phys = first;
+    else
+        _head = first;
+    first->_prev_phys = prev;
+    for (auto p = first;; p = p->_next_phys)
+    {
+        p->_offset -= hole_size;
+        if (p == last) break;
+    }
+    // merge with the free block after the run
+    auto after = last->_next_phys;
+    if (after && after->_free)
+    {
+        _remove_free(after);
+        after->_offset -= hole_size;
+        after->_size += hole_size;
+        _insert_free(after);
+        _node_pool.destroy(hole);
+        return after;
+    }
+    // reuse the hole node right after the run
+    hole->_offset = last->_offset + last->_size;
+    hole->_prev_phys = last;
+    hole->_next_phys = after;
+    last->_next_phys = hole;
+    if (after)
+        after->_prev_phys = hole;
+    else
+        _tail = hole;
+    _insert_free(hole);
+    return hole;
+}
+
+size_t TLSFAllocator::largest_free_size() const noexcept
+{
+    if (!_fl_bitmap) return 0u;
+    auto fl = 63u - static_cast<uint32_t>(std::countl_zero(_fl_bitmap));
+    auto sl = 31u - static_cast<uint32_t>(std::countl_zero(_sl_bitmap[fl]));
+    size_t result = 0u;
+    for (auto p = _blocks[fl][sl]; p != nullptr; p = p->_next_free)
+    {
+        result = std::max(result, p->_size);
+    }
+    return result;
+}
+
+void TLSFAllocator::clean_all() noexcept
+{
+    _node_pool.destroy_all();
+    _reset();
+}
+} // namespace rbc
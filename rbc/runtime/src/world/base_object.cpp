@@ -33,6 +33,9 @@ TypeRegisterBase::TypeRegisterBase() {
     _type_register_header = this;
 }
 void _collect_all_materials();
+void _flush_render_transforms();// in render_component.cpp
+void _flush_dirty_meshes();      // in resources/mesh.cpp
+void _flush_dirty_textures();    // in resources/texture.cpp
 void init_resource_loader(luisa::filesystem::path const &meta_path);// in resource_base.cpp
 void dispose_resource_loader();                                     // in resource_base.cpp
 void init_world(
@@ -126,8 +129,6 @@ BaseObject::~BaseObject() {
     }
 }
 
-luisa::spin_mutex &dirty_trans_mtx();
-luisa::vector<InstanceID> &dirty_transforms();
 BaseObjectType get_base_object_type(vstd::Guid const &type_id) {
     LUISA_DEBUG_ASSERT(_world_inst, "World already destroyed.");
     auto iter = _world_inst->_create_funcs.find((std::array<uint64_t, 2> const &)type_id);
@@ -206,15 +207,9 @@ BaseObjectType base_type_of(vstd::Guid const &type_id) {
         return BaseObjectType::Custom;
     return iter->second->base_type();
 }
-void _zz_clear_dirty_transform() {
-    auto &v = dirty_transforms();
-    for (auto &i : v) {
-        auto obj = get_object(i);
-        if (!obj) continue;
-        LUISA_DEBUG_ASSERT(obj->is_type_of(TypeInfo::get<TransformComponent>()));
-        static_cast<TransformComponent *>(obj)->_dirty = false;
-    }
-    v.clear();
+void _zz_clear_dirty_transform(bool parallel) {
+    luisa::vector<TransformComponent *> transforms;
+    TransformComponent::_drain_dirty(transforms, parallel);
 }
 uint64_t object_count() {
     LUISA_DEBUG_ASSERT(_world_inst, "World already destroyed.");
@@ -222,16 +217,16 @@ uint64_t object_count() {
     return _world_inst->_instance_ids.size();
 }
 
-void _zz_on_before_rendering() {
+void _zz_on_before_rendering(bool parallel) {
     _collect_all_materials();
-    for (auto &i : dirty_transforms()) {
-        auto tr_obj = get_object(i);
-        if (!tr_obj || !tr_obj->is_type_of(TypeInfo::get<TransformComponent>())) {
-            continue;
-        }
-        auto tr = static_cast<TransformComponent *>(tr_obj);
+    _flush_dirty_meshes();
+    _flush_dirty_textures();
+    luisa::vector<TransformComponent *> transforms;
+    TransformComponent::_drain_dirty(transforms, parallel);
+    // light updates must run on the render thread, so the update events stay serial
+    for (auto tr : transforms) {
         tr->_execute_on_update_event();
     }
-    _zz_clear_dirty_transform();
+    _flush_render_transforms();
 }
 }// namespace rbc::world
\ No newline at end of file
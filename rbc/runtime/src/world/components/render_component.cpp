@@ -6,15 +6,23 @@
 #include <rbc_world/resources/mesh.h>
 #include <rbc_graphics/render_device.h>
 #include <rbc_world/entity.h>
+#include <rbc_core/runtime_static.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/spin_mutex.h>
 /*
 TODO: only should update light bvh while in ray-tracing mode
 */
 namespace rbc::world {
+struct RenderComponentStatic : RBCStruct {
+    luisa::spin_mutex mtx;
+    luisa::vector<InstanceID> moved_objects;
+};
+static RuntimeStatic<RenderComponentStatic> _render_inst;
 void RenderComponent::_on_transform_update() {
     if (_mesh_tlas_idx != ~0u) {
-        auto tr = entity()->get_component<TransformComponent>();
-        if (!tr) return;
-        _update_object_pos(tr->trs_float());
+        // applied together in _flush_render_transforms
+        std::lock_guard lck{_render_inst->mtx};
+        _render_inst->moved_objects.emplace_back(instance_id());
     }
 }
 void RenderComponent::on_awake() {
@@ -329,6 +337,51 @@ coroutine RenderComponent::_update_object(luisa::span<RC<MaterialResource> const
         }
     }
 }
+// called in _zz_on_before_rendering after the transform update events
+void _flush_render_transforms() {
+    luisa::vector<InstanceID> ids;
+    {
+        std::lock_guard lck{_render_inst->mtx};
+        ids = std::move(_render_inst->moved_objects);
+    }
+    auto render_device = RenderDevice::instance_ptr();
+    if (ids.empty() || !render_device) return;
+    struct MovedObject {
+        RenderComponent *component;
+        float4x4 matrix;
+    };
+    luisa::vector<MovedObject> objects;
+    objects.push_back_uninitialized(ids.size());
+    luisa::fiber::parallel(
+        ids.size(), [&](size_t i) {
+            auto &obj = objects[i];
+            obj.component = nullptr;
+            auto base = get_object(ids[i]);
+            if (!base || !base->is_type_of(TypeInfo::get<RenderComponent>())) return;
+            auto comp = static_cast<RenderComponent *>(base);
+            if (comp->_mesh_tlas_idx == ~0u) return;
+            auto tr = comp->entity()->get_component<TransformComponent>();
+            if (!tr) return;
+            obj.component = comp;
+            obj.matrix = tr->trs_float();
+        },
+        256);
+    auto &sm = SceneManager::instance();
+    luisa::vector<AccelManager::MeshInstanceTransform> mesh_updates;
+    mesh_updates.reserve(objects.size());
+    for (auto &obj : objects) {
+        if (!obj.component) continue;
+        if (obj.component->_type == ObjectRenderType::Mesh) {
+            mesh_updates.emplace_back(AccelManager::MeshInstanceTransform{
+                .transform = obj.matrix,
+                .inst_id = obj.component->_mesh_tlas_idx});
+        } else {
+            // mesh lights rebuild their bvh, procedural ones are rare
+            obj.component->_update_object_pos(obj.matrix);
+        }
+    }
+    sm.accel_manager().set_mesh_instances(render_device->lc_main_cmd_list(), mesh_updates);
+}
 void RenderComponent::_update_object_pos(float4x4 matrix) {
     if (_mesh_tlas_idx == ~0u) [[unlikely]] {
         return;
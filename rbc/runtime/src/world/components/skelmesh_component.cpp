@@ -1,9 +1,15 @@
 #include "rbc_world/components/skelmesh_component.h"
 #include "rbc_world/type_register.h"
 #include "rbc_anim/skeletal_mesh.h"
+#include "rbc_anim/system/anim_update_system.h"
+#include "rbc_graphics/camera.h"
+#include "rbc_graphics/frustum.h"
 #include "rbc_graphics/device_assets/device_transforming_mesh.h"
 #include "rbc_graphics/render_device.h"
 #include "rbc_world/entity.h"
+#include "rbc_world/components/transform.h"
+#include <algorithm>
+#include <limits>
 
 namespace rbc::world {
 
@@ -23,6 +29,57 @@ void SkelMeshComponent::serialize_meta(ObjSerialize const &ser) const {
 }
 void SkelMeshComponent::deserialize_meta(ObjDeSerialize const &ser) {}
 
+void SkelMeshComponent::update_visibility(Camera const &cam) {
+    if (!runtime_skel_mesh || !runtime_skel_mesh->IsInitialized()) {
+        return;
+    }
+    if (!_local_bounds_valid) {
+        auto *mesh = _skel_mesh_ref->ref_skin->ref_mesh.get();
+        auto *host_data = mesh ? mesh->host_data() : nullptr;
+        if (!host_data || host_data->size() < mesh->vertex_count() * sizeof(float3) || mesh->vertex_count() == 0) {
+            // no host positions, keep the mesh visible at full size
+            return;
+        }
+        luisa::span<float3 const> positions{reinterpret_cast<float3 const *>(host_data->data()), mesh->vertex_count()};
+        float3 min_point{std::numeric_limits<float>::max()};
+        float3 max_point{std::numeric_limits<float>::lowest()};
+        for (auto &pos : positions) {
+            min_point = min(min_point, pos);
+            max_point = max(max_point, pos);
+        }
+        _local_bounds.packed_min = {min_point.x, min_point.y, min_point.z};
+        _local_bounds.packed_max = {max_point.x, max_point.y, max_point.z};
+        _local_bounds_valid = true;
+    }
+    auto *tr = entity()->get_component<TransformComponent>();
+    double4x4 local_to_world = tr ? tr->trs() : make_double4x4(1.0);
+
+    auto frustum_corners = cam.frustum_corners();
+    auto frustum_planes = cam.frustum_plane();
+    auto frustum_min_point = frustum_corners[0];
+    auto frustum_max_point = frustum_corners[0];
+    for (auto i : vstd::range(1, 8)) {
+        frustum_min_point = min(frustum_min_point, frustum_corners[i]);
+        frustum_max_point = max(frustum_max_point, frustum_corners[i]);
+    }
+    bool visible = frustum_cull(local_to_world, _local_bounds, frustum_planes, frustum_min_point, frustum_max_point, cam.dir_forward(), cam.position);
+
+    // bounding sphere of the transformed box
+    double3 local_min{_local_bounds.packed_min[0], _local_bounds.packed_min[1], _local_bounds.packed_min[2]};
+    double3 local_max{_local_bounds.packed_max[0], _local_bounds.packed_max[1], _local_bounds.packed_max[2]};
+    double3 center = (local_to_world * make_double4((local_min + local_max) * 0.5, 1.0)).xyz();
+    double max_scale = std::max({length(local_to_world.cols[0].xyz()),
+                                 length(local_to_world.cols[1].xyz()),
+                                 length(local_to_world.cols[2].xyz())});
+    double radius = length(local_max - local_min) * 0.5 * max_scale;
+    double distance = length(center - cam.position);
+    runtime_skel_mesh->SetScreenSize(AnimUpdateSystem::ComputeScreenSize(
+        static_cast<float>(radius),
+        static_cast<float>(distance),
+        static_cast<float>(std::tan(cam.fov * 0.5))));
+    runtime_skel_mesh->SetAnimVisibility(visible);
+}
+
 void SkelMeshComponent::tick(float delta_time) {
     // LUISA_INFO("Updating SkelMesh");
     if (!runtime_skel_mesh) [[unlikely]] {
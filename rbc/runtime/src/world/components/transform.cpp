@@ -2,15 +2,102 @@
 #include <rbc_world/entity.h>
 #include <rbc_world/type_register.h>
 #include <rbc_core/runtime_static.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/spin_mutex.h>
+#include <algorithm>
 
 namespace rbc::world {
+namespace {
+// Ids marked dirty by one thread, the lock is only contended while draining
+struct DirtyBucket {
+    luisa::spin_mutex mtx;
+    luisa::vector<InstanceID> ids;
+    luisa::vector<InstanceID> draining;
+};
+std::atomic_uint64_t _trans_generation{};
+}// namespace
 struct TransformStatic : RBCStruct {
-    luisa::vector<InstanceID> dirty_trans;
+    luisa::spin_mutex buckets_mtx;
+    luisa::vector<luisa::unique_ptr<DirtyBucket>> buckets;
+    // buckets of exited threads, handed to the next new thread so short-lived threads do not grow buckets
+    luisa::vector<DirtyBucket *> free_buckets;
+    // thread-local bucket pointers from a previous runtime are stale
+    uint64_t generation{++_trans_generation};
 };
 TransformComponent::TransformComponent(Entity *entity) : ComponentDerive<TransformComponent>(entity) {}
 static RuntimeStatic<TransformStatic> _trans_inst;
-luisa::vector<InstanceID> &dirty_transforms() {
-    return _trans_inst->dirty_trans;
+static DirtyBucket &local_dirty_bucket() {
+    struct LocalBucket {
+        DirtyBucket *bucket{};
+        uint64_t generation{};
+        ~LocalBucket() {
+            if (!bucket || !_trans_inst || _trans_inst->generation != generation) return;
+            // queued ids stay in the bucket until the next drain
+            std::lock_guard lck{_trans_inst->buckets_mtx};
+            _trans_inst->free_buckets.emplace_back(bucket);
+        }
+    };
+    thread_local LocalBucket local;
+    auto &inst = *_trans_inst;
+    if (local.generation != inst.generation) [[unlikely]] {
+        std::lock_guard lck{inst.buckets_mtx};
+        if (!inst.free_buckets.empty()) {
+            local.bucket = inst.free_buckets.back();
+            inst.free_buckets.pop_back();
+        } else {
+            local.bucket = inst.buckets.emplace_back(luisa::make_unique<DirtyBucket>()).get();
+        }
+        local.generation = inst.generation;
+    }
+    return *local.bucket;
+}
+void TransformComponent::_drain_dirty(luisa::vector<TransformComponent *> &transforms, bool parallel) {
+    auto &inst = *_trans_inst;
+    luisa::vector<DirtyBucket *> buckets;
+    {
+        std::lock_guard lck{inst.buckets_mtx};
+        buckets.reserve(inst.buckets.size());
+        for (auto &i : inst.buckets) {
+            buckets.emplace_back(i.get());
+        }
+    }
+    luisa::vector<size_t> offsets;
+    offsets.reserve(buckets.size());
+    size_t count = 0;
+    for (auto bucket : buckets) {
+        {
+            std::lock_guard lck{bucket->mtx};
+            std::swap(bucket->ids, bucket->draining);
+        }
+        offsets.emplace_back(count);
+        count += bucket->draining.size();
+    }
+    auto start = transforms.size();
+    transforms.push_back_uninitialized(count);
+    auto resolve_bucket = [&](size_t bucket_idx) {
+        auto &ids = buckets[bucket_idx]->draining;
+        auto dst = transforms.data() + start + offsets[bucket_idx];
+        for (auto i : vstd::range(ids.size())) {
+            auto obj = get_object(ids[i]);
+            TransformComponent *tr{};
+            if (obj) {
+                LUISA_DEBUG_ASSERT(obj->is_type_of(TypeInfo::get<TransformComponent>()));
+                tr = static_cast<TransformComponent *>(obj);
+                // marks from now on are queued for the next drain
+                tr->_dirty.store(false, std::memory_order_relaxed);
+            }
+            dst[i] = tr;
+        }
+        ids.clear();
+    };
+    if (parallel) {
+        luisa::fiber::parallel(buckets.size(), resolve_bucket);
+    } else {
+        for (auto i : vstd::range(buckets.size())) resolve_bucket(i);
+    }
+    // drop destroyed transforms
+    auto end = std::remove(transforms.begin() + start, transforms.end(), nullptr);
+    transforms.erase(end, transforms.end());
 }
 void TransformComponent::serialize_meta(ObjSerialize const &obj) const {
     obj.ar.start_array();
@@ -68,9 +155,10 @@ double3 TransformComponent::scale() {
     return _scale;
 }
 void TransformComponent::mark_dirty() {
-    if (_dirty) return;
-    _dirty = true;
-    dirty_transforms().emplace_back(instance_id());
+    if (_dirty.load(std::memory_order_relaxed) || _dirty.exchange(true, std::memory_order_relaxed)) return;
+    auto &bucket = local_dirty_bucket();
+    std::lock_guard lck{bucket.mtx};
+    bucket.ids.emplace_back(instance_id());
 }
 void TransformComponent::traversal(double4x4 const &new_trs) {
     auto old_l2w = _trs;
@@ -81,7 +169,7 @@ void TransformComponent::traversal(double4x4 const &new_trs) {
         auto new_l2w = child_to_parent * new_trs;
         tr->_trs = new_l2w;
         tr->_decomposed = false;
-        mark_dirty();
+        tr->mark_dirty();
         for (auto &i : tr->_children) {
             transform(transform, i);
         }
@@ -147,6 +235,103 @@ void TransformComponent::set_trs(
     _decomposed = true;
     mark_dirty();
 }
+template<typename Func>
+size_t TransformComponent::_apply_batch(luisa::span<InstanceID const> ids, bool recursive, bool parallel, Func &&func) {
+    auto for_each = [&](auto &&body) {
+        if (parallel) {
+            luisa::fiber::parallel(ids.size(), body, 256);
+        } else {
+            for (auto i : vstd::range(ids.size())) body(i);
+        }
+    };
+    luisa::vector<TransformComponent *> transforms;
+    transforms.push_back_uninitialized(ids.size());
+    for_each([&](size_t i) {
+        auto obj = get_object(ids[i]);
+        transforms[i] = (obj && obj->is_type_of(TypeInfo::get<TransformComponent>())) ? static_cast<TransformComponent *>(obj) : nullptr;
+    });
+    size_t count = 0;
+    if (recursive) {
+        // parents move their whole subtree, a descendant with children applied before its
+        // ancestor would be moved again, so they go shallowest first
+        struct Inner {
+            size_t index;
+            size_t depth;
+        };
+        luisa::vector<Inner> inners;
+        for (auto i : vstd::range(ids.size())) {
+            auto tr = transforms[i];
+            if (!tr || tr->_children.empty()) continue;
+            size_t depth = 0;
+            for (auto p = tr->_parent; p; p = p->_parent) ++depth;
+            inners.emplace_back(Inner{i, depth});
+        }
+        std::stable_sort(inners.begin(), inners.end(), [](Inner const &a, Inner const &b) { return a.depth < b.depth; });
+        for (auto &inner : inners) {
+            auto i = inner.index;
+            auto tr = transforms[i];
+            // traversal reads the old matrix
+            auto old_trs = tr->_trs;
+            auto new_trs = func(i, tr);
+            tr->_trs = old_trs;
+            tr->traversal(new_trs);
+            tr->_trs = new_trs;
+            tr->mark_dirty();
+            transforms[i] = nullptr;
+            ++count;
+        }
+    }
+    // leaves get their final matrix after every ancestor moved them
+    std::atomic_size_t leaf_count{0};
+    for_each([&](size_t i) {
+        auto tr = transforms[i];
+        if (!tr) return;
+        func(i, tr);
+        leaf_count.fetch_add(1, std::memory_order_relaxed);
+        // keep only the newly dirty ones for the bucket
+        if (tr->_dirty.exchange(true, std::memory_order_relaxed)) {
+            transforms[i] = nullptr;
+        }
+    });
+    count += leaf_count.load();
+    auto &bucket = local_dirty_bucket();
+    std::lock_guard lck{bucket.mtx};
+    for (auto tr : transforms) {
+        if (tr) bucket.ids.emplace_back(tr->instance_id());
+    }
+    return count;
+}
+size_t TransformComponent::set_trs_batch(
+    luisa::span<InstanceID const> ids,
+    luisa::span<double4x4 const> trs,
+    bool recursive,
+    bool parallel) {
+    LUISA_ASSERT(ids.size() == trs.size(), "Transform batch size mismatch.");
+    return _apply_batch(ids, recursive, parallel, [&](size_t i, TransformComponent *tr) {
+        auto const &new_trs = trs[i];
+        tr->_trs = new_trs;
+        tr->_decomposed = false;
+        return new_trs;
+    });
+}
+size_t TransformComponent::set_trs_batch(
+    luisa::span<InstanceID const> ids,
+    luisa::span<double3 const> positions,
+    luisa::span<Quaternion const> rotations,
+    luisa::span<double3 const> scales,
+    bool recursive,
+    bool parallel) {
+    LUISA_ASSERT(ids.size() == positions.size() && ids.size() == rotations.size() && ids.size() == scales.size(), "Transform batch size mismatch.");
+    return _apply_batch(ids, recursive, parallel, [&](size_t i, TransformComponent *tr) {
+        auto new_trs = rbc::rotation(positions[i], rotations[i], scales[i]);
+        tr->_position = positions[i];
+        tr->_rotation = rotations[i];
+        tr->_scale = scales[i];
+        tr->_trs = new_trs;
+        tr->_decomposed = true;
+        return new_trs;
+    });
+}
 void TransformComponent::add_children(TransformComponent *tr) {
     if (tr->_parent) {
         remove_children(tr);
@@ -180,6 +365,7 @@ void TransformComponent::_execute_on_update_event() {
         auto obj = get_object(i.first);
         if (!obj || obj->base_type() != BaseObjectType::Component) [[unlikely]] {
             invalid_components.emplace_back(i.first);
+            continue;
         }
         auto ptr = static_cast<Component *>(obj);
         (ptr->*i.second)();
@@ -2,32 +2,73 @@
 #include "ozz/animation/offline/tools/import2ozz.h"
 #include "rbc_world/importers/gltf2ozz.h"
 #include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/animation_optimizer.h"
 #include "rbc_core/memory.h"
+#include <algorithm>
 
 namespace rbc::world {
+namespace {
+size_t count_keyframes(RawAnimationAsset const &raw) {
+    size_t count = 0;
+    for (auto const &track : raw.tracks) {
+        count += track.translations.size() + track.rotations.size() + track.scales.size();
+    }
+    return count;
+}
+}// namespace
 
 bool GltfAnimSequenceImporter::import(AnimSequenceResource *resource, luisa::filesystem::path const &path) {
-    LUISA_ASSERT(ref_skel.get());// RefSkeleton Should be valid
     GltfOzzImporter impl;
     ozz::animation::offline::OzzImporter &importer = impl;
+    if (!importer.Load(path.string().c_str())) {
+        LUISA_ERROR("Failed to load gltf {} for AnimSeq", path.string());
+    }
+    return import_anim(resource, importer, path.string());
+}
+
+bool GltfAnimSequenceImporter::import_from_model(AnimSequenceResource *resource, tinygltf::Model const &model, luisa::string_view source_name) {
+    GltfOzzImporter impl;
+    impl.Load(model);
+    return import_anim(resource, impl, source_name);
+}
 
+size_t GltfAnimSequenceImporter::configure_optimizer(
+    ozz::animation::offline::AnimationOptimizer &optimizer,
+    AnimOptimizationOverride const &optimization,
+    luisa::span<const char *const> joint_names,
+    luisa::string_view source_name) {
+    optimizer.setting = {optimization.setting.tolerance, optimization.setting.distance};
+    size_t applied = 0;
+    for (auto const &[joint_name, setting] : optimization.joints) {
+        auto it = std::find_if(joint_names.begin(), joint_names.end(), [&](char const *name) {
+            return joint_name == name;
+        });
+        if (it == joint_names.end()) {
+            LUISA_WARNING("Optimization override for unknown joint {} in {}", joint_name, source_name);
+            continue;
+        }
+        optimizer.joints_setting_override[static_cast<int>(it - joint_names.begin())] = {setting.tolerance, setting.distance};
+        ++applied;
+    }
+    return applied;
+}
+
+bool GltfAnimSequenceImporter::import_anim(AnimSequenceResource *resource, ozz::animation::offline::OzzImporter &importer, luisa::string_view source_name) {
+    LUISA_ASSERT(ref_skel.get());// RefSkeleton Should be valid
     auto *skel = ref_skel.get();
     if (!skel) {
         LUISA_ERROR("Import AnimSequence Should Depend on a Valid SkeletonResource");
     }
-    if (!importer.Load(path.string().c_str())) {
-        LUISA_ERROR("Failed to load gltf {} for AnimSeq", path.string());
-    }
 
     auto *raw_anim = RBCNew<RawAnimationAsset>();
 
     auto anim_names = importer.GetAnimationNames();
 
     if (!(anim_names.size() > 0)) {
-        LUISA_ERROR("No Animation Found in GLTF File: {}", path.string());
+        LUISA_ERROR("No Animation Found in GLTF File: {}", source_name);
         return false;
     } else {
-        LUISA_INFO("{} anims found in {}", anim_names.size(), path.string());
+        LUISA_INFO("{} anims found in {}", anim_names.size(), source_name);
     }
     if (chosen_anim_name.size() == 0) {
         // no specific choose, load first
@@ -39,13 +80,29 @@ bool GltfAnimSequenceImporter::import(AnimSequenceResource *resource, luisa::fil
         skel->ref_skel().GetRawSkeleton(),
         sampling_rate, raw_anim);
 
-    // Cook
+    // Reduce keys within per-joint tolerances before cooking
+    RawAnimationAsset *cook_src = raw_anim;
+    RawAnimationAsset optimized_anim;
+    if (optimization.enabled) {
+        auto const &skeleton = skel->ref_skel().GetRawSkeleton();
+        ozz::animation::offline::AnimationOptimizer optimizer;
+        configure_optimizer(optimizer, optimization, skel->ref_skel().RawJointNames(), source_name);
+        if (optimizer(*raw_anim, skeleton, &optimized_anim)) {
+            LUISA_INFO("Animation {} keyframes reduced from {} to {}", chosen_anim_name, count_keyframes(*raw_anim), count_keyframes(optimized_anim));
+            cook_src = &optimized_anim;
+        } else {
+            LUISA_WARNING("Failed to optimize animation {}, cooking unoptimized keys", chosen_anim_name);
+        }
+    }
+
+    // Cook, the runtime format quantizes rotations to 48 bits and translations/scales to half floats
     ozz::animation::offline::AnimationBuilder builder;
-    ozz::unique_ptr<ozz::animation::Animation> animation = builder(*raw_anim);
+    ozz::unique_ptr<ozz::animation::Animation> animation = builder(*cook_src);
     if (!animation) {
         LUISA_ERROR("Failed to Cook Animation");
         return false;
     }
+    LUISA_INFO("Animation {} cooked to {} bytes", chosen_anim_name, animation->size());
     seq_ref(resource) = std::move(*animation);
     skel_ref(resource) = ref_skel;
 
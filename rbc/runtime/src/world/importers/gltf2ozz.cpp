@@ -427,7 +427,7 @@ bool GltfOzzImporter::Load(const char *_filename) {
     // the file extension
     if (std::strcmp(ext, "glb") == 0) {
         success =
-            m_loader.LoadBinaryFromFile(&m_model, &errors, &warnings, _filename);
+            m_loader.LoadBinaryFromFile(&m_owned_model, &errors, &warnings, _filename);
     } else {
         if (std::strcmp(ext, "gltf") != 0) {
             ozz::log::Log() << "Unknown file extension '" << ext
@@ -435,7 +435,7 @@ bool GltfOzzImporter::Load(const char *_filename) {
         }
 
         success =
-            m_loader.LoadASCIIFromFile(&m_model, &errors, &warnings, _filename);
+            m_loader.LoadASCIIFromFile(&m_owned_model, &errors, &warnings, _filename);
     }
 
     // Prints any errors or warnings emitted by the loader
@@ -452,22 +452,38 @@ bool GltfOzzImporter::Load(const char *_filename) {
     }
 
     if (success) {
-        success &= FixupNames(m_model.scenes, "Scene", "scene_");
-        success &= FixupNames(m_model.nodes, "Node", "node_");
-        success &= FixupNames(m_model.animations, "Animation", "animation_");
+        success &= FixupModelNames(m_owned_model);
     }
+    if (success) {
+        m_model = &m_owned_model;
+    }
+
+    return success;
+}
 
+bool GltfOzzImporter::FixupModelNames(tinygltf::Model &_model) {
+    bool success = true;
+    success &= FixupNames(_model.scenes, "Scene", "scene_");
+    success &= FixupNames(_model.nodes, "Node", "node_");
+    success &= FixupNames(_model.animations, "Animation", "animation_");
     return success;
 }
 
+bool GltfOzzImporter::Load(const tinygltf::Model &_model) {
+    m_model = &_model;
+    return true;
+}
+
+
+
 // Find all unique root joints of skeletons used by given skins and add them
 // to `roots`
 void GltfOzzImporter::FindSkinRootJointIndices(const ozz::vector<tinygltf::Skin> &skins, ozz::vector<int> &roots) {
     static constexpr int no_parent = -1;
     static constexpr int visited = -2;
-    ozz::vector<int> parents(m_model.nodes.size(), no_parent);
-    for (int node = 0; node < static_cast<int>(m_model.nodes.size()); node++) {
-        for (int child : m_model.nodes[node].children) {
+    ozz::vector<int> parents(m_model->nodes.size(), no_parent);
+    for (int node = 0; node < static_cast<int>(m_model->nodes.size()); node++) {
+        for (int child : m_model->nodes[node].children) {
             parents[child] = node;
         }
     }
@@ -496,7 +512,7 @@ void GltfOzzImporter::FindSkinRootJointIndices(const ozz::vector<tinygltf::Skin>
 bool GltfOzzImporter::Import(ozz::animation::offline::RawSkeleton *_skeleton, const NodeType &_types) {
     (void)_types;
 
-    if (m_model.scenes.empty()) {
+    if (m_model->scenes.empty()) {
         ozz::log::Err() << "No scenes found." << std::endl;
         return false;
     }
@@ -504,12 +520,12 @@ bool GltfOzzImporter::Import(ozz::animation::offline::RawSkeleton *_skeleton, co
     // If no default scene has been set then take the first one spec does not
     // disallow gltfs without a default scene but it makes more sense to keep
     // going instead of throwing an error here
-    int defaultScene = m_model.defaultScene;
+    int defaultScene = m_model->defaultScene;
     if (defaultScene == -1) {
         defaultScene = 0;
     }
 
-    tinygltf::Scene &scene = m_model.scenes[defaultScene];
+    const tinygltf::Scene &scene = m_model->scenes[defaultScene];
     ozz::log::LogV() << "Importing from default scene #" << defaultScene
                      << " with name \"" << scene.name << "\"." << std::endl;
 
@@ -548,7 +564,7 @@ bool GltfOzzImporter::Import(ozz::animation::offline::RawSkeleton *_skeleton, co
     // Traverses the scene graph and record all joints starting from the roots.
     _skeleton->roots.resize(roots.size());
     for (size_t i = 0; i < roots.size(); ++i) {
-        const tinygltf::Node &root_node = m_model.nodes[roots[i]];
+        const tinygltf::Node &root_node = m_model->nodes[roots[i]];
         ozz::animation::offline::RawSkeleton::Joint &root_joint =
             _skeleton->roots[i];
         if (!ImportNode(root_node, &root_joint)) {
@@ -581,7 +597,7 @@ bool GltfOzzImporter::ImportNode(const tinygltf::Node &_node, ozz::animation::of
 
     // Fills each child information.
     for (size_t i = 0; i < _node.children.size(); ++i) {
-        const tinygltf::Node &child_node = m_model.nodes[_node.children[i]];
+        const tinygltf::Node &child_node = m_model->nodes[_node.children[i]];
         ozz::animation::offline::RawSkeleton::Joint &child_joint =
             _joint->children[i];
 
@@ -596,8 +612,8 @@ bool GltfOzzImporter::ImportNode(const tinygltf::Node &_node, ozz::animation::of
 // Returns all animations in the gltf document.
 GltfOzzImporter::AnimationNames GltfOzzImporter::GetAnimationNames() {
     AnimationNames animNames;
-    for (size_t i = 0; i < m_model.animations.size(); ++i) {
-        tinygltf::Animation &animation = m_model.animations[i];
+    for (size_t i = 0; i < m_model->animations.size(); ++i) {
+        const tinygltf::Animation &animation = m_model->animations[i];
         LUISA_ASSERT(animation.name.length() != 0);
         animNames.push_back(animation.name.c_str());
     }
@@ -622,10 +638,10 @@ bool GltfOzzImporter::Import(const char *_animation_name, const ozz::animation::
 
     // Find the corresponding gltf animation
     std::vector<tinygltf::Animation>::const_iterator gltf_animation =
-        std::find_if(begin(m_model.animations), end(m_model.animations), [_animation_name](const tinygltf::Animation &_animation) {
+        std::find_if(begin(m_model->animations), end(m_model->animations), [_animation_name](const tinygltf::Animation &_animation) {
             return _animation.name == _animation_name;
         });
-    LUISA_ASSERT(gltf_animation != end(m_model.animations));
+    LUISA_ASSERT(gltf_animation != end(m_model->animations));
 
     _animation->name = gltf_animation->name.c_str();
 
@@ -658,7 +674,7 @@ bool GltfOzzImporter::Import(const char *_animation_name, const ozz::animation::
             continue;
         }
 
-        const tinygltf::Node &target_node = m_model.nodes[channel.target_node];
+        const tinygltf::Node &target_node = m_model->nodes[channel.target_node];
         channels_per_joint[target_node.name.c_str()].push_back(&channel);
     }
 
@@ -671,7 +687,7 @@ bool GltfOzzImporter::Import(const char *_animation_name, const ozz::animation::
 
         for (auto &channel : channels) {
             auto &sampler = gltf_animation->samplers[channel->sampler];
-            if (!SampleAnimationChannel(m_model, sampler, channel->target_path, _sampling_rate, &_animation->duration, &track)) {
+            if (!SampleAnimationChannel(*m_model, sampler, channel->target_path, _sampling_rate, &_animation->duration, &track)) {
                 return false;
             }
         }
@@ -716,7 +732,7 @@ bool GltfOzzImporter::SampleAnimationChannel(
         return false;
     }
 
-    auto &input = m_model.accessors[_sampler.input];
+    auto &input = m_model->accessors[_sampler.input];
     LUISA_ASSERT(input.maxValues.size() == 1);
 
     // The max[0] property of the input accessor is the animation duration
@@ -732,7 +748,7 @@ bool GltfOzzImporter::SampleAnimationChannel(
     }
 
     LUISA_ASSERT(input.type == TINYGLTF_TYPE_SCALAR);
-    auto &_output = m_model.accessors[_sampler.output];
+    auto &_output = m_model->accessors[_sampler.output];
     LUISA_ASSERT(_output.type == TINYGLTF_TYPE_VEC3 || _output.type == TINYGLTF_TYPE_VEC4);
 
     const ozz::span<const float> timestamps = GetGltfBufferView<float>(_model, input);
@@ -744,10 +760,10 @@ bool GltfOzzImporter::SampleAnimationChannel(
     bool valid = false;
     if (_target_path == "translation") {
         valid =
-            SampleChannel(m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->translations);
+            SampleChannel(*m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->translations);
     } else if (_target_path == "rotation") {
         valid =
-            SampleChannel(m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->rotations);
+            SampleChannel(*m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->rotations);
         if (valid) {
             // Normalize quaternions.
             for (auto &key : _track->rotations) {
@@ -756,7 +772,7 @@ bool GltfOzzImporter::SampleAnimationChannel(
         }
     } else if (_target_path == "scale") {
         valid =
-            SampleChannel(m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->scales);
+            SampleChannel(*m_model, _sampler.interpolation, _output, timestamps, _sampling_rate, duration, &_track->scales);
     } else {
         LUISA_ASSERT(false && "Invalid target path");
     }
@@ -779,14 +795,14 @@ ozz::vector<tinygltf::Skin> GltfOzzImporter::GetSkinsForScene(
         found.insert(nodeIndex);
         open.erase(nodeIndex);
 
-        auto &node = m_model.nodes[nodeIndex];
+        auto &node = m_model->nodes[nodeIndex];
         for (int childIndex : node.children) {
             open.insert(childIndex);
         }
     }
 
     ozz::vector<tinygltf::Skin> skins;
-    for (const tinygltf::Skin &skin : m_model.skins) {
+    for (const tinygltf::Skin &skin : m_model->skins) {
         if (!skin.joints.empty() && found.find(skin.joints[0]) != found.end()) {
             skins.push_back(skin);
         }
@@ -796,7 +812,7 @@ ozz::vector<tinygltf::Skin> GltfOzzImporter::GetSkinsForScene(
 }
 
 const tinygltf::Node *GltfOzzImporter::FindNodeByName(const std::string &_name) const {
-    for (const tinygltf::Node &node : m_model.nodes) {
+    for (const tinygltf::Node &node : m_model->nodes) {
         if (node.name == _name) {
             return &node;
         }
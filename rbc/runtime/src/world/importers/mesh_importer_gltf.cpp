@@ -8,6 +8,7 @@
 #include <luisa/core/logging.h>
 #include <cstring>
 #include <algorithm>
+#include <limits>
 #include "rbc_world/util/gltf_scene_loader.h"
 #include "rbc_world/util/gltf.h"
 
@@ -25,6 +26,14 @@ bool GltfMeshImporter::import(MeshResource *resource, luisa::filesystem::path co
     if (!load_gltf_model(model, path, false)) {
         return false;
     }
+    return import_from_model(resource, model);
+}
+
+bool GltfMeshImporter::import_from_model(MeshResource *resource, tinygltf::Model const &model) {
+    if (!resource || resource->empty() == false) [[unlikely]] {
+        LUISA_WARNING("Can not create on exists mesh.");
+        return false;
+    }
     GltfImportData import_data = process_gltf_model(model);
     return import_from_data(resource, import_data);
 }
@@ -79,53 +88,274 @@ bool GltfMeshImporter::import_from_data(MeshResource *resource, GltfImportData &
     return true;
 }
 
+namespace {
+// Element-wise conversion of a mapped accessor into a MeshBuilder stream, T is float2, float3 or float4
+template<typename T, int N>
+void convert_attribute(GlbAccessorView const &view, T *dst) {
+    if (view.component_type == TINYGLTF_COMPONENT_TYPE_FLOAT && view.stride == sizeof(T) && N * sizeof(float) == sizeof(T)) {
+        std::memcpy(dst, view.data, view.count * sizeof(T));
+        return;
+    }
+    luisa::fiber::parallel(
+        view.count,
+        [&](size_t v) {
+            if (view.component_type == TINYGLTF_COMPONENT_TYPE_FLOAT) {
+                // float3 is padded to 16 bytes, only the components are copied
+                std::memcpy(&dst[v], view.element(v), N * sizeof(float));
+            } else {
+                for (int c = 0; c < N; ++c) {
+                    dst[v][c] = view.read_float(v, c);
+                }
+            }
+        },
+        4096);
+}
+bool is_attribute(GlbAccessorView const &view, int components, size_t vertex_count) {
+    return view.valid() && view.components == components && view.count == vertex_count;
+}
+}// namespace
+
 bool GlbMeshImporter::import(MeshResource *resource, luisa::filesystem::path const &path) {
     if (!resource || resource->empty() == false) [[unlikely]] {
         LUISA_WARNING("Can not create on exists mesh.");
         return false;
     }
+    GlbDocument doc;
+    if (doc.open(path) && doc.self_contained()) {
+        return import_from_glb(resource, doc);
+    }
+    // external buffers or data URIs, go through tinygltf
     tinygltf::Model model;
     if (!load_gltf_model(model, path, true)) {
         return false;
     }
+    return GltfMeshImporter::import_from_model(resource, model);
+}
 
-    GltfImportData import_data = process_gltf_model(model);
-    MeshBuilder &mesh_builder = import_data.mesh_builder;
-
-    if (mesh_builder.position.empty()) {
+bool GlbMeshImporter::import_from_glb(MeshResource *resource, GlbDocument const &doc) {
+    if (!resource || resource->empty() == false) [[unlikely]] {
+        LUISA_WARNING("Can not create on exists mesh.");
         return false;
     }
+    struct PrimitiveRange {
+        GlbAccessorView position;
+        GlbAccessorView normal;
+        GlbAccessorView tangent;
+        std::array<GlbAccessorView, GlbPrimitive::max_uv_sets> uvs;
+        GlbAccessorView indices;
+        GlbAccessorView joints;
+        GlbAccessorView weights;
+        size_t vertex_offset;
+        size_t index_offset;
+        size_t index_count;
+    };
+    luisa::vector<PrimitiveRange> ranges;
+    size_t vertex_count = 0;
+    size_t index_count = 0;
+    uint uv_count = 0;
+    size_t weight_count = 0;
+    bool has_normal = false;
+    bool has_tangent = false;
+    bool missing_tangent = false;
 
-    luisa::vector<uint> submesh_offsets;
-    luisa::vector<std::byte> resource_bytes;
-    mesh_builder.write_to(resource_bytes, submesh_offsets);
-    resource->create_empty({}, std::move(submesh_offsets), 0, mesh_builder.vertex_count(), mesh_builder.indices_count() / 3, mesh_builder.uv_count(), mesh_builder.contained_normal(), mesh_builder.contained_tangent());
-    *(resource->host_data()) = std::move(resource_bytes);
-
-    // skinning
-    if (import_data.max_weight_count > 0) {
-        size_t weight_size = import_data.max_weight_count;
-
-        auto property = resource->add_property(
-            "joint_index",
-            weight_size * resource->vertex_count() * sizeof(uint16_t));
+    // First pass: validate primitives and lay them out, same rules as process_gltf_model
+    for (auto const &primitive : doc.primitives()) {
+        if (primitive.mode != TINYGLTF_MODE_TRIANGLES && primitive.mode != -1) {
+            continue;
+        }
+        PrimitiveRange range{};
+        range.position = doc.accessor(primitive.position);
+        auto const &position = range.position;
+        if (!position.valid() || position.count == 0 || position.components != 3 ||
+            position.component_type != TINYGLTF_COMPONENT_TYPE_FLOAT) {
+            continue;
+        }
+        if (primitive.indices >= 0) {
+            range.indices = doc.accessor(primitive.indices);
+            if (!range.indices.valid() || range.indices.components != 1) {
+                continue;
+            }
+            // indices past the POSITION accessor would read outside this primitive's vertices
+            if (range.indices.count > 0 && range.indices.max_uint() >= position.count) {
+                LUISA_WARNING("GLB primitive index out of range of its {} vertices, skipped.", position.count);
+                continue;
+            }
+            range.index_count = range.indices.count;
+        } else {
+            range.index_count = position.count;
+        }
+        if (range.index_count % 3 != 0) {
+            continue;
+        }
+        range.normal = doc.accessor(primitive.normal);
+        if (!is_attribute(range.normal, 3, position.count)) range.normal = {};
+        range.tangent = doc.accessor(primitive.tangent);
+        if (!is_attribute(range.tangent, 4, position.count)) range.tangent = {};
+        for (uint uv_idx = 0; uv_idx < GlbPrimitive::max_uv_sets; ++uv_idx) {
+            auto uv = doc.accessor(primitive.uvs[uv_idx]);
+            if (is_attribute(uv, 2, position.count)) {
+                range.uvs[uv_idx] = uv;
+                uv_count = std::max(uv_count, uv_idx + 1);
+            }
+        }
+        auto joints = doc.accessor(primitive.joints);
+        auto weights = doc.accessor(primitive.weights);
+        if (joints.valid() && weights.valid() && joints.count == position.count && weights.count == position.count) {
+            range.joints = joints;
+            range.weights = weights;
+            weight_count = std::max(weight_count, static_cast<size_t>(std::min(joints.components, weights.components)));
+        }
+        has_normal |= range.normal.valid();
+        has_tangent |= range.tangent.valid();
+        missing_tangent |= !range.tangent.valid();
+        range.vertex_offset = vertex_count;
+        range.index_offset = index_count;
+        vertex_count += position.count;
+        index_count += range.index_count;
+        ranges.emplace_back(range);
+    }
+    if (ranges.empty()) {
+        return false;
+    }
+    if (vertex_count > std::numeric_limits<uint>::max() || index_count / 3 > std::numeric_limits<uint>::max()) [[unlikely]] {
+        LUISA_WARNING("GLB mesh with {} vertices and {} indices exceeds the mesh limits.", vertex_count, index_count);
+        return false;
+    }
+    // tangents are generated from the first uv set when any primitive lacks them, as process_gltf_model does
+    bool generate_tangent = missing_tangent && uv_count > 0 && has_normal;
+    bool contained_tangent = has_tangent || generate_tangent;
 
-        auto joint_index = luisa::span{
-            (uint16_t *)property.second.data(),
-            property.second.size()};
+    // [pos: float3] [normal: float3] [tangent: float4] [uvs: float2[]] [triangle: uint], see MeshBuilder::write_to
+    size_t normal_offset = vertex_count * sizeof(float3);
+    size_t tangent_offset = normal_offset + (has_normal ? vertex_count * sizeof(float3) : 0);
+    size_t uv_offset = tangent_offset + (contained_tangent ? vertex_count * sizeof(float4) : 0);
+    size_t index_offset = uv_offset + uv_count * vertex_count * sizeof(float2);
+    size_t size_bytes = index_offset + index_count * sizeof(uint);
 
-        std::memcpy(joint_index.data(), import_data.all_joint_index.data(), joint_index.size_bytes());
+    luisa::vector<uint> submesh_offsets;
+    if (ranges.size() > 1) {
+        submesh_offsets.reserve(ranges.size());
+        for (auto const &range : ranges) {
+            submesh_offsets.emplace_back(static_cast<uint>(range.index_offset / 3));
+        }
+    }
+    resource->create_empty({}, std::move(submesh_offsets), 0, static_cast<uint>(vertex_count), static_cast<uint>(index_count / 3), uv_count, has_normal, contained_tangent);
+    auto &bytes = *resource->host_data();
+    bytes.clear();
+    bytes.push_back_uninitialized(size_bytes);
+    // properties are appended to the host data, so pointers are taken after it stopped growing
+    if (weight_count > 0) {
+        LUISA_ASSERT(weight_count == 4, "Skinning Weight Size is not 4");
+        (void)resource->add_property("joint_index", weight_count * vertex_count * sizeof(uint16_t));
+        (void)resource->add_property("joint_weight", weight_count * vertex_count * sizeof(float));
+    }
+    auto positions = reinterpret_cast<float3 *>(bytes.data());
+    auto normals = has_normal ? reinterpret_cast<float3 *>(bytes.data() + normal_offset) : nullptr;
+    auto tangents = contained_tangent ? reinterpret_cast<float4 *>(bytes.data() + tangent_offset) : nullptr;
+    auto uvs = reinterpret_cast<float2 *>(bytes.data() + uv_offset);
+    auto indices = reinterpret_cast<uint *>(bytes.data() + index_offset);
+    luisa::span<uint16_t> joint_index;
+    luisa::span<float> joint_weight;
+    if (weight_count > 0) {
+        auto index_bytes = resource->get_property_host("joint_index");
+        auto weight_bytes = resource->get_property_host("joint_weight");
+        joint_index = {reinterpret_cast<uint16_t *>(index_bytes.data()), weight_count * vertex_count};
+        joint_weight = {reinterpret_cast<float *>(weight_bytes.data()), weight_count * vertex_count};
+    }
 
-        auto w_property = resource->add_property(
-            "joint_weight",
-            weight_size * resource->vertex_count() * sizeof(uint16_t));
+    // Second pass: every primitive converts its own vertex and index range, nothing is staged in between
+    luisa::fiber::parallel(ranges.size(), [&](size_t prim_idx) {
+        auto const &range = ranges[prim_idx];
+        auto count = range.position.count;
+        auto vertex_offset = range.vertex_offset;
+        convert_attribute<float3, 3>(range.position, positions + vertex_offset);
+        if (normals) {
+            if (range.normal.valid()) {
+                convert_attribute<float3, 3>(range.normal, normals + vertex_offset);
+            } else {
+                std::fill_n(normals + vertex_offset, count, float3(0.0f));
+            }
+        }
+        if (tangents) {
+            if (range.tangent.valid()) {
+                convert_attribute<float4, 4>(range.tangent, tangents + vertex_offset);
+            } else if (!generate_tangent) {
+                std::fill_n(tangents + vertex_offset, count, float4(0, 0, 0, 1));
+            }
+        }
+        for (uint uv_idx = 0; uv_idx < uv_count; ++uv_idx) {
+            auto dst = uvs + uv_idx * vertex_count + vertex_offset;
+            if (range.uvs[uv_idx].valid()) {
+                convert_attribute<float2, 2>(range.uvs[uv_idx], dst);
+            } else {
+                std::fill_n(dst, count, float2(0.0f));
+            }
+        }
+        auto dst_indices = indices + range.index_offset;
+        auto base = static_cast<uint>(vertex_offset);
+        if (range.indices.valid()) {
+            luisa::fiber::parallel(
+                range.index_count,
+                [&](size_t i) {
+                    dst_indices[i] = base + range.indices.read_uint(i, 0);
+                },
+                4096);
+        } else {
+            for (size_t i = 0; i < range.index_count; ++i) {
+                dst_indices[i] = base + static_cast<uint>(i);
+            }
+        }
+        if (!joint_index.empty()) {
+            auto joint_dst = joint_index.subspan(vertex_offset * weight_count, count * weight_count);
+            auto weight_dst = joint_weight.subspan(vertex_offset * weight_count, count * weight_count);
+            if (!range.joints.valid()) {
+                std::fill(joint_dst.begin(), joint_dst.end(), uint16_t{0});
+                std::fill(weight_dst.begin(), weight_dst.end(), 0.0f);
+                return;
+            }
+            auto components = static_cast<size_t>(std::min(range.joints.components, range.weights.components));
+            for (size_t v = 0; v < count; ++v) {
+                for (size_t w = 0; w < weight_count; ++w) {
+                    bool has = w < components;
+                    joint_dst[v * weight_count + w] = has ? static_cast<uint16_t>(range.joints.read_uint(v, static_cast<int>(w))) : 0;
+                    weight_dst[v * weight_count + w] = has ? range.weights.read_float(v, static_cast<int>(w)) : 0.0f;
+                }
+            }
+        }
+    });
 
-        auto joint_weight = luisa::span{
-            (float *)w_property.second.data(),
-            w_property.second.size()};
+    if (generate_tangent) {
+        calculate_tangent(
+            {positions, vertex_count},
+            {uvs, vertex_count},
+            {tangents, vertex_count},
+            {reinterpret_cast<Triangle const *>(indices), index_count / 3},
+            1);
+    }
 
-        std::memcpy(joint_weight.data(), import_data.all_joint_weight.data(), joint_weight.size_bytes());
+#ifndef NDEBUG
+    {
+        // view the converted data as a MeshBuilder to run the usual validation
+        luisa::vector<luisa::span<float2 const>> uv_spans;
+        for (uint uv_idx = 0; uv_idx < uv_count; ++uv_idx) {
+            uv_spans.emplace_back(uvs + uv_idx * vertex_count, vertex_count);
+        }
+        luisa::vector<luisa::span<uint const>> index_spans;
+        for (auto const &range : ranges) {
+            index_spans.emplace_back(indices + range.index_offset, range.index_count);
+        }
+        MeshBuilderSpan mesh_view;
+        mesh_view.position = {positions, vertex_count};
+        if (normals) mesh_view.normal = {normals, vertex_count};
+        if (tangents) mesh_view.tangent = {tangents, vertex_count};
+        mesh_view.uvs = uv_spans;
+        mesh_view.triangle_indices = index_spans;
+        auto err_msg = mesh_view.check();
+        if (!err_msg.empty()) [[unlikely]] {
+            LUISA_ERROR("{}", err_msg);
+        }
     }
+#endif
     return true;
 }
 
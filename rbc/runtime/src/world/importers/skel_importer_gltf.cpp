@@ -7,17 +7,9 @@
 #include <tracy_wrapper.h>
 
 namespace rbc {
-bool GltfSkeletonImporter::import(SkeletonResource *resource, luisa::filesystem::path const &path) {
-    GltfOzzImporter impl;
-    ozz::animation::offline::OzzImporter &importer = impl;
+bool GltfSkeletonImporter::import_skeleton(SkeletonResource *resource, ozz::animation::offline::OzzImporter &importer) {
     ozz::animation::offline::OzzImporter::NodeType types = {};
     types.skeleton = true;
-
-    if (!importer.Load(path.string().c_str())) {
-        LUISA_ERROR("Failed to load gltf file {} for Skeleton", path.string());
-        resource = nullptr;
-        return false;
-    }
     auto raw_skel = RBCNew<RawSkeletonAsset>();
 
     importer.Import(raw_skel, types);
@@ -38,4 +30,22 @@ bool GltfSkeletonImporter::import(SkeletonResource *resource, luisa::filesystem:
     return true;
 }
 
+bool GltfSkeletonImporter::import(SkeletonResource *resource, luisa::filesystem::path const &path) {
+    GltfOzzImporter impl;
+    ozz::animation::offline::OzzImporter &importer = impl;
+
+    if (!importer.Load(path.string().c_str())) {
+        LUISA_ERROR("Failed to load gltf file {} for Skeleton", path.string());
+        resource = nullptr;
+        return false;
+    }
+    return import_skeleton(resource, importer);
+}
+
+bool GltfSkeletonImporter::import_from_model(SkeletonResource *resource, tinygltf::Model const &model) {
+    GltfOzzImporter impl;
+    impl.Load(model);
+    return import_skeleton(resource, impl);
+}
+
 }// namespace rbc
\ No newline at end of file
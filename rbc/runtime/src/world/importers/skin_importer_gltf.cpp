@@ -1,19 +1,22 @@
 #include "rbc_world/importers/skin_importer_gltf.h"
+#include "rbc_world/importers/gltf2ozz.h"
+#include "rbc_world/util/gltf_scene_loader.h"
 #include <tiny_gltf.h>
 
 namespace rbc {
 
 bool GltfSkinImporter::import(SkinResource *resource, luisa::filesystem::path const &path) {
     tinygltf::Model model;
-    tinygltf::TinyGLTF loader;
-    std::string err;
-    std::string warn;
-    bool ret = loader.LoadASCIIFromFile(&model, &err, &warn, path.string().c_str());
-    if (!ret) {
-        LUISA_ERROR("Failed to load GLTF model: {}", err);
+    if (!world::load_gltf_model(model, path, false)) {
+        LUISA_ERROR("Failed to load GLTF model: {}", path.string());
         return false;
     }
+    // joint remaps must name the joints the way the skeleton importer does
+    GltfOzzImporter::FixupModelNames(model);
+    return import_from_model(resource, model);
+}
 
+bool GltfSkinImporter::import_from_model(SkinResource *resource, tinygltf::Model const &model) {
     for (auto const &skin : model.skins) {
         name_ref(resource) = skin.name;
         auto &joint_remaps = joint_remaps_ref(resource);
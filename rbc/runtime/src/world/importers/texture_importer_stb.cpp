@@ -36,12 +36,20 @@ bool StbTextureImporter::import(
     luisa::vector<std::byte> data;
     data.push_back_uninitialized(file_stream.length());
     file_stream.read(data);
+    return import_from_memory(std::move(resource), loader, data, mip_level, to_vt);
+}
 
+bool StbTextureImporter::import_from_memory(
+    RC<TextureResource> resource,
+    TextureLoader *loader,
+    luisa::span<std::byte const> data,
+    uint mip_level,
+    bool to_vt) {
     int x;
     int y;
     int channels_in_file;
     auto ptr = stbi_load_from_memory(
-        (const stbi_uc *)data.data(), data.size(), &x, &y, &channels_in_file, 4);
+        (const stbi_uc *)data.data(), static_cast<int>(data.size()), &x, &y, &channels_in_file, 4);
 
     if (!ptr) return false;
 
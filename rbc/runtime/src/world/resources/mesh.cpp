@@ -5,7 +5,17 @@
 #include <rbc_graphics/device_assets/device_mesh.h>
 #include <rbc_graphics/device_assets/device_transforming_mesh.h>
 #include <rbc_graphics/device_assets/assets_manager.h>
+#include <rbc_graphics/scene_manager.h>
+#include <rbc_core/runtime_static.h>
+#include <luisa/core/spin_mutex.h>
 namespace rbc::world {
+static constexpr uint8_t host_dirty_vertex = 1u;
+static constexpr uint8_t host_dirty_all = 2u;
+struct MeshDirtyStatic : RBCStruct {
+    luisa::spin_mutex mtx;
+    luisa::vector<RC<MeshResource>> meshes;
+};
+static RuntimeStatic<MeshDirtyStatic> _mesh_dirty_inst;
 MeshResource::MeshResource() {
     _origin_mesh.reset();
 }
@@ -125,6 +135,48 @@ luisa::vector<std::byte> *MeshResource::host_data() {
     } else
         return nullptr;
 }
+void MeshResource::mark_host_dirty(bool only_vertex) {
+    auto prev = _host_dirty.fetch_or(only_vertex ? host_dirty_vertex : host_dirty_all, std::memory_order_relaxed);
+    if (prev != 0) return;
+    std::lock_guard lck{_mesh_dirty_inst->mtx};
+    _mesh_dirty_inst->meshes.emplace_back(this);
+}
+// called in _zz_on_before_rendering, same upload as GraphicsUtils::update_mesh_data
+void _flush_dirty_meshes() {
+    luisa::vector<RC<MeshResource>> meshes;
+    {
+        std::lock_guard lck{_mesh_dirty_inst->mtx};
+        meshes = std::move(_mesh_dirty_inst->meshes);
+    }
+    auto sm = SceneManager::instance_ptr();
+    for (auto &mesh_res : meshes) {
+        auto dirty = mesh_res->_host_dirty.exchange(0, std::memory_order_relaxed);
+        auto mesh = mesh_res->device_mesh();
+        if (!sm || !mesh) continue;
+        mesh->wait_finished();
+        // not created yet, init_device_resource uploads the current host data
+        auto mesh_data = mesh->mesh_data();
+        if (!mesh_data) continue;
+        mesh->calculate_bounding_box();
+        auto host_data = mesh->host_data();
+        if ((dirty & host_dirty_all) == 0) {
+            sm->frame_mem_io_list() << IOCommand{
+                host_data.data(),
+                0,
+                IOBufferSubView{mesh_data->pack.data.view(0, mesh_data->meta.tri_byte_offset / sizeof(uint))}};
+        } else {
+            sm->frame_mem_io_list() << IOCommand{
+                host_data.data(),
+                0,
+                IOBufferSubView{mesh_data->pack.data}};
+        }
+        if (mesh_data->pack.mesh) {
+            sm->set_io_cmdlist_require_sync();
+            sm->build_mesh_in_frame(&mesh_data->pack.mesh, RC<RCBase>{mesh});
+        }
+        sm->dispose_after_sync(RC<DeviceMesh>(mesh));
+    }
+}
 uint64_t MeshResource::basic_size_bytes() const {
     return DeviceMesh::get_mesh_size(_vertex_count, _contained_normal, _contained_tangent, _uv_count, _triangle_count);
 }
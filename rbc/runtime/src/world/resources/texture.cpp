@@ -6,7 +6,15 @@
 #include <rbc_graphics/render_device.h>
 #include <rbc_graphics/texture/tex_stream_manager.h>
 #include <rbc_world/type_register.h>
+#include <rbc_graphics/scene_manager.h>
+#include <rbc_core/runtime_static.h>
+#include <luisa/core/spin_mutex.h>
 namespace rbc::world {
+struct TextureDirtyStatic : RBCStruct {
+    luisa::spin_mutex mtx;
+    luisa::vector<RC<TextureResource>> textures;
+};
+static RuntimeStatic<TextureDirtyStatic> _tex_dirty_inst;
 
 TextureResource::TextureResource() = default;
 TextureResource::~TextureResource() = default;
@@ -17,6 +25,50 @@ luisa::vector<std::byte> *TextureResource::host_data() {
     }
     return nullptr;
 }
+void TextureResource::mark_host_dirty() {
+    if (_host_dirty.exchange(true, std::memory_order_relaxed)) return;
+    std::lock_guard lck{_tex_dirty_inst->mtx};
+    _tex_dirty_inst->textures.emplace_back(this);
+}
+// called in _zz_on_before_rendering, like GraphicsUtils::update_texture but for every mip level,
+// the uploader stages rows that are not 512 bytes aligned through a buffer
+void _flush_dirty_textures() {
+    luisa::vector<RC<TextureResource>> textures;
+    {
+        std::lock_guard lck{_tex_dirty_inst->mtx};
+        textures = std::move(_tex_dirty_inst->textures);
+    }
+    auto sm = SceneManager::instance_ptr();
+    auto render_device = RenderDevice::instance_ptr();
+    for (auto &tex : textures) {
+        tex->_host_dirty.store(false, std::memory_order_relaxed);
+        if (!sm || !render_device || tex->is_vt() || !tex->_tex || tex->_tex->resource_type() != DeviceResource::Type::Image) continue;
+        auto image = static_cast<DeviceImage *>(tex->_tex.get());
+        image->wait_finished();
+        auto &img = image->get_float_image();
+        // not created yet, init_device_resource uploads the current host data
+        if (!img) continue;
+        if (image->heap_idx() != ~0u) {
+            sm->set_io_cmdlist_require_sync();
+        }
+        auto host_data = image->host_data();
+        uint64_t offset = 0;
+        for (auto level : vstd::range(std::min(tex->_mip_level, img.mip_levels()))) {
+            auto view = img.view(level);
+            auto size = pixel_storage_size(view.storage(), make_uint3(view.size(), 1u));
+            if (offset + size > host_data.size()) break;
+            sm->tex_uploader().upload(
+                sm->frame_mem_io_list(),
+                render_device->lc_main_cmd_list(),
+                sm->device(),
+                sm->dispose_queue(),
+                host_data.data() + offset,
+                view);
+            offset += size;
+        }
+        sm->dispose_after_sync(RC<DeviceImage>(image));
+    }
+}
 DeviceImage *TextureResource::get_image() const {
     std::shared_lock lck{_async_mtx};
     if (_tex && !is_vt()) {
@@ -51,6 +103,9 @@ void TextureResource::serialize_meta(ObjSerialize const &obj) const {
     obj.ar.value(_size, "size");
     obj.ar.value(_mip_level, "mip_level");
     obj.ar.value(is_vt(), "is_vt");
+    if (_vt_codec != VTCodec::None) {
+        obj.ar.value(luisa::to_underlying(_vt_codec), "vt_codec");
+    }
 }
 void TextureResource::deserialize_meta(ObjDeSerialize const &obj) {
     std::lock_guard lck{_async_mtx};
@@ -67,6 +122,10 @@ void TextureResource::deserialize_meta(ObjDeSerialize const &obj) {
     RBC_MESH_LOAD(size)
     RBC_MESH_LOAD(is_vt)
 #undef RBC_MESH_LOAD
+    uint32_t vt_codec;
+    if (obj.ar.value(vt_codec, "vt_codec")) {
+        _vt_codec = static_cast<VTCodec>(vt_codec);
+    }
 }
 void TextureResource::create_empty(
     luisa::filesystem::path &&path,
@@ -100,7 +159,12 @@ bool TextureResource::unsafe_save_to_path() const {
     if (!writer._file) [[unlikely]] {
         return false;
     }
-    writer.write(_tex->host_data());
+    if (is_vt() && _vt_codec != VTCodec::None) {
+        auto tile_size_bytes = pixel_storage_size((PixelStorage)_pixel_storage, uint3(TexStreamManager::chunk_resolution, TexStreamManager::chunk_resolution, 1u));
+        writer.write(VTCache::cook(_tex->host_data(), tile_size_bytes, _vt_codec));
+    } else {
+        writer.write(_tex->host_data());
+    }
     return true;
 }
 bool TextureResource::is_vt() const {
@@ -138,11 +202,23 @@ bool TextureResource::init_device_resource() {
             _mip_level);
     } else {
         auto tex = static_cast<DeviceImage *>(_tex.get());
-        tex->create_texture<float>(
-            render_device->lc_device(),
-            (PixelStorage)_pixel_storage,
-            _size,
-            _mip_level);
+        // cooked host data already holds the whole mip chain, upload it as-is
+        if (host_data_ && !host_data_->empty()) {
+            tex->async_load_from_memory(
+                luisa::BinaryBlob{},
+                {},
+                (PixelStorage)_pixel_storage,
+                _size,
+                _mip_level,
+                DeviceImage::ImageType::Float,
+                true);
+        } else {
+            tex->create_texture<float>(
+                render_device->lc_device(),
+                (PixelStorage)_pixel_storage,
+                _size,
+                _mip_level);
+        }
     }
     _status = EResourceLoadingStatus::Loaded;
     return true;
@@ -264,6 +340,50 @@ void TextureResource::_pack_to_tile_level(uint level, luisa::span<std::byte cons
             }
         }
 }
+bool TextureResource::compress_to_bc(BCEncoder::Format format, BCEncoder::Quality quality) {
+    auto src_storage = BCEncoder::source_storage(format);
+    if (_is_vt || _pixel_storage != static_cast<LCPixelStorage>(src_storage)) return false;
+    if (any((_size & 3u) != 0u)) {
+        LUISA_WARNING("Texture size {} is not aligned as 4, skip block compression.", _size);
+        return false;
+    }
+    auto host_data_ = host_data();
+    if (!host_data_ || host_data_->size() != desire_size_bytes()) return false;
+    auto dst_storage = BCEncoder::pixel_storage(format);
+    luisa::vector<std::byte> data;
+    uint64_t dst_size = 0;
+    {
+        auto size = _size;
+        for (auto i : vstd::range(_mip_level)) {
+            dst_size += BCEncoder::encoded_size(format, size);
+            size = max(uint2(1), size >> 1u);
+        }
+    }
+    data.push_back_uninitialized(dst_size);
+    auto size = _size;
+    uint64_t src_offset = 0;
+    uint64_t dst_offset = 0;
+    for (auto i : vstd::range(_mip_level)) {
+        auto src_level_size = pixel_storage_size(src_storage, make_uint3(size, 1u));
+        auto dst_level_size = BCEncoder::encoded_size(format, size);
+        BCEncoder::encode(
+            format,
+            quality,
+            luisa::span{*host_data_}.subspan(src_offset, src_level_size),
+            size,
+            luisa::span{data}.subspan(dst_offset, dst_level_size));
+        size = max(uint2(1), size >> 1u);
+        src_offset += src_level_size;
+        dst_offset += dst_level_size;
+    }
+    std::lock_guard lck{_async_mtx};
+    // the old device image was created with the uncompressed format
+    auto tex = new DeviceImage();
+    tex->host_data_ref() = std::move(data);
+    _tex = tex;
+    _pixel_storage = static_cast<LCPixelStorage>(dst_storage);
+    return true;
+}
 bool TextureResource::pack_to_tile() {
     if (_is_vt) return {};
     auto host_data_ = host_data();
@@ -0,0 +1,265 @@
+#include "rbc_world/util/glb.h"
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/format.h>
+#include <tiny_gltf.h>
+#include <yyjson.h>
+#include <algorithm>
+#include <cstring>
+
+namespace rbc::world {
+namespace {
+constexpr uint32_t kGlbMagic = 0x46546C67u;// "glTF"
+constexpr uint32_t kChunkJson = 0x4E4F534Au;// "JSON"
+constexpr uint32_t kChunkBin = 0x004E4942u; // "BIN\0"
+
+uint32_t read_u32(std::byte const *ptr) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+int json_int(yyjson_val *obj, char const *key, int default_value) {
+    auto val = yyjson_obj_get(obj, key);
+    return yyjson_is_int(val) ? static_cast<int>(yyjson_get_int(val)) : default_value;
+}
+size_t json_size(yyjson_val *obj, char const *key) {
+    auto val = yyjson_obj_get(obj, key);
+    return yyjson_is_uint(val) ? static_cast<size_t>(yyjson_get_uint(val)) : 0u;
+}
+int component_count(char const *type) {
+    if (!type) return 0;
+    if (std::strcmp(type, "SCALAR") == 0) return 1;
+    if (std::strcmp(type, "VEC2") == 0) return 2;
+    if (std::strcmp(type, "VEC3") == 0) return 3;
+    if (std::strcmp(type, "VEC4") == 0) return 4;
+    if (std::strcmp(type, "MAT2") == 0) return 4;
+    if (std::strcmp(type, "MAT3") == 0) return 9;
+    if (std::strcmp(type, "MAT4") == 0) return 16;
+    return 0;
+}
+size_t component_size(int component_type) {
+    switch (component_type) {
+        case TINYGLTF_COMPONENT_TYPE_BYTE:
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            return 1;
+        case TINYGLTF_COMPONENT_TYPE_SHORT:
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            return 2;
+        case TINYGLTF_COMPONENT_TYPE_INT:
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        case TINYGLTF_COMPONENT_TYPE_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+}// namespace
+
+size_t GlbAccessorView::element_size() const {
+    return component_size(component_type) * components;
+}
+
+float GlbAccessorView::read_float(size_t index, int c) const {
+    auto ptr = element(index) + c * component_size(component_type);
+    switch (component_type) {
+        case TINYGLTF_COMPONENT_TYPE_FLOAT: {
+            float v;
+            std::memcpy(&v, ptr, sizeof(v));
+            return v;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
+            auto v = static_cast<float>(*reinterpret_cast<uint8_t const *>(ptr));
+            return normalized ? v / 255.0f : v;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+            uint16_t v;
+            std::memcpy(&v, ptr, sizeof(v));
+            return normalized ? static_cast<float>(v) / 65535.0f : static_cast<float>(v);
+        }
+        case TINYGLTF_COMPONENT_TYPE_BYTE: {
+            auto v = static_cast<float>(*reinterpret_cast<int8_t const *>(ptr));
+            return normalized ? std::max(v / 127.0f, -1.0f) : v;
+        }
+        case TINYGLTF_COMPONENT_TYPE_SHORT: {
+            int16_t v;
+            std::memcpy(&v, ptr, sizeof(v));
+            return normalized ? std::max(static_cast<float>(v) / 32767.0f, -1.0f) : static_cast<float>(v);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+uint32_t GlbAccessorView::read_uint(size_t index, int c) const {
+    auto ptr = element(index) + c * component_size(component_type);
+    switch (component_type) {
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            return *reinterpret_cast<uint8_t const *>(ptr);
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+            uint16_t v;
+            std::memcpy(&v, ptr, sizeof(v));
+            return v;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+            uint32_t v;
+            std::memcpy(&v, ptr, sizeof(v));
+            return v;
+        }
+        default:
+            return 0u;
+    }
+}
+
+uint32_t GlbAccessorView::max_uint() const {
+    uint32_t result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result = std::max(result, read_uint(i, 0));
+    }
+    return result;
+}
+
+bool GlbDocument::open(luisa::filesystem::path const &path) {
+    _file = MappedFile{path};
+    if (!_file.valid()) {
+        LUISA_WARNING("Failed to map GLB file {}", luisa::to_string(path));
+        return false;
+    }
+    auto data = _file.data();
+    // header: magic, version, length, then 8-byte chunk headers padded to 4 bytes
+    if (data.size() < 20 || read_u32(data.data()) != kGlbMagic || read_u32(data.data() + 4) != 2) {
+        LUISA_WARNING("{} is not a glTF 2.0 binary file", luisa::to_string(path));
+        return false;
+    }
+    auto total = std::min<size_t>(read_u32(data.data() + 8), data.size());
+    size_t offset = 12;
+    while (offset + 8 <= total) {
+        auto chunk_length = static_cast<size_t>(read_u32(data.data() + offset));
+        auto chunk_type = read_u32(data.data() + offset + 4);
+        offset += 8;
+        if (offset + chunk_length > total) [[unlikely]] {
+            LUISA_WARNING("Truncated chunk in GLB file {}", luisa::to_string(path));
+            return false;
+        }
+        if (chunk_type == kChunkJson && _json.empty()) {
+            _json = {reinterpret_cast<char const *>(data.data() + offset), chunk_length};
+        } else if (chunk_type == kChunkBin && _bin.empty()) {
+            _bin = data.subspan(offset, chunk_length);
+        }
+        offset += (chunk_length + 3u) & ~size_t{3u};
+    }
+    if (_json.empty()) {
+        LUISA_WARNING("GLB file {} has no JSON chunk", luisa::to_string(path));
+        return false;
+    }
+    if (!_parse_json()) {
+        LUISA_WARNING("Failed to parse JSON chunk of GLB file {}", luisa::to_string(path));
+        return false;
+    }
+    return true;
+}
+
+bool GlbDocument::_parse_json() {
+    auto doc = yyjson_read(_json.data(), _json.size(), 0);
+    if (!doc) return false;
+    auto root = yyjson_doc_get_root(doc);
+    if (!yyjson_is_obj(root)) {
+        yyjson_doc_free(doc);
+        return false;
+    }
+    // only the first buffer without uri refers to the BIN chunk
+    luisa::vector<bool> bin_buffers;
+    {
+        size_t idx, max;
+        yyjson_val *buffer;
+        yyjson_arr_foreach(yyjson_obj_get(root, "buffers"), idx, max, buffer) {
+            bin_buffers.emplace_back(idx == 0 && !yyjson_obj_get(buffer, "uri"));
+        }
+    }
+    {
+        size_t idx, max;
+        yyjson_val *view;
+        yyjson_arr_foreach(yyjson_obj_get(root, "bufferViews"), idx, max, view) {
+            auto &v = _buffer_views.emplace_back();
+            v.buffer = json_int(view, "buffer", -1);
+            v.byte_offset = json_size(view, "byteOffset");
+            v.byte_length = json_size(view, "byteLength");
+            v.byte_stride = json_size(view, "byteStride");
+            v.in_bin = v.buffer >= 0 && v.buffer < static_cast<int>(bin_buffers.size()) && bin_buffers[v.buffer] &&
+                       v.byte_offset <= _bin.size() && v.byte_length <= _bin.size() - v.byte_offset;
+            if (!v.in_bin) {
+                _self_contained = false;
+            }
+        }
+    }
+    {
+        size_t idx, max;
+        yyjson_val *accessor;
+        yyjson_arr_foreach(yyjson_obj_get(root, "accessors"), idx, max, accessor) {
+            auto &a = _accessors.emplace_back();
+            a.buffer_view = json_int(accessor, "bufferView", -1);
+            a.byte_offset = json_size(accessor, "byteOffset");
+            a.count = json_size(accessor, "count");
+            a.component_type = json_int(accessor, "componentType", 0);
+            a.components = component_count(yyjson_get_str(yyjson_obj_get(accessor, "type")));
+            a.normalized = yyjson_get_bool(yyjson_obj_get(accessor, "normalized"));
+        }
+    }
+    {
+        size_t mesh_idx, mesh_max;
+        yyjson_val *mesh;
+        yyjson_arr_foreach(yyjson_obj_get(root, "meshes"), mesh_idx, mesh_max, mesh) {
+            size_t idx, max;
+            yyjson_val *primitive;
+            yyjson_arr_foreach(yyjson_obj_get(mesh, "primitives"), idx, max, primitive) {
+                auto &p = _primitives.emplace_back();
+                p.mode = json_int(primitive, "mode", -1);
+                p.indices = json_int(primitive, "indices", -1);
+                auto attributes = yyjson_obj_get(primitive, "attributes");
+                p.position = json_int(attributes, "POSITION", -1);
+                p.normal = json_int(attributes, "NORMAL", -1);
+                p.tangent = json_int(attributes, "TANGENT", -1);
+                p.joints = json_int(attributes, "JOINTS_0", -1);
+                p.weights = json_int(attributes, "WEIGHTS_0", -1);
+                for (uint32_t uv_idx = 0; uv_idx < GlbPrimitive::max_uv_sets; ++uv_idx) {
+                    auto uv_name = luisa::format("TEXCOORD_{}", uv_idx);
+                    p.uvs[uv_idx] = json_int(attributes, uv_name.c_str(), -1);
+                }
+            }
+        }
+    }
+    yyjson_doc_free(doc);
+    return true;
+}
+
+GlbAccessorView GlbDocument::accessor(int index) const {
+    GlbAccessorView result;
+    if (index < 0 || index >= static_cast<int>(_accessors.size())) {
+        return result;
+    }
+    auto const &a = _accessors[index];
+    if (a.buffer_view < 0 || a.buffer_view >= static_cast<int>(_buffer_views.size())) {
+        return result;
+    }
+    auto const &v = _buffer_views[a.buffer_view];
+    result.count = a.count;
+    result.component_type = a.component_type;
+    result.components = a.components;
+    result.normalized = a.normalized;
+    auto element_size = result.element_size();
+    if (element_size == 0) {
+        return {};
+    }
+    result.stride = v.byte_stride > 0 ? v.byte_stride : element_size;
+    if (!v.in_bin || a.byte_offset > v.byte_length) {
+        return {};
+    }
+    // the last element only needs element_size bytes, not a full stride,
+    // bounded by division first so a huge count can not wrap the multiplication
+    auto available = v.byte_length - a.byte_offset;
+    if (a.count > 0 && (element_size > available || a.count - 1 > (available - element_size) / result.stride)) {
+        return {};
+    }
+    result.data = _bin.data() + v.byte_offset + a.byte_offset;
+    return result;
+}
+
+}// namespace rbc::world
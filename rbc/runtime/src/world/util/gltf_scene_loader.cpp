@@ -6,12 +6,17 @@
 #include <rbc_world/importers/skel_importer_gltf.h>
 #include <rbc_world/importers/anim_sequence_importer_gltf.h>
 #include <rbc_world/importers/skin_importer_gltf.h>
+#include <rbc_world/importers/texture_importer_stb.h>
+#include <rbc_world/importers/gltf2ozz.h>
 
 #include <rbc_anim/graph/AnimNode_Root.h>
 #include <rbc_anim/graph/AnimNode_SequencePlayer.h>
 
 #include <tiny_gltf.h>
 #include <luisa/core/logging.h>
+#include <luisa/core/fiber.h>
+#include <rbc_core/mapped_file.h>
+#include <limits>
 
 namespace rbc::world {
 using namespace luisa;
@@ -24,9 +29,35 @@ bool load_gltf_model(tinygltf::Model &model, luisa::filesystem::path const &path
     luisa::string luisa_path_str = luisa::to_string(path);
     std::string path_str(luisa_path_str.c_str(), luisa_path_str.size());
 
+    // embedded images stay encoded and are decoded in parallel by GltfSceneLoader,
+    // external images are read again by the texture importers, so their bytes are dropped
+    loader.SetImageLoader(
+        [](tinygltf::Image *image, const int, std::string *, std::string *, int, int, const unsigned char *bytes, int size, void *) {
+            if (image->uri.empty()) {
+                image->image.assign(bytes, bytes + size);
+                image->as_is = true;
+            }
+            return true;
+        },
+        nullptr);
     bool ret = false;
     if (is_binary) {
-        ret = loader.LoadBinaryFromFile(&model, &err, &warn, path_str);
+        // map instead of reading the whole file, tinygltf only copies the buffers out of it
+        MappedFile file{path};
+        if (!file.valid()) {
+            LUISA_WARNING_WITH_LOCATION("Failed to map GLB file {}", luisa_path_str);
+            return false;
+        }
+        if (file.size() > std::numeric_limits<unsigned int>::max()) {
+            LUISA_WARNING_WITH_LOCATION("GLB file {} exceeds 4GB, use GlbDocument to stream its geometry", luisa_path_str);
+            return false;
+        }
+        auto base_dir = luisa::to_string(path.parent_path());
+        ret = loader.LoadBinaryFromMemory(
+            &model, &err, &warn,
+            reinterpret_cast<unsigned char const *>(file.data().data()),
+            static_cast<unsigned int>(file.size()),
+            std::string(base_dir.c_str(), base_dir.size()));
     } else {
         ret = loader.LoadASCIIFromFile(&model, &err, &warn, path_str);
     }
@@ -51,111 +82,184 @@ GltfSceneData GltfSceneLoader::load_from_model(
     auto gltf_dir = path.parent_path();
     result.config = config;
 
-    // Load mesh using GltfMeshImporter
-    {
-        result.mesh = RC<MeshResource>(create_object<MeshResource>());
-        GltfMeshImporter importer;
-        if (!importer.import(result.mesh.get(), path)) {
-            LUISA_ERROR("Failed to import mesh from GLTF file");
-            return result;
-        }
-    }
+    // skeleton joints, skin remaps and animation channels are matched by node names
+    GltfOzzImporter::FixupModelNames(model);
 
-    // Load skeleton
+    // resources are created up front, every import below runs as a fiber task on the shared document
+    result.mesh = RC<MeshResource>(create_object<MeshResource>());
     if (config.load_skeleton) {
         result.skel = RC<SkeletonResource>(create_object<SkeletonResource>());
-        GltfSkeletonImporter importer;
-        if (!importer.import(result.skel.get(), path)) {
-            LUISA_ERROR("Failed to import skeleton from GLTF file");
-            return result;
-        }
-        result.skel->unsafe_set_loaded();
-
-        // Load skin (depends on skeleton and mesh)
         if (config.load_skin) {
             result.skin = RC<SkinResource>(create_object<SkinResource>());
-            GltfSkinImporter importer;
-            if (!importer.import(result.skin.get(), path)) {
-                LUISA_ERROR("Failed to import skin from GLTF file");
-                return result;
-            }
-            result.skin->ref_skel = result.skel;
-            result.skin->ref_mesh = result.mesh;
-            result.skin->generate_LUT();
-            result.skin->unsafe_set_loaded();
         }
-
-        // Load animation (depends on skeleton)
         if (config.load_anim_seq) {
             result.anim = create_object<AnimSequenceResource>();
-            GltfAnimSequenceImporter importer;
-            importer.ref_skel = result.skel;
-            if (!importer.import(result.anim.get(), path)) {
-                LUISA_ERROR("Failed to import animation sequence from GLTF file");
-                return result;
+        }
+    }
+    result.textures.reserve(model.images.size());
+    for (size_t i = 0; i < model.images.size(); ++i) {
+        result.textures.emplace_back(create_object<TextureResource>());
+    }
+
+    // color textures are authored in sRGB, their mips must be filtered in linear space
+    luisa::vector<bool> srgb_images(model.images.size(), false);
+    auto mark_srgb = [&](int texture_index) {
+        if (texture_index < 0 || texture_index >= static_cast<int>(model.textures.size())) return;
+        auto source = model.textures[texture_index].source;
+        if (source >= 0 && source < static_cast<int>(srgb_images.size())) {
+            srgb_images[source] = true;
+        }
+    };
+    for (auto const &gltf_mat : model.materials) {
+        mark_srgb(gltf_mat.pbrMetallicRoughness.baseColorTexture.index);
+        mark_srgb(gltf_mat.emissiveTexture.index);
+    }
+    // one loader per color space, textures are processed concurrently
+    TextureLoader srgb_loader;
+    srgb_loader.set_color_space(MipGenerator::ColorSpace::SRGB);
+    TextureLoader linear_loader;
+    linear_loader.set_color_space(MipGenerator::ColorSpace::Linear);
+
+    std::atomic_bool mesh_ok{true};
+    std::atomic_bool skel_ok{true};
+    std::atomic_bool skin_ok{true};
+    std::atomic_bool anim_ok{true};
+    luisa::vector<uint8_t> texture_ok(model.images.size(), 0);
+    luisa::fiber::counter counter;
+    auto schedule = [&](auto &&func) {
+        counter.add();
+        luisa::fiber::schedule([counter, func = std::forward<decltype(func)>(func)]() mutable {
+            func();
+            counter.done();
+        });
+    };
+
+    // Load mesh using GltfMeshImporter, GLB geometry is converted from the mapped file instead of the copied buffers
+    schedule([&]() {
+        if (path.extension() == ".glb") {
+            GlbDocument doc;
+            if (doc.open(path) && doc.self_contained()) {
+                mesh_ok = GlbMeshImporter::import_from_glb(result.mesh.get(), doc);
+                return;
             }
         }
+        mesh_ok = GltfMeshImporter::import_from_model(result.mesh.get(), model);
+    });
+
+    // Load skeleton, then the animation depending on it
+    if (result.skel) {
+        schedule([&]() {
+            GltfSkeletonImporter importer;
+            if (!importer.import_from_model(result.skel.get(), model)) {
+                skel_ok = false;
+                return;
+            }
+            result.skel->unsafe_set_loaded();
+            if (result.anim) {
+                GltfAnimSequenceImporter anim_importer;
+                anim_importer.ref_skel = result.skel;
+                anim_ok = anim_importer.import_from_model(result.anim.get(), model, luisa::to_string(path));
+            }
+        });
     }
 
-    // Load Texture and Materials
-    {
-        TextureLoader tex_loader;
-        auto &registry = ResourceImporterRegistry::instance();
+    // Load skin, the LUT depending on skeleton and mesh is generated after the join
+    if (result.skin) {
+        schedule([&]() {
+            skin_ok = GltfSkinImporter::import_from_model(result.skin.get(), model);
+        });
+    }
 
-        for (auto i = 0; i < model.images.size(); i++) {
-            result.textures.emplace_back(create_object<TextureResource>());
+    // Load textures
+    auto &registry = ResourceImporterRegistry::instance();
+    for (size_t i = 0; i < model.images.size(); ++i) {
+        schedule([&, i]() {
             auto const &img = model.images[i];
-
-            // Resolve texture path
-            luisa::filesystem::path tex_path;
-            if (!img.uri.empty()) {
-                // Check if it's a data URI (base64 encoded)
-                if (img.uri.find("data:") == 0) {
-                    // Embedded base64 image - skip for now
-                    LUISA_WARNING("Base64 embedded images not yet supported, skipping texture");
-                    continue;
+            auto &tex_loader = srgb_images[i] ? srgb_loader : linear_loader;
+            // tinygltf keeps no uri for data URIs, those land in image bytes like buffer-embedded images
+            if (img.uri.empty()) {
+                if (img.image.empty()) {
+                    LUISA_WARNING("Embedded image {} has no data, skipping texture", i);
+                    return;
                 }
-                // Relative or absolute path
-                if (luisa::filesystem::path(img.uri).is_absolute()) {
-                    tex_path = img.uri;
-                } else {
-                    tex_path = gltf_dir / img.uri;
+                luisa::span<std::byte const> data{reinterpret_cast<std::byte const *>(img.image.data()), img.image.size()};
+                if (!StbTextureImporter::import_from_memory(result.textures[i], &tex_loader, data, 4, false)) {
+                    LUISA_WARNING("Embedded image {} decode failed, skipping texture", i);
+                    return;
                 }
+                texture_ok[i] = 1;
+                return;
+            }
+
+            // Resolve texture path, relative or absolute
+            luisa::filesystem::path tex_path;
+            if (luisa::filesystem::path(img.uri).is_absolute()) {
+                tex_path = img.uri;
             } else {
-                // Embedded image in buffer - skip for now
-                LUISA_WARNING("Buffer-embedded images not yet supported, skipping texture");
-                continue;
+                tex_path = gltf_dir / img.uri;
             }
 
             // import with config
             if (!luisa::filesystem::exists(tex_path)) {
                 LUISA_WARNING("{} is not valid, check gltf resource {}",
                               tex_path.string(), path.string());
-                continue;
+                return;
             }
             auto *importer = registry.find_importer(tex_path, ResourceType::Texture);
 
             if (!importer) {
                 LUISA_WARNING("No importer found for texture file: {}", tex_path.string());
-                continue;
+                return;
             }
             if (importer->resource_type() != ResourceType::Texture) {
                 LUISA_WARNING("Invalid importer type for texture file: {}", tex_path.string());
-                continue;
+                return;
             }
             auto *texture_importer = static_cast<ITextureImporter *>(importer);
 
             if (!texture_importer->import(result.textures[i], &tex_loader, tex_path, 4, false)) {
                 LUISA_ERROR("{} import failed!", tex_path.string());
-                continue;
+                return;
             }
-        }
-        tex_loader.finish_task();
-        // Store loaded textures and initialize them
-        for (auto &tex : result.textures) {
-            if (tex) {
-                tex->init_device_resource();
+            texture_ok[i] = 1;
+        });
+    }
+    counter.wait();
+
+    if (!mesh_ok) {
+        LUISA_ERROR("Failed to import mesh from GLTF file");
+        return result;
+    }
+    if (!skel_ok) {
+        LUISA_ERROR("Failed to import skeleton from GLTF file");
+        return result;
+    }
+    if (!skin_ok) {
+        LUISA_ERROR("Failed to import skin from GLTF file");
+        return result;
+    }
+    if (!anim_ok) {
+        LUISA_ERROR("Failed to import animation sequence from GLTF file");
+        return result;
+    }
+    if (result.skin) {
+        result.skin->ref_skel = result.skel;
+        result.skin->ref_mesh = result.mesh;
+        result.skin->generate_LUT();
+        result.skin->unsafe_set_loaded();
+    }
+
+    // Texture and Materials
+    {
+        srgb_loader.finish_task();
+        linear_loader.finish_task();
+        // Store loaded textures and initialize them, skipped ones are left empty
+        for (size_t i = 0; i < result.textures.size(); ++i) {
+            if (!texture_ok[i]) {
+                result.textures[i] = nullptr;
+                continue;
             }
+            result.textures[i]->init_device_resource();
         }
 
         // Second pass: create materials
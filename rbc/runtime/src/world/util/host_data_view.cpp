@@ -0,0 +1,87 @@
+#include "rbc_world/util/host_data_view.h"
+#include <rbc_world/resources/mesh.h>
+#include <cstring>
+
+namespace rbc::world {
+
+MeshHostLayout::MeshHostLayout(MeshResource const &mesh) {
+    size_t vertex_count = mesh.vertex_count();
+    size_t offset = vertex_count * sizeof(luisa::float3);
+    normal = offset;
+    if (mesh.contained_normal()) offset += vertex_count * sizeof(luisa::float3);
+    tangent = offset;
+    if (mesh.contained_tangent()) offset += vertex_count * sizeof(luisa::float4);
+    uv = offset;
+    offset += mesh.uv_count() * vertex_count * sizeof(luisa::float2);
+    triangle = offset;
+    end = offset + size_t{mesh.triangle_count()} * 3 * sizeof(luisa::uint);
+}
+
+TextureLevelRange texture_level_range(luisa::compute::PixelStorage storage, luisa::uint2 size, uint32_t level) {
+    TextureLevelRange result;
+    for (uint32_t i = 0; i < level; ++i) {
+        result.offset += luisa::compute::pixel_storage_size(storage, luisa::make_uint3(luisa::max(size >> i, luisa::uint2(1u)), 1u));
+    }
+    result.size = luisa::compute::pixel_storage_size(storage, luisa::make_uint3(luisa::max(size >> level, luisa::uint2(1u)), 1u));
+    return result;
+}
+
+luisa::optional<StridedRows> resolve_strided_rows(
+    luisa::span<ptrdiff_t const> shape,
+    luisa::span<ptrdiff_t const> strides,
+    size_t element_size,
+    size_t rows,
+    size_t cols,
+    size_t inner) {
+    if (shape.empty() || shape.size() != strides.size() || static_cast<size_t>(shape[0]) != rows) {
+        return luisa::nullopt;
+    }
+    StridedRows result;
+    result.row_stride = strides[0];
+    result.row_inner = cols;
+    if (shape.size() == 2 && static_cast<size_t>(shape[1]) == cols) {
+        result.col_stride = strides[1];
+    } else if (inner > 0 && shape.size() == 3 && static_cast<size_t>(shape[1]) == cols / inner && static_cast<size_t>(shape[2]) == inner) {
+        result.mid_stride = strides[1];
+        result.col_stride = strides[2];
+        result.row_inner = inner;
+        // dense trailing axes are one contiguous row
+        if (result.col_stride == static_cast<ptrdiff_t>(element_size) && result.mid_stride == static_cast<ptrdiff_t>(inner * element_size)) {
+            result.row_inner = cols;
+        }
+    } else {
+        return luisa::nullopt;
+    }
+    return result;
+}
+
+void copy_strided_rows(
+    StridedRows const &layout,
+    std::byte const *src,
+    std::byte *dst,
+    size_t rows,
+    size_t cols,
+    size_t element_size,
+    size_t dst_stride) {
+    bool dense_row = layout.row_inner == cols && layout.col_stride == static_cast<ptrdiff_t>(element_size);
+    if (dense_row && layout.row_stride == static_cast<ptrdiff_t>(dst_stride) && rows > 0) {
+        // the padding after the last source row may not exist
+        std::memcpy(dst, src, (rows - 1) * dst_stride + cols * element_size);
+        return;
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        auto src_row = src + static_cast<ptrdiff_t>(r) * layout.row_stride;
+        auto dst_row = dst + r * dst_stride;
+        if (dense_row) {
+            std::memcpy(dst_row, src_row, cols * element_size);
+        } else {
+            for (size_t c = 0; c < cols; ++c) {
+                auto src_offset = static_cast<ptrdiff_t>(c / layout.row_inner) * layout.mid_stride +
+                                  static_cast<ptrdiff_t>(c % layout.row_inner) * layout.col_stride;
+                std::memcpy(dst_row + c * element_size, src_row + src_offset, element_size);
+            }
+        }
+    }
+}
+
+}// namespace rbc::world
@@ -0,0 +1,81 @@
+#include "test_util.h"
+#include "rbc_anim/system/anim_update_system.h"
+#include <luisa/core/stl/vector.h>
+
+namespace rbc {
+
+TEST_SUITE("anim") {
+    TEST_CASE("update_rate_params") {
+        AnimUpdateRateParams params;
+        params.UpdateRate = 4;
+        params.bInterpolateSkippedFrames = true;
+        // the first frame always updates to get a valid pose
+        CHECK(params.Advance(0.01f, true));
+        CHECK(params.ConsumeDeltaTime() == doctest::Approx(0.01f));
+        CHECK(params.GetInterpolationAlpha() == doctest::Approx(0.25f));
+        CHECK_FALSE(params.Advance(0.01f, false));
+        CHECK(params.GetInterpolationAlpha() == doctest::Approx(1.0f / 3.0f));
+        CHECK_FALSE(params.Advance(0.01f, false));
+        CHECK_FALSE(params.Advance(0.01f, false));
+        CHECK(params.GetInterpolationAlpha() == doctest::Approx(1.0f));
+        // skipped frames hand their time to the next update
+        CHECK(params.Advance(0.01f, false));
+        CHECK(params.ConsumeDeltaTime() == doctest::Approx(0.04f));
+        CHECK(params.ShouldInterpolate());
+        params.bSkipEvaluation = true;
+        CHECK_FALSE(params.ShouldInterpolate());
+    }
+
+    TEST_CASE("anim_screen_size") {
+        const float tan_half_fov = 1.0f;// 90 degree vertical fov
+        // a sphere of radius 1 at distance 4 spans a quarter of the viewport height
+        CHECK(AnimUpdateSystem::ComputeScreenSize(1.0f, 4.0f, tan_half_fov) == doctest::Approx(0.25f));
+        // halves with distance, clamped once the camera gets inside the bounds
+        CHECK(AnimUpdateSystem::ComputeScreenSize(1.0f, 8.0f, tan_half_fov) == doctest::Approx(0.125f));
+        CHECK(AnimUpdateSystem::ComputeScreenSize(1.0f, 1.5f, tan_half_fov) == doctest::Approx(1.0f));
+        CHECK(AnimUpdateSystem::ComputeScreenSize(2.0f, 1.0f, tan_half_fov) == doctest::Approx(1.0f));
+        // a narrower fov magnifies
+        CHECK(AnimUpdateSystem::ComputeScreenSize(1.0f, 8.0f, 0.5f) == doctest::Approx(0.25f));
+    }
+
+    TEST_CASE("anim_budget_allocation") {
+        AnimBudgetSettings settings;
+        settings.BudgetMs = 1.0f;
+        settings.MaxUpdateRate = 8;
+        settings.MaxInterpolatedRate = 4;
+        settings.FullRateScreenSize = 0.25f;
+
+        luisa::vector<AnimUpdateRateParams> meshes(20);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            meshes[i].ScreenSize = 0.5f / static_cast<float>(i + 1);
+            meshes[i].UpdateCostMs = 0.2f;
+            meshes[i].SkipCostMs = 0.02f;
+        }
+        meshes[1].bVisible = false;
+        luisa::vector<AnimUpdateRateParams *> params;
+        for (auto &mesh : meshes) params.emplace_back(&mesh);
+
+        auto cost = AnimUpdateSystem::AssignUpdateRates(params, settings);
+        // 20 meshes at full rate would take 4 ms
+        CHECK(cost <= settings.BudgetMs);
+        // the largest mesh keeps every frame, culled meshes only keep time flowing
+        CHECK(meshes[0].UpdateRate == 1);
+        CHECK(meshes[1].bSkipEvaluation);
+        CHECK(meshes[1].UpdateRate == settings.MaxUpdateRate);
+        // rates never improve with decreasing screen size
+        for (size_t i = 3; i < meshes.size(); ++i) {
+            CHECK(meshes[i].UpdateRate >= meshes[i - 1].UpdateRate);
+            CHECK(meshes[i].bInterpolateSkippedFrames == (meshes[i].UpdateRate > 1 && meshes[i].UpdateRate <= 4));
+        }
+
+        // plenty of budget, only screen size limits the rate
+        settings.BudgetMs = 100.0f;
+        AnimUpdateSystem::AssignUpdateRates(params, settings);
+        CHECK(meshes[0].UpdateRate == 1);
+        CHECK(meshes[1].UpdateRate == settings.MaxUpdateRate);
+        CHECK(meshes[2].UpdateRate == 2);
+        CHECK(meshes[19].UpdateRate == 8);
+    }
+}
+
+}// namespace rbc
@@ -0,0 +1,128 @@
+#include "test_util.h"
+#include "rbc_world/importers/anim_sequence_importer_gltf.h"
+#include <ozz/animation/offline/animation_optimizer.h>
+#include <ozz/animation/offline/raw_animation.h>
+#include <ozz/animation/offline/raw_skeleton.h>
+#include <ozz/animation/offline/skeleton_builder.h>
+#include <ozz/animation/runtime/skeleton.h>
+#include <ozz/base/maths/transform.h>
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+namespace rbc {
+namespace {
+using namespace ozz::animation::offline;
+
+// root with one child, joint order is depth first
+ozz::unique_ptr<ozz::animation::Skeleton> make_arm_skeleton() {
+    RawSkeleton raw;
+    raw.roots.resize(1);
+    auto &root = raw.roots[0];
+    root.name = "root";
+    root.transform = ozz::math::Transform::identity();
+    root.children.resize(1);
+    auto &hand = root.children[0];
+    hand.name = "hand";
+    hand.transform = ozz::math::Transform::identity();
+    hand.transform.translation = ozz::math::Float3(0.0f, 1.0f, 0.0f);
+    SkeletonBuilder builder;
+    return builder(raw);
+}
+
+// 31 keys per translation track: the root moves on a straight line, the hand wobbles 5e-4 around one
+RawAnimation make_arm_animation() {
+    constexpr int key_count = 31;
+    RawAnimation raw;
+    raw.duration = 1.0f;
+    raw.tracks.resize(2);
+    for (int i = 0; i < key_count; ++i) {
+        float t = static_cast<float>(i) / (key_count - 1);
+        raw.tracks[0].translations.push_back({t, ozz::math::Float3(t, 0.0f, 0.0f)});
+        raw.tracks[1].translations.push_back({t, ozz::math::Float3(0.0f, 1.0f, 5e-4f * std::sin(t * 12.0f))});
+    }
+    for (auto &track : raw.tracks) {
+        track.rotations.push_back({0.0f, ozz::math::Quaternion::identity()});
+        track.scales.push_back({0.0f, ozz::math::Float3::one()});
+    }
+    return raw;
+}
+
+size_t count_keys(RawAnimation const &raw) {
+    size_t count = 0;
+    for (auto const &track : raw.tracks) {
+        count += track.translations.size() + track.rotations.size() + track.scales.size();
+    }
+    return count;
+}
+
+// largest distance between the original translation keys and the optimized track, linearly interpolated
+float max_translation_error(RawAnimation::JointTrack const &original, RawAnimation::JointTrack const &optimized) {
+    float error = 0.0f;
+    auto const &keys = optimized.translations;
+    for (auto const &key : original.translations) {
+        auto next = std::find_if(keys.begin(), keys.end(), [&](auto const &k) { return k.time >= key.time; });
+        ozz::math::Float3 value;
+        if (next == keys.begin()) {
+            value = next->value;
+        } else if (next == keys.end()) {
+            value = keys.back().value;
+        } else {
+            auto prev = next - 1;
+            float alpha = (key.time - prev->time) / (next->time - prev->time);
+            value = ozz::math::Lerp(prev->value, next->value, alpha);
+        }
+        error = std::max(error, ozz::math::Length(value - key.value));
+    }
+    return error;
+}
+}// namespace
+
+TEST_SUITE("anim") {
+    TEST_CASE("anim_optimizer_override") {
+        auto skeleton = make_arm_skeleton();
+        REQUIRE(skeleton);
+        auto names = skeleton->joint_names();
+        luisa::span<const char *const> joint_names{names.begin(), names.size()};
+        REQUIRE(joint_names.size() == 2);
+        const int hand = std::string_view{joint_names[1]} == "hand" ? 1 : 0;
+
+        AnimOptimizationOverride optimization;
+        optimization.setting = {1e-2f, 0.1f};
+        optimization.joints.emplace_back("hand", AnimOptimizationSetting{1e-4f, 0.5f});
+        optimization.joints.emplace_back("tail", AnimOptimizationSetting{1e-5f, 0.5f});
+
+        AnimationOptimizer optimizer;
+        // unknown joints are skipped
+        CHECK(world::GltfAnimSequenceImporter::configure_optimizer(optimizer, optimization, joint_names, "test") == 1);
+        CHECK(optimizer.setting.tolerance == 1e-2f);
+        CHECK(optimizer.setting.distance == 0.1f);
+        REQUIRE(optimizer.joints_setting_override.size() == 1);
+        auto it = optimizer.joints_setting_override.find(hand);
+        REQUIRE(it != optimizer.joints_setting_override.end());
+        CHECK(it->second.tolerance == 1e-4f);
+        CHECK(it->second.distance == 0.5f);
+
+        auto raw = make_arm_animation();
+        REQUIRE(raw.Validate());
+        RawAnimation optimized;
+        REQUIRE(optimizer(raw, *skeleton, &optimized));
+        CHECK(count_keys(optimized) < count_keys(raw));
+        // the straight line only needs its end points
+        CHECK(optimized.tracks[1 - hand].translations.size() == 2);
+        CHECK(max_translation_error(raw.tracks[1 - hand], optimized.tracks[1 - hand]) <= 1e-2f);
+        // the tight override keeps the wobble within its own tolerance
+        CHECK(optimized.tracks[hand].translations.size() > 2);
+        CHECK(max_translation_error(raw.tracks[hand], optimized.tracks[hand]) <= 1e-4f + 1e-6f);
+
+        // without the override the wobble is below tolerance and dropped
+        AnimationOptimizer loose;
+        optimization.joints.clear();
+        CHECK(world::GltfAnimSequenceImporter::configure_optimizer(loose, optimization, joint_names, "test") == 0);
+        RawAnimation loose_optimized;
+        REQUIRE(loose(raw, *skeleton, &loose_optimized));
+        CHECK(loose_optimized.tracks[hand].translations.size() < optimized.tracks[hand].translations.size());
+    }
+}
+
+}// namespace rbc
@@ -0,0 +1,80 @@
+#include "test_util.h"
+#include "rbc_anim/system/anim_pose_cache.h"
+#include <luisa/core/stl/vector.h>
+
+namespace rbc {
+
+TEST_SUITE("anim") {
+    TEST_CASE("anim_pose_cache") {
+        AnimPoseCache cache;
+        // exact times by default, playback is never quantized unless asked for
+        CHECK(cache.TimeQuantum == 0.0f);
+        cache.TimeQuantum = 0.25f;
+
+        float time = 1.1f;
+        AnimPoseCacheKey key;
+        key.graph = &cache;
+        key.node_id = 1;
+        key.quantized_time = cache.QuantizeTime(time);
+        key.num_soa_bones = 2;
+        // sharers sample the snapped time
+        CHECK(key.quantized_time == 4);
+        CHECK(time == doctest::Approx(1.0f));
+        float close_time = 0.9f;
+        CHECK(cache.QuantizeTime(close_time) == key.quantized_time);
+
+        CHECK_FALSE(cache.Find(key));
+        luisa::vector<AnimSOATransform> bones(2, AnimSOATransform::identity());
+        auto stored = cache.Add(key, bones);
+        REQUIRE(stored);
+        CHECK(stored->size() == 2);
+        // a racing evaluation gets the entry that was there first
+        CHECK(cache.Add(key, bones) == stored);
+        CHECK(cache.Find(key) == stored);
+        CHECK(cache.Find(key) == stored);
+
+        auto other = key;
+        other.node_id = 2;
+        CHECK_FALSE(cache.Find(other));
+        CHECK(cache.GetNumEntries() == 1);
+
+        // stats of the finished frame survive until the next one, entries do not
+        cache.NewFrame();
+        CHECK(cache.GetNumEntries() == 0);
+        CHECK(cache.GetFrameStats().hits == 2);
+        CHECK(cache.GetFrameStats().misses == 2);
+        CHECK(cache.GetFrameStats().HitRate() == doctest::Approx(0.5f));
+        CHECK_FALSE(cache.Find(key));
+        cache.NewFrame();
+        CHECK(cache.GetFrameStats().misses == 1);
+        CHECK(cache.GetTotalStats().misses == 3);
+        // the held shared pose outlives the frame
+        CHECK(stored->size() == 2);
+
+        // exact keys without quantization
+        cache.TimeQuantum = 0.0f;
+        float a = 0.5f, b = 0.5000001f;
+        CHECK(cache.QuantizeTime(a) != cache.QuantizeTime(b));
+        CHECK(a == 0.5f);
+    }
+
+    TEST_CASE("anim_pose_cache_bounded") {
+        // no NewFrame, e.g. a host that never runs AnimUpdateSystem::BeginFrame
+        AnimPoseCache cache;
+        cache.MaxEntries = 4;
+        luisa::vector<AnimSOATransform> bones(1, AnimSOATransform::identity());
+        AnimPoseCacheKey key;
+        key.num_soa_bones = 1;
+        AnimPoseCache::SharedPose first;
+        for (int64_t frame = 0; frame < 64; ++frame) {
+            key.quantized_time = frame;
+            auto stored = cache.Add(key, bones);
+            if (frame == 0) first = stored;
+            CHECK(cache.GetNumEntries() <= cache.MaxEntries);
+        }
+        // dropped entries are still held by their users
+        CHECK(first->size() == 1);
+    }
+}
+
+}// namespace rbc
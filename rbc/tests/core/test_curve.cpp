@@ -0,0 +1,112 @@
+#include "test_util.h"
+#include <rbc_core/utils/curve.h>
+#include <luisa/core/clock.h>
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/vector.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+rbc::Curve make_random_curve(std::mt19937 &rng, size_t key_count) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    luisa::vector<luisa::float2> keys;
+    float time = 0.0f;
+    for (size_t i = 0; i < key_count; ++i) {
+        time += 0.05f + dist(rng);
+        keys.emplace_back(time, dist(rng) * 2.0f - 1.0f);
+    }
+    rbc::Curve curve;
+    for (auto &key : keys) {
+        curve.add_node(key.x, key.y);
+    }
+    return curve;
+}
+}// namespace
+
+TEST_SUITE("core") {
+    TEST_CASE("curve_sample_batch") {
+        using namespace rbc;
+        std::mt19937 rng{7};
+        auto curve = make_random_curve(rng, 16);
+        std::uniform_real_distribution<float> dist(curve.min_time() - 1.0f, curve.max_time() + 1.0f);
+        luisa::vector<float> times(4096);
+        for (auto &t : times) t = dist(rng);
+        // exact key times and both clamped ends
+        times[0] = curve.key_nodes()[3].x;
+        times[1] = curve.min_time() - 10.0f;
+        times[2] = curve.max_time() + 10.0f;
+        luisa::vector<float> out(times.size());
+        // unsorted input takes the search path, sorted input walks the segments
+        for (int sorted = 0; sorted < 2; ++sorted) {
+            if (sorted) std::sort(times.begin(), times.end());
+            curve.sample_nodes(times, out);
+            for (size_t i = 0; i < times.size(); ++i) {
+                CHECK(out[i] == doctest::Approx(curve.sample_node(times[i])).epsilon(1e-4));
+            }
+        }
+        luisa::vector<float> uniform(1000);
+        auto step = (curve.max_time() - curve.min_time()) / 999.0f;
+        curve.sample_uniform(curve.min_time(), step, uniform);
+        for (size_t i = 0; i < uniform.size(); ++i) {
+            CHECK(uniform[i] == doctest::Approx(curve.sample_node(curve.min_time() + i * step)).epsilon(1e-4));
+        }
+        Curve empty;
+        empty.sample_uniform(0.0f, 1.0f, uniform);
+        CHECK(uniform[10] == 0.0f);
+    }
+
+    TEST_CASE("curve_batch") {
+        using namespace rbc;
+        std::mt19937 rng{11};
+        luisa::vector<Curve> curves;
+        CurveBatch batch;
+        for (size_t i = 0; i < 64; ++i) {
+            curves.emplace_back(make_random_curve(rng, 1 + i % 9));
+            CHECK(batch.add_curve(curves.back()) == i);
+        }
+        batch.add_curve(Curve{});
+        luisa::vector<float> out(batch.curve_count());
+        // forward in small steps, then jump back
+        for (float time : {-1.0f, 0.3f, 0.31f, 1.7f, 2.5f, 6.0f, 0.5f, 100.0f}) {
+            batch.sample(time, out);
+            for (size_t i = 0; i < curves.size(); ++i) {
+                CHECK(out[i] == doctest::Approx(curves[i].sample_node(time)).epsilon(1e-4));
+            }
+            CHECK(out.back() == 0.0f);
+        }
+    }
+
+    TEST_CASE("cubic_bezier_batch") {
+        using namespace rbc;
+        CubicBezier2D bezier{{0, 0}, {0.2f, 1.0f}, {0.8f, -1.0f}, {1, 0.5f}};
+        luisa::vector<float> times(33);
+        for (size_t i = 0; i < times.size(); ++i) times[i] = i / 32.0f;
+        luisa::vector<luisa::float2> out(times.size());
+        bezier.eval(times, out);
+        for (size_t i = 0; i < times.size(); ++i) {
+            auto expected = bezier.eval(times[i]);
+            CHECK(out[i].x == doctest::Approx(expected.x).epsilon(1e-5));
+            CHECK(out[i].y == doctest::Approx(expected.y).epsilon(1e-5));
+        }
+    }
+
+    TEST_CASE("curve_sample_benchmark") {
+        using namespace rbc;
+        std::mt19937 rng{3};
+        auto curve = make_random_curve(rng, 64);
+        constexpr size_t sample_count = 1u << 20;
+        luisa::vector<float> out(sample_count);
+        auto step = (curve.max_time() - curve.min_time()) / float(sample_count);
+        luisa::Clock clk;
+        for (size_t i = 0; i < sample_count; ++i) {
+            out[i] = curve.sample_node(curve.min_time() + i * step);
+        }
+        auto scalar_ms = clk.toc();
+        auto checksum = out[sample_count / 3];
+        clk.tic();
+        curve.sample_uniform(curve.min_time(), step, out);
+        auto batch_ms = clk.toc();
+        CHECK(out[sample_count / 3] == doctest::Approx(checksum).epsilon(1e-4));
+        LUISA_INFO("Curve bake of {} samples: sample_node {:.3f} ms, sample_uniform {:.3f} ms", sample_count, scalar_ms, batch_ms);
+    }
+}
@@ -0,0 +1,98 @@
+#include "test_util.h"
+#include <rbc_core/utils/lz4_codec.h>
+#include <luisa/core/stl/vector.h>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+luisa::vector<std::byte> roundtrip(luisa::vector<std::byte> const &src, size_t &compressed_size) {
+    luisa::vector<std::byte> compressed(rbc::lz4::compress_bound(src.size()));
+    compressed_size = rbc::lz4::compress(src, compressed);
+    luisa::vector<std::byte> result(src.size());
+    auto size = rbc::lz4::decompress(luisa::span{compressed}.subspan(0, compressed_size), result);
+    result.resize(size);
+    return result;
+}
+// Block extracted from the frame written by the reference CLI (lz4 v1.9.4):
+// `lz4 -9 --no-frame-crc -B4 in.bin`, in.bin being reference_fixture_source()
+const uint8_t reference_block[] = {
+    0xf1, 0x1b, 0x72, 0x62, 0x63, 0x20, 0x74, 0x69, 0x6c, 0x65, 0x20, 0x30,
+    0x3a, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+    0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75,
+    0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72, 0x1f, 0x00, 0xa5, 0x6c,
+    0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20, 0x39, 0x00, 0x1f,
+    0x31, 0x39, 0x00, 0x25, 0x1f, 0x32, 0x39, 0x00, 0x25, 0x1f, 0x33, 0x39,
+    0x00, 0x1c, 0x0f, 0xe4, 0x00, 0xcc, 0x50, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+};
+luisa::vector<std::byte> reference_fixture_source() {
+    luisa::vector<std::byte> src;
+    for (int i = 0; i < 8; ++i) {
+        char line[64];
+        auto size = std::snprintf(line, sizeof(line), "rbc tile %d: the quick brown fox jumps over the lazy dog. ", i % 4);
+        for (int c = 0; c < size; ++c) {
+            src.emplace_back(static_cast<std::byte>(line[c]));
+        }
+    }
+    return src;
+}
+}// namespace
+
+TEST_SUITE("core") {
+    TEST_CASE("lz4_decodes_reference_block") {
+        auto src = reference_fixture_source();
+        REQUIRE(src.size() == 456);
+        luisa::vector<std::byte> result(src.size());
+        auto size = rbc::lz4::decompress({reinterpret_cast<std::byte const *>(reference_block), sizeof(reference_block)}, result);
+        REQUIRE(size == src.size());
+        CHECK(std::memcmp(result.data(), src.data(), src.size()) == 0);
+    }
+
+    TEST_CASE("lz4_roundtrip_repetitive") {
+        luisa::vector<std::byte> src(256 * 256 * 4);
+        for (size_t i = 0; i < src.size(); ++i) {
+            src[i] = static_cast<std::byte>((i / 4) % 13);
+        }
+        size_t compressed_size{};
+        auto result = roundtrip(src, compressed_size);
+        CHECK(compressed_size > 0);
+        CHECK(compressed_size < src.size() / 8);
+        REQUIRE(result.size() == src.size());
+        CHECK(std::memcmp(result.data(), src.data(), src.size()) == 0);
+    }
+
+    TEST_CASE("lz4_roundtrip_incompressible") {
+        luisa::vector<std::byte> src(10000);
+        uint32_t state = 12345u;
+        for (auto &i : src) {
+            state = state * 1664525u + 1013904223u;
+            i = static_cast<std::byte>(state >> 24u);
+        }
+        size_t compressed_size{};
+        auto result = roundtrip(src, compressed_size);
+        CHECK(compressed_size <= rbc::lz4::compress_bound(src.size()));
+        REQUIRE(result.size() == src.size());
+        CHECK(std::memcmp(result.data(), src.data(), src.size()) == 0);
+    }
+
+    TEST_CASE("lz4_roundtrip_tiny") {
+        for (size_t size = 0; size < 20; ++size) {
+            luisa::vector<std::byte> src(size, std::byte{7});
+            size_t compressed_size{};
+            auto result = roundtrip(src, compressed_size);
+            CHECK(compressed_size > 0);
+            CHECK(result.size() == size);
+        }
+    }
+
+    TEST_CASE("lz4_rejects_malformed") {
+        // match offset points before the start of output
+        const std::byte bad[] = {std::byte{0x10}, std::byte{'a'}, std::byte{0x05}, std::byte{0x00}};
+        luisa::vector<std::byte> dst(64);
+        CHECK(rbc::lz4::decompress(bad, dst) == 0);
+        luisa::vector<std::byte> src(1000, std::byte{1});
+        luisa::vector<std::byte> compressed(rbc::lz4::compress_bound(src.size()));
+        auto size = rbc::lz4::compress(src, compressed);
+        luisa::vector<std::byte> small_dst(10);
+        CHECK(rbc::lz4::decompress(luisa::span{compressed}.subspan(0, size), small_dst) == 0);
+    }
+}
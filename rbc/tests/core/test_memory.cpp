@@ -1,7 +1,10 @@
 #include "test_util.h"
 #include <rbc_core/memory.h>
+#include <rbc_core/pool_allocator.h>
 #include <cstring>
 #include <cstdint>
+#include <thread>
+#include <vector>
 
 TEST_SUITE("core") {
     TEST_CASE("memory_malloc_basic") {
@@ -267,5 +270,116 @@ TEST_SUITE("core") {
         
         containers_free_aligned(ptr, alignment);
     }
-}
 
+    TEST_CASE("memory_pool_stats") {
+        const char *pool_name = "test_stats_pool";
+        void *a = rbc_mallocN(100, pool_name);
+        void *b = rbc_malloc_alignedN(256, 64, pool_name);
+        RBCPoolStats stats{};
+        REQUIRE(rbc_pool_stats(pool_name, &stats));
+        CHECK(stats.alloc_count == 2);
+        CHECK(stats.free_count == 0);
+        CHECK(stats.live_bytes >= 356);
+        auto peak = stats.live_bytes;
+        rbc_freeN(a, pool_name);
+        rbc_free_alignedN(b, 64, pool_name);
+        REQUIRE(rbc_pool_stats(pool_name, &stats));
+        CHECK(stats.free_count == 2);
+        CHECK(stats.live_bytes == 0);
+        CHECK(stats.peak_bytes == peak);
+        CHECK(!rbc_pool_stats("test_unused_pool", &stats));
+    }
+
+    TEST_CASE("memory_pool_stats_threads") {
+        const char *pool_name = "test_stats_threads_pool";
+        constexpr size_t thread_count = 8, iterations = 10000;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&] {
+                for (size_t i = 0; i < iterations; ++i) {
+                    rbc_freeN(rbc_mallocN(64, pool_name), pool_name);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        RBCPoolStats stats{};
+        REQUIRE(rbc_pool_stats(pool_name, &stats));
+        CHECK(stats.alloc_count == thread_count * iterations);
+        CHECK(stats.free_count == thread_count * iterations);
+        CHECK(stats.live_bytes == 0);
+        CHECK(stats.total_alloc_bytes >= thread_count * iterations * 64);
+        CHECK(stats.peak_bytes > 0);
+    }
+
+    TEST_CASE("memory_pool_arena") {
+        const char *pool_name = "test_arena_pool";
+        // stays bound after the test, the pool name is never used again
+        static rbc::ArenaPoolAllocator arena{4096};
+        // rebinding is allowed until the first allocation
+        REQUIRE(rbc_pool_bind_allocator(pool_name, nullptr));
+        REQUIRE(rbc_pool_bind_allocator(pool_name, arena.allocator()));
+        for (int frame = 0; frame < 3; ++frame) {
+            void *ptrs[64];
+            for (auto &ptr : ptrs) {
+                ptr = rbc_mallocN(200, pool_name);
+                REQUIRE(ptr != nullptr);
+                memset(ptr, frame, 200);
+            }
+            void *aligned = rbc_malloc_alignedN(100, 128, pool_name);
+            CHECK((reinterpret_cast<uintptr_t>(aligned) % 128) == 0);
+            ptrs[0] = rbc_reallocN(ptrs[0], 400, pool_name);
+            CHECK(static_cast<uint8_t *>(ptrs[0])[199] == frame);
+            for (auto ptr : ptrs) {
+                rbc_freeN(ptr, pool_name);
+            }
+            rbc_free_alignedN(aligned, 128, pool_name);
+            arena.reset();
+        }
+        // chunks are reused across resets
+        CHECK(arena.reserved_bytes() <= 5 * 4096);
+        RBCPoolStats stats{};
+        REQUIRE(rbc_pool_stats(pool_name, &stats));
+        CHECK(stats.live_bytes == 0);
+        // sealed by the first allocation, even with no blocks alive
+        CHECK(!rbc_pool_bind_allocator(pool_name, nullptr));
+    }
+
+    TEST_CASE("memory_pool_arena_direct") {
+        rbc::ArenaPoolAllocator arena{4096};
+        for (int frame = 0; frame < 3; ++frame) {
+            auto values = arena.allocate_array<uint64_t>(1000);
+            REQUIRE(values.data() != nullptr);
+            CHECK((reinterpret_cast<uintptr_t>(values.data()) % alignof(uint64_t)) == 0);
+            for (size_t i = 0; i < values.size(); ++i) values[i] = i;
+            auto aligned = arena.allocate(64, 256);
+            CHECK((reinterpret_cast<uintptr_t>(aligned) % 256) == 0);
+            CHECK(values[999] == 999);
+            CHECK(arena.used_bytes() == 1000 * sizeof(uint64_t) + 64);
+            arena.reset();
+            CHECK(arena.used_bytes() == 0);
+        }
+        CHECK(arena.reserved_bytes() <= 3 * 4096 + 8192);
+    }
+
+    TEST_CASE("memory_pool_size_class") {
+        const char *pool_name = "test_size_class_pool";
+        static rbc::SizeClassPoolAllocator pool;
+        REQUIRE(rbc_pool_bind_allocator(pool_name, pool.allocator()));
+        void *small = rbc_mallocN(24, pool_name);
+        void *large = rbc_mallocN(10000, pool_name);
+        // binding is refused once the pool has allocated
+        CHECK(!rbc_pool_bind_allocator(pool_name, nullptr));
+        RBCPoolStats stats{};
+        REQUIRE(rbc_pool_stats(pool_name, &stats));
+        CHECK(stats.live_bytes == 32 + 10000);
+        rbc_freeN(small, pool_name);
+        // freed block is reused for the same size class
+        void *reused = rbc_mallocN(30, pool_name);
+        CHECK(reused == small);
+        rbc_freeN(reused, pool_name);
+        rbc_freeN(large, pool_name);
+        CHECK(!rbc_pool_bind_allocator(pool_name, nullptr));
+    }
+}
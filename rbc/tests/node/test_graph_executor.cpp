@@ -0,0 +1,68 @@
+#include "test_util.h"
+#include <rbc_node/graph_executor.h>
+
+namespace {
+struct IntValue : rbc::RCBase {
+    int value;
+    explicit IntValue(int value) : value(value) {}
+};
+rbc::NodeValue make_int(int value) {
+    return rbc::NodeValue{rbc::RC<rbc::RCBase>{new IntValue{value}}};
+}
+int get_int(rbc::NodeValue const *value) {
+    return static_cast<IntValue *>(value->force_get<rbc::RC<rbc::RCBase>>().get())->value;
+}
+}// namespace
+
+TEST_SUITE("node") {
+    using namespace rbc;
+    TEST_CASE("graph_executor_diamond") {
+        luisa::fiber::scheduler scheduler;
+        GraphExecutor executor;
+        auto src = executor.add_node("src", [](NodeContext &ctx) { ctx.set_output(0, make_int(3)); }, 1);
+        auto add = executor.add_node("add", [](NodeContext &ctx) { ctx.set_output(0, make_int(get_int(ctx.input(0)) + 1)); }, 1);
+        auto mul = executor.add_node("mul", [](NodeContext &ctx) { ctx.set_output(0, make_int(get_int(ctx.input(0)) * 2)); }, 1);
+        auto sum = executor.add_node(
+            "sum", [](NodeContext &ctx) {
+                NodeValue lhs;
+                // sole consumer of "add", the value is moved out
+                CHECK(ctx.take_input(0, lhs));
+                ctx.set_output(0, make_int(get_int(&lhs) + get_int(ctx.input(1))));
+            },
+            1);
+        executor.connect(src, 0, add, 0);
+        executor.connect(src, 0, mul, 0);
+        executor.connect(add, 0, sum, 0);
+        executor.connect(mul, 0, sum, 1);
+        REQUIRE(executor.compile());
+        executor.execute();
+        for (auto i : vstd::range(executor.node_count())) {
+            CHECK(executor.status(static_cast<uint32_t>(i)) == NodeStatus::Completed);
+        }
+        CHECK(get_int(executor.output(sum, 0)) == 10);
+        CHECK(executor.output(add, 0) == nullptr);
+        CHECK(executor.timing(sum).start_ms >= executor.timing(src).start_ms + executor.timing(src).duration_ms);
+    }
+    TEST_CASE("graph_executor_failure") {
+        luisa::fiber::scheduler scheduler;
+        GraphExecutor executor;
+        auto bad = executor.add_node("bad", [](NodeContext &ctx) { ctx.set_error("bad input"); }, 1);
+        auto good = executor.add_node("good", [](NodeContext &ctx) { ctx.set_output(0, make_int(1)); }, 1);
+        auto after = executor.add_node("after", [](NodeContext &) {}, 0);
+        executor.connect(bad, 0, after, 0);
+        executor.connect_dependency(good, after);
+        executor.execute();
+        CHECK(executor.status(bad) == NodeStatus::Failed);
+        CHECK(executor.error(bad) == "bad input");
+        CHECK(executor.status(good) == NodeStatus::Completed);
+        CHECK(executor.status(after) == NodeStatus::Skipped);
+    }
+    TEST_CASE("graph_executor_cycle") {
+        GraphExecutor executor;
+        auto a = executor.add_node("a", [](NodeContext &) {}, 1);
+        auto b = executor.add_node("b", [](NodeContext &) {}, 1);
+        executor.connect(a, 0, b, 0);
+        executor.connect(b, 0, a, 0);
+        CHECK(!executor.compile());
+    }
+}
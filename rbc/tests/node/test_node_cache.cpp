@@ -0,0 +1,138 @@
+#include "test_util.h"
+#include <rbc_node/graph_executor.h>
+#include <algorithm>
+
+namespace {
+struct CountValue : rbc::RCBase {
+    int value;
+    explicit CountValue(int value) : value(value) {}
+};
+int get_value(rbc::NodeValue const *value) {
+    return static_cast<CountValue *>(value->force_get<rbc::RC<rbc::RCBase>>().get())->value;
+}
+}// namespace
+
+TEST_SUITE("node") {
+    using namespace rbc;
+    TEST_CASE("node_cache_key") {
+        uint64_t inputs[] = {1, 2};
+        uint64_t swapped[] = {2, 1};
+        auto key = NodeCache::make_key("add", 7, inputs);
+        CHECK(key == NodeCache::make_key("add", 7, inputs));
+        CHECK(key != NodeCache::make_key("add", 8, inputs));
+        CHECK(key != NodeCache::make_key("mul", 7, inputs));
+        CHECK(key != NodeCache::make_key("add", 7, swapped));
+    }
+    TEST_CASE("node_cache_memoize") {
+        luisa::fiber::scheduler scheduler;
+        NodeCache cache{1024 * 1024};
+        GraphExecutor executor;
+        executor.set_cache(&cache);
+        std::atomic_int head_runs{};
+        std::atomic_int tail_runs{};
+        int param = 1;
+        auto head = executor.add_node(
+            "head", [&](NodeContext &ctx) {
+                head_runs++;
+                ctx.set_output(0, NodeValue{RC<RCBase>{new CountValue{10}}});
+            },
+            1);
+        auto tail = executor.add_node(
+            "tail", [&](NodeContext &ctx) {
+                tail_runs++;
+                ctx.set_output(0, NodeValue{RC<RCBase>{new CountValue{get_value(ctx.input(0)) + param}}});
+            },
+            1);
+        executor.connect(head, 0, tail, 0);
+        executor.set_cache_key(head, "head", 0);
+        executor.set_cache_key(tail, "tail", param);
+        executor.execute();
+        CHECK(get_value(executor.output(tail, 0)) == 11);
+        // nothing changed, both nodes come from the cache
+        executor.execute();
+        CHECK(head_runs == 1);
+        CHECK(tail_runs == 1);
+        CHECK(executor.from_cache(tail));
+        CHECK(get_value(executor.output(tail, 0)) == 11);
+        // editing the tail only re-runs the tail
+        param = 2;
+        executor.set_cache_key(tail, "tail", param);
+        executor.execute();
+        CHECK(head_runs == 1);
+        CHECK(tail_runs == 2);
+        CHECK(get_value(executor.output(tail, 0)) == 12);
+        auto stats = cache.stats();
+        CHECK(stats.hits == 3);
+        CHECK(stats.misses == 3);
+    }
+    TEST_CASE("node_cache_output_hashes") {
+        luisa::fiber::scheduler scheduler;
+        NodeCache cache{1024 * 1024};
+        GraphExecutor executor;
+        executor.set_cache(&cache);
+        int tail_runs = 0;
+        auto head = executor.add_node(
+            "head", [&](NodeContext &ctx) {
+                ctx.set_output(0, NodeValue{RC<RCBase>{new CountValue{10}}});
+                ctx.set_output_hash(0, 1234);
+            },
+            1);
+        auto tail = executor.add_node(
+            "tail", [&](NodeContext &ctx) {
+                tail_runs++;
+                ctx.set_output(0, NodeValue{RC<RCBase>{new CountValue{get_value(ctx.input(0)) + 1}}});
+            },
+            1);
+        executor.connect(head, 0, tail, 0);
+        executor.set_cache_key(head, "head", 0);
+        executor.set_cache_key(tail, "tail", 0);
+        executor.execute();
+        executor.execute();
+        // the head hit restores its content hash, so the tail key is unchanged
+        CHECK(executor.from_cache(head));
+        CHECK(executor.from_cache(tail));
+        CHECK(tail_runs == 1);
+    }
+    TEST_CASE("node_cache_lru_spill") {
+        auto spill_dir = luisa::filesystem::temp_directory_path() / "rbc_test_node_cache";
+        NodeCache cache{3 * 64, spill_dir};
+        auto put = [&](uint64_t key, std::byte fill) {
+            auto buffer = NodeBuffer::create_host(64);
+            std::fill(buffer.host_data().begin(), buffer.host_data().end(), fill);
+            luisa::vector<NodeValue> outputs;
+            outputs.emplace_back(std::move(buffer));
+            cache.put(key, std::move(outputs), {key * 10});
+        };
+        put(1, std::byte{1});
+        put(2, std::byte{2});
+        put(3, std::byte{3});
+        // touch 1, the least recently used one is now 2
+        luisa::vector<NodeValue> values;
+        luisa::vector<uint64_t> hashes;
+        REQUIRE(cache.take(1, values, hashes));
+        CHECK(hashes == luisa::vector<uint64_t>{10});
+        put(1, std::byte{1});
+        put(4, std::byte{4});
+        auto stats = cache.stats();
+        CHECK(stats.evictions == 1);
+        CHECK(stats.spills == 1);
+        CHECK(stats.entry_count == 3);
+        // 2 comes back from disk with its hash and content
+        REQUIRE(cache.take(2, values, hashes));
+        CHECK(cache.stats().spill_hits == 1);
+        CHECK(hashes == luisa::vector<uint64_t>{20});
+        REQUIRE(values.size() == 1);
+        auto data = values[0].force_get<NodeBuffer>().host_data();
+        REQUIRE(data.size() == 64);
+        CHECK(data[63] == std::byte{2});
+        // shrinking the budget evicts in LRU order: 3 first, then 1
+        cache.set_memory_budget(64);
+        CHECK(cache.take(4, values, hashes));
+        CHECK(cache.stats().spill_hits == 1);
+        CHECK(cache.take(3, values, hashes));
+        CHECK(cache.stats().spill_hits == 2);
+        cache.clear();
+        std::error_code ec;
+        luisa::filesystem::remove_all(spill_dir, ec);
+    }
+}
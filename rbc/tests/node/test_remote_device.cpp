@@ -0,0 +1,102 @@
+#include "test_util.h"
+#include <rbc_node/graph_executor.h>
+#include <rbc_node/remote_device.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+std::atomic_bool first_batch_ran{false};
+void double_floats(rbc::NodeContext &ctx) {
+    auto src = ctx.input(0)->force_get<rbc::NodeBuffer>().host_data();
+    auto dst = rbc::NodeBuffer::create_host(src.size());
+    auto src_floats = reinterpret_cast<float const *>(src.data());
+    auto dst_floats = reinterpret_cast<float *>(dst.host_data().data());
+    for (size_t i = 0; i < src.size() / sizeof(float); ++i) {
+        dst_floats[i] = src_floats[i] * 2.f;
+    }
+    ctx.set_output(0, rbc::NodeValue{std::move(dst)});
+}
+void mark_first_batch(rbc::NodeContext &ctx) {
+    first_batch_ran = true;
+    ctx.set_output(0, rbc::NodeValue{rbc::NodeBuffer::create_host(0)});
+}
+}// namespace
+
+TEST_SUITE("node") {
+    using namespace rbc;
+    TEST_CASE("remote_device_batch") {
+        luisa::fiber::scheduler scheduler;
+        NativeNodeRegistry::instance().register_node("test_remote_double", double_floats, 1);
+        luisa::string topic = "rbc_test_remote_device";
+        // same machine, the worker would usually live in another process
+        std::thread worker_thread{[&] {
+            RemoteComputeWorker worker{topic, 4096};
+            worker.run();
+        }};
+        {
+            RemoteComputeDevice device{topic, 4096};
+            luisa::vector<float> data(10000);
+            for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i);
+            RemoteBatch batch;
+            auto input = batch.add_buffer(luisa::as_bytes(luisa::span<float const>{data}));
+            RemotePort first{batch.add_node("test_remote_double", {&input, 1}), 0};
+            RemotePort second{batch.add_node("test_remote_double", {&first, 1}), 0};
+            auto result_index = batch.read_back(second);
+            auto future = device.submit(batch);
+
+            // several batches may be in flight
+            RemoteBatch bad_batch;
+            bad_batch.add_node("test_remote_missing", {});
+            auto bad_future = device.submit(bad_batch);
+
+            auto outputs = future.take_outputs();
+            CHECK(future.error().empty());
+            REQUIRE(outputs.size() == 1);
+            REQUIRE(outputs[result_index].has_value());
+            auto result = outputs[result_index]->host_data();
+            REQUIRE(result.size() == data.size() * sizeof(float));
+            auto floats = reinterpret_cast<float const *>(result.data());
+            bool equal = true;
+            for (size_t i = 0; i < data.size(); ++i) {
+                equal &= floats[i] == data[i] * 4.f;
+            }
+            CHECK(equal);
+            CHECK(!bad_future.error().empty());
+            device.shutdown_worker();
+        }
+        worker_thread.join();
+    }
+    TEST_CASE("remote_device_worker_killed") {
+        luisa::fiber::scheduler scheduler;
+        NativeNodeRegistry::instance().register_node("test_remote_mark", mark_first_batch, 1);
+        luisa::string topic = "rbc_test_remote_device_killed";
+        // the worker dies right after the first batch, with the second one still streaming in
+        std::thread worker_thread{[&] {
+            RemoteComputeWorker worker{topic, 4096};
+            while (!first_batch_ran) {
+                worker.tick();
+            }
+        }};
+        {
+            RemoteComputeDevice device{topic, 4096, std::chrono::milliseconds{500}};
+            RemoteBatch first_batch;
+            first_batch.add_node("test_remote_mark", {});
+            auto first = device.submit(first_batch);
+
+            luisa::vector<float> data(16 * 1024);
+            RemoteBatch second_batch;
+            auto input = second_batch.add_buffer(luisa::as_bytes(luisa::span<float const>{data}));
+            second_batch.read_back(input);
+            auto second = device.submit(second_batch);
+
+            REQUIRE(first.wait_for(std::chrono::seconds{10}));
+            CHECK(first.error().empty());
+            // no heartbeat arrives anymore, the pending batch fails instead of hanging
+            REQUIRE(second.wait_for(std::chrono::seconds{10}));
+            CHECK(second.error().find("disconnected") != luisa::string_view::npos);
+            CHECK(second.take_outputs().empty());
+            CHECK(device.pending_count() == 0);
+        }
+        worker_thread.join();
+    }
+}
@@ -331,7 +331,11 @@ int main(int argc, char *argv[]) {
 
             {
                 // AnimTick
-                entity->get_component<world::SkelMeshComponent>()->tick(delta_time);
+                auto *skelmesh = entity->get_component<world::SkelMeshComponent>();
+                skelmesh->update_visibility(cam);
+                AnimUpdateSystem::instance().BeginFrame();
+                RBCPlot("Anim Pose Cache Hit Rate", AnimUpdateSystem::instance().GetPoseCache().GetFrameStats().HitRate());
+                skelmesh->tick(delta_time);
             }
 
             if (true) {
@@ -0,0 +1,143 @@
+#include "test_util.h"
+#include <rbc_graphics/texture/bc_encoder.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/clock.h>
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/vector.h>
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace {
+using rbc::BCEncoder;
+luisa::vector<std::byte> make_image(luisa::uint2 size) {
+    luisa::vector<std::byte> img(size.x * size.y * 4);
+    for (uint32_t y = 0; y < size.y; ++y)
+        for (uint32_t x = 0; x < size.x; ++x) {
+            auto p = img.data() + (y * size.x + x) * 4;
+            p[0] = static_cast<std::byte>(128 + 100 * std::sin(x * 0.05f));
+            p[1] = static_cast<std::byte>(y * 255 / size.y);
+            p[2] = static_cast<std::byte>(128 + 100 * std::cos((x + y) * 0.03f));
+            p[3] = static_cast<std::byte>(255 - x % 256);
+        }
+    return img;
+}
+double psnr(luisa::span<std::byte const> a, luisa::span<std::byte const> b, uint32_t channels) {
+    double mse = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (i % 4 >= channels) continue;
+        double d = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+        mse += d * d;
+    }
+    mse /= static_cast<double>(a.size() / 4 * channels);
+    return mse == 0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+double encode_psnr(BCEncoder::Format format, BCEncoder::Quality quality, uint32_t channels) {
+    luisa::uint2 size{130, 66};
+    auto src = make_image(size);
+    luisa::vector<std::byte> encoded(BCEncoder::encoded_size(format, size));
+    luisa::vector<std::byte> decoded(src.size());
+    BCEncoder::encode(format, quality, src, size, encoded);
+    BCEncoder::decode(format, encoded, size, decoded);
+    return psnr(src, decoded, channels);
+}
+}// namespace
+
+TEST_SUITE("world") {
+    TEST_CASE("bc_encoder_sizes") {
+        CHECK(BCEncoder::encoded_size(BCEncoder::Format::BC1, {256, 256}) == 256 * 256 / 2);
+        CHECK(BCEncoder::encoded_size(BCEncoder::Format::BC7, {256, 256}) == 256 * 256);
+        CHECK(BCEncoder::encoded_size(BCEncoder::Format::BC4, {6, 6}) == 4 * 8);
+        CHECK(BCEncoder::encoded_size(BCEncoder::Format::BC6H, {256, 256}) == 256 * 256);
+        CHECK(BCEncoder::source_storage(BCEncoder::Format::BC6H) == luisa::compute::PixelStorage::FLOAT4);
+        CHECK(BCEncoder::source_storage(BCEncoder::Format::BC7) == luisa::compute::PixelStorage::BYTE4);
+    }
+    TEST_CASE("bc_encoder_quality") {
+        luisa::fiber::scheduler scheduler;
+        CHECK(encode_psnr(BCEncoder::Format::BC1, BCEncoder::Quality::Normal, 3) > 30.0);
+        CHECK(encode_psnr(BCEncoder::Format::BC3, BCEncoder::Quality::Normal, 4) > 30.0);
+        CHECK(encode_psnr(BCEncoder::Format::BC4, BCEncoder::Quality::Fast, 1) > 40.0);
+        CHECK(encode_psnr(BCEncoder::Format::BC5, BCEncoder::Quality::Normal, 2) > 40.0);
+        CHECK(encode_psnr(BCEncoder::Format::BC7, BCEncoder::Quality::Normal, 4) > 35.0);
+        // higher presets never lose quality
+        CHECK(encode_psnr(BCEncoder::Format::BC1, BCEncoder::Quality::High, 3) >= encode_psnr(BCEncoder::Format::BC1, BCEncoder::Quality::Fast, 3));
+        CHECK(encode_psnr(BCEncoder::Format::BC7, BCEncoder::Quality::High, 4) >= encode_psnr(BCEncoder::Format::BC7, BCEncoder::Quality::Fast, 4));
+    }
+    TEST_CASE("bc_encoder_flat_blocks") {
+        luisa::fiber::scheduler scheduler;
+        // a single partial block, solid colors only lose endpoint quantization precision
+        luisa::uint2 size{3, 2};
+        luisa::vector<std::byte> src(size.x * size.y * 4);
+        for (size_t i = 0; i < src.size(); i += 4) {
+            src[i] = std::byte{200};
+            src[i + 1] = std::byte{64};
+            src[i + 2] = std::byte{0};
+            src[i + 3] = std::byte{255};
+        }
+        for (auto format : {BCEncoder::Format::BC1, BCEncoder::Format::BC3, BCEncoder::Format::BC4, BCEncoder::Format::BC5, BCEncoder::Format::BC7}) {
+            luisa::vector<std::byte> encoded(BCEncoder::encoded_size(format, size));
+            luisa::vector<std::byte> decoded(src.size());
+            BCEncoder::encode(format, BCEncoder::Quality::Fast, src, size, encoded);
+            BCEncoder::decode(format, encoded, size, decoded);
+            auto channels = format == BCEncoder::Format::BC4 ? 1u : (format == BCEncoder::Format::BC5 ? 2u : 3u);
+            CHECK(psnr(src, decoded, channels) > 40.0);
+        }
+    }
+    TEST_CASE("bc_encoder_bc6h") {
+        luisa::fiber::scheduler scheduler;
+        // HDR gradients far above 1, error is relative because BC6H works on half floats
+        luisa::uint2 size{130, 66};
+        luisa::vector<float> src(size.x * size.y * 4);
+        for (uint32_t y = 0; y < size.y; ++y)
+            for (uint32_t x = 0; x < size.x; ++x) {
+                auto p = src.data() + (y * size.x + x) * 4;
+                p[0] = std::exp2(x * 0.1f - 4.f);
+                p[1] = 0.5f + 0.4f * std::sin(y * 0.1f);
+                p[2] = y * 2.f;
+                p[3] = 1.f;
+            }
+        auto mean_relative_error = [&](BCEncoder::Quality quality) {
+            luisa::vector<std::byte> encoded(BCEncoder::encoded_size(BCEncoder::Format::BC6H, size));
+            luisa::vector<float> decoded(src.size());
+            BCEncoder::encode(BCEncoder::Format::BC6H, quality, std::as_bytes(luisa::span{src}), size, encoded);
+            BCEncoder::decode(BCEncoder::Format::BC6H, encoded, size, std::as_writable_bytes(luisa::span{decoded}));
+            double error = 0;
+            for (size_t i = 0; i < src.size(); ++i) {
+                if (i % 4 == 3) continue;
+                error += std::abs(decoded[i] - src[i]) / std::max(src[i], 1e-2f);
+            }
+            return error / static_cast<double>(src.size() / 4 * 3);
+        };
+        CHECK(mean_relative_error(BCEncoder::Quality::Fast) < 0.06);
+        CHECK(mean_relative_error(BCEncoder::Quality::Normal) < 0.04);
+        // a flat block only loses endpoint precision
+        float color[4] = {3.5f, 0.25f, 100.f, 1.f};
+        luisa::vector<float> flat(16 * 4);
+        for (size_t i = 0; i < flat.size(); ++i) flat[i] = color[i % 4];
+        luisa::vector<std::byte> encoded(16);
+        luisa::vector<float> decoded(flat.size());
+        BCEncoder::encode(BCEncoder::Format::BC6H, BCEncoder::Quality::Fast, std::as_bytes(luisa::span{flat}), {4, 4}, encoded);
+        BCEncoder::decode(BCEncoder::Format::BC6H, encoded, {4, 4}, std::as_writable_bytes(luisa::span{decoded}));
+        for (uint32_t ch = 0; ch < 3; ++ch) {
+            CHECK(decoded[ch] == doctest::Approx(color[ch]).epsilon(0.01));
+        }
+        CHECK(decoded[3] == 1.f);
+    }
+    // throughput only, opt in with --no-skip
+    TEST_CASE("bc_encoder_benchmark" * doctest::skip()) {
+        luisa::fiber::scheduler scheduler;
+        luisa::uint2 size{1024, 1024};
+        auto src = make_image(size);
+        for (auto format : {BCEncoder::Format::BC1, BCEncoder::Format::BC3, BCEncoder::Format::BC5, BCEncoder::Format::BC7}) {
+            luisa::vector<std::byte> encoded(BCEncoder::encoded_size(format, size));
+            for (auto quality : {BCEncoder::Quality::Fast, BCEncoder::Quality::Normal, BCEncoder::Quality::High}) {
+                luisa::Clock clk;
+                BCEncoder::encode(format, quality, src, size, encoded);
+                auto ms = clk.toc();
+                LUISA_INFO("BC format {} quality {}: {:.2f} ms, {:.2f} MTexels/s",
+                           luisa::to_underlying(format), luisa::to_underlying(quality),
+                           ms, size.x * size.y / (ms * 1e3));
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include "test_util.h"
+#include <rbc_world/util/glb.h>
+#include <rbc_core/binary_file_writer.h>
+#include <luisa/core/stl/string.h>
+#include <luisa/core/stl/vector.h>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+// One triangle: interleaved position and uv with a 20-byte stride, then uint16 indices
+luisa::vector<std::byte> make_triangle_glb(uint16_t last_index = 2, luisa::string const &uv_count = "3") {
+    luisa::vector<std::byte> bin;
+    auto append = [&](void const *ptr, size_t size) {
+        auto begin = static_cast<std::byte const *>(ptr);
+        bin.insert(bin.end(), begin, begin + size);
+    };
+    float vertices[3][5] = {{0, 0, 0, 0, 0}, {1, 0, 0, 1, 0}, {0, 1, 0, 0, 1}};
+    append(vertices, sizeof(vertices));
+    uint16_t indices[4] = {0, 1, last_index, 0};// padded to 4 bytes
+    append(indices, sizeof(indices));
+    luisa::string json = R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":68}],)"
+                         R"("bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":60,"byteStride":20},)"
+                         R"({"buffer":0,"byteOffset":60,"byteLength":6}],)"
+                         R"("accessors":[{"bufferView":0,"componentType":5126,"count":3,"type":"VEC3"},)"
+                         R"({"bufferView":0,"byteOffset":12,"componentType":5126,"count":)" + uv_count + R"(,"type":"VEC2"},)"
+                         R"({"bufferView":1,"componentType":5123,"count":3,"type":"SCALAR"}],)"
+                         R"("meshes":[{"primitives":[{"attributes":{"POSITION":0,"TEXCOORD_0":1},"indices":2}]}]})";
+    while (json.size() % 4 != 0) json.push_back(' ');
+    luisa::vector<std::byte> glb;
+    auto write_u32 = [&](uint32_t value) {
+        auto begin = reinterpret_cast<std::byte const *>(&value);
+        glb.insert(glb.end(), begin, begin + sizeof(value));
+    };
+    write_u32(0x46546C67u);
+    write_u32(2);
+    write_u32(static_cast<uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+    write_u32(static_cast<uint32_t>(json.size()));
+    write_u32(0x4E4F534Au);
+    auto json_begin = reinterpret_cast<std::byte const *>(json.data());
+    glb.insert(glb.end(), json_begin, json_begin + json.size());
+    write_u32(static_cast<uint32_t>(bin.size()));
+    write_u32(0x004E4942u);
+    glb.insert(glb.end(), bin.begin(), bin.end());
+    return glb;
+}
+}// namespace
+
+TEST_SUITE("world") {
+    TEST_CASE("glb_document") {
+        using namespace rbc;
+        auto path = std::filesystem::temp_directory_path() / "rbc_test_triangle.glb";
+        {
+            auto glb = make_triangle_glb();
+            BinaryFileWriter writer{luisa::to_string(path)};
+            REQUIRE(writer._file);
+            writer.write(glb);
+        }
+        {
+            world::GlbDocument doc;
+            REQUIRE(doc.open(path));
+            CHECK(doc.self_contained());
+            CHECK(doc.bin().size() == 68);
+            REQUIRE(doc.primitives().size() == 1);
+            auto const &primitive = doc.primitives()[0];
+            CHECK(primitive.mode == -1);
+            CHECK(primitive.normal == -1);
+
+            auto position = doc.accessor(primitive.position);
+            REQUIRE(position.valid());
+            CHECK(position.count == 3);
+            CHECK(position.stride == 20);
+            CHECK(position.element_size() == 12);
+            // views point into the mapping, not into a copy
+            CHECK(position.data == doc.bin().data());
+            CHECK(position.read_float(1, 0) == 1.0f);
+
+            auto uv = doc.accessor(primitive.uvs[0]);
+            REQUIRE(uv.valid());
+            CHECK(uv.read_float(2, 1) == 1.0f);
+            CHECK_FALSE(doc.accessor(primitive.uvs[1]).valid());
+
+            auto indices = doc.accessor(primitive.indices);
+            REQUIRE(indices.valid());
+            CHECK(indices.stride == 2);
+            CHECK(indices.read_uint(2, 0) == 2);
+            CHECK(indices.max_uint() < position.count);
+            CHECK_FALSE(doc.accessor(3).valid());
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("glb_document_out_of_range") {
+        using namespace rbc;
+        auto path = std::filesystem::temp_directory_path() / "rbc_test_bad_triangle.glb";
+        {
+            // (count - 1) * 20 wraps to 0 in 64 bits, so the end of the last element looks in range
+            auto glb = make_triangle_glb(7, "4611686018427387905");
+            BinaryFileWriter writer{luisa::to_string(path)};
+            REQUIRE(writer._file);
+            writer.write(glb);
+        }
+        {
+            world::GlbDocument doc;
+            REQUIRE(doc.open(path));
+            REQUIRE(doc.primitives().size() == 1);
+            auto const &primitive = doc.primitives()[0];
+            CHECK_FALSE(doc.accessor(primitive.uvs[0]).valid());
+            auto position = doc.accessor(primitive.position);
+            auto indices = doc.accessor(primitive.indices);
+            REQUIRE(indices.valid());
+            // the importer skips primitives whose indices reach past POSITION
+            CHECK(indices.max_uint() == 7);
+            CHECK(indices.max_uint() >= position.count);
+        }
+        std::filesystem::remove(path);
+    }
+}
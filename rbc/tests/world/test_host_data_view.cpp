@@ -0,0 +1,154 @@
+#include "test_util.h"
+#include <rbc_core/runtime_static.h>
+#include <rbc_world/base_object.h>
+#include <rbc_world/resources/mesh.h>
+#include <rbc_world/resources/texture.h>
+#include <rbc_world/util/host_data_view.h>
+#include <rbc_graphics/device_assets/device_mesh.h>
+#include <rbc_anim/types.h>
+#include <luisa/core/stl/vector.h>
+#include <array>
+
+TEST_SUITE("world") {
+    TEST_CASE("host_data_strided_rows") {
+        using namespace rbc;
+        // (4, 3) positions into float3 rows padded to 16 bytes
+        constexpr size_t rows = 4;
+        float src[rows][3];
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t c = 0; c < 3; ++c) src[r][c] = static_cast<float>(r * 10 + c);
+        std::array<ptrdiff_t, 2> shape{rows, 3};
+        std::array<ptrdiff_t, 2> strides{3 * sizeof(float), sizeof(float)};
+        auto layout = world::resolve_strided_rows(shape, strides, sizeof(float), rows, 3);
+        REQUIRE(layout);
+        luisa::vector<luisa::float4> dst(rows, luisa::float4(-1.0f));
+        world::copy_strided_rows(*layout, reinterpret_cast<std::byte const *>(src), reinterpret_cast<std::byte *>(dst.data()), rows, 3, sizeof(float), sizeof(luisa::float4));
+        for (size_t r = 0; r < rows; ++r) {
+            CHECK(dst[r].x == static_cast<float>(r * 10));
+            CHECK(dst[r].z == static_cast<float>(r * 10 + 2));
+            // the padding is left alone
+            CHECK(dst[r].w == -1.0f);
+        }
+
+        // column-major source, e.g. a transposed numpy array
+        float src_t[3][rows];
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t c = 0; c < 3; ++c) src_t[c][r] = static_cast<float>(r * 100 + c);
+        std::array<ptrdiff_t, 2> strides_t{sizeof(float), rows * sizeof(float)};
+        layout = world::resolve_strided_rows(shape, strides_t, sizeof(float), rows, 3);
+        REQUIRE(layout);
+        world::copy_strided_rows(*layout, reinterpret_cast<std::byte const *>(src_t), reinterpret_cast<std::byte *>(dst.data()), rows, 3, sizeof(float), sizeof(luisa::float4));
+        CHECK(dst[3].y == 301.0f);
+
+        // wrong row count, wrong column count and a third axis without inner are rejected
+        std::array<ptrdiff_t, 2> bad_rows{rows + 1, 3};
+        std::array<ptrdiff_t, 2> bad_cols{rows, 4};
+        std::array<ptrdiff_t, 3> bad_axes{rows, 1, 3};
+        std::array<ptrdiff_t, 3> bad_strides{12, 12, 4};
+        CHECK_FALSE(world::resolve_strided_rows(bad_rows, strides, sizeof(float), rows, 3));
+        CHECK_FALSE(world::resolve_strided_rows(bad_cols, strides, sizeof(float), rows, 3));
+        CHECK_FALSE(world::resolve_strided_rows(bad_axes, bad_strides, sizeof(float), rows, 3));
+    }
+
+    TEST_CASE("host_data_bone_transforms") {
+        using namespace rbc;
+        // Pose.set_bone_space_transforms takes (N, 10, 4) or (N, 40) rows of AnimSOATransform
+        static_assert(sizeof(AnimSOATransform) == 40 * sizeof(float));
+        constexpr size_t soa_count = 2;
+        float src[soa_count][10][4];
+        for (size_t r = 0; r < soa_count; ++r)
+            for (size_t m = 0; m < 10; ++m)
+                for (size_t i = 0; i < 4; ++i) src[r][m][i] = static_cast<float>(r * 1000 + m * 10 + i);
+        luisa::vector<AnimSOATransform> bones(soa_count);
+        auto bones_ptr = reinterpret_cast<std::byte *>(bones.data());
+        auto bones_floats = reinterpret_cast<float const *>(bones.data());
+
+        std::array<ptrdiff_t, 3> shape{soa_count, 10, 4};
+        std::array<ptrdiff_t, 3> strides{sizeof(AnimSOATransform), 4 * sizeof(float), sizeof(float)};
+        auto layout = world::resolve_strided_rows(shape, strides, sizeof(float), soa_count, 40, 4);
+        REQUIRE(layout);
+        // dense trailing axes collapse into one row
+        CHECK(layout->row_inner == 40);
+        world::copy_strided_rows(*layout, reinterpret_cast<std::byte const *>(src), bones_ptr, soa_count, 40, sizeof(float), sizeof(AnimSOATransform));
+        CHECK(bones_floats[40 + 3 * 4 + 2] == 1032.0f);
+
+        // (N, 40) is the same memory
+        std::array<ptrdiff_t, 2> flat_shape{soa_count, 40};
+        std::array<ptrdiff_t, 2> flat_strides{sizeof(AnimSOATransform), sizeof(float)};
+        CHECK(world::resolve_strided_rows(flat_shape, flat_strides, sizeof(float), soa_count, 40, 4));
+
+        // (N, 10, 4) view of (N, 4, 10) memory, every element is gathered
+        float src_t[soa_count][4][10];
+        for (size_t r = 0; r < soa_count; ++r)
+            for (size_t m = 0; m < 10; ++m)
+                for (size_t i = 0; i < 4; ++i) src_t[r][i][m] = static_cast<float>(r * 1000 + m * 10 + i + 1);
+        std::array<ptrdiff_t, 3> strides_t{sizeof(AnimSOATransform), sizeof(float), 10 * sizeof(float)};
+        layout = world::resolve_strided_rows(shape, strides_t, sizeof(float), soa_count, 40, 4);
+        REQUIRE(layout);
+        world::copy_strided_rows(*layout, reinterpret_cast<std::byte const *>(src_t), bones_ptr, soa_count, 40, sizeof(float), sizeof(AnimSOATransform));
+        for (size_t m = 0; m < 10; ++m)
+            for (size_t i = 0; i < 4; ++i) CHECK(bones_floats[40 + m * 4 + i] == static_cast<float>(1000 + m * 10 + i + 1));
+
+        // (N, 4, 10) itself is not a bone layout
+        std::array<ptrdiff_t, 3> bad_shape{soa_count, 4, 10};
+        CHECK_FALSE(world::resolve_strided_rows(bad_shape, strides, sizeof(float), soa_count, 40, 4));
+    }
+
+    TEST_CASE("host_data_dirty_flush") {
+        using namespace rbc;
+        RuntimeStaticBase::init_all();
+        world::init_world({});
+        auto dispose_world = vstd::scope_exit([] {
+            world::destroy_world();
+            RuntimeStaticBase::dispose_all();
+        });
+        {
+            RC<world::MeshResource> mesh{world::create_object<world::MeshResource>()};
+            mesh->create_empty({}, {}, 0, 4, 2, 2, true, true);
+            world::MeshHostLayout layout{*mesh};
+            CHECK(layout.normal == 4 * sizeof(luisa::float3));
+            CHECK(layout.tangent == 8 * sizeof(luisa::float3));
+            CHECK(layout.uv == layout.tangent + 4 * sizeof(luisa::float4));
+            CHECK(layout.triangle == layout.uv + 2 * 4 * sizeof(luisa::float2));
+            CHECK(layout.end == DeviceMesh::get_mesh_size(4, true, true, 2, 2));
+            auto host = mesh->host_data();
+            REQUIRE(host);
+            host->resize(layout.end);
+            reinterpret_cast<luisa::float3 *>(host->data())[1] = luisa::float3(1.0f);
+
+            // an edit is queued once whatever the range, the next flush takes it
+            CHECK_FALSE(mesh->host_dirty());
+            mesh->mark_host_dirty(true);
+            mesh->mark_host_dirty(false);
+            CHECK(mesh->host_dirty());
+            // no scene manager, nothing is uploaded but the queue is still drained
+            world::_flush_dirty_meshes();
+            CHECK_FALSE(mesh->host_dirty());
+            mesh->mark_host_dirty(true);
+            CHECK(mesh->host_dirty());
+            world::_flush_dirty_meshes();
+            CHECK_FALSE(mesh->host_dirty());
+        }
+        {
+            RC<world::TextureResource> texture{world::create_object<world::TextureResource>()};
+            texture->create_empty({}, 0, LCPixelStorage::BYTE4, luisa::uint2(4, 4), 3, false);
+            // mip levels are stored back to back: 4x4, 2x2, 1x1
+            auto level1 = world::texture_level_range(luisa::compute::PixelStorage::BYTE4, luisa::uint2(4, 4), 1);
+            auto level2 = world::texture_level_range(luisa::compute::PixelStorage::BYTE4, luisa::uint2(4, 4), 2);
+            CHECK(level1.offset == 64);
+            CHECK(level1.size == 16);
+            CHECK(level2.offset == 80);
+            CHECK(level2.size == 4);
+            auto host = texture->host_data();
+            REQUIRE(host);
+            host->resize(level2.offset + level2.size);
+
+            CHECK_FALSE(texture->host_dirty());
+            texture->mark_host_dirty();
+            texture->mark_host_dirty();
+            CHECK(texture->host_dirty());
+            world::_flush_dirty_textures();
+            CHECK_FALSE(texture->host_dirty());
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include "test_util.h"
+#include <rbc_graphics/texture/mip_generator.h>
+#include <luisa/core/fiber.h>
+#include <luisa/core/stl/vector.h>
+#include <span>
+
+TEST_SUITE("world") {
+    using rbc::MipGenerator;
+    TEST_CASE("mip_generator_chain_size") {
+        using luisa::compute::PixelStorage;
+        CHECK(MipGenerator::chain_size_bytes(PixelStorage::BYTE4, {4, 4}, 3) == (16 + 4 + 1) * 4);
+        CHECK(MipGenerator::chain_size_bytes(PixelStorage::FLOAT4, {4, 1}, 3) == (4 + 2 + 1) * 16);
+        CHECK(MipGenerator::level_size({8, 2}, 2).x == 2);
+        CHECK(MipGenerator::level_size({8, 2}, 2).y == 1);
+    }
+    TEST_CASE("mip_generator_srgb") {
+        using luisa::compute::PixelStorage;
+        luisa::fiber::scheduler scheduler;
+        luisa::uint2 size{8, 8};
+        auto generate = [&](MipGenerator::ColorSpace color_space) {
+            luisa::vector<std::byte> data(MipGenerator::chain_size_bytes(PixelStorage::BYTE4, size, 4));
+            // black/white checkerboard with constant alpha
+            for (uint32_t y = 0; y < size.y; ++y)
+                for (uint32_t x = 0; x < size.x; ++x) {
+                    auto p = data.data() + (y * size.x + x) * 4;
+                    auto v = static_cast<std::byte>(((x + y) & 1) ? 255 : 0);
+                    p[0] = p[1] = p[2] = v;
+                    p[3] = static_cast<std::byte>(100);
+                }
+            REQUIRE(MipGenerator::generate(PixelStorage::BYTE4, size, 4, color_space, data));
+            return data;
+        };
+        auto linear = generate(MipGenerator::ColorSpace::Linear);
+        auto srgb = generate(MipGenerator::ColorSpace::SRGB);
+        auto last = linear.size() - 4;
+        CHECK(static_cast<int>(linear[last]) == 128);
+        // 50% linear coverage encodes to sRGB 188
+        CHECK(static_cast<int>(srgb[last]) == 188);
+        CHECK(static_cast<int>(srgb[last + 3]) == 100);
+    }
+    TEST_CASE("mip_generator_odd_size") {
+        using luisa::compute::PixelStorage;
+        luisa::fiber::scheduler scheduler;
+        // 5x3 -> 2x1 -> 1x1, the last column is dropped and the single row is clamped
+        luisa::uint2 size{5, 3};
+        luisa::vector<float> data(MipGenerator::chain_size_bytes(PixelStorage::FLOAT1, size, 3) / sizeof(float));
+        for (uint32_t i = 0; i < size.x * size.y; ++i) data[i] = static_cast<float>(i);
+        REQUIRE(MipGenerator::generate(PixelStorage::FLOAT1, size, 3, MipGenerator::ColorSpace::Linear, std::as_writable_bytes(luisa::span{data})));
+        CHECK(data[15] == doctest::Approx((0 + 1 + 5 + 6) / 4.f));
+        CHECK(data[16] == doctest::Approx((2 + 3 + 7 + 8) / 4.f));
+        CHECK(data[17] == doctest::Approx((data[15] + data[16]) / 2.f));
+    }
+}
@@ -0,0 +1,79 @@
+#include "test_util.h"
+#include <rbc_plugin/plugin_manager.h>
+#include <oidn_denoiser.h>
+#include <luisa/core/stl/vector.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+using rbc::DenoiserExt;
+double variance(luisa::span<float const> data) {
+    double mean = 0;
+    for (auto v : data) mean += v;
+    mean /= static_cast<double>(data.size());
+    double var = 0;
+    for (auto v : data) var += (v - mean) * (v - mean);
+    return var / static_cast<double>(data.size());
+}
+}// namespace
+
+TEST_SUITE("world") {
+    TEST_CASE("oidn_cpu_denoiser") {
+        auto module = rbc::PluginManager::instance().load_module("oidn_plugin");
+        if (!module || !*module) {
+            MESSAGE("oidn_plugin not found, skipped.");
+            return;
+        }
+        // small tiles so the 80x48 frame is split with overlap
+        auto ext = luisa::unique_ptr<DenoiserExt>(module->invoke<DenoiserExt *(uint32_t, uint32_t)>("rbc_create_oidn_cpu", 32u, 8u));
+        if (!ext) {
+            MESSAGE("OIDN CPU device not supported, skipped.");
+            return;
+        }
+        CHECK(ext->tag() == DenoiserExt::Tag::CPU);
+        uint32_t width = 80, height = 48;
+        luisa::vector<float> noisy(width * height * 3);
+        uint32_t state = 7u;
+        for (auto &v : noisy) {
+            state = state * 1664525u + 1013904223u;
+            v = 0.5f + (static_cast<float>(state >> 8u) / static_cast<float>(1u << 24u) - 0.5f) * 0.4f;
+        }
+        luisa::vector<float> output(noisy.size(), -1.f);
+        DenoiserExt::DenoiserInput input{width, height};
+        input.push_noisy_image(DenoiserExt::ImageFormat::FLOAT3);
+        input.inputs[0].out_device_ptr = noisy.data();
+        input.outputs[0].out_device_ptr = output.data();
+        auto denoiser = ext->create();
+        denoiser->init(input);
+
+        auto check_output = [&] {
+            bool finite = true;
+            for (auto v : output) finite &= std::isfinite(v) && v >= 0.f;
+            CHECK(finite);
+            CHECK(variance(output) < variance(noisy) * 0.5);
+        };
+        denoiser->execute(false);
+        check_output();
+        CHECK(denoiser->ms_per_mpixel() > 0.0);
+
+        // async copies the input before returning, the caller may clobber it right away
+        auto reference = output;
+        auto noisy_copy = noisy;
+        auto same_as_reference = [&] {
+            float max_diff = 0.f;
+            for (size_t i = 0; i < output.size(); ++i) max_diff = std::max(max_diff, std::abs(output[i] - reference[i]));
+            return max_diff < 1e-3f;
+        };
+        std::fill(output.begin(), output.end(), -1.f);
+        denoiser->execute(true);
+        std::fill(noisy.begin(), noisy.end(), 0.f);
+        denoiser->sync();
+        CHECK(same_as_reference());
+        // the worker is reused by later executes
+        noisy = noisy_copy;
+        std::fill(output.begin(), output.end(), -1.f);
+        denoiser->execute(true);
+        denoiser->sync();
+        CHECK(same_as_reference());
+    }
+}
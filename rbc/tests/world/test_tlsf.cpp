@@ -0,0 +1,194 @@
+#include "test_util.h"
+#include <rbc_graphics/first_fit.h>
+#include <rbc_graphics/tlsf_allocator.h>
+#include <luisa/core/clock.h>
+#include <luisa/core/logging.h>
+#include <luisa/core/stl/vector.h>
+#include <limits>
+#include <random>
+
+namespace {
+// Churn of BufferAllocator clients: material, instance and light blocks spawn and die in bursts,
+// with a small number of long-lived large blocks.
+struct ChurnOp {
+    uint32_t size;// 0 for free
+    uint32_t slot;
+};
+luisa::vector<ChurnOp> make_churn_trace(size_t op_count, uint32_t max_live) {
+    std::mt19937 rng{42};
+    luisa::vector<ChurnOp> ops;
+    luisa::vector<uint32_t> live;
+    luisa::vector<uint32_t> free_slots;
+    uint32_t slot_count = 0;
+    ops.reserve(op_count);
+    auto random_size = [&]() -> uint32_t {
+        auto r = rng() % 100;
+        // instance infos and light data
+        if (r < 60) return 16u * (1u + rng() % 8u);
+        // materials
+        if (r < 95) return 64u * (1u + rng() % 16u);
+        // procedural metas and large tables
+        return 4096u * (1u + rng() % 16u);
+    };
+    while (ops.size() < op_count) {
+        bool spawn = live.empty() || (live.size() < max_live && rng() % 100 < 55);
+        auto burst = 1u + rng() % 32u;
+        for (uint32_t i = 0; i < burst && ops.size() < op_count; ++i) {
+            if (spawn && live.size() < max_live) {
+                uint32_t slot;
+                if (free_slots.empty()) {
+                    slot = slot_count++;
+                } else {
+                    slot = free_slots.back();
+                    free_slots.pop_back();
+                }
+                live.emplace_back(slot);
+                ops.emplace_back(ChurnOp{random_size(), slot});
+            } else if (!live.empty()) {
+                auto idx = rng() % live.size();
+                auto slot = live[idx];
+                live[idx] = live.back();
+                live.pop_back();
+                free_slots.emplace_back(slot);
+                ops.emplace_back(ChurnOp{0u, slot});
+            }
+        }
+    }
+    for (auto slot : live) {
+        ops.emplace_back(ChurnOp{0u, slot});
+    }
+    return ops;
+}
+struct ChurnResult {
+    double ms;
+    size_t peak_end;
+    size_t peak_live;
+};
+template<typename Alloc>
+ChurnResult run_churn(Alloc &alloc, luisa::span<ChurnOp const> ops, bool best_fit = false) {
+    luisa::vector<typename Alloc::Node *> slots;
+    ChurnResult result{};
+    size_t live_bytes = 0;
+    luisa::Clock clk;
+    for (auto &op : ops) {
+        if (slots.size() <= op.slot) slots.resize(op.slot + 1, nullptr);
+        if (op.size == 0) {
+            live_bytes -= slots[op.slot]->size();
+            alloc.free(slots[op.slot]);
+            slots[op.slot] = nullptr;
+            continue;
+        }
+        typename Alloc::Node *node;
+        if constexpr (std::is_same_v<Alloc, rbc::FirstFit>) {
+            node = best_fit ? alloc.allocate_best_fit(op.size) : alloc.allocate(op.size);
+        } else {
+            node = alloc.allocate(op.size);
+        }
+        REQUIRE(node != nullptr);
+        slots[op.slot] = node;
+        live_bytes += node->size();
+        // the device buffer has to cover the highest allocated byte
+        result.peak_end = std::max(result.peak_end, node->offset() + node->size());
+        result.peak_live = std::max(result.peak_live, live_bytes);
+    }
+    result.ms = clk.toc();
+    return result;
+}
+}// namespace
+
+TEST_SUITE("world") {
+    TEST_CASE("tlsf_allocator") {
+        rbc::TLSFAllocator alloc{1024, 4};
+        auto a = alloc.allocate(100);
+        auto b = alloc.allocate(200);
+        auto c = alloc.allocate(3);
+        REQUIRE(a);
+        REQUIRE(b);
+        REQUIRE(c);
+        CHECK(a->offset() == 0);
+        CHECK(b->offset() == 100);
+        CHECK(c->offset() == 300);
+        CHECK(c->size() == 4);
+        CHECK(alloc.free_bytes() == 1024 - 304);
+        // too large for what is left
+        CHECK(alloc.allocate(1024) == nullptr);
+        // neighbors coalesce in any free order
+        alloc.free(b);
+        alloc.free(a);
+        // good fit rounds requests up to the next size class, 296 shares the class of the merged 300
+        auto d = alloc.allocate(296);
+        REQUIRE(d);
+        CHECK(d->offset() == 0);
+        alloc.free(d);
+        alloc.free(c);
+        CHECK(alloc.free_bytes() == 1024);
+        CHECK(alloc.largest_free_size() == 1024);
+        auto whole = alloc.allocate(1024);
+        REQUIRE(whole);
+        CHECK(alloc.allocate(4) == nullptr);
+        alloc.free(whole);
+    }
+
+    TEST_CASE("tlsf_allocator_slide") {
+        rbc::TLSFAllocator alloc{1024, 4};
+        auto a = alloc.allocate(64);
+        auto b = alloc.allocate(32);
+        auto c = alloc.allocate(16);
+        auto d = alloc.allocate(8);
+        alloc.free(a);
+        CHECK(alloc.used_end() == 120);
+        // b and c move into the hole left by a, the hole reappears before d
+        auto hole = alloc.slide_down(alloc.first_block(), c);
+        CHECK(alloc.first_block() == b);
+        CHECK(b->offset() == 0);
+        CHECK(c->offset() == 32);
+        CHECK(hole->is_free());
+        CHECK(hole->offset() == 48);
+        CHECK(hole->size() == 64);
+        CHECK(hole->next() == d);
+        // the hole merges into the free tail
+        alloc.free(d);
+        CHECK(alloc.used_end() == 48);
+        alloc.free(b);
+        auto tail = alloc.slide_down(alloc.first_block(), c);
+        CHECK(c->offset() == 0);
+        CHECK(tail->offset() == 16);
+        CHECK(tail->size() == 1008);
+        CHECK(alloc.used_end() == 16);
+        alloc.free(c);
+        CHECK(alloc.free_bytes() == 1024);
+    }
+
+    TEST_CASE("tlsf_allocator_churn") {
+        auto ops = make_churn_trace(100000, 8192);
+        rbc::TLSFAllocator alloc{1ull << 32, 4};
+        auto result = run_churn(alloc, ops);
+        CHECK(alloc.free_bytes() == alloc.size());
+        CHECK(alloc.largest_free_size() == alloc.size());
+        CHECK(result.peak_end >= result.peak_live);
+    }
+
+    // throughput only, opt in with --no-skip
+    TEST_CASE("tlsf_allocator_benchmark" * doctest::skip()) {
+        auto ops = make_churn_trace(1000000, 16384);
+        constexpr size_t range = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) * sizeof(uint32_t);
+        auto report = [](char const *name, ChurnResult const &r, size_t op_count) {
+            LUISA_INFO("{}: {:.2f} ms, {:.2f} Mops/s, peak live {} KB, peak end {} KB, overhead {:.1f}%",
+                       name, r.ms, op_count / (r.ms * 1e3),
+                       r.peak_live / 1024, r.peak_end / 1024,
+                       (static_cast<double>(r.peak_end) / r.peak_live - 1.0) * 100.0);
+        };
+        {
+            rbc::FirstFit alloc{range, alignof(uint32_t)};
+            report("FirstFit", run_churn(alloc, ops, false), ops.size());
+        }
+        {
+            rbc::FirstFit alloc{range, alignof(uint32_t)};
+            report("FirstFit best fit", run_churn(alloc, ops, true), ops.size());
+        }
+        {
+            rbc::TLSFAllocator alloc{range, alignof(uint32_t)};
+            report("TLSF", run_churn(alloc, ops), ops.size());
+        }
+    }
+}
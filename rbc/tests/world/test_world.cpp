@@ -2,6 +2,8 @@
 #include <rbc_world/base_object.h>
 #include <rbc_world/entity.h>
 #include <rbc_world/components/transform.h>
+#include <luisa/core/fiber.h>
+#include <thread>
 
 TEST_SUITE("world") {
     TEST_CASE("ec") {
@@ -9,4 +11,110 @@ TEST_SUITE("world") {
         auto entity = world::create_object<world::Entity>();
         auto transform = entity->add_component<world::TransformComponent>();
     }
-}
\ No newline at end of file
+    TEST_CASE("transform_batch") {
+        using namespace rbc;
+        luisa::fiber::scheduler scheduler;
+        auto parent_entity = world::create_object<world::Entity>();
+        auto child_entity = world::create_object<world::Entity>();
+        auto parent = parent_entity->add_component<world::TransformComponent>();
+        auto child = child_entity->add_component<world::TransformComponent>();
+        parent->add_children(child);
+        world::InstanceID invalid{world::InstanceID::invalid_resource_handle()};
+        world::InstanceID ids[] = {parent->instance_id(), invalid, child->instance_id()};
+        double3 positions[] = {double3(1, 0, 0), double3(), double3(0, 2, 0)};
+        Quaternion rotations[3];
+        double3 scales[] = {double3(1), double3(1), double3(1)};
+        auto count = world::TransformComponent::set_trs_batch(ids, positions, rotations, scales, true);
+        CHECK(count == 2);
+        CHECK(parent->trs()[3].x == doctest::Approx(1.0));
+        // the child is set after its parent moved it, so it ends up at its own absolute value
+        CHECK(child->trs()[3].x == doctest::Approx(0.0));
+        CHECK(child->trs()[3].y == doctest::Approx(2.0));
+    }
+    TEST_CASE("transform_batch_hierarchy_order") {
+        using namespace rbc;
+        // no scheduler bound, applied serially
+        luisa::vector<RC<world::Entity>> entities;
+        luisa::vector<world::TransformComponent *> transforms;
+        for (size_t i = 0; i < 3; ++i) {
+            auto entity = world::create_object<world::Entity>();
+            transforms.emplace_back(entity->add_component<world::TransformComponent>());
+            entities.emplace_back(entity);
+        }
+        auto root = transforms[0], middle = transforms[1], leaf = transforms[2];
+        root->add_children(middle);
+        middle->add_children(leaf);
+        // the descendant comes first, the root must still be applied before it
+        world::InstanceID ids[] = {middle->instance_id(), root->instance_id()};
+        double3 positions[] = {double3(0, 3, 0), double3(10, 0, 0)};
+        Quaternion rotations[2];
+        double3 scales[] = {double3(1), double3(1)};
+        auto count = world::TransformComponent::set_trs_batch(ids, positions, rotations, scales, true, false);
+        CHECK(count == 2);
+        CHECK(root->trs()[3].x == doctest::Approx(10.0));
+        CHECK(middle->trs()[3].x == doctest::Approx(0.0));
+        CHECK(middle->trs()[3].y == doctest::Approx(3.0));
+        // the leaf follows the last move of its parent
+        CHECK(leaf->trs()[3].x == doctest::Approx(0.0));
+        CHECK(leaf->trs()[3].y == doctest::Approx(3.0));
+        world::_zz_clear_dirty_transform(false);
+    }
+    TEST_CASE("transform_drain_serial") {
+        using namespace rbc;
+        // no scheduler bound, drained serially
+        constexpr size_t count = 64;
+        luisa::vector<RC<world::Entity>> entities;
+        luisa::vector<world::TransformComponent *> transforms;
+        for (size_t i = 0; i < count; ++i) {
+            auto entity = world::create_object<world::Entity>();
+            transforms.emplace_back(entity->add_component<world::TransformComponent>());
+            entities.emplace_back(entity);
+        }
+        world::_zz_clear_dirty_transform(false);
+        // marks from short-lived threads survive the thread and reuse its bucket afterwards
+        for (size_t round = 0; round < 4; ++round) {
+            std::thread([&] {
+                for (size_t i = round; i < count; i += 4) {
+                    transforms[i]->set_pos(double3(static_cast<double>(round), 0, 0), false);
+                }
+            }).join();
+        }
+        transforms[0]->set_pos(double3(1, 0, 0), false);
+        for (auto tr : transforms) {
+            CHECK(tr->dirty());
+        }
+        world::_zz_clear_dirty_transform(false);
+        for (auto tr : transforms) {
+            CHECK(!tr->dirty());
+        }
+        CHECK(transforms[5]->trs()[3].x == doctest::Approx(1.0));
+    }
+    TEST_CASE("transform_dirty_multithread") {
+        using namespace rbc;
+        luisa::fiber::scheduler scheduler;
+        constexpr size_t count = 1024;
+        luisa::vector<RC<world::Entity>> entities;
+        luisa::vector<world::TransformComponent *> transforms;
+        for (size_t i = 0; i < count; ++i) {
+            auto entity = world::create_object<world::Entity>();
+            transforms.emplace_back(entity->add_component<world::TransformComponent>());
+            entities.emplace_back(entity);
+        }
+        world::_zz_clear_dirty_transform();
+        // every transform is marked twice from different threads, each must be queued once
+        luisa::fiber::parallel(count * 2, [&](size_t i) {
+            transforms[i % count]->set_pos(double3(static_cast<double>(i), 0, 0), false);
+        }, 16);
+        for (auto tr : transforms) {
+            CHECK(tr->dirty());
+        }
+        world::_zz_clear_dirty_transform();
+        for (auto tr : transforms) {
+            CHECK(!tr->dirty());
+        }
+        transforms[0]->set_pos(double3(1, 0, 0), false);
+        CHECK(transforms[0]->dirty());
+        world::_zz_clear_dirty_transform();
+        CHECK(!transforms[0]->dirty());
+    }
+}
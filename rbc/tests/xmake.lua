@@ -28,7 +28,13 @@ end
 
 add_test("core", { "rbc_core" })
 add_test("world", { "rbc_runtime", "rbc_core" })
-add_test("anim", { "rbc_runtime", "rbc_core" })
+-- the optimizer test builds ozz skeletons and clips itself, rbc_runtime links ozz privately
+add_test("anim", { "rbc_runtime", "rbc_core", "ozz_animation_runtime_static", "ozz_animation_offline_static" })
+add_test("node", { "rbc_node", "rbc_core" })
+-- the OIDN CPU denoiser test loads oidn_plugin at runtime, only its header is needed
+target("test_world")
+    add_deps("oidn_plugin", {links = false})
+target_end()
 
 
 -- 一些第三方库的测试用例，用来检测第三方库是否稳定
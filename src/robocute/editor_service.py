@@ -118,6 +118,22 @@ class EditorService(Service):
             except Exception as e:
                 raise HTTPException(status_code=500, detail=str(e))
 
+        @app.get("/scene/delta")
+        def get_scene_delta(since: int = 0, timeout_ms: int = 0):
+            """
+            Entities changed since version `since`
+
+            With `timeout_ms` the request is held open (long-poll) until the
+            scene changes or the timeout expires, an unchanged scene returns
+            an empty delta at the same version.
+            """
+            try:
+                if timeout_ms > 0 and since > 0:
+                    self.scene.wait_for_change(since, min(timeout_ms, 30000) / 1000.0)
+                return {"success": True, "delta": self.scene.get_delta(since)}
+            except Exception as e:
+                raise HTTPException(status_code=500, detail=str(e))
+
         @app.get("/resources/all")
         def get_all_resources():
             """Get all resource metadata"""
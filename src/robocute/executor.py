@@ -262,6 +262,99 @@ class GraphExecutor:
 
         return self._execution_result
 
+    def execute_parallel(self) -> GraphExecutionResult:
+        """
+        使用 rbc_ext_c 的原生调度器并行执行节点图
+
+        前驱全部完成的节点会被立即调度，执行期间释放 GIL，
+        Python 节点仅在自身运行时持有 GIL。rbc_ext_c 不可用时退回到 execute()。
+
+        Returns:
+            图执行结果
+        """
+        try:
+            import rbc_ext_c
+        except ImportError:
+            return self.execute()
+
+        self._execution_result = GraphExecutionResult(
+            graph_id=self.graph.graph_id,
+            status=ExecutionStatus.RUNNING,
+            start_time=datetime.now(),
+        )
+        try:
+            is_valid, error = self.graph.validate()
+            if not is_valid:
+                self._execution_result.status = ExecutionStatus.FAILED
+                self._execution_result.error = f"Graph validation failed: {error}"
+                return self._execution_result
+
+            native = rbc_ext_c.GraphExecutor()
+            node_ids = list(self.graph._nodes.keys())
+            indices: Dict[str, int] = {}
+            for node_id in node_ids:
+
+                def run(_inputs, node_id=node_id):
+                    node = self.graph.get_node(node_id)
+                    self._notify_callbacks(node_id, ExecutionStatus.RUNNING)
+                    try:
+                        node.run()
+                    except Exception:
+                        self._notify_callbacks(node_id, ExecutionStatus.FAILED)
+                        raise
+                    # 后继节点在本节点完成后才会被调度，此处传播输出是安全的
+                    self._propagate_outputs(node_id)
+                    self._notify_callbacks(node_id, ExecutionStatus.COMPLETED)
+                    return None
+
+                indices[node_id] = native.add_node(node_id, run, 0)
+
+            for conn in self.graph.get_connections():
+                # 仅表达依赖关系，数据仍通过 set_input 传递
+                native.connect_dependency(indices[conn.from_node], indices[conn.to_node])
+
+            if not native.compile():
+                self._execution_result.status = ExecutionStatus.FAILED
+                self._execution_result.error = (
+                    "Failed to get execution order (cycle detected)"
+                )
+                return self._execution_result
+
+            native.execute()
+
+            failed = None
+            for node_id, index in indices.items():
+                status = ExecutionStatus(native.status(index))
+                start_ms, duration_ms = native.timing(index)
+                node = self.graph.get_node(node_id)
+                self._execution_result.node_results[node_id] = NodeExecutionResult(
+                    node_id=node_id,
+                    status=status,
+                    outputs=node.get_all_outputs() if status == ExecutionStatus.COMPLETED else {},
+                    error=native.error(index) or None,
+                    duration_ms=duration_ms,
+                )
+                if status == ExecutionStatus.FAILED and failed is None:
+                    failed = node_id
+            if failed is not None:
+                self._execution_result.status = ExecutionStatus.FAILED
+                self._execution_result.error = (
+                    f"Node {failed} failed: {native.error(indices[failed])}"
+                )
+            else:
+                self._execution_result.status = ExecutionStatus.COMPLETED
+        except Exception as e:
+            self._execution_result.status = ExecutionStatus.FAILED
+            self._execution_result.error = f"Execution error: {str(e)}"
+        finally:
+            self._execution_result.end_time = datetime.now()
+            duration = (
+                self._execution_result.end_time - self._execution_result.start_time
+            ).total_seconds() * 1000
+            self._execution_result.duration_ms = duration
+
+        return self._execution_result
+
     def get_result(self) -> Optional[GraphExecutionResult]:
         """
         获取执行结果
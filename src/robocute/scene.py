@@ -6,8 +6,10 @@ resource management, ECS, and editor synchronization.
 """
 
 from typing import Optional, Dict, List, Any
+from collections import OrderedDict
 from dataclasses import dataclass
 import json
+import threading
 from pathlib import Path
 
 from rbc_ext.resource import ResourceManager, ResourceType, LoadPriority
@@ -94,6 +96,16 @@ class Scene:
         # Animation storage
         self._animations: Dict[str, AnimationClip] = {}
 
+        # Change tracking for incremental editor sync
+        self._version: int = 0
+        self._entity_versions: Dict[int, int] = {}
+        # kept in version order, the first entry is always the oldest tombstone
+        self._removed_versions: "OrderedDict[int, int]" = OrderedDict()
+        # Deltas older than this version are no longer reconstructible
+        self._delta_base_version: int = 0
+        self._version_cond = threading.Condition()
+        self.max_removed_history = 4096
+
     def start(self):
         """Start the scene (initializes resource manager)"""
         if not self._running:
@@ -117,13 +129,18 @@ class Scene:
 
     # === Entity Management ===
 
-    def create_entity(self, name: str = "") -> Entity:
-        """Create a new entity"""
+    def create_entity(
+        self, name: str = "", components: Optional[Dict[str, Any]] = None
+    ) -> Entity:
+        """Create a new entity, `components` are attached before it is published"""
         entity_id = self._next_entity_id
         self._next_entity_id += 1
 
         entity = Entity(entity_id, name)
+        for component_type, component in (components or {}).items():
+            entity.add_component(component_type, component)
         self._entities[entity_id] = entity
+        self.mark_dirty(entity_id)
 
         return entity
 
@@ -131,6 +148,7 @@ class Scene:
         """Destroy an entity"""
         if entity_id in self._entities:
             del self._entities[entity_id]
+            self._mark_removed(entity_id)
 
     def get_entity(self, entity_id: int) -> Optional[Entity]:
         """Get an entity by ID"""
@@ -147,12 +165,82 @@ class Scene:
         entity = self.get_entity(entity_id)
         if entity:
             entity.add_component(component_type, component)
+            self.mark_dirty(entity_id)
 
     def get_component(self, entity_id: int, component_type: str) -> Optional[Any]:
         """Get a component from an entity"""
         entity = self.get_entity(entity_id)
         return entity.get_component(component_type) if entity else None
 
+    # === Change Tracking ===
+
+    @property
+    def version(self) -> int:
+        """Monotonic scene version, bumped on every entity change"""
+        return self._version
+
+    def mark_dirty(self, entity_id: int):
+        """Mark an entity as changed, call after editing its components in place"""
+        with self._version_cond:
+            self._version += 1
+            self._entity_versions[entity_id] = self._version
+            self._removed_versions.pop(entity_id, None)
+            self._version_cond.notify_all()
+
+    def _mark_removed(self, entity_id: int):
+        with self._version_cond:
+            self._version += 1
+            self._entity_versions.pop(entity_id, None)
+            # re-insert so the order stays the version order
+            self._removed_versions.pop(entity_id, None)
+            self._removed_versions[entity_id] = self._version
+            # forget the oldest removals, editors older than them get a full sync
+            while len(self._removed_versions) > self.max_removed_history:
+                _, oldest_version = self._removed_versions.popitem(last=False)
+                self._delta_base_version = max(
+                    self._delta_base_version, oldest_version
+                )
+            self._version_cond.notify_all()
+
+    def wait_for_change(self, since: int, timeout: float) -> bool:
+        """Block until the scene version passes `since` or the timeout expires"""
+        with self._version_cond:
+            return self._version_cond.wait_for(
+                lambda: self._version > since, timeout=timeout
+            )
+
+    def get_delta(self, since: int) -> dict:
+        """
+        Entities changed and removed after version `since`
+
+        A full snapshot (`full` set, every entity listed) is returned when
+        `since` is 0, from the future, or older than the retained history.
+        """
+        with self._version_cond:
+            version = self._version
+            full = since <= 0 or since > version or since < self._delta_base_version
+            if full:
+                changed_ids = list(self._entities.keys())
+                removed = []
+            else:
+                changed_ids = [
+                    eid for eid, v in self._entity_versions.items() if v > since
+                ]
+                removed = [
+                    eid for eid, v in self._removed_versions.items() if v > since
+                ]
+            entities = [
+                self._entity_to_dict(self._entities[eid])
+                for eid in changed_ids
+                if eid in self._entities
+            ]
+        return {
+            "version": version,
+            "full": full,
+            "entities": entities,
+            "removed": removed,
+        }
+
     # === Animation Management ===
 
     def add_animation(self, name: str, clip: AnimationClip):
@@ -221,9 +309,8 @@ class Scene:
         # Load entities
         entities_data = data.get("entities", [])
         for entity_data in entities_data:
-            entity = self.create_entity(entity_data.get("name", ""))
-
-            # Load components
+            # Load components first, the entity is published complete
+            components = {}
             for comp_type, comp_data in entity_data.get("components", {}).items():
                 if comp_type == "transform":
                     component = TransformComponent(**comp_data)
@@ -231,7 +318,8 @@ class Scene:
                     component = RenderComponent(**comp_data)
                 else:
                     component = comp_data
-                entity.add_component(comp_type, component)
+                components[comp_type] = component
+            self.create_entity(entity_data.get("name", ""), components)
 
         # Load animations
         animations_data = data.get("animations", {})
@@ -272,15 +360,7 @@ class Scene:
 
         # Save entities
         for entity in self._entities.values():
-            entity_data = {"id": entity.id, "name": entity.name, "components": {}}
-
-            for comp_type, component in entity.components.items():
-                if hasattr(component, "__dict__"):
-                    entity_data["components"][comp_type] = component.__dict__
-                else:
-                    entity_data["components"][comp_type] = component
-
-            data["entities"].append(entity_data)
+            data["entities"].append(self._entity_to_dict(entity))
 
         # Save animations
         for name, clip in self._animations.items():
@@ -288,6 +368,18 @@ class Scene:
 
         return data
 
+    @staticmethod
+    def _entity_to_dict(entity: Entity) -> dict:
+        entity_data = {"id": entity.id, "name": entity.name, "components": {}}
+
+        for comp_type, component in entity.components.items():
+            if hasattr(component, "__dict__"):
+                entity_data["components"][comp_type] = component.__dict__
+            else:
+                entity_data["components"][comp_type] = component
+
+        return entity_data
+
     # === Resource Convenience Methods ===
 
     def load_mesh(self, path: str, priority: LoadPriority = LoadPriority.Normal) -> int: